@@ -0,0 +1,249 @@
+#include "batchinjector.h"
+#include "mysterygift.h"
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QThread>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QSet>
+#include <algorithm>
+
+BatchInjector::BatchInjector()
+    : m_makeBackup(false)
+    , m_enableMysteryGift(false)
+    , m_threadCount(0)
+    , m_writeMode(SaveWriteMode::FullRewrite)
+{
+}
+
+bool BatchInjector::setTicket(const TicketResource &ticket, const QByteArray &crcTable,
+                              QString &errorMessage)
+{
+    if (!ticket.isDataLoaded()) {
+        errorMessage = QString("Ticket data not loaded: %1").arg(ticket.id());
+        return false;
+    }
+
+    if (ticket.wonderCardData().size() != TicketResource::WONDERCARD_SIZE) {
+        errorMessage = QString("Invalid Wonder Card size for ticket %1: %2 bytes")
+                          .arg(ticket.id())
+                          .arg(ticket.wonderCardData().size());
+        return false;
+    }
+
+    if (ticket.gameType() != GameType::FireRedLeafGreen && ticket.gameType() != GameType::Emerald) {
+        errorMessage = QString("Ticket %1 targets a game without Wonder Card support")
+                          .arg(ticket.id());
+        return false;
+    }
+
+    if (crcTable.size() != 512) {
+        errorMessage = QString("Invalid CRC table size: %1 bytes (expected 512 bytes)")
+                          .arg(crcTable.size());
+        return false;
+    }
+
+    m_ticket = ticket;
+    m_crcTable = crcTable;
+
+    // Parse once; injection prefers the raw bytes, the struct is only a fallback
+    m_wonderCard = MysteryGift::parseWonderCard(ticket.wonderCardData());
+
+    return true;
+}
+
+int BatchInjector::threadCount() const
+{
+    return m_threadCount > 0 ? m_threadCount : qMax(1, QThread::idealThreadCount());
+}
+
+QStringList BatchInjector::collectSaveFiles(const QStringList &paths, bool recursive)
+{
+    QStringList result;
+    QSet<QString> seen;
+
+    for (const QString &path : paths) {
+        QFileInfo info(path);
+
+        if (info.isDir()) {
+            QDirIterator it(info.absoluteFilePath(), QStringList() << "*.sav", QDir::Files,
+                            recursive ? QDirIterator::Subdirectories : QDirIterator::NoIteratorFlags);
+            while (it.hasNext()) {
+                QString filePath = QFileInfo(it.next()).absoluteFilePath();
+                if (!seen.contains(filePath)) {
+                    seen.insert(filePath);
+                    result.append(filePath);
+                }
+            }
+        } else {
+            // Explicit files are accepted regardless of extension; a missing
+            // file is kept so that it shows up as a failure in the report
+            QString filePath = info.absoluteFilePath();
+            if (!seen.contains(filePath)) {
+                seen.insert(filePath);
+                result.append(filePath);
+            }
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+QString BatchInjector::outputPathFor(const QString &savePath) const
+{
+    if (m_outputDirectory.isEmpty()) {
+        return savePath;  // In-place
+    }
+
+    return QDir(m_outputDirectory).filePath(QFileInfo(savePath).fileName());
+}
+
+QStringList BatchInjector::outputPathsFor(const QStringList &savePaths) const
+{
+    if (m_outputDirectory.isEmpty()) {
+        return savePaths;  // In-place
+    }
+
+    // One output per input (duplicate file names get a numeric suffix). Names
+    // are compared case-folded: Save.sav and save.sav are the same file on
+    // the default Windows and macOS filesystems
+    QDir outputDir(m_outputDirectory);
+    QStringList outputPaths;
+    QSet<QString> used;
+    for (const QString &savePath : savePaths) {
+        QFileInfo info(savePath);
+        QString suffix = info.suffix().isEmpty() ? QString() : "." + info.suffix();
+        QString fileName = info.fileName();
+        for (int n = 2; used.contains(fileName.toCaseFolded()); ++n) {
+            fileName = QString("%1_%2%3").arg(info.completeBaseName(), QString::number(n), suffix);
+        }
+        used.insert(fileName.toCaseFolded());
+        outputPaths.append(outputDir.filePath(fileName));
+    }
+    return outputPaths;
+}
+
+bool BatchInjector::processSave(SaveFile &saveFile, const QString &savePath, const QString &target,
+                                QString &outputPath, QString &errorMessage) const
+{
+    // Finish an interrupted in-place patch before reading the save; a copy
+    // to the output directory must not start from a half-written input
+    if (target == savePath) {
+        if (!SaveFile::recoverJournal(savePath, errorMessage)) {
+            return false;
+        }
+    } else if (SaveFile::hasPendingJournal(savePath)) {
+        errorMessage = "Save has an interrupted write pending; run it in place first to recover it";
+        return false;
+    }
+
+    if (!saveFile.loadFromFile(savePath, errorMessage)) {
+        return false;
+    }
+
+    GameType game = saveFile.detectedGame();
+    if (game != m_ticket.gameType()) {
+        errorMessage = QString("Save is %1 but ticket is for %2")
+                          .arg(saveFile.gameTypeToString(game),
+                               saveFile.gameTypeToString(m_ticket.gameType()));
+        return false;
+    }
+
+    if (m_enableMysteryGift && !saveFile.isMysteryGiftEnabled()) {
+        if (!saveFile.enableMysteryGift(errorMessage)) {
+            return false;
+        }
+    }
+
+    if (!saveFile.injectWonderCard(m_wonderCard, m_ticket.scriptData(), m_crcTable,
+                                   errorMessage, m_ticket.wonderCardData(), m_options)) {
+        return false;
+    }
+
+    if (!saveFile.saveToFile(target, m_makeBackup, errorMessage, m_writeMode)) {
+        return false;
+    }
+
+    outputPath = target;
+    return true;
+}
+
+BatchInjectionResult BatchInjector::process(const QString &savePath) const
+{
+    BatchInjectionResult result;
+    result.savePath = savePath;
+
+    if (!m_outputDirectory.isEmpty() && !QDir().mkpath(m_outputDirectory)) {
+        result.errorMessage = "Failed to create output directory: " + m_outputDirectory;
+        return result;
+    }
+
+    SaveFile saveFile;
+    result.success = processSave(saveFile, savePath, outputPathFor(savePath),
+                                 result.outputPath, result.errorMessage);
+    return result;
+}
+
+BatchInjectionReport BatchInjector::run(const QStringList &savePaths) const
+{
+    BatchInjectionReport report;
+    report.total = savePaths.size();
+    report.threadCount = qMin(threadCount(), qMax(1, report.total));
+    report.results.resize(report.total);
+
+    if (report.total == 0) {
+        return report;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if (!m_outputDirectory.isEmpty() && !QDir().mkpath(m_outputDirectory)) {
+        for (int i = 0; i < report.total; ++i) {
+            report.results[i].savePath = savePaths.at(i);
+            report.results[i].errorMessage = "Failed to create output directory: " + m_outputDirectory;
+        }
+        report.failed = report.total;
+        report.elapsedMs = timer.elapsed();
+        return report;
+    }
+
+    // Each worker keeps one SaveFile (and therefore one save buffer) for the
+    // whole batch and pulls the next index from a shared cursor. Results are
+    // written to distinct slots, so no locking is needed.
+    QAtomicInt cursor(0);
+    BatchInjectionResult *results = report.results.data();
+    const QStringList targets = outputPathsFor(savePaths);
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(report.threadCount);
+
+    for (int worker = 0; worker < report.threadCount; ++worker) {
+        pool.start([this, &savePaths, &targets, results, &cursor]() {
+            SaveFile saveFile;
+            int index;
+            while ((index = cursor.fetchAndAddRelaxed(1)) < savePaths.size()) {
+                BatchInjectionResult &result = results[index];
+                result.savePath = savePaths.at(index);
+                result.success = processSave(saveFile, result.savePath, targets.at(index),
+                                             result.outputPath, result.errorMessage);
+            }
+        });
+    }
+
+    pool.waitForDone();
+    report.elapsedMs = timer.elapsed();
+
+    for (const BatchInjectionResult &result : report.results) {
+        if (result.success) {
+            ++report.succeeded;
+        } else {
+            ++report.failed;
+        }
+    }
+
+    return report;
+}
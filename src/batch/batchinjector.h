@@ -0,0 +1,137 @@
+/**
+ * @file batchinjector.h
+ * @brief Headless, multi-threaded Wonder Card injection over many save files.
+ *
+ * BatchInjector applies a single ticket (Wonder Card + GREEN MAN script) to a
+ * list of Pokemon Generation III save files without any GUI involvement. It is
+ * intended for distribution events where thousands of uploaded saves must
+ * receive the same ticket.
+ *
+ * ## Processing Model
+ * - The save list is split across a QThreadPool worker set
+ * - Each worker owns one SaveFile for its whole lifetime, so the 128 KB save
+ *   buffer is allocated once per thread and reused for every file
+ * - Work is handed out through a shared atomic cursor (no per-file task objects)
+ * - Results are written into a pre-sized vector slot per input (no locking)
+ *
+ * Each save goes through the same path as the GUI: SaveFile::recoverJournal,
+ * SaveFile::loadFromFile, optional SaveFile::enableMysteryGift,
+ * SaveFile::injectWonderCard and SaveFile::saveToFile. Saves whose detected game does not match the ticket's
+ * game are rejected rather than written.
+ *
+ * With an output directory, saves are written there under their file name;
+ * inputs sharing a file name (e.g. from different subfolders with -r) get a
+ * numeric suffix (name_2.sav, name_3.sav, ...) in input order.
+ *
+ * @see savefile.h for the underlying save file operations
+ * @see ticketresource.h for ticket data
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef BATCHINJECTOR_H
+#define BATCHINJECTOR_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "savefile.h"
+#include "ticketresource.h"
+
+/// <summary>
+/// Outcome of injecting the ticket into one save file.
+/// </summary>
+struct BatchInjectionResult {
+    QString savePath;        // Input save file
+    QString outputPath;      // Where the modified save was written (empty on failure)
+    bool success = false;    // True if injected and written
+    QString errorMessage;    // Reason for failure
+};
+
+/// <summary>
+/// Aggregate statistics for one BatchInjector::run() call.
+/// </summary>
+struct BatchInjectionReport {
+    int total = 0;           // Number of save files submitted
+    int succeeded = 0;       // Saves injected and written
+    int failed = 0;          // Saves that could not be processed
+    int threadCount = 0;     // Worker threads used
+    qint64 elapsedMs = 0;    // Wall-clock time for the whole batch
+    QVector<BatchInjectionResult> results;  // One entry per input, in input order
+
+    /// Throughput over the whole batch (successful and failed saves).
+    double savesPerSecond() const {
+        return elapsedMs > 0 ? (total * 1000.0) / elapsedMs : 0.0;
+    }
+};
+
+/// <summary>
+/// Injects one ticket into many save files on a worker pool.
+///
+/// USAGE:
+///   BatchInjector injector;
+///   injector.setTicket(ticket, ticketManager.crcTable());
+///   injector.setOutputDirectory("out");
+///   BatchInjectionReport report = injector.run(BatchInjector::collectSaveFiles(paths));
+///
+/// The ticket must have its data loaded (TicketResource::loadData) before
+/// run() is called. The injector itself is not modified by run(), so a single
+/// configured instance can be reused for successive batches.
+/// </summary>
+class BatchInjector
+{
+public:
+    BatchInjector();
+
+    // Configuration
+    bool setTicket(const TicketResource &ticket, const QByteArray &crcTable, QString &errorMessage);
+    void setInjectionOptions(const InjectionOptions &options) { m_options = options; }
+    void setOutputDirectory(const QString &directory) { m_outputDirectory = directory; }
+    void setMakeBackup(bool makeBackup) { m_makeBackup = makeBackup; }
+    void setEnableMysteryGift(bool enable) { m_enableMysteryGift = enable; }
+    void setThreadCount(int threadCount) { m_threadCount = threadCount; }
+    void setWriteMode(SaveWriteMode mode) { m_writeMode = mode; }
+
+    // Accessors
+    const TicketResource& ticket() const { return m_ticket; }
+    QString outputDirectory() const { return m_outputDirectory; }
+    int threadCount() const;
+
+    /// Expands files and directories into a sorted, de-duplicated list of *.sav files.
+    static QStringList collectSaveFiles(const QStringList &paths, bool recursive = false);
+
+    /// Processes every save in savePaths and returns per-file results plus timing.
+    BatchInjectionReport run(const QStringList &savePaths) const;
+
+    /// Processes one save on the calling thread (thread-safe, like run()).
+    BatchInjectionResult process(const QString &savePath) const;
+
+    /// Where process() writes savePath (the save itself when writing in place).
+    QString outputPathFor(const QString &savePath) const;
+
+private:
+    bool processSave(SaveFile &saveFile, const QString &savePath, const QString &target,
+                     QString &outputPath, QString &errorMessage) const;
+    QStringList outputPathsFor(const QStringList &savePaths) const;   // Collision-free, for run()
+
+    TicketResource m_ticket;
+    WonderCardData m_wonderCard;    // Parsed once from the ticket (fallback for encoding)
+    QByteArray m_crcTable;
+    InjectionOptions m_options;
+    QString m_outputDirectory;      // Empty = overwrite saves in place
+    bool m_makeBackup;
+    bool m_enableMysteryGift;
+    int m_threadCount;              // <= 0 = QThread::idealThreadCount()
+    SaveWriteMode m_writeMode;      // PatchSections only applies to in-place writes
+};
+
+#endif // BATCHINJECTOR_H
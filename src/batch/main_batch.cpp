@@ -0,0 +1,262 @@
+/**
+ * @file main_batch.cpp
+ * @brief Command-line front end for headless batch Wonder Card injection.
+ *
+ * Usage:
+ *   mgi_batch --ticket <id> [options] <save-or-directory>...
+ *   mgi_batch --analyze [options] [<save-or-directory>...]
+ *   mgi_batch --restore-delta [options] <save-or-directory>...
+ *
+ * Loads the ticket folder through TicketManager, selects one ticket by ID
+ * (the lower-cased file base name, e.g. "aurora_ticket_frlg_enguk"), and
+ * injects it into every save via BatchInjector. A summary including
+ * throughput (saves/sec) is printed when the batch finishes; the process exit
+ * code is non-zero if any save failed.
+ *
+ * With --analyze nothing is written: the RamScript of every save (or of every
+ * ticket, when no saves are given) is audited by ScriptAnalyzer and a
+ * tab-separated report is printed to stdout, one row per script. The exit
+ * code is non-zero if any script is unreadable or fails lint.
+ *
+ * With --restore-delta every save is rolled back through its <base>.bakd
+ * delta backup (written by --patch --backup); no ticket is needed. Saves
+ * without a delta are skipped, the exit code is non-zero if a restore fails.
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <QFile>
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "batchinjector.h"
+#include "ticketmanager.h"
+#include "scriptanalyzer.h"
+#include "tracing.h"
+
+static int runAnalysis(const QStringList &inputs, bool recursive, int threadCount,
+                       const TicketManager &ticketManager, QTextStream &out, QTextStream &err)
+{
+    ScriptDisassembler disassembler;
+    QString errorMessage;
+    if (!disassembler.loadDefaultData(errorMessage)) {
+        err << "Failed to load script data: " << errorMessage << Qt::endl;
+        return 2;
+    }
+
+    QVector<ScriptSource> sources;
+    if (inputs.isEmpty()) {
+        for (const TicketResource &source : ticketManager.tickets()) {
+            TicketResource ticket = source;
+            if (!ticket.isDataLoaded() && !ticket.loadData(ticketManager.ticketsFolderPath(), errorMessage)) {
+                err << "Skipping " << ticket.id() << ": " << errorMessage << Qt::endl;
+                continue;
+            }
+            ScriptSource script;
+            script.name = ticket.id();
+            script.ramScript = ticket.scriptData().mid(TicketResource::SCRIPT_HEADER_SIZE);
+            sources.append(script);
+        }
+    } else {
+        sources = ScriptAnalyzer::sourcesForSaves(BatchInjector::collectSaveFiles(inputs, recursive));
+    }
+
+    if (sources.isEmpty()) {
+        err << "No scripts to analyze" << Qt::endl;
+        return 2;
+    }
+
+    ScriptAnalyzer analyzer(disassembler);
+    analyzer.setThreadCount(threadCount);
+    ScriptAnalysisReport report = analyzer.run(sources);
+    analyzer.writeReport(report, out);
+
+    // Summary on stderr so stdout stays a clean table
+    err << QString("%1 sources (%2 with scripts, %3 clean) in %4 ms on %5 threads - %6 scripts/sec")
+               .arg(report.total)
+               .arg(report.withScript)
+               .arg(report.clean)
+               .arg(report.elapsedMs)
+               .arg(report.threadCount)
+               .arg(report.scriptsPerSecond(), 0, 'f', 1)
+        << Qt::endl;
+
+    return report.clean == report.total ? 0 : 1;
+}
+
+static int runDeltaRestore(const QStringList &inputs, bool recursive, bool quiet,
+                           QTextStream &out, QTextStream &err)
+{
+    QStringList saves = BatchInjector::collectSaveFiles(inputs, recursive);
+    if (saves.isEmpty()) {
+        err << "No save files given" << Qt::endl;
+        return 2;
+    }
+
+    int restored = 0;
+    int failed = 0;
+    for (const QString &savePath : saves) {
+        QString deltaPath = SaveFile::deltaBackupPath(savePath);
+        if (!QFile::exists(deltaPath)) {
+            if (!quiet) {
+                out << "SKIP " << savePath << ": no delta backup" << Qt::endl;
+            }
+            continue;
+        }
+
+        QString errorMessage;
+        if (SaveFile::restoreFromDeltaBackup(savePath, deltaPath, errorMessage)) {
+            ++restored;
+            if (!quiet) {
+                out << "OK   " << savePath << Qt::endl;
+            }
+        } else {
+            ++failed;
+            err << "FAIL " << savePath << ": " << errorMessage << Qt::endl;
+        }
+    }
+
+    out << QString("%1 saves (%2 restored, %3 failed)").arg(saves.size()).arg(restored).arg(failed) << Qt::endl;
+    return failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("mgi_batch");
+    QCoreApplication::setApplicationVersion("1.0");
+    Tracing::initFromEnvironment();   // MGI_TRACE / MGI_TRACE_COUNTERS
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Injects one Mystery Gift ticket into many Gen3 save files.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption ticketsOption("tickets", "Tickets folder (default: <app dir>/Tickets).", "dir");
+    QCommandLineOption ticketOption("ticket", "ID of the ticket to inject.", "id");
+    QCommandLineOption listOption("list", "List available ticket IDs and exit.");
+    QCommandLineOption outputOption({"o", "output"}, "Write modified saves here instead of in place.", "dir");
+    QCommandLineOption threadsOption({"j", "threads"}, "Worker threads (default: ideal thread count).", "n");
+    QCommandLineOption recursiveOption({"r", "recursive"}, "Search directories recursively for *.sav.");
+    QCommandLineOption backupOption("backup", "Create a .bak backup before overwriting each save.");
+    QCommandLineOption patchOption("patch", "Rewrite only changed sections in place (journaled; backups become .bakd deltas).");
+    QCommandLineOption enableMgOption("enable-mystery-gift", "Set the Mystery Gift flag if it is not set.");
+    QCommandLineOption clearTrainerIdsOption("clear-trainer-ids", "Clear saved Mystery Gift trainer IDs.");
+    QCommandLineOption keepMetadataOption("keep-metadata", "Do not clear Wonder Card metadata.");
+    QCommandLineOption quietOption({"q", "quiet"}, "Only print failures and the summary.");
+    QCommandLineOption analyzeOption("analyze", "Audit RamScripts of the given saves (or of every ticket) instead of injecting.");
+    QCommandLineOption restoreDeltaOption("restore-delta", "Undo patched writes of the given saves from their .bakd delta backups.");
+
+    parser.addOptions({ticketsOption, ticketOption, listOption, outputOption, threadsOption,
+                       recursiveOption, backupOption, patchOption, enableMgOption, clearTrainerIdsOption,
+                       keepMetadataOption, quietOption, analyzeOption, restoreDeltaOption});
+    parser.addPositionalArgument("saves", "Save files or directories containing *.sav files.",
+                                 "<save-or-directory>...");
+    parser.process(app);
+
+    if (parser.isSet(restoreDeltaOption)) {
+        return runDeltaRestore(parser.positionalArguments(), parser.isSet(recursiveOption),
+                               parser.isSet(quietOption), out, err);
+    }
+
+    // Load tickets
+    QString ticketsFolder = parser.isSet(ticketsOption)
+        ? parser.value(ticketsOption)
+        : QCoreApplication::applicationDirPath() + "/" + TicketManager::DEFAULT_TICKETS_FOLDER;
+
+    TicketManager ticketManager;
+    QString errorMessage;
+    if (!ticketManager.loadFromFolder(ticketsFolder, errorMessage)) {
+        err << "Failed to load tickets: " << errorMessage << Qt::endl;
+        return 2;
+    }
+
+    if (parser.isSet(listOption)) {
+        for (const TicketResource &ticket : ticketManager.tickets()) {
+            out << ticket.id() << "\t" << ticket.name() << Qt::endl;
+        }
+        return 0;
+    }
+
+    if (parser.isSet(analyzeOption)) {
+        return runAnalysis(parser.positionalArguments(), parser.isSet(recursiveOption),
+                           parser.value(threadsOption).toInt(), ticketManager, out, err);
+    }
+
+    if (!parser.isSet(ticketOption)) {
+        err << "No ticket selected (use --ticket <id>, or --list to see IDs)" << Qt::endl;
+        return 2;
+    }
+
+    const TicketResource *selected = ticketManager.findTicketById(parser.value(ticketOption));
+    if (!selected) {
+        err << "Unknown ticket: " << parser.value(ticketOption) << Qt::endl;
+        return 2;
+    }
+
+    TicketResource ticket = *selected;
+    if (!ticket.loadData(ticketManager.ticketsFolderPath(), errorMessage)) {
+        err << "Failed to load ticket data: " << errorMessage << Qt::endl;
+        return 2;
+    }
+
+    // Configure injector
+    BatchInjector injector;
+    if (!injector.setTicket(ticket, ticketManager.crcTable(), errorMessage)) {
+        err << errorMessage << Qt::endl;
+        return 2;
+    }
+
+    InjectionOptions options;
+    options.clearMetadata = !parser.isSet(keepMetadataOption);
+    options.clearTrainerIds = parser.isSet(clearTrainerIdsOption);
+    injector.setInjectionOptions(options);
+    injector.setOutputDirectory(parser.value(outputOption));
+    injector.setMakeBackup(parser.isSet(backupOption));
+    injector.setEnableMysteryGift(parser.isSet(enableMgOption));
+    injector.setWriteMode(parser.isSet(patchOption) ? SaveWriteMode::PatchSections
+                                                    : SaveWriteMode::FullRewrite);
+    if (parser.isSet(threadsOption)) {
+        injector.setThreadCount(parser.value(threadsOption).toInt());
+    }
+
+    QStringList saves = BatchInjector::collectSaveFiles(parser.positionalArguments(),
+                                                        parser.isSet(recursiveOption));
+    if (saves.isEmpty()) {
+        err << "No save files given" << Qt::endl;
+        return 2;
+    }
+
+    // Run
+    BatchInjectionReport report = injector.run(saves);
+
+    for (const BatchInjectionResult &result : report.results) {
+        if (!result.success) {
+            err << "FAIL " << result.savePath << ": " << result.errorMessage << Qt::endl;
+        } else if (!parser.isSet(quietOption)) {
+            out << "OK   " << result.outputPath << Qt::endl;
+        }
+    }
+
+    out << QString("%1 saves (%2 ok, %3 failed) in %4 ms on %5 threads - %6 saves/sec")
+               .arg(report.total)
+               .arg(report.succeeded)
+               .arg(report.failed)
+               .arg(report.elapsedMs)
+               .arg(report.threadCount)
+               .arg(report.savesPerSecond(), 0, 'f', 1)
+        << Qt::endl;
+
+    return report.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,596 @@
+/**
+ * @file main_bench.cpp
+ * @brief Micro/macro benchmark suite for the injector's hot paths.
+ *
+ * Usage:
+ *   mgi_bench [--rom <rom>] [--tickets <dir>] [--filter <regex>]
+ *             [--min-time <ms>] [--repetitions <n>] [--output <file>]
+ *
+ * Every benchmark is calibrated first (the iteration count doubles until
+ * one batch runs for at least --min-time), then timed --repetitions times;
+ * median, minimum and mean time per operation are reported. Inputs are
+ * reproducible: saves are synthesized from a fixed seed and written to a
+ * temporary folder, tickets come from the bundled Tickets/ corpus.
+ *
+ * Benchmarks that read ROM data (LZ77, Wonder Card backgrounds, the glyph
+ * atlas, the ROM scanner) only run with --rom; without it they are listed
+ * under "skipped" with the reason, so runs on different machines still
+ * produce comparable result sets.
+ *
+ * The report is JSON on stdout (or --output); a human-readable summary goes
+ * to stderr. The exit code is non-zero only if the inputs cannot be set up.
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDateTime>
+#include <QThread>
+#include <QFile>
+#include <QDir>
+#include <algorithm>
+#include <numeric>
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "savefile.h"
+#include "mysterygift.h"
+#include "ticketmanager.h"
+#include "ticketpack.h"
+#include "scriptdisassembler.h"
+#include "gbaromreader.h"
+#include "gen3fontrenderer.h"
+#include "cardrasterizer.h"
+#include "romscanner.h"
+
+#ifndef MGI_BENCH_TICKETS_DIR
+#define MGI_BENCH_TICKETS_DIR ""
+#endif
+
+namespace {
+
+// =============================================================================
+// HARNESS
+// =============================================================================
+
+const quint32 SYNTHETIC_SEED = 0x4D474931;      // "MGI1"; change only with a results note
+const qint64 MAX_BATCH_ITERATIONS = 1 << 24;
+const char FONT_SAMPLE_TEXT[] = "AURORA TICKET - Take this to the Deoxys event!";
+
+/// <summary>
+/// Timing settings shared by every benchmark.
+/// </summary>
+struct BenchConfig {
+    qint64 minTimeNs = 200 * 1000 * 1000;   // Minimum duration of one timed batch
+    int repetitions = 5;                     // Timed batches per benchmark
+    QRegularExpression filter;               // Benchmarks to run (matched against the name)
+};
+
+/// <summary>
+/// Timing of one benchmark, per operation.
+/// </summary>
+struct BenchResult {
+    QString name;
+    qint64 iterations = 0;     // Operations per timed batch
+    int repetitions = 0;
+    double medianNs = 0.0;
+    double minNs = 0.0;
+    double meanNs = 0.0;
+    qint64 bytesPerOp = 0;     // Input bytes per operation (0: no throughput)
+
+    double megabytesPerSecond() const {
+        return (bytesPerOp > 0 && medianNs > 0.0) ? (bytesPerOp * 1000.0) / medianNs : 0.0;
+    }
+};
+
+// Results are folded in here so the compiler cannot drop the work
+volatile quint32 g_sink = 0;
+
+inline void consume(quint32 value)
+{
+    g_sink = g_sink ^ value;
+}
+
+template <typename Fn>
+double timeBatch(Fn &fn, qint64 iterations)
+{
+    QElapsedTimer timer;
+    timer.start();
+    for (qint64 i = 0; i < iterations; ++i) {
+        fn();
+    }
+    return static_cast<double>(timer.nsecsElapsed());
+}
+
+template <typename Fn>
+BenchResult runBenchmark(const QString &name, qint64 bytesPerOp, const BenchConfig &config, Fn fn)
+{
+    BenchResult result;
+    result.name = name;
+    result.bytesPerOp = bytesPerOp;
+
+    // Calibrate (this also warms caches and lazy initialization)
+    qint64 iterations = 1;
+    while (iterations < MAX_BATCH_ITERATIONS && timeBatch(fn, iterations) < config.minTimeNs) {
+        iterations *= 2;
+    }
+
+    QVector<double> samples;
+    samples.reserve(config.repetitions);
+    for (int r = 0; r < config.repetitions; ++r) {
+        samples.append(timeBatch(fn, iterations) / iterations);
+    }
+    std::sort(samples.begin(), samples.end());
+
+    int count = samples.size();
+    result.iterations = iterations;
+    result.repetitions = count;
+    result.minNs = samples.first();
+    result.medianNs = (count % 2) ? samples[count / 2] : (samples[count / 2 - 1] + samples[count / 2]) / 2.0;
+    result.meanNs = std::accumulate(samples.cbegin(), samples.cend(), 0.0) / count;
+    return result;
+}
+
+QString formatDuration(double ns)
+{
+    if (ns >= 1e6) {
+        return QString("%1 ms").arg(ns / 1e6, 0, 'f', 3);
+    }
+    if (ns >= 1e3) {
+        return QString("%1 us").arg(ns / 1e3, 0, 'f', 3);
+    }
+    return QString("%1 ns").arg(ns, 0, 'f', 1);
+}
+
+// =============================================================================
+// SYNTHETIC INPUTS
+// =============================================================================
+
+void writeU16(uint8_t *p, uint16_t value)
+{
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void writeU32(uint8_t *p, uint32_t value)
+{
+    writeU16(p, static_cast<uint16_t>(value));
+    writeU16(p + 2, static_cast<uint16_t>(value >> 16));
+}
+
+// A 128 KB save with valid footers and checksums in both slots. Slot 0 is
+// the newer one; each slot uses a different section rotation, as real saves
+// do. Section contents are seeded noise apart from the game identification.
+QByteArray makeSyntheticSave(GameType game, quint32 seed)
+{
+    QByteArray bytes(static_cast<int>(SaveFile::EXPECTED_FILE_SIZE), '\0');
+    uint8_t *data = reinterpret_cast<uint8_t*>(bytes.data());
+    QRandomGenerator random(seed);
+
+    const size_t slotSize = SaveFile::SECTION_SIZE * SaveFile::SECTIONS_PER_SAVE;
+    const uint32_t saveIndex[2] = {10, 9};
+    const size_t rotation[2] = {0, 5};
+
+    for (size_t slot = 0; slot < 2; ++slot) {
+        for (size_t position = 0; position < SaveFile::SECTIONS_PER_SAVE; ++position) {
+            uint8_t *section = data + slot * slotSize + position * SaveFile::SECTION_SIZE;
+            uint16_t sectionId = static_cast<uint16_t>((position + rotation[slot]) % SaveFile::SECTIONS_PER_SAVE);
+
+            for (size_t i = 0; i < SaveFile::CHECKSUM_DATA_LENGTH_DEFAULT; i += 4) {
+                writeU32(section + i, random.generate());
+            }
+
+            if (sectionId == 0) {
+                // FRLG stores game code 1; Emerald a nonzero security key
+                uint32_t key = random.generate() | 0x00010000;
+                writeU32(section + SaveFile::GAME_CODE_OFFSET, game == GameType::FireRedLeafGreen ? 1 : key);
+                writeU32(section + SaveFile::GAME_CODE_OFFSET + 4, game == GameType::FireRedLeafGreen ? 0 : key);
+            }
+
+            writeU16(section + SaveFile::SECTION_ID_OFFSET, sectionId);
+            writeU32(section + SaveFile::SIGNATURE_OFFSET, 0x08012025);
+            writeU32(section + SaveFile::SAVE_INDEX_OFFSET, saveIndex[slot]);
+            writeU16(section + SaveFile::CHECKSUM_OFFSET,
+                     SaveFile::computeSectionChecksum(section, SaveFile::CHECKSUM_DATA_LENGTH_DEFAULT));
+        }
+    }
+    return bytes;
+}
+
+bool writeFile(const QString &path, const QByteArray &bytes, QString &errorMessage)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(bytes) != bytes.size()) {
+        errorMessage = QString("Failed to write %1: %2").arg(path, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+// First ticket for the game, with its data loaded
+bool findTicket(const TicketManager &ticketManager, GameType game, TicketResource &ticket)
+{
+    for (const TicketResource &source : ticketManager.tickets()) {
+        if (source.gameType() != game) {
+            continue;
+        }
+        ticket = source;
+        QString errorMessage;
+        if (ticket.isDataLoaded() || ticket.loadData(ticketManager.ticketsFolderPath(), errorMessage)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QJsonObject resultToJson(const BenchResult &result)
+{
+    QJsonObject object;
+    object["name"] = result.name;
+    object["iterations"] = result.iterations;
+    object["repetitions"] = result.repetitions;
+    object["median_ns"] = result.medianNs;
+    object["min_ns"] = result.minNs;
+    object["mean_ns"] = result.meanNs;
+    if (result.bytesPerOp > 0) {
+        object["bytes_per_op"] = result.bytesPerOp;
+        object["mb_per_s"] = result.megabytesPerSecond();
+    }
+    return object;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    // Card and font rendering use QImage/QPainter; no window is ever shown
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName("mgi_bench");
+    QCoreApplication::setApplicationVersion("1.0");
+
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Benchmarks checksums, save loading, injection, decompression, rendering and script disassembly.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption romOption("rom", "ROM for the LZ77, background, glyph atlas and scanner benchmarks.", "rom");
+    QCommandLineOption ticketsOption("tickets", "Tickets folder (default: the source tree's Tickets/).", "dir",
+                                     QString(MGI_BENCH_TICKETS_DIR));
+    QCommandLineOption filterOption("filter", "Only run benchmarks whose name matches this regex.", "regex");
+    QCommandLineOption minTimeOption("min-time", "Minimum duration of one timed batch in ms (default: 200).", "ms", "200");
+    QCommandLineOption repetitionsOption("repetitions", "Timed batches per benchmark (default: 5).", "n", "5");
+    QCommandLineOption outputOption({"o", "output"}, "Write the JSON report here instead of stdout.", "file");
+
+    parser.addOptions({romOption, ticketsOption, filterOption, minTimeOption, repetitionsOption, outputOption});
+    parser.process(app);
+
+    BenchConfig config;
+    config.minTimeNs = qMax(1LL, parser.value(minTimeOption).toLongLong()) * 1000 * 1000;
+    config.repetitions = qMax(1, parser.value(repetitionsOption).toInt());
+    config.filter = QRegularExpression(parser.value(filterOption));
+    if (!config.filter.isValid()) {
+        err << "Invalid --filter: " << config.filter.errorString() << Qt::endl;
+        return 2;
+    }
+
+    QVector<BenchResult> results;
+    QJsonArray skipped;
+
+    auto selected = [&](const QString &name) {
+        return config.filter.match(name).hasMatch();
+    };
+    auto skip = [&](const QString &name, const QString &reason) {
+        if (!selected(name)) {
+            return;
+        }
+        skipped.append(QJsonObject{{"name", name}, {"reason", reason}});
+        err << QString("%1  skipped: %2").arg(name, -32).arg(reason) << Qt::endl;
+    };
+    auto bench = [&](const QString &name, qint64 bytesPerOp, auto fn) {
+        if (!selected(name)) {
+            return;
+        }
+        BenchResult result = runBenchmark(name, bytesPerOp, config, fn);
+        QString line = QString("%1  %2  (min %3, %4 iterations)")
+                           .arg(name, -32)
+                           .arg(formatDuration(result.medianNs), 12)
+                           .arg(formatDuration(result.minNs))
+                           .arg(result.iterations);
+        if (result.bytesPerOp > 0) {
+            line += QString("  %1 MB/s").arg(result.megabytesPerSecond(), 0, 'f', 1);
+        }
+        err << line << Qt::endl;
+        results.append(result);
+    };
+
+    // -------------------------------------------------------------------------
+    // Inputs
+    // -------------------------------------------------------------------------
+
+    QString errorMessage;
+    QString ticketsFolder = parser.value(ticketsOption);
+    TicketManager ticketManager;
+    if (!ticketManager.loadFromFolder(ticketsFolder, errorMessage)) {
+        err << "Failed to load tickets from " << ticketsFolder << ": " << errorMessage << Qt::endl;
+        return 2;
+    }
+
+    QTemporaryDir tempDir;
+    if (!tempDir.isValid()) {
+        err << "Failed to create a temporary folder" << Qt::endl;
+        return 2;
+    }
+
+    const GameType games[] = {GameType::FireRedLeafGreen, GameType::Emerald};
+    const char *gameKeys[] = {"frlg", "emerald"};
+    QStringList savePaths;
+    for (int i = 0; i < 2; ++i) {
+        QString path = tempDir.filePath(QString("synthetic_%1.sav").arg(gameKeys[i]));
+        if (!writeFile(path, makeSyntheticSave(games[i], SYNTHETIC_SEED + i), errorMessage)) {
+            err << errorMessage << Qt::endl;
+            return 2;
+        }
+        savePaths.append(path);
+    }
+
+    QByteArray noise(4096, '\0');
+    QRandomGenerator noiseRandom(SYNTHETIC_SEED);
+    for (int i = 0; i < noise.size(); i += 4) {
+        writeU32(reinterpret_cast<uint8_t*>(noise.data()) + i, noiseRandom.generate());
+    }
+    const uint8_t *noiseBytes = reinterpret_cast<const uint8_t*>(noise.constData());
+
+    // -------------------------------------------------------------------------
+    // Checksums
+    // -------------------------------------------------------------------------
+
+    bench("crc16.wondercard", 332, [&]() {
+        consume(MysteryGift::calculateCRC16(noiseBytes, 332));
+    });
+    bench("crc16.ramscript", 1000, [&]() {
+        consume(MysteryGift::calculateCRC16(noiseBytes, 1000));
+    });
+    bench("save.section_checksum", SaveFile::CHECKSUM_DATA_LENGTH_DEFAULT, [&]() {
+        consume(SaveFile::computeSectionChecksum(noiseBytes, SaveFile::CHECKSUM_DATA_LENGTH_DEFAULT));
+    });
+
+    // -------------------------------------------------------------------------
+    // Save loading and injection
+    // -------------------------------------------------------------------------
+
+    for (int i = 0; i < 2; ++i) {
+        const QString &path = savePaths[i];
+        bench(QString("save.load_validate.%1").arg(gameKeys[i]), SaveFile::EXPECTED_FILE_SIZE, [&]() {
+            SaveFile save;
+            QString error;
+            consume(save.loadFromFile(path, error) && save.validateChecksums());
+        });
+
+        QString injectName = QString("save.inject.%1").arg(gameKeys[i]);
+        if (!selected(injectName)) {
+            continue;
+        }
+        TicketResource ticket;
+        SaveFile save;
+        if (!findTicket(ticketManager, games[i], ticket)) {
+            skip(injectName, "No ticket for this game in " + ticketsFolder);
+        } else if (!save.loadFromFile(path, errorMessage)) {
+            skip(injectName, "Synthetic save did not load: " + errorMessage);
+        } else {
+            WonderCardData card = MysteryGift::parseWonderCard(ticket.wonderCardData());
+            InjectionOptions options;
+            bench(injectName, ticket.wonderCardData().size() + ticket.scriptData().size(), [&]() {
+                QString error;
+                consume(save.injectWonderCard(card, ticket.scriptData(), ticketManager.crcTable(),
+                                              error, ticket.wonderCardData(), options));
+            });
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Tickets and scripts
+    // -------------------------------------------------------------------------
+
+    // The source folder normally has no tickets.mgtp; pack its tickets into
+    // a pack-only folder so the mapped path is what gets measured
+    if (selected("tickets.load_folder.pack")) {
+        QString packFolder = tempDir.filePath("pack");
+        TicketPack::Builder builder;
+        for (const TicketResource &source : ticketManager.tickets()) {
+            TicketResource ticket = source;
+            QString ticketError;
+            if (!ticket.isDataLoaded() && !ticket.loadData(ticketManager.ticketsFolderPath(), ticketError)) {
+                continue;
+            }
+            // Tickets the builder rejects are simply left out, as mgi_pack does
+            builder.addTicket(ticket.id(), ticket.name(), ticket.description(), ticket.gameType(),
+                              ticket.wonderCardData(), ticket.scriptData(), ticketError);
+        }
+
+        TicketManager probe;
+        if (builder.count() == 0) {
+            skip("tickets.load_folder.pack", "No tickets to pack in " + ticketsFolder);
+        } else if (!QDir().mkpath(packFolder) ||
+                   !builder.write(QDir(packFolder).filePath(TicketPack::DEFAULT_FILENAME), errorMessage)) {
+            skip("tickets.load_folder.pack", "Failed to build a ticket pack: " + errorMessage);
+        } else if (!probe.loadFromFolder(packFolder, errorMessage) || !probe.isPackLoaded()) {
+            skip("tickets.load_folder.pack", "Built ticket pack did not load: " + errorMessage);
+        } else {
+            bench("tickets.load_folder.pack", 0, [&]() {
+                TicketManager manager;
+                QString error;
+                consume(manager.loadFromFolder(packFolder, error, true));
+            });
+        }
+    }
+    bench("tickets.load_folder.files", 0, [&]() {
+        TicketManager manager;
+        QString error;
+        consume(manager.loadFromFolder(ticketsFolder, error, false));
+    });
+
+    if (selected("script.disassemble")) {
+        ScriptDisassembler disassembler;
+        TicketResource ticket;
+        bool haveTicket = findTicket(ticketManager, GameType::FireRedLeafGreen, ticket)
+                       || findTicket(ticketManager, GameType::Emerald, ticket);
+        if (!disassembler.loadDefaultData(errorMessage)) {
+            skip("script.disassemble", "Disassembler data did not load: " + errorMessage);
+        } else if (!haveTicket) {
+            skip("script.disassemble", "No ticket script in " + ticketsFolder);
+        } else {
+            DecodedScript buffer;
+            QByteArray script = ticket.scriptData();
+            bench("script.disassemble", script.size(), [&]() {
+                consume(static_cast<quint32>(disassembler.disassembleRamScript(script, buffer).size()));
+            });
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // Rendering (placeholder assets; no ROM needed)
+    // -------------------------------------------------------------------------
+
+    if (selected("render.card.fallback") || selected("font.render_line.sheet")) {
+        QSharedPointer<const CardAssets> assets = CardRasterizer::fallbackAssets(errorMessage);
+        TicketResource ticket;
+        bool haveTicket = findTicket(ticketManager, GameType::FireRedLeafGreen, ticket);
+        if (!assets) {
+            skip("render.card.fallback", "Fallback assets did not load: " + errorMessage);
+            skip("font.render_line.sheet", "Fallback assets did not load: " + errorMessage);
+        } else {
+            if (haveTicket) {
+                CardRasterizer rasterizer(assets);
+                WonderCardData card = MysteryGift::parseWonderCard(ticket.wonderCardData());
+                bench("render.card.fallback", 0, [&]() {
+                    consume(static_cast<quint32>(rasterizer.render(card).width()));
+                });
+            } else {
+                skip("render.card.fallback", "No FRLG ticket in " + ticketsFolder);
+            }
+
+            QString text = QString::fromLatin1(FONT_SAMPLE_TEXT);
+            bench("font.render_line.sheet", text.size(), [&]() {
+                consume(static_cast<quint32>(assets->fontRenderer->renderLine(text, assets->fontHeader).width()));
+            });
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // ROM paths
+    // -------------------------------------------------------------------------
+
+    const QStringList romBenchmarks = {"rom.lz77.wondercard_tileset", "rom.render_wondercard",
+                                       "font.render_line.atlas", "rom.scan"};
+    GBAROReader reader;
+    if (!parser.isSet(romOption)) {
+        for (const QString &name : romBenchmarks) {
+            skip(name, "Needs --rom");
+        }
+    } else if (!reader.loadROM(parser.value(romOption), errorMessage)) {
+        for (const QString &name : romBenchmarks) {
+            skip(name, "ROM did not load: " + errorMessage);
+        }
+    } else if (reader.getWonderCardCount() <= 0) {
+        for (const QString &name : romBenchmarks) {
+            skip(name, "ROM has no Wonder Card graphics table");
+        }
+    } else {
+        GBAROReader::WonderCardGraphicsEntry entry = reader.loadWonderCardEntry(0);
+
+        QByteArray tileset;
+        QString error;
+        if (reader.decompressLZ77(entry.tilesetPtr, tileset, error)) {
+            int streamLength = reader.lz77StreamLength(entry.tilesetPtr, error);
+            bench("rom.lz77.wondercard_tileset", qMax(0, streamLength), [&]() {
+                QString lz77Error;
+                consume(reader.decompressLZ77(entry.tilesetPtr, tileset, lz77Error));
+            });
+        } else {
+            skip("rom.lz77.wondercard_tileset", "Tileset did not decompress: " + error);
+        }
+
+        bench("rom.render_wondercard", 0, [&]() {
+            consume(static_cast<quint32>(reader.renderWonderCard(entry).width()));
+        });
+
+        Gen3FontRenderer fonts;
+        if (selected("font.render_line.atlas") && fonts.loadFromROM(&reader, error) && fonts.hasAtlas()) {
+            QString text = QString::fromLatin1(FONT_SAMPLE_TEXT);
+            QImage line(CardRasterizer::CARD_WIDTH, Gen3FontRenderer::RENDER_HEIGHT, QImage::Format_ARGB32);
+            line.fill(Qt::transparent);
+            QRgb *dest = reinterpret_cast<QRgb*>(line.bits());
+            int stride = line.bytesPerLine() / static_cast<int>(sizeof(QRgb));
+            bench("font.render_line.atlas", text.size(), [&]() {
+                consume(static_cast<quint32>(fonts.renderLine(text, Gen3FontRenderer::TitleHeader,
+                                                              dest, stride, line.width())));
+            });
+        } else {
+            skip("font.render_line.atlas", "ROM font did not load: " + error);
+        }
+
+        bench("rom.scan", reader.romSize(), [&]() {
+            consume(static_cast<quint32>(RomScanner::scan(reader).hits.size()));
+        });
+    }
+
+    // -------------------------------------------------------------------------
+    // Report
+    // -------------------------------------------------------------------------
+
+    QJsonArray resultArray;
+    for (const BenchResult &result : results) {
+        resultArray.append(resultToJson(result));
+    }
+
+    QJsonObject report;
+    report["tool"] = "mgi_bench";
+    report["version"] = QCoreApplication::applicationVersion();
+    report["qt_version"] = QString::fromLatin1(qVersion());
+    report["threads"] = QThread::idealThreadCount();
+    report["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    report["config"] = QJsonObject{
+        {"min_time_ms", static_cast<double>(config.minTimeNs / (1000 * 1000))},
+        {"repetitions", config.repetitions},
+        {"seed", static_cast<double>(SYNTHETIC_SEED)},
+        {"filter", config.filter.pattern()},
+        {"tickets", ticketsFolder},
+        {"rom", parser.value(romOption)},
+        {"rom_md5", reader.md5()}
+    };
+    report["results"] = resultArray;
+    report["skipped"] = skipped;
+
+    QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+    if (parser.isSet(outputOption)) {
+        if (!writeFile(parser.value(outputOption), json, errorMessage)) {
+            err << errorMessage << Qt::endl;
+            return 2;
+        }
+    } else {
+        QTextStream(stdout) << json;
+    }
+
+    err << QString("%1 benchmarks, %2 skipped").arg(results.size()).arg(skipped.size()) << Qt::endl;
+    return 0;
+}
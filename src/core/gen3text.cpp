@@ -0,0 +1,285 @@
+/**
+ * @file gen3text.cpp
+ * @brief Implementation of the Gen3 text codec and its lookup tables.
+ *
+ * @see gen3text.h for the charsets
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "gen3text.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QPair>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Complete Gen 3 character encoding table (International/English)
+// Maps Gen 3 byte values (0x00-0xFF) to Unicode characters
+// Source: Data Crystal TBL file & https://github.com/zeon256/gen3-charset
+// CORRECTED MAPPINGS - digits at 0xA1-0xAA, uppercase at 0xBB-0xD4, lowercase at 0xD5-0xEE
+const QChar GEN3_TO_UNICODE[256] = {
+    // 0x00-0x0F: Space and accented letters
+    QChar(' '),    QChar(0x00C0), QChar(0x00C1), QChar(0x00C2), QChar(0x00C7), QChar(0x00C8), QChar(0x00C9), QChar(0x00CA),
+    QChar(0x00CB), QChar(0x00CC), QChar(' '),    QChar(0x00CE), QChar(0x00CF), QChar(0x00D2), QChar(0x00D3), QChar(0x00D4),
+    // 0x10-0x1F: More accented letters
+    QChar(0x0152), QChar(0x00D9), QChar(0x00DA), QChar(0x00DB), QChar(0x00D1), QChar(0x00DF), QChar(0x00E0), QChar(0x00E1),
+    QChar(0x0000), QChar(0x00E7), QChar(0x00E8), QChar(0x00E9), QChar(0x00EA), QChar(0x00EB), QChar(0x00EC), QChar(0x0000),
+    // 0x20-0x2F: More accented, special symbols
+    QChar(0x00EE), QChar(0x00EF), QChar(0x00F2), QChar(0x00F3), QChar(0x00F4), QChar(0x0153), QChar(0x00F9), QChar(0x00FA),
+    QChar(0x00FB), QChar(0x00F1), QChar(0x00BA), QChar(0x00AA), QChar(0x1D49), QChar(0x0026), QChar(0x002B), QChar(0x0000),
+    // 0x30-0x3F: Spaces, Lv, =, ;
+    QChar(0x0000), QChar('L'),     QChar('v'),     QChar(0x003D), QChar(0x003B), QChar(0x0000), QChar(0x0000), QChar(0x0000),
+    QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000),
+    // 0x40-0x4F: Symbols, PK, MN
+    QChar(0x0000), QChar(0x00BF), QChar(0x00A1), QChar('P'),     QChar('K'),     QChar('M'),     QChar('N'),     QChar(0x0000),
+    QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x00CD), QChar(0x0025), QChar(0x0028), QChar(0x0029), QChar(0x0000),
+    // 0x50-0x5F: Spaces, arrows, â, í
+    QChar(0x0000), QChar(0x00E2), QChar(0x0000), QChar(0x00ED), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000),
+    QChar(0x0000), QChar(0x0000), QChar(0x2191), QChar(0x2193), QChar(0x2190), QChar(0x2192), QChar(0x0000), QChar(0x0000),
+    // 0x60-0x6F: Asterisks, superscripts
+    QChar(0x002A), QChar(0x002A), QChar(0x002A), QChar(0x002A), QChar(0x1D49), QChar(0x003C), QChar(0x003E), QChar(0x0000),
+    QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000),
+    // 0x70-0x7F: Spaces, arrows, asterisks
+    QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000),
+    QChar(0x0000), QChar(0x2191), QChar(0x2193), QChar(0x2190), QChar(0x2192), QChar('*'),     QChar('*'),     QChar('*'),
+    // 0x80-0x8F: Asterisks, superscript, spaces
+    QChar('*'),     QChar('*'),     QChar('*'),     QChar('*'),     QChar(0x1D49), QChar('<'),     QChar('>'),     QChar(0x0000),
+    QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000),
+    // 0x90-0x9F: Spaces
+    QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000),
+    QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000),
+    // 0xA0-0xAF: CORRECTED - null, digits 0-9, punctuation
+    QChar(0x0000), QChar('0'),     QChar('1'),     QChar('2'),     QChar('3'),     QChar('4'),     QChar('5'),     QChar('6'),
+    QChar('7'),     QChar('8'),     QChar('9'),     QChar('!'),     QChar('?'),     QChar('.'),     QChar('-'),     QChar(0x30FB),
+    // 0xB0-0xBF: CORRECTED - Ellipsis, quotes, gender, punctuation, /, A-E
+    QChar(0x2025), QChar(0x201C), QChar(0x201D), QChar(0x2018), QChar(0x2019), QChar(0x2642), QChar(0x2640), QChar(' '),
+    QChar(','),     QChar(0x00D7), QChar('/'),     QChar('A'),     QChar('B'),     QChar('C'),     QChar('D'),     QChar('E'),
+    // 0xC0-0xCF: CORRECTED - Uppercase F-U
+    QChar('F'),     QChar('G'),     QChar('H'),     QChar('I'),     QChar('J'),     QChar('K'),     QChar('L'),     QChar('M'),
+    QChar('N'),     QChar('O'),     QChar('P'),     QChar('Q'),     QChar('R'),     QChar('S'),     QChar('T'),     QChar('U'),
+    // 0xD0-0xDF: CORRECTED - Uppercase V-Z, lowercase a-j
+    QChar('V'),     QChar('W'),     QChar('X'),     QChar('Y'),     QChar('Z'),     QChar('a'),     QChar('b'),     QChar('c'),
+    QChar('d'),     QChar('e'),     QChar('f'),     QChar('g'),     QChar('h'),     QChar('i'),     QChar('j'),     QChar('k'),
+    // 0xE0-0xEF: CORRECTED - Lowercase l-z, ▶
+    QChar('l'),     QChar('m'),     QChar('n'),     QChar('o'),     QChar('p'),     QChar('q'),     QChar('r'),     QChar('s'),
+    QChar('t'),     QChar('u'),     QChar('v'),     QChar('w'),     QChar('x'),     QChar('y'),     QChar('z'),     QChar(0x25BA),
+    // 0xF0-0xFF: CORRECTED - Colon, umlauts, control characters
+    QChar(':'),     QChar(0x00C4), QChar(0x00D6), QChar(0x00DC), QChar(0x00E4), QChar(0x00F6), QChar(0x00FC), QChar(0x0000),
+    QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000), QChar(0x0000)
+};
+
+// Typographic script charset (differs from the card table in punctuation
+// and symbols); bytes not listed are skipped
+const struct { uint8_t byte; ushort unicode; } SCRIPT_CHARSET[] = {
+    {0x00, ' '},
+    // Accented uppercase
+    {0x01, 0x00C0}, {0x02, 0x00C1}, {0x03, 0x00C2}, {0x04, 0x00C7}, {0x05, 0x00C8}, {0x06, 0x00C9},
+    {0x07, 0x00CA}, {0x08, 0x00CB}, {0x09, 0x00CC}, {0x0B, 0x00CE}, {0x0C, 0x00CF}, {0x0D, 0x00D2},
+    {0x0E, 0x00D3}, {0x0F, 0x00D4}, {0x10, 0x0152}, {0x11, 0x00D9}, {0x12, 0x00DA}, {0x13, 0x00DB},
+    {0x14, 0x00D1}, {0x15, 0x00DF},
+    // Accented lowercase
+    {0x16, 0x00E0}, {0x17, 0x00E1}, {0x19, 0x00E7}, {0x1A, 0x00E8}, {0x1B, 0x00E9}, {0x1C, 0x00EA},
+    {0x1D, 0x00EB}, {0x1E, 0x00EC}, {0x20, 0x00EE}, {0x21, 0x00EF}, {0x22, 0x00F2}, {0x23, 0x00F3},
+    {0x24, 0x00F4}, {0x25, 0x0153}, {0x26, 0x00F9}, {0x27, 0x00FA}, {0x28, 0x00FB}, {0x29, 0x00F1},
+    // Special characters
+    {0x2A, 0x00BA}, {0x2B, 0x00AA}, {0x2D, '&'}, {0x2E, '+'}, {0x35, '='}, {0x36, ';'},
+    {0x51, 0x00BF}, {0x52, 0x00A1}, {0x5A, 0x00CD}, {0x5B, '%'}, {0x5C, '('}, {0x5D, ')'},
+    {0x68, 0x00E2}, {0x6F, 0x00ED},
+    // Punctuation
+    {0xAB, '!'}, {0xAC, '?'}, {0xAD, '.'}, {0xAE, '-'},
+    {0xB0, 0x2026}, {0xB1, 0x201C}, {0xB2, 0x201D}, {0xB3, 0x2018}, {0xB4, 0x2019},
+    {0xB5, 0x2642}, {0xB6, 0x2640}, {0xB7, '$'}, {0xB8, ','}, {0xB9, 0x00D7}, {0xBA, '/'},
+    // Other
+    {0xEF, 0x25B6}, {0xF0, ':'},
+    {0xF1, 0x00C4}, {0xF2, 0x00D6}, {0xF3, 0x00DC}, {0xF4, 0x00E4}, {0xF5, 0x00F6}, {0xF6, 0x00FC},
+};
+
+struct CodecTables {
+    QChar decode[Gen3Text::CharsetCount][256];
+    int16_t encodeLatin1[256];                  // -1 = unmapped
+    QVector<QPair<ushort, uint8_t>> encodeWide; // Sorted by code unit
+
+    CodecTables()
+    {
+        // Digits and letters sit at the same bytes in every charset
+        QChar common[256];
+        for (int i = 0; i < 10; ++i) {
+            common[0xA1 + i] = QChar('0' + i);
+        }
+        for (int i = 0; i < 26; ++i) {
+            common[0xBB + i] = QChar('A' + i);
+            common[0xD5 + i] = QChar('a' + i);
+        }
+
+        // Card text: full table, with padding and control codes as spaces
+        std::copy(std::begin(GEN3_TO_UNICODE), std::end(GEN3_TO_UNICODE), decode[Gen3Text::CardText]);
+        for (uint8_t byte : {0x00, 0xA0, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE}) {
+            decode[Gen3Text::CardText][byte] = QChar(' ');
+        }
+
+        // ROM names: ASCII subset
+        std::copy(std::begin(common), std::end(common), decode[Gen3Text::RomNames]);
+        const struct { uint8_t byte; char ch; } nameExtras[] = {
+            {0x00, ' '}, {0xAB, '!'}, {0xAC, '?'}, {0xAD, '.'}, {0xAE, '-'},
+            {0xB4, '\''}, {0xB8, ','}, {0xBA, '/'}, {0xF0, ':'},
+        };
+        for (const auto &extra : nameExtras) {
+            decode[Gen3Text::RomNames][extra.byte] = QChar(extra.ch);
+        }
+
+        // Script text
+        std::copy(std::begin(common), std::end(common), decode[Gen3Text::ScriptText]);
+        for (const auto &entry : SCRIPT_CHARSET) {
+            decode[Gen3Text::ScriptText][entry.byte] = QChar(entry.unicode);
+        }
+
+        // Encoding follows the card table; the first byte holding a character
+        // wins, except that the alphabet, digits and common punctuation take
+        // precedence over duplicates (P, K, M, N also appear at 0x43-0x46)
+        std::fill(std::begin(encodeLatin1), std::end(encodeLatin1), int16_t(-1));
+        auto assign = [this](ushort unicode, uint8_t byte) {
+            if (unicode < 256) {
+                encodeLatin1[unicode] = byte;
+                return;
+            }
+            auto it = std::lower_bound(encodeWide.begin(), encodeWide.end(), qMakePair(unicode, uint8_t(0)),
+                                       [](const QPair<ushort, uint8_t> &a, const QPair<ushort, uint8_t> &b) {
+                                           return a.first < b.first;
+                                       });
+            if (it != encodeWide.end() && it->first == unicode) {
+                it->second = byte;
+            } else {
+                encodeWide.insert(it, qMakePair(unicode, byte));
+            }
+        };
+        for (int i = 255; i >= 0; --i) {
+            ushort unicode = GEN3_TO_UNICODE[i].unicode();
+            if (unicode != 0) {
+                assign(unicode, static_cast<uint8_t>(i));
+            }
+        }
+        for (int i = 0; i < 256; ++i) {
+            if (!common[i].isNull()) {
+                assign(common[i].unicode(), static_cast<uint8_t>(i));
+            }
+        }
+        const struct { char ch; uint8_t byte; } punctuation[] = {
+            {'!', 0xAB}, {'?', 0xAC}, {'.', 0xAD}, {'-', 0xAE}, {',', 0xB8}, {'/', 0xBA}, {':', 0xF0}, {' ', 0x00},
+        };
+        for (const auto &entry : punctuation) {
+            assign(static_cast<ushort>(entry.ch), entry.byte);
+        }
+    }
+};
+
+const CodecTables &codecTables()
+{
+    static const CodecTables tables;
+    return tables;
+}
+
+} // namespace
+
+// =============================================================================
+// DECODING
+// =============================================================================
+
+const QChar *Gen3Text::decodeTable(Charset charset)
+{
+    return codecTables().decode[charset];
+}
+
+int Gen3Text::terminatedLength(const uint8_t *data, int maxLength)
+{
+    if (maxLength <= 0) {
+        return 0;
+    }
+    const void *terminator = std::memchr(data, TERMINATOR, static_cast<size_t>(maxLength));
+    return terminator ? static_cast<int>(static_cast<const uint8_t*>(terminator) - data) : maxLength;
+}
+
+QString Gen3Text::decode(const uint8_t *data, int maxLength, Charset charset)
+{
+    int length = terminatedLength(data, maxLength);
+    const QChar *table = decodeTable(charset);
+
+    // One allocation at the upper bound; skipped bytes only shorten it
+    QString result(length, Qt::Uninitialized);
+    QChar *out = result.data();
+    int written = 0;
+    for (int i = 0; i < length; ++i) {
+        QChar ch = table[data[i]];
+        if (!ch.isNull()) {
+            out[written++] = ch;
+        }
+    }
+    result.truncate(written);
+    return result;
+}
+
+QString Gen3Text::decode(const QByteArray &data, Charset charset)
+{
+    return decode(reinterpret_cast<const uint8_t*>(data.constData()), data.size(), charset);
+}
+
+QVector<QString> Gen3Text::decodeRecords(const uint8_t *data, qint64 dataSize, int count,
+                                         int stride, int length, Charset charset)
+{
+    QVector<QString> result(qMax(0, count));
+    for (int i = 0; i < count; ++i) {
+        qint64 offset = static_cast<qint64>(i) * stride;
+        if (offset + length > dataSize) {
+            break;
+        }
+        result[i] = decode(data + offset, length, charset);
+    }
+    return result;
+}
+
+// =============================================================================
+// ENCODING
+// =============================================================================
+
+static int encodeIndex(QChar ch)
+{
+    const CodecTables &tables = codecTables();
+    ushort unicode = ch.unicode();
+    if (unicode < 256) {
+        return tables.encodeLatin1[unicode];
+    }
+
+    auto it = std::lower_bound(tables.encodeWide.cbegin(), tables.encodeWide.cend(), unicode,
+                               [](const QPair<ushort, uint8_t> &entry, ushort key) { return entry.first < key; });
+    return (it != tables.encodeWide.cend() && it->first == unicode) ? it->second : -1;
+}
+
+bool Gen3Text::canEncode(QChar ch)
+{
+    return encodeIndex(ch) >= 0;
+}
+
+uint8_t Gen3Text::encodeChar(QChar ch)
+{
+    int byte = encodeIndex(ch);
+    return byte >= 0 ? static_cast<uint8_t>(byte) : 0x00;
+}
+
+void Gen3Text::encode(uint8_t *dest, const QString &text, int maxLength)
+{
+    // Gen3 Wonder Cards use 0x00 padding after text, NOT 0xFF terminators
+    std::memset(dest, 0x00, maxLength);
+
+    int count = qMin(text.length(), maxLength);
+    for (int i = 0; i < count; ++i) {
+        dest[i] = encodeChar(text.at(i));
+    }
+}
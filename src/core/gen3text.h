@@ -0,0 +1,87 @@
+/**
+ * @file gen3text.h
+ * @brief Table-driven codec for the Gen3 proprietary text encoding.
+ *
+ * Every Gen3 text consumer (Wonder Card fields, ROM name tables, script
+ * strings) decodes through the same flat 256-entry QChar tables, and encodes
+ * through one direct-indexed table. The tables are built once, on first use,
+ * and never change afterwards, so the codec is safe to call from any thread.
+ *
+ * ## Charsets
+ * The bytes are the same everywhere, but callers render them differently:
+ * - CardText:  Wonder Card fields. Spaces, padding (0xA0) and control codes
+ *              (0xFA-0xFE) all display as a single space.
+ * - RomNames:  Item, Pokemon and move names. ASCII only (0xB4 is a plain
+ *              apostrophe) so names match the identifiers in the YAML data.
+ * - ScriptText: Script strings, with typographic quotes and symbols. Control
+ *              codes are left to the script decoder (null entries).
+ * A null table entry means "no character": the byte is skipped.
+ *
+ * ## Decoding
+ * The 0xFF terminator is located with memchr (vectorized by the C library),
+ * then each QString is allocated once at its final capacity and filled
+ * straight from the table.
+ *
+ * @see MysteryGift::decodeText, GBAROReader::decodeNameTable,
+ *      ScriptDisassembler::decodeGen3String
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef GEN3TEXT_H
+#define GEN3TEXT_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <cstdint>
+
+/**
+ * @class Gen3Text
+ * @brief Static Gen3 <-> Unicode conversion over shared lookup tables.
+ *
+ * USAGE:
+ *   QString title = Gen3Text::decode(bytes, 40);
+ *   Gen3Text::encode(dest, title, 40);
+ *   QVector<QString> names = Gen3Text::decodeRecords(rom, count, 44, 14, Gen3Text::RomNames);
+ */
+class Gen3Text
+{
+public:
+    enum Charset {
+        CardText = 0,
+        RomNames,
+        ScriptText,
+        CharsetCount
+    };
+
+    static const uint8_t TERMINATOR = 0xFF;
+
+    // 256-entry decode table for a charset (null QChar = skipped byte)
+    static const QChar *decodeTable(Charset charset);
+
+    // Length up to (not including) the 0xFF terminator, at most maxLength
+    static int terminatedLength(const uint8_t *data, int maxLength);
+
+    // Decode up to the terminator or maxLength bytes
+    static QString decode(const uint8_t *data, int maxLength, Charset charset = CardText);
+    static QString decode(const QByteArray &data, Charset charset = CardText);
+
+    // Bulk decode of count fixed-size records (e.g. a ROM name table).
+    // Records that would run past dataSize decode as empty strings.
+    static QVector<QString> decodeRecords(const uint8_t *data, qint64 dataSize, int count,
+                                          int stride, int length, Charset charset);
+
+    // Encoding (0x00 = space, also used for unmappable characters)
+    static bool canEncode(QChar ch);
+    static uint8_t encodeChar(QChar ch);
+
+    // Encode into a maxLength buffer padded with 0x00 (no 0xFF terminator)
+    static void encode(uint8_t *dest, const QString &text, int maxLength);
+};
+
+#endif // GEN3TEXT_H
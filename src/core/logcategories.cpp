@@ -0,0 +1,24 @@
+/**
+ * @file logcategories.cpp
+ * @brief Definitions of the debug output categories.
+ *
+ * @see logcategories.h for enabling them
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "logcategories.h"
+
+// Info and above by default: debug output needs an explicit logging rule
+Q_LOGGING_CATEGORY(lcRom, "mgi.rom", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcRomData, "mgi.romdata", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcSave, "mgi.save", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcTickets, "mgi.tickets", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcScript, "mgi.script", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcRender, "mgi.render", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcUi, "mgi.ui", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcService, "mgi.service", QtInfoMsg)
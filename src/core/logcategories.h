@@ -0,0 +1,39 @@
+/**
+ * @file logcategories.h
+ * @brief Debug output categories, off unless enabled by logging rules.
+ *
+ * Diagnostics go through qCDebug(lcRom) and friends instead of qDebug(). A
+ * disabled category costs a single flag check: the streamed arguments are
+ * never evaluated. Debug output of every category is off by default; turn
+ * it on per area with Qt logging rules, for example:
+ *
+ *   QT_LOGGING_RULES="mgi.rom.debug=true;mgi.render.debug=true"
+ *   QT_LOGGING_RULES="mgi.*.debug=true"
+ *
+ * Release builds define QT_NO_DEBUG_OUTPUT, which compiles the calls out
+ * entirely. Warnings stay on qWarning().
+ *
+ * @see tracing.h for timing the same areas
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef LOGCATEGORIES_H
+#define LOGCATEGORIES_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(lcRom)        // mgi.rom: ROM loading, graphics extraction, caches
+Q_DECLARE_LOGGING_CATEGORY(lcRomData)    // mgi.romdata: gen3_rom_data tables
+Q_DECLARE_LOGGING_CATEGORY(lcSave)       // mgi.save: save parsing and writing
+Q_DECLARE_LOGGING_CATEGORY(lcTickets)    // mgi.tickets: ticket folder and packs
+Q_DECLARE_LOGGING_CATEGORY(lcScript)     // mgi.script: script data and disassembly
+Q_DECLARE_LOGGING_CATEGORY(lcRender)     // mgi.render: fonts and card rendering
+Q_DECLARE_LOGGING_CATEGORY(lcUi)         // mgi.ui: main window and widgets
+Q_DECLARE_LOGGING_CATEGORY(lcService)    // mgi.service: resident service
+
+#endif // LOGCATEGORIES_H
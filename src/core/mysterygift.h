@@ -30,7 +30,8 @@
  * Both Wonder Cards and Scripts use CCITT CRC-16:
  * - Polynomial: 0x1021
  * - Initial seed: 0x1121
- * - Uses 256-entry lookup table (loaded from tab.bin)
+ * - Slicing-by-8 lookup tables generated at compile time; tab.bin is only
+ *   loaded to cross-check them (validateCRCTable)
  *
  * ## Gen3 Text Encoding
  *
@@ -117,6 +118,72 @@ struct WonderCardData {
     bool isEmpty() const { return eventId == 0 && icon == 0; }
 };
 
+/// <summary>
+/// Non-owning view over a contiguous byte range (e.g. a block inside a loaded
+/// save buffer). Valid only while the underlying buffer is alive and unchanged.
+/// </summary>
+struct ByteView {
+    const uint8_t *data = nullptr;
+    size_t size = 0;
+
+    ByteView() = default;
+    ByteView(const uint8_t *bytes, size_t length) : data(bytes), size(length) {}
+    explicit ByteView(const QByteArray &bytes)
+        : data(reinterpret_cast<const uint8_t*>(bytes.constData()))
+        , size(static_cast<size_t>(bytes.size())) {}
+
+    bool isEmpty() const { return size == 0; }
+    ByteView mid(size_t offset, size_t length) const {
+        return offset + length <= size ? ByteView(data + offset, length) : ByteView();
+    }
+    QByteArray toByteArray() const {
+        return QByteArray(reinterpret_cast<const char*>(data), static_cast<int>(size));
+    }
+};
+
+/// <summary>
+/// Lazily-decoded Wonder Card over a 332-byte payload (or 336 bytes with the
+/// CRC header). Numeric fields are read straight from the bytes; text fields
+/// are only decoded into QStrings when asked for. Same lifetime rules as ByteView.
+/// </summary>
+class WonderCardView
+{
+public:
+    WonderCardView() = default;
+    explicit WonderCardView(ByteView bytes);
+
+    bool isValid() const { return m_payload != nullptr; }
+    ByteView payload() const;
+
+    // Numeric fields (no allocation)
+    uint16_t eventId() const { return readU16(WonderCardOffsets::EVENT_ID); }
+    uint16_t icon() const { return readU16(WonderCardOffsets::ICON); }
+    uint32_t count() const {
+        return readU16(WonderCardOffsets::COUNT) | (static_cast<uint32_t>(readU16(WonderCardOffsets::COUNT + 2)) << 16);
+    }
+    uint8_t typeColorResend() const { return m_payload ? m_payload[WonderCardOffsets::TYPE_COLOR_RESEND] : 0; }
+    uint8_t stampMax() const { return m_payload ? m_payload[WonderCardOffsets::STAMP_MAX] : 0; }
+    WonderCardType type() const { return static_cast<WonderCardType>(typeColorResend() & 0x03); }
+    uint8_t color() const { return (typeColorResend() >> 2) & 0x07; }
+    bool canResend() const { return (typeColorResend() & 0x40) != 0; }
+    bool isEmpty() const { return eventId() == 0 && icon() == 0; }
+
+    // Text fields (decoded on demand)
+    QString text(int fieldOffset) const;
+    QString title() const { return text(WonderCardOffsets::TITLE); }
+    QString subtitle() const { return text(WonderCardOffsets::SUBTITLE); }
+
+    // Fully decoded copy
+    WonderCardData toData() const;
+
+private:
+    uint16_t readU16(int offset) const {
+        return m_payload ? static_cast<uint16_t>(m_payload[offset] | (m_payload[offset + 1] << 8)) : 0;
+    }
+
+    const uint8_t *m_payload = nullptr;   // Start of the 332-byte payload
+};
+
 /// <summary>
 /// Mystery Gift utilities for parsing and encoding Wonder Card data.
 /// </summary>
@@ -140,9 +207,15 @@ public:
     // Encode Wonder Card to 332-byte payload
     static QByteArray encodeWonderCard(const WonderCardData &data);
 
-    // Calculate CRC16 checksum
+    // Calculate CRC16 checksum (crcTable is only size-checked; see validateCRCTable)
     static uint16_t calculateCRC16(const QByteArray &data, const QByteArray &crcTable);
 
+    // Calculate CRC16 checksum over a raw byte span
+    static uint16_t calculateCRC16(const uint8_t *data, size_t length);
+
+    // Check that a loaded tab.bin matches the built-in CRC16 table
+    static bool validateCRCTable(const QByteArray &crcTable);
+
     // Decode text from Pokemon Gen 3 encoding to QString
     static QString decodeText(const uint8_t *data, int maxLength);
 
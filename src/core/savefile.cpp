@@ -1,12 +1,87 @@
 #include "savefile.h"
+#include "logcategories.h"
+#include "tracing.h"
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
+#include <QSaveFile>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+// SIMD kernels for the 32-bit section word sum (little-endian targets only)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SAVEFILE_CHECKSUM_SSE2
+#elif defined(__ARM_NEON) && !defined(__ARM_BIG_ENDIAN)
+#include <arm_neon.h>
+#define SAVEFILE_CHECKSUM_NEON
+#endif
+
+#if defined(Q_OS_WIN)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+const char JOURNAL_MAGIC[4] = {'M', 'G', 'S', 'J'};
+const char DELTA_MAGIC[4] = {'M', 'G', 'S', 'D'};
+const uint32_t PATCH_FILE_VERSION = 2;
+const char JOURNAL_SUFFIX[] = ".journal";
+
+// Flush an open file's data to stable storage
+bool syncToDisk(QFile &file)
+{
+    if (!file.flush()) {
+        return false;
+    }
+#if defined(Q_OS_WIN)
+    return _commit(file.handle()) == 0;
+#else
+    return ::fsync(file.handle()) == 0;
+#endif
+}
+
+void appendU32(QByteArray &out, uint32_t value)
+{
+    char bytes[4] = {static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+                     static_cast<char>((value >> 16) & 0xFF), static_cast<char>((value >> 24) & 0xFF)};
+    out.append(bytes, 4);
+}
+
+uint32_t readU32(const char *data)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*>(data);
+    return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+}
+
+// =============================================================================
+// LAYOUT BINDING
+// =============================================================================
+
+template <typename Layout>
+const SaveFile::LayoutOps& SaveFile::layoutOps()
+{
+    static const LayoutOps ops = {
+        SaveLayoutInfo::of<Layout>(),
+        &SaveFile::writeWonderCard<Layout>,
+        &SaveFile::setMysteryGiftFlag<Layout>
+    };
+    return ops;
+}
 
 SaveFile::SaveFile()
     : m_detectedGame(GameType::Unknown)
+    , m_layout(&layoutOps<UnknownSaveLayout>())
     , m_checksumValid(false)
     , m_activeSaveSlot(-1)
+    , m_scanned(false)
+    , m_dirtySections(0)
+    , m_loadedFileSize(0)
 {
 }
 
@@ -16,12 +91,24 @@ SaveFile::~SaveFile()
 
 bool SaveFile::loadFromFile(const QString &path, QString &errorMessage)
 {
-    // Clear previous data
-    m_bytes.clear();
+    MGI_TRACE_SCOPE("SaveFile::loadFromFile");
+    // Clear previous data. The byte buffer is truncated rather than released so
+    // that a SaveFile reused across many loads (batch mode) keeps its 128 KB
+    // allocation instead of reallocating it for every file.
+    m_bytes.resize(0);
     m_filePath.clear();
     m_detectedGame = GameType::Unknown;
+    m_layout = &layoutOps<UnknownSaveLayout>();
     m_checksumValid = false;
     m_activeSaveSlot = -1;
+    m_scanned = false;
+    m_dirtySections = 0;
+
+    // Loading never writes: a pending journal is only recovered by write
+    // paths (recoverJournal), and saveToFile refuses the file until then
+    if (hasPendingJournal(path)) {
+        qWarning() << "SaveFile: interrupted section patch pending for" << path;
+    }
 
     // Check if file exists
     QFileInfo fileInfo(path);
@@ -30,6 +117,14 @@ bool SaveFile::loadFromFile(const QString &path, QString &errorMessage)
         return false;
     }
 
+    // Validate file size before reading anything
+    if (fileInfo.size() != EXPECTED_FILE_SIZE) {
+        errorMessage = QString("Invalid file size: %1 bytes (expected %2 bytes)")
+                          .arg(fileInfo.size())
+                          .arg(EXPECTED_FILE_SIZE);
+        return false;
+    }
+
     // Open file
     QFile file(path);
     if (!file.open(QIODevice::ReadOnly)) {
@@ -37,24 +132,32 @@ bool SaveFile::loadFromFile(const QString &path, QString &errorMessage)
         return false;
     }
 
-    // Read all bytes
-    m_bytes = file.readAll();
+    // Read directly into the (possibly already allocated) buffer
+    m_bytes.resize(EXPECTED_FILE_SIZE);
+    qint64 bytesRead = file.read(m_bytes.data(), EXPECTED_FILE_SIZE);
     file.close();
 
-    // Validate file size
-    if (m_bytes.size() != EXPECTED_FILE_SIZE) {
-        errorMessage = QString("Invalid file size: %1 bytes (expected %2 bytes)")
-                          .arg(m_bytes.size())
+    if (bytesRead != EXPECTED_FILE_SIZE) {
+        errorMessage = QString("Failed to read file: %1 of %2 bytes read")
+                          .arg(bytesRead)
                           .arg(EXPECTED_FILE_SIZE);
-        m_bytes.clear();
+        m_bytes.resize(0);
         return false;
     }
 
-    // Store file path
+    // Store file path and on-disk state
     m_filePath = path;
+    m_loadedFileSize = fileInfo.size();
+    m_loadedModified = QFileInfo(path).lastModified();
 
-    // Detect game type
+    // One sweep: section checksums, section map and active slot
+    scanSave();
+
+    // Detect game type and bind its layout (the only per-game dispatch)
     m_detectedGame = detectGameType();
+    m_layout = dispatchSaveLayout(m_detectedGame, [](auto layout) {
+        return &layoutOps<decltype(layout)>();
+    });
 
     // Validate checksums
     m_checksumValid = validateChecksums();
@@ -62,13 +165,36 @@ bool SaveFile::loadFromFile(const QString &path, QString &errorMessage)
     return true;
 }
 
-bool SaveFile::saveToFile(const QString &path, bool makeBackup, QString &errorMessage)
+bool SaveFile::saveToFile(const QString &path, bool makeBackup, QString &errorMessage,
+                          SaveWriteMode mode)
 {
+    MGI_TRACE_SCOPE("SaveFile::saveToFile");
     if (!isLoaded()) {
         errorMessage = "No save file loaded";
         return false;
     }
 
+    // Any write would leave the journal describing a file that no longer exists
+    if (hasPendingJournal(path)) {
+        errorMessage = "An interrupted save is pending recovery: " + path + JOURNAL_SUFFIX;
+        return false;
+    }
+
+    bool saved = (mode == SaveWriteMode::PatchSections)
+        ? writePatched(path, makeBackup, errorMessage)
+        : writeFull(path, makeBackup, errorMessage);
+
+    if (saved) {
+        m_dirtySections = 0;
+        m_loadedFileSize = m_bytes.size();
+        m_loadedModified = QFileInfo(path).lastModified();
+    }
+
+    return saved;
+}
+
+bool SaveFile::writeFull(const QString &path, bool makeBackup, QString &errorMessage)
+{
     // Create backup if requested
     if (makeBackup) {
         QFileInfo fileInfo(path);
@@ -119,22 +245,386 @@ bool SaveFile::saveToFile(const QString &path, bool makeBackup, QString &errorMe
         return false;
     }
 
+    // A full rewrite is not chained into the delta, which now undoes a file
+    // that no longer exists and would block every later backup
+    discardDeltaBackup(path);
+
     m_filePath = path;
     return true;
 }
 
+QString SaveFile::deltaBackupPath(const QString &savePath)
+{
+    QFileInfo fileInfo(savePath);
+    return fileInfo.absolutePath() + "/" + fileInfo.baseName() + ".bakd";
+}
+
+bool SaveFile::writePatched(const QString &path, bool makeBackup, QString &errorMessage)
+{
+    // Patching is only sound when the target is the untouched file we loaded
+    QFileInfo target(path);
+    bool sameFile = target.exists() && QFileInfo(m_filePath).canonicalFilePath() == target.canonicalFilePath();
+    if (!sameFile || target.size() != m_loadedFileSize || target.lastModified() != m_loadedModified) {
+        qCDebug(lcSave) << "SaveFile: target differs from loaded file, writing full save:" << path;
+        return writeFull(path, makeBackup, errorMessage);
+    }
+
+    if (m_dirtySections == 0) {
+        return true;  // Nothing changed since load
+    }
+
+    // Previous on-disk contents of the sections about to change: their hashes
+    // let recovery check the journal against the file, the images form the delta
+    QFile original(path);
+    if (!original.open(QIODevice::ReadOnly)) {
+        errorMessage = "Failed to read original file: " + original.errorString();
+        return false;
+    }
+    QByteArray onDisk = original.readAll();
+    original.close();
+    if (onDisk.size() != EXPECTED_FILE_SIZE) {
+        errorMessage = "Failed to read original file";
+        return false;
+    }
+
+    QVector<SectionPatch> patches;
+    QVector<SectionPatch> previous;
+    for (uint32_t section = 0; section < SECTIONS_PER_SAVE * 2; ++section) {
+        if (m_dirtySections & (1u << section)) {
+            uint32_t offset = section * SECTION_SIZE;
+            QByteArray oldData = onDisk.mid(offset, SECTION_SIZE);
+            QByteArray newData = m_bytes.mid(offset, SECTION_SIZE);
+            patches.append({offset, sectionMd5(oldData), newData});
+            previous.append({offset, sectionMd5(newData), oldData});
+        }
+    }
+
+    QByteArray newMd5 = QCryptographicHash::hash(m_bytes, QCryptographicHash::Md5);
+
+    // Delta backup: previous on-disk contents of the sections about to change
+    if (makeBackup) {
+        if (!chainDeltaBackup(deltaBackupPath(path), onDisk, previous, errorMessage)) {
+            return false;
+        }
+        if (!writePatchFile(deltaBackupPath(path), DELTA_MAGIC, previous, newMd5, errorMessage)) {
+            errorMessage = "Failed to create backup file: " + errorMessage;
+            return false;
+        }
+    }
+
+    // Journal first, then patch in place; a crash in between is rolled
+    // forward by recoverJournal() before the next write
+    QString journalPath = path + JOURNAL_SUFFIX;
+    if (!writePatchFile(journalPath, JOURNAL_MAGIC, patches, newMd5, errorMessage)) {
+        return false;
+    }
+
+    if (!applyPatches(path, patches, errorMessage)) {
+        return false;  // Journal kept for recovery
+    }
+
+    QFile::remove(journalPath);
+    if (!makeBackup) {
+        discardDeltaBackup(path);  // Not chained, so it no longer matches the file
+    }
+    qCDebug(lcSave) << "SaveFile: patched" << patches.size() << "sections in" << path;
+    return true;
+}
+
+void SaveFile::discardDeltaBackup(const QString &savePath)
+{
+    QString deltaPath = deltaBackupPath(savePath);
+    if (QFile::exists(deltaPath)) {
+        qCDebug(lcSave) << "SaveFile: discarding delta backup made stale by an unchained write:" << deltaPath;
+        QFile::remove(deltaPath);
+    }
+}
+
+bool SaveFile::chainDeltaBackup(const QString &deltaPath, const QByteArray &onDisk,
+                                QVector<SectionPatch> &previous, QString &errorMessage)
+{
+    if (!QFile::exists(deltaPath)) {
+        return true;
+    }
+
+    // An existing delta is only extended if it undoes the file as it is now;
+    // anything else (a stale or foreign delta) is not silently clobbered
+    QVector<SectionPatch> older;
+    QByteArray olderTarget;
+    QString readError;
+    if (!readPatchFile(deltaPath, DELTA_MAGIC, older, olderTarget, readError) ||
+        olderTarget != QCryptographicHash::hash(onDisk, QCryptographicHash::Md5)) {
+        errorMessage = "Existing delta backup does not match the current save, not overwriting it: " + deltaPath;
+        return false;
+    }
+
+    // Chain: the older image of a section wins, so the merged delta restores
+    // the save as it was before the first patch of the chain
+    for (const SectionPatch &entry : older) {
+        auto same = std::find_if(previous.begin(), previous.end(), [&entry](const SectionPatch &patch) {
+            return patch.offset == entry.offset;
+        });
+        if (same != previous.end()) {
+            same->data = entry.data;
+        } else {
+            previous.append({entry.offset, sectionMd5(onDisk.mid(entry.offset, SECTION_SIZE)), entry.data});
+        }
+    }
+    std::sort(previous.begin(), previous.end(), [](const SectionPatch &a, const SectionPatch &b) {
+        return a.offset < b.offset;
+    });
+    return true;
+}
+
+bool SaveFile::writePatchFile(const QString &path, const char *magic, const QVector<SectionPatch> &patches,
+                              const QByteArray &targetMd5, QString &errorMessage)
+{
+    // Layout: magic[4], version, file size, entry count, target MD5[16],
+    // then per entry: offset + MD5[16] of the section it replaces + 4 KB image
+    QByteArray content;
+    content.reserve(32 + patches.size() * (20 + static_cast<int>(SECTION_SIZE)));
+    content.append(magic, 4);
+    appendU32(content, PATCH_FILE_VERSION);
+    appendU32(content, static_cast<uint32_t>(EXPECTED_FILE_SIZE));
+    appendU32(content, static_cast<uint32_t>(patches.size()));
+    content.append(targetMd5);
+    for (const SectionPatch &patch : patches) {
+        appendU32(content, patch.offset);
+        content.append(patch.expectedMd5);
+        content.append(patch.data);
+    }
+
+    // QSaveFile writes a temp file, syncs it and renames it over the target
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        errorMessage = "Failed to create " + path + ": " + file.errorString();
+        return false;
+    }
+    if (file.write(content) != content.size() || !file.commit()) {
+        errorMessage = "Failed to write " + path + ": " + file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+bool SaveFile::readPatchFile(const QString &path, const char *magic, QVector<SectionPatch> &patches,
+                             QByteArray &targetMd5, QString &errorMessage)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorMessage = "Failed to open " + path + ": " + file.errorString();
+        return false;
+    }
+
+    QByteArray content = file.readAll();
+    const int headerSize = 32;
+    const int entrySize = 20 + static_cast<int>(SECTION_SIZE);
+    if (content.size() < headerSize || memcmp(content.constData(), magic, 4) != 0 ||
+        readU32(content.constData() + 4) != PATCH_FILE_VERSION ||
+        readU32(content.constData() + 8) != static_cast<uint32_t>(EXPECTED_FILE_SIZE)) {
+        errorMessage = "Not a valid section patch file: " + path;
+        return false;
+    }
+
+    uint32_t count = readU32(content.constData() + 12);
+    if (count > SECTIONS_PER_SAVE * 2 || content.size() != headerSize + static_cast<int>(count) * entrySize) {
+        errorMessage = "Section patch file is truncated: " + path;
+        return false;
+    }
+
+    targetMd5 = content.mid(16, 16);
+    patches.clear();
+    for (uint32_t i = 0; i < count; ++i) {
+        const char *entry = content.constData() + headerSize + i * entrySize;
+        uint32_t offset = readU32(entry);
+        if (offset % SECTION_SIZE != 0 || offset + SECTION_SIZE > static_cast<uint32_t>(EXPECTED_FILE_SIZE)) {
+            errorMessage = "Section patch file has an invalid offset: " + path;
+            return false;
+        }
+        patches.append({offset, QByteArray(entry + 4, 16), QByteArray(entry + 20, SECTION_SIZE)});
+    }
+
+    return true;
+}
+
+bool SaveFile::applyPatches(const QString &path, const QVector<SectionPatch> &patches, QString &errorMessage)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadWrite)) {
+        errorMessage = "Failed to open file for patching: " + file.errorString();
+        return false;
+    }
+
+    if (file.size() != EXPECTED_FILE_SIZE) {
+        errorMessage = QString("Cannot patch file of size %1 bytes").arg(file.size());
+        return false;
+    }
+
+    for (const SectionPatch &patch : patches) {
+        if (!file.seek(patch.offset) || file.write(patch.data) != patch.data.size()) {
+            errorMessage = "Failed to patch section: " + file.errorString();
+            return false;
+        }
+    }
+
+    if (!syncToDisk(file)) {
+        errorMessage = "Failed to flush patched file to disk";
+        return false;
+    }
+
+    return true;
+}
+
+QByteArray SaveFile::sectionMd5(const QByteArray &section)
+{
+    return QCryptographicHash::hash(section, QCryptographicHash::Md5);
+}
+
+bool SaveFile::hasPendingJournal(const QString &savePath)
+{
+    return QFile::exists(savePath + JOURNAL_SUFFIX);
+}
+
+bool SaveFile::recoverJournal(const QString &path, QString &errorMessage)
+{
+    QString journalPath = path + JOURNAL_SUFFIX;
+    if (!QFile::exists(journalPath)) {
+        return true;  // Nothing to recover
+    }
+
+    QVector<SectionPatch> patches;
+    QByteArray targetMd5;
+    QString journalError;
+    if (!readPatchFile(journalPath, JOURNAL_MAGIC, patches, targetMd5, journalError)) {
+        errorMessage = "Cannot recover interrupted save, journal unreadable: " + journalError;
+        return false;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorMessage = "Failed to open save file: " + file.errorString();
+        return false;
+    }
+    QByteArray current = file.readAll();
+    file.close();
+
+    if (current.size() != EXPECTED_FILE_SIZE) {
+        errorMessage = "Cannot recover interrupted save: file size changed since the journal was written";
+        return false;
+    }
+
+    // Patch completed but the journal was not removed yet
+    if (QCryptographicHash::hash(current, QCryptographicHash::Md5) == targetMd5) {
+        QFile::remove(journalPath);
+        return true;
+    }
+
+    // Every journaled section must still hold its pre-image or already its
+    // new image, and the result must be exactly the file the journal was
+    // written for; this also covers the sections the journal does not touch
+    QByteArray patched = current;
+    for (const SectionPatch &patch : patches) {
+        QByteArray onDisk = current.mid(patch.offset, SECTION_SIZE);
+        if (onDisk != patch.data && sectionMd5(onDisk) != patch.expectedMd5) {
+            errorMessage = "Cannot recover interrupted save: the file was modified after the journal was written";
+            return false;
+        }
+        patched.replace(patch.offset, SECTION_SIZE, patch.data);
+    }
+    if (QCryptographicHash::hash(patched, QCryptographicHash::Md5) != targetMd5) {
+        errorMessage = "Cannot recover interrupted save: the journal does not match this file";
+        return false;
+    }
+
+    qWarning() << "SaveFile: completing interrupted section patch for" << path;
+    if (!applyPatches(path, patches, errorMessage)) {
+        errorMessage = "Failed to recover interrupted save: " + errorMessage;
+        return false;
+    }
+
+    QFile::remove(journalPath);
+    return true;
+}
+
+bool SaveFile::restoreFromDeltaBackup(const QString &savePath, const QString &deltaPath,
+                                      QString &errorMessage)
+{
+    if (hasPendingJournal(savePath)) {
+        errorMessage = "An interrupted save is pending recovery: " + savePath + JOURNAL_SUFFIX;
+        return false;
+    }
+
+    QVector<SectionPatch> patches;
+    QByteArray targetMd5;
+    if (!readPatchFile(deltaPath, DELTA_MAGIC, patches, targetMd5, errorMessage)) {
+        return false;
+    }
+
+    // The delta only applies to the exact file it was taken against
+    QFile file(savePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorMessage = "Failed to open save file: " + file.errorString();
+        return false;
+    }
+    QByteArray currentMd5 = QCryptographicHash::hash(file.readAll(), QCryptographicHash::Md5);
+    file.close();
+
+    if (currentMd5 != targetMd5) {
+        errorMessage = "Save file has changed since this backup was made";
+        return false;
+    }
+
+    if (!applyPatches(savePath, patches, errorMessage)) {
+        return false;
+    }
+
+    // Used up: it no longer matches the save, and would block the next backup
+    QFile::remove(deltaPath);
+    return true;
+}
+
+
 uint16_t SaveFile::computeSectionChecksum(const uint8_t* data, size_t length)
 {
-    // Algorithm from Project 1
+    // Algorithm from Project 1: sum of little-endian 32-bit words
     size_t words = length / 4;
+    size_t i = 0;
     uint32_t sum = 0;
 
-    for (size_t i = 0; i < words; ++i) {
+#if defined(SAVEFILE_CHECKSUM_SSE2)
+    // Two accumulators of four lanes each; 32-bit lane wrap-around matches
+    // the scalar modulo-2^32 sum
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    for (; i + 8 <= words; i += 8) {
+        acc0 = _mm_add_epi32(acc0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 4)));
+        acc1 = _mm_add_epi32(acc1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 4 + 16)));
+    }
+    acc0 = _mm_add_epi32(acc0, acc1);
+    uint32_t lanes[4];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc0);
+    sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#elif defined(SAVEFILE_CHECKSUM_NEON)
+    uint32x4_t acc0 = vdupq_n_u32(0);
+    uint32x4_t acc1 = vdupq_n_u32(0);
+    for (; i + 8 <= words; i += 8) {
+        acc0 = vaddq_u32(acc0, vreinterpretq_u32_u8(vld1q_u8(data + i * 4)));
+        acc1 = vaddq_u32(acc1, vreinterpretq_u32_u8(vld1q_u8(data + i * 4 + 16)));
+    }
+    acc0 = vaddq_u32(acc0, acc1);
+    uint32_t lanes[4];
+    vst1q_u32(lanes, acc0);
+    sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+
+    // Scalar tail (and whole buffer without SIMD)
+    for (; i < words; ++i) {
         // Little-endian 32-bit word
         uint32_t word = data[i*4] |
                        (data[i*4+1] << 8) |
                        (data[i*4+2] << 16) |
-                       (data[i*4+3] << 24);
+                       (static_cast<uint32_t>(data[i*4+3]) << 24);
         sum += word;
     }
 
@@ -143,65 +633,119 @@ uint16_t SaveFile::computeSectionChecksum(const uint8_t* data, size_t length)
     return static_cast<uint16_t>(sum & 0xFFFF);
 }
 
-SaveBlockInfo SaveFile::analyzeSaveSlot(size_t slotIndex)
+void SaveFile::scanSection(size_t slotIndex, size_t position)
 {
-    SaveBlockInfo info;
-    info.blockIndex = slotIndex;
-    info.valid = true;
-    info.saveIndex = 0;
-    info.gameCode = 0;
-    info.hasSecurityKey = false;
-
-    const uint8_t* saveData = reinterpret_cast<const uint8_t*>(m_bytes.constData());
-    size_t baseOffset = slotIndex * (SECTION_SIZE * SECTIONS_PER_SAVE);
+    SlotScan &scan = m_slotScan[slotIndex];
+    const uint8_t* sectionData = reinterpret_cast<const uint8_t*>(m_bytes.constData()) +
+                                 slotIndex * (SECTION_SIZE * SECTIONS_PER_SAVE) +
+                                 position * SECTION_SIZE;
+
+    // Compute checksum (use default length for validation before game type is known)
+    // Note: Per-section lengths vary, but most use 0xF80 so this is reasonable for validation
+    uint16_t computed = computeSectionChecksum(sectionData, CHECKSUM_DATA_LENGTH_DEFAULT);
+
+    // Read stored checksum (little-endian)
+    uint16_t stored = sectionData[CHECKSUM_OFFSET] |
+                     (sectionData[CHECKSUM_OFFSET + 1] << 8);
+
+    scan.sectionValid[position] = (computed == stored);
+
+    // Read section ID; the first physical position holding an ID wins
+    uint16_t sectionId = sectionData[SECTION_ID_OFFSET] |
+                        (sectionData[SECTION_ID_OFFSET + 1] << 8);
+    if (sectionId < SECTIONS_PER_SAVE && scan.sectionPosition[sectionId] < 0) {
+        scan.sectionPosition[sectionId] = static_cast<int>(position);
+    }
 
-    // Validate all 14 sections
-    for (size_t section = 0; section < SECTIONS_PER_SAVE; ++section) {
-        size_t sectionOffset = baseOffset + (section * SECTION_SIZE);
-        const uint8_t* sectionData = saveData + sectionOffset;
+    // Read save index from the first section (should be same for all)
+    if (position == 0) {
+        scan.info.saveIndex = sectionData[SAVE_INDEX_OFFSET] |
+                             (sectionData[SAVE_INDEX_OFFSET + 1] << 8) |
+                             (sectionData[SAVE_INDEX_OFFSET + 2] << 16) |
+                             (static_cast<uint32_t>(sectionData[SAVE_INDEX_OFFSET + 3]) << 24);
+    }
 
-        // Compute checksum (use default length for validation before game type is known)
-        // Note: Per-section lengths vary, but most use 0xF80 so this is reasonable for validation
-        uint16_t computed = computeSectionChecksum(sectionData, CHECKSUM_DATA_LENGTH_DEFAULT);
+    // Section 0 contains game code
+    if (sectionId == 0) {
+        scan.info.gameCode = sectionData[GAME_CODE_OFFSET] |
+                            (sectionData[GAME_CODE_OFFSET + 1] << 8) |
+                            (sectionData[GAME_CODE_OFFSET + 2] << 16) |
+                            (static_cast<uint32_t>(sectionData[GAME_CODE_OFFSET + 3]) << 24);
+
+        // Check security key (offset 0xAC + 4, non-zero for Emerald)
+        uint32_t securityKey = sectionData[GAME_CODE_OFFSET + 4] |
+                              (sectionData[GAME_CODE_OFFSET + 5] << 8) |
+                              (sectionData[GAME_CODE_OFFSET + 6] << 16) |
+                              (static_cast<uint32_t>(sectionData[GAME_CODE_OFFSET + 7]) << 24);
+        scan.info.hasSecurityKey = (securityKey != 0);
+    }
+}
 
-        // Read stored checksum (little-endian)
-        uint16_t stored = sectionData[CHECKSUM_OFFSET] |
-                         (sectionData[CHECKSUM_OFFSET + 1] << 8);
+void SaveFile::scanSave()
+{
+    m_scanned = false;
+    if (!isLoaded()) {
+        return;
+    }
 
-        if (computed != stored) {
-            info.valid = false;
+    for (size_t slot = 0; slot < 2; ++slot) {
+        SlotScan &scan = m_slotScan[slot];
+        scan.info.blockIndex = slot;
+        scan.info.valid = true;
+        scan.info.saveIndex = 0;
+        scan.info.gameCode = 0;
+        scan.info.hasSecurityKey = false;
+        std::fill(std::begin(scan.sectionPosition), std::end(scan.sectionPosition), -1);
+
+        for (size_t position = 0; position < SECTIONS_PER_SAVE; ++position) {
+            scanSection(slot, position);
+            scan.info.valid = scan.info.valid && scan.sectionValid[position];
         }
+    }
 
-        // Read section ID
-        uint16_t sectionId = sectionData[SECTION_ID_OFFSET] |
-                            (sectionData[SECTION_ID_OFFSET + 1] << 8);
-
-        // Read save index from each section (should be same for all)
-        uint32_t saveIdx = sectionData[SAVE_INDEX_OFFSET] |
-                          (sectionData[SAVE_INDEX_OFFSET + 1] << 8) |
-                          (sectionData[SAVE_INDEX_OFFSET + 2] << 16) |
-                          (sectionData[SAVE_INDEX_OFFSET + 3] << 24);
-        if (section == 0) {
-            info.saveIndex = saveIdx;
-        }
+    // Prefer valid save over invalid; if both valid or both invalid, use
+    // higher save index
+    const SaveBlockInfo &slot0 = m_slotScan[0].info;
+    const SaveBlockInfo &slot1 = m_slotScan[1].info;
+    if (slot0.valid != slot1.valid) {
+        m_activeSaveSlot = slot0.valid ? 0 : 1;
+    } else {
+        m_activeSaveSlot = (slot0.saveIndex > slot1.saveIndex) ? 0 : 1;
+    }
 
-        // Section 0 contains game code
-        if (sectionId == 0) {
-            info.gameCode = sectionData[GAME_CODE_OFFSET] |
-                           (sectionData[GAME_CODE_OFFSET + 1] << 8) |
-                           (sectionData[GAME_CODE_OFFSET + 2] << 16) |
-                           (sectionData[GAME_CODE_OFFSET + 3] << 24);
-
-            // Check security key (offset 0xAC + 4, non-zero for Emerald)
-            uint32_t securityKey = sectionData[GAME_CODE_OFFSET + 4] |
-                                  (sectionData[GAME_CODE_OFFSET + 5] << 8) |
-                                  (sectionData[GAME_CODE_OFFSET + 6] << 16) |
-                                  (sectionData[GAME_CODE_OFFSET + 7] << 24);
-            info.hasSecurityKey = (securityKey != 0);
-        }
+    m_scanned = true;
+}
+
+void SaveFile::updateSectionChecksum(size_t position, size_t checksumLength)
+{
+    uint8_t* sectionData = reinterpret_cast<uint8_t*>(m_bytes.data()) +
+                           m_activeSaveSlot * (SECTION_SIZE * SECTIONS_PER_SAVE) +
+                           position * SECTION_SIZE;
+
+    uint16_t checksum = computeSectionChecksum(sectionData, checksumLength);
+
+    // Write checksum (little-endian - Gen3 uses little-endian throughout)
+    sectionData[CHECKSUM_OFFSET] = checksum & 0xFF;
+    sectionData[CHECKSUM_OFFSET + 1] = (checksum >> 8) & 0xFF;
+
+    m_dirtySections |= 1u << (m_activeSaveSlot * SECTIONS_PER_SAVE + position);
+
+    // Only the modified section needs rescanning; the ID map is unchanged
+    if (m_scanned) {
+        SlotScan &scan = m_slotScan[m_activeSaveSlot];
+        scanSection(m_activeSaveSlot, position);
+        scan.info.valid = std::all_of(std::begin(scan.sectionValid), std::end(scan.sectionValid),
+                                      [](bool valid) { return valid; });
+    }
+}
+
+SaveBlockInfo SaveFile::analyzeSaveSlot(size_t slotIndex)
+{
+    if (!m_scanned) {
+        scanSave();
     }
 
-    return info;
+    return m_slotScan[slotIndex].info;
 }
 
 int SaveFile::findActiveSaveSlot()
@@ -210,15 +754,11 @@ int SaveFile::findActiveSaveSlot()
         return -1;
     }
 
-    SaveBlockInfo slot0 = analyzeSaveSlot(0);
-    SaveBlockInfo slot1 = analyzeSaveSlot(1);
-
-    // Prefer valid save over invalid
-    if (slot0.valid && !slot1.valid) return 0;
-    if (!slot0.valid && slot1.valid) return 1;
+    if (!m_scanned) {
+        scanSave();
+    }
 
-    // If both valid or both invalid, use higher save index
-    return (slot0.saveIndex > slot1.saveIndex) ? 0 : 1;
+    return m_activeSaveSlot;
 }
 
 GameType SaveFile::detectGameType()
@@ -287,25 +827,14 @@ int SaveFile::findWonderCardBlock() const
         return -1;
     }
 
-    const uint8_t* saveData = reinterpret_cast<const uint8_t*>(m_bytes.constData());
-    size_t slotOffset = m_activeSaveSlot * (SECTION_SIZE * SECTIONS_PER_SAVE);
-
-    // Search through all 14 sections for Wonder Card block (marker 0x04)
-    for (size_t section = 0; section < SECTIONS_PER_SAVE; ++section) {
-        size_t sectionOffset = slotOffset + (section * SECTION_SIZE);
-        uint8_t sectionId = saveData[sectionOffset + SECTION_ID_OFFSET];
-
-        if (sectionId == WONDERCARD_BLOCK_MARKER) {
-            return static_cast<int>(section);
-        }
-    }
-
-    return -1;  // Wonder Card block not found
+    // Wonder Card block is the section with ID 0x04 (resolved by the scan)
+    return findSection(WONDERCARD_BLOCK_MARKER);
 }
 
 bool SaveFile::hasWonderCard() const
 {
-    if (!isLoaded()) {
+    // Ruby/Sapphire (and unknown layouts) have no Wonder Card area to read
+    if (!isLoaded() || !m_layout->info.hasWonderCard) {
         return false;
     }
 
@@ -315,8 +844,7 @@ bool SaveFile::hasWonderCard() const
     }
 
     // Get game-specific offset
-    size_t wonderCardOffset = (m_detectedGame == GameType::Emerald) ?
-                              WONDERCARD_OFFSET_EMERALD : WONDERCARD_OFFSET_FRLG;
+    size_t wonderCardOffset = m_layout->info.wonderCardOffset;
 
     // Calculate absolute offset in file
     size_t slotOffset = m_activeSaveSlot * (SECTION_SIZE * SECTIONS_PER_SAVE);
@@ -358,8 +886,7 @@ WonderCardData SaveFile::extractWonderCard(QString &errorMessage) const
     }
 
     // Get game-specific offset
-    size_t wonderCardOffset = (m_detectedGame == GameType::Emerald) ?
-                              WONDERCARD_OFFSET_EMERALD : WONDERCARD_OFFSET_FRLG;
+    size_t wonderCardOffset = m_layout->info.wonderCardOffset;
 
     // Calculate absolute offset
     size_t slotOffset = m_activeSaveSlot * (SECTION_SIZE * SECTIONS_PER_SAVE);
@@ -404,8 +931,7 @@ QByteArray SaveFile::extractWonderCardRaw(QString &errorMessage) const
     }
 
     // Get game-specific offset
-    size_t wonderCardOffset = (m_detectedGame == GameType::Emerald) ?
-                              WONDERCARD_OFFSET_EMERALD : WONDERCARD_OFFSET_FRLG;
+    size_t wonderCardOffset = m_layout->info.wonderCardOffset;
 
     // Calculate absolute offset
     size_t slotOffset = m_activeSaveSlot * (SECTION_SIZE * SECTIONS_PER_SAVE);
@@ -447,8 +973,7 @@ QByteArray SaveFile::extractScript(QString &errorMessage) const
     }
 
     // Get game-specific offset for script
-    size_t scriptOffset = (m_detectedGame == GameType::Emerald) ?
-                          GMSCRIPT_OFFSET_EMERALD : GMSCRIPT_OFFSET_FRLG;
+    size_t scriptOffset = m_layout->info.gmScriptOffset;
 
     // Calculate absolute offset
     size_t slotOffset = m_activeSaveSlot * (SECTION_SIZE * SECTIONS_PER_SAVE);
@@ -463,11 +988,52 @@ QByteArray SaveFile::extractScript(QString &errorMessage) const
     return script;
 }
 
+const uint8_t* SaveFile::wonderCardBlockData() const
+{
+    if (!isLoaded() || !m_layout->info.hasWonderCard) {
+        return nullptr;
+    }
+
+    int wonderCardBlock = findWonderCardBlock();
+    if (wonderCardBlock < 0) {
+        return nullptr;
+    }
+
+    size_t slotOffset = m_activeSaveSlot * (SECTION_SIZE * SECTIONS_PER_SAVE);
+    return reinterpret_cast<const uint8_t*>(m_bytes.constData()) + slotOffset + wonderCardBlock * SECTION_SIZE;
+}
+
+ByteView SaveFile::wonderCardRawView() const
+{
+    const uint8_t* blockData = wonderCardBlockData();
+    if (!blockData) {
+        return ByteView();
+    }
+
+    return ByteView(blockData + m_layout->info.wonderCardOffset, MysteryGift::WONDERCARD_TOTAL_SIZE);
+}
+
+ByteView SaveFile::scriptView() const
+{
+    const uint8_t* blockData = wonderCardBlockData();
+    if (!blockData) {
+        return ByteView();
+    }
+
+    return ByteView(blockData + m_layout->info.gmScriptOffset + 4, RAMSCRIPT_SIZE);  // Skip CRC16 + padding header
+}
+
+WonderCardView SaveFile::wonderCardView() const
+{
+    return WonderCardView(wonderCardRawView());
+}
+
 bool SaveFile::injectWonderCard(const WonderCardData &wonderCard, const QByteArray &scriptData,
                                 const QByteArray &crcTable, QString &errorMessage,
                                 const QByteArray &rawWonderCardData,
                                 const InjectionOptions &options)
 {
+    MGI_TRACE_SCOPE("SaveFile::injectWonderCard");
     if (!isLoaded()) {
         errorMessage = "No save file loaded";
         return false;
@@ -478,7 +1044,7 @@ bool SaveFile::injectWonderCard(const WonderCardData &wonderCard, const QByteArr
         return false;
     }
 
-    if (m_detectedGame == GameType::RubySapphire) {
+    if (!m_layout->info.hasWonderCard) {
         errorMessage = "Ruby/Sapphire do not support Wonder Cards";
         return false;
     }
@@ -490,36 +1056,6 @@ bool SaveFile::injectWonderCard(const WonderCardData &wonderCard, const QByteArr
         return false;
     }
 
-    // Get game-specific offsets
-    size_t wonderCardOffset = (m_detectedGame == GameType::Emerald) ?
-                              WONDERCARD_OFFSET_EMERALD : WONDERCARD_OFFSET_FRLG;
-    size_t scriptOffset = (m_detectedGame == GameType::Emerald) ?
-                          GMSCRIPT_OFFSET_EMERALD : GMSCRIPT_OFFSET_FRLG;
-    size_t metadataOffset = (m_detectedGame == GameType::Emerald) ?
-                            WCMETADATA_OFFSET_EMERALD : WCMETADATA_OFFSET_FRLG;
-    size_t trainerIdsOffset = (m_detectedGame == GameType::Emerald) ?
-                              TRAINERIDS_OFFSET_EMERALD : TRAINERIDS_OFFSET_FRLG;
-
-    // Calculate absolute offsets
-    size_t slotOffset = m_activeSaveSlot * (SECTION_SIZE * SECTIONS_PER_SAVE);
-    size_t blockOffset = slotOffset + (wonderCardBlock * SECTION_SIZE);
-
-    uint8_t* saveData = reinterpret_cast<uint8_t*>(m_bytes.data());
-    uint8_t* blockData = saveData + blockOffset;
-
-    // Clear WonderCardMetadata first (mirrors game's ClearSavedWonderCardAndRelated behavior)
-    // This zeros battlesWon, battlesLost, numTrades, iconSpecies, stampData
-    if (options.clearMetadata) {
-        memset(blockData + metadataOffset, 0x00, WCMETADATA_SIZE);
-        // Also clear the metadata CRC (4 bytes before metadata)
-        memset(blockData + metadataOffset - 4, 0x00, 4);
-    }
-
-    // Clear TrainerIds if requested (40 bytes = 10 trainer IDs)
-    if (options.clearTrainerIds) {
-        memset(blockData + trainerIdsOffset, 0x00, TRAINERIDS_SIZE);
-    }
-
     // Get Wonder Card payload - prefer raw data to avoid encoding artifacts
     QByteArray wonderCardPayload;
     if (!rawWonderCardData.isEmpty()) {
@@ -537,26 +1073,7 @@ bool SaveFile::injectWonderCard(const WonderCardData &wonderCard, const QByteArr
         wonderCardPayload = MysteryGift::encodeWonderCard(wonderCard);
     }
 
-    // Calculate Wonder Card CRC16
-    uint16_t wonderCardCRC = MysteryGift::calculateCRC16(wonderCardPayload, crcTable);
-
-    // Write Wonder Card: CRC16 + padding + payload
-    // Note: Do NOT write FF FF terminator after payload - the game interprets
-    // non-zero bytes at offset +336 as "no card present" indicator
-    size_t wcOffset = wonderCardOffset;
-    blockData[wcOffset] = wonderCardCRC & 0xFF;
-    blockData[wcOffset + 1] = (wonderCardCRC >> 8) & 0xFF;
-    blockData[wcOffset + 2] = 0x00;  // Padding
-    blockData[wcOffset + 3] = 0x00;  // Padding
-    memcpy(blockData + wcOffset + 4, wonderCardPayload.constData(), 332);
-
-    // Write GMScript if provided
     // Script can be 1000 bytes (payload only) or 1004 bytes (with CRC header)
-    // Following decomp's InitRamScript() logic:
-    //   1. Zero the RamScript area
-    //   2. Set magic = RAM_SCRIPT_MAGIC (51)
-    //   3. Set mapGroup, mapNum, objectId
-    //   4. Copy script bytecode
     QByteArray scriptPayload;
     if (scriptData.size() == 1004) {
         // Strip 4-byte CRC header to get 1000-byte payload
@@ -565,48 +1082,92 @@ bool SaveFile::injectWonderCard(const WonderCardData &wonderCard, const QByteArr
         scriptPayload = scriptData;
     }
 
-    if (scriptPayload.size() == 1000) {
-        // Make a mutable copy to ensure magic number is set (following decomp logic)
-        QByteArray scriptToWrite = scriptPayload;
+    (this->*m_layout->writeWonderCard)(wonderCardBlock, wonderCardPayload, scriptPayload, crcTable, options);
+    return true;
+}
 
-        // Verify/set magic number at offset 0 (decomp: gSaveBlock1Ptr->gmScript.magic = RAM_SCRIPT_MAGIC)
-        // This ensures the script will be recognized as valid by ValidateRamScript()
-        if (static_cast<uint8_t>(scriptToWrite[RAMSCRIPT_MAGIC_OFFSET]) != RAM_SCRIPT_MAGIC) {
-            // Script doesn't have magic number - set it (shouldn't happen with valid presets)
-            scriptToWrite[RAMSCRIPT_MAGIC_OFFSET] = static_cast<char>(RAM_SCRIPT_MAGIC);
+template <typename Layout>
+void SaveFile::writeWonderCard(int wonderCardBlock, const QByteArray &wonderCardPayload,
+                               const QByteArray &scriptPayload, const QByteArray &crcTable,
+                               const InjectionOptions &options)
+{
+    if constexpr (!Layout::HAS_WONDER_CARD) {
+        return;
+    } else {
+        // Calculate absolute offsets
+        size_t slotOffset = m_activeSaveSlot * (SECTION_SIZE * SECTIONS_PER_SAVE);
+        size_t blockOffset = slotOffset + (wonderCardBlock * SECTION_SIZE);
+
+        uint8_t* saveData = reinterpret_cast<uint8_t*>(m_bytes.data());
+        uint8_t* blockData = saveData + blockOffset;
+
+        // Clear WonderCardMetadata first (mirrors game's ClearSavedWonderCardAndRelated behavior)
+        // This zeros battlesWon, battlesLost, numTrades, iconSpecies, stampData
+        if (options.clearMetadata) {
+            memset(blockData + Layout::WCMETADATA_OFFSET, 0x00, WCMETADATA_SIZE);
+            // Also clear the metadata CRC (4 bytes before metadata)
+            memset(blockData + Layout::WCMETADATA_OFFSET - 4, 0x00, 4);
         }
 
-        // Calculate CRC16 on the (potentially modified) script payload
-        uint16_t scriptCRC = MysteryGift::calculateCRC16(scriptToWrite, crcTable);
-
-        // Write script with CRC header (4 bytes) + payload (1000 bytes)
-        blockData[scriptOffset] = scriptCRC & 0xFF;
-        blockData[scriptOffset + 1] = (scriptCRC >> 8) & 0xFF;
-        blockData[scriptOffset + 2] = 0x00;  // Padding
-        blockData[scriptOffset + 3] = 0x00;  // Padding
-        memcpy(blockData + scriptOffset + 4, scriptToWrite.constData(), RAMSCRIPT_SIZE);
-    }
-
-    // Update WonderCardMetadata.iconSpecies (the game uses this for icon display)
-    // The icon value is at payload offset 2-3 (little-endian u16)
-    // Note: We write this AFTER clearing metadata so the icon is preserved
-    uint16_t iconSpecies = static_cast<uint8_t>(wonderCardPayload[2]) |
-                          (static_cast<uint8_t>(wonderCardPayload[3]) << 8);
-    size_t iconOffset = metadataOffset + WCMETADATA_ICON_OFFSET;
-    blockData[iconOffset] = iconSpecies & 0xFF;
-    blockData[iconOffset + 1] = (iconSpecies >> 8) & 0xFF;
+        // Clear TrainerIds if requested (40 bytes = 10 trainer IDs)
+        if (options.clearTrainerIds) {
+            memset(blockData + Layout::TRAINERIDS_OFFSET, 0x00, TRAINERIDS_SIZE);
+        }
 
-    // Get section-specific checksum data length (Section 4 varies by game)
-    size_t checksumDataLength = getSection4ChecksumLength();
+        // Calculate Wonder Card CRC16
+        uint16_t wonderCardCRC = MysteryGift::calculateCRC16(wonderCardPayload, crcTable);
+
+        // Write Wonder Card: CRC16 + padding + payload
+        // Note: Do NOT write FF FF terminator after payload - the game interprets
+        // non-zero bytes at offset +336 as "no card present" indicator
+        uint8_t* wonderCardData = blockData + Layout::WONDERCARD_OFFSET;
+        wonderCardData[0] = wonderCardCRC & 0xFF;
+        wonderCardData[1] = (wonderCardCRC >> 8) & 0xFF;
+        wonderCardData[2] = 0x00;  // Padding
+        wonderCardData[3] = 0x00;  // Padding
+        memcpy(wonderCardData + 4, wonderCardPayload.constData(), 332);
+
+        // Write GMScript if provided
+        // Following decomp's InitRamScript() logic:
+        //   1. Zero the RamScript area
+        //   2. Set magic = RAM_SCRIPT_MAGIC (51)
+        //   3. Set mapGroup, mapNum, objectId
+        //   4. Copy script bytecode
+        if (scriptPayload.size() == 1000) {
+            // Make a mutable copy to ensure magic number is set (following decomp logic)
+            QByteArray scriptToWrite = scriptPayload;
+
+            // Verify/set magic number at offset 0 (decomp: gSaveBlock1Ptr->gmScript.magic = RAM_SCRIPT_MAGIC)
+            // This ensures the script will be recognized as valid by ValidateRamScript()
+            if (static_cast<uint8_t>(scriptToWrite[RAMSCRIPT_MAGIC_OFFSET]) != RAM_SCRIPT_MAGIC) {
+                // Script doesn't have magic number - set it (shouldn't happen with valid presets)
+                scriptToWrite[RAMSCRIPT_MAGIC_OFFSET] = static_cast<char>(RAM_SCRIPT_MAGIC);
+            }
 
-    // Recalculate block checksum
-    uint16_t blockChecksum = computeSectionChecksum(blockData, checksumDataLength);
+            // Calculate CRC16 on the (potentially modified) script payload
+            uint16_t scriptCRC = MysteryGift::calculateCRC16(scriptToWrite, crcTable);
 
-    // Write block checksum (little-endian - Gen3 uses little-endian throughout)
-    blockData[CHECKSUM_OFFSET] = blockChecksum & 0xFF;
-    blockData[CHECKSUM_OFFSET + 1] = (blockChecksum >> 8) & 0xFF;
+            // Write script with CRC header (4 bytes) + payload (1000 bytes)
+            uint8_t* scriptData = blockData + Layout::GMSCRIPT_OFFSET;
+            scriptData[0] = scriptCRC & 0xFF;
+            scriptData[1] = (scriptCRC >> 8) & 0xFF;
+            scriptData[2] = 0x00;  // Padding
+            scriptData[3] = 0x00;  // Padding
+            memcpy(scriptData + 4, scriptToWrite.constData(), RAMSCRIPT_SIZE);
+        }
 
-    return true;
+        // Update WonderCardMetadata.iconSpecies (the game uses this for icon display)
+        // The icon value is at payload offset 2-3 (little-endian u16)
+        // Note: We write this AFTER clearing metadata so the icon is preserved
+        uint16_t iconSpecies = static_cast<uint8_t>(wonderCardPayload[2]) |
+                              (static_cast<uint8_t>(wonderCardPayload[3]) << 8);
+        uint8_t* iconData = blockData + Layout::WCMETADATA_OFFSET + WCMETADATA_ICON_OFFSET;
+        iconData[0] = iconSpecies & 0xFF;
+        iconData[1] = (iconSpecies >> 8) & 0xFF;
+
+        // Recalculate block checksum (Section 4 length varies by game)
+        updateSectionChecksum(wonderCardBlock, Layout::SECTION4_CHECKSUM_LENGTH);
+    }
 }
 
 int SaveFile::findSection(int sectionId) const
@@ -615,54 +1176,32 @@ int SaveFile::findSection(int sectionId) const
         return -1;
     }
 
-    const uint8_t* saveData = reinterpret_cast<const uint8_t*>(m_bytes.constData());
-    size_t slotOffset = m_activeSaveSlot * (SECTION_SIZE * SECTIONS_PER_SAVE);
-
-    // Search through all 14 physical positions for the requested section ID
-    for (size_t pos = 0; pos < SECTIONS_PER_SAVE; ++pos) {
-        size_t sectionOffset = slotOffset + (pos * SECTION_SIZE);
-        uint16_t id = saveData[sectionOffset + SECTION_ID_OFFSET] |
-                     (saveData[sectionOffset + SECTION_ID_OFFSET + 1] << 8);
-
-        if (id == sectionId) {
-            return static_cast<int>(pos);
-        }
+    if (!m_scanned || sectionId < 0 || sectionId >= static_cast<int>(SECTIONS_PER_SAVE)) {
+        return -1;  // Section not found
     }
 
-    return -1;  // Section not found
+    // Physical position of the ID in the active slot, recorded by scanSave()
+    return m_slotScan[m_activeSaveSlot].sectionPosition[sectionId];
 }
 
 size_t SaveFile::getSection4ChecksumLength() const
 {
-    // Section 4 checksum data length varies by game
-    if (m_detectedGame == GameType::Emerald) {
-        return CHECKSUM_DATA_LENGTH_SECTION4_EMERALD;  // 0xF08 = 3848 bytes
-    } else {
-        return CHECKSUM_DATA_LENGTH_SECTION4_FRLG;     // 0xEE8 = 3816 bytes
-    }
+    // Section 4 checksum data length varies by game (0xF08 Emerald, 0xEE8 FRLG)
+    return m_layout->info.section4ChecksumLength;
 }
 
 size_t SaveFile::getSectionChecksumLength(int sectionId) const
 {
-    // Section 4 has game-specific length, all others use default
-    if (sectionId == 4) {
-        return getSection4ChecksumLength();
-    }
-
     // Section-specific lengths from Gen3 documentation
-    // Most sections use 0xF80, except Section 0 and Section 13
+    // Most sections use 0xF80, except Sections 0, 4 and 13
     switch (sectionId) {
         case 0:
             // Trainer Info - varies by game
-            if (m_detectedGame == GameType::Emerald) {
-                return 0xF2C;  // 3884 bytes
-            } else if (m_detectedGame == GameType::FireRedLeafGreen) {
-                return 0xF24;  // 3876 bytes
-            } else {
-                return 0x890;  // 2192 bytes (Ruby/Sapphire)
-            }
+            return m_layout->info.section0ChecksumLength;
+        case 4:
+            return getSection4ChecksumLength();
         case 13:
-            return 0x7D0;  // 2000 bytes (PC Buffer I)
+            return CHECKSUM_DATA_LENGTH_SECTION13;
         default:
             return CHECKSUM_DATA_LENGTH_DEFAULT;  // 0xF80 = 3968 bytes
     }
@@ -674,12 +1213,12 @@ bool SaveFile::isMysteryGiftEnabled() const
         return false;
     }
 
-    if (m_detectedGame == GameType::Unknown || m_detectedGame == GameType::RubySapphire) {
+    if (!m_layout->info.hasWonderCard) {
         return false;
     }
 
     // Find Section 2 (where Mystery Gift flag is stored)
-    int section2Pos = const_cast<SaveFile*>(this)->findSection(2);
+    int section2Pos = findSection(MYSTERY_GIFT_SECTION);
     if (section2Pos < 0) {
         return false;
     }
@@ -691,21 +1230,9 @@ bool SaveFile::isMysteryGiftEnabled() const
     const uint8_t* saveData = reinterpret_cast<const uint8_t*>(m_bytes.constData());
     const uint8_t* section2Data = saveData + section2Offset;
 
-    // Get game-specific flag offset and bit
-    size_t flagOffset;
-    uint8_t flagBit;
-
-    if (m_detectedGame == GameType::Emerald) {
-        flagOffset = MYSTERY_GIFT_OFFSET_EMERALD;
-        flagBit = MYSTERY_GIFT_BIT_EMERALD;
-    } else {
-        flagOffset = MYSTERY_GIFT_OFFSET_FRLG;
-        flagBit = MYSTERY_GIFT_BIT_FRLG;
-    }
-
     // Check if flag is set
-    uint8_t currentValue = section2Data[flagOffset];
-    return (currentValue & flagBit) != 0;
+    uint8_t currentValue = section2Data[m_layout->info.mysteryGiftFlagOffset];
+    return (currentValue & m_layout->info.mysteryGiftFlagBit) != 0;
 }
 
 bool SaveFile::enableMysteryGift(QString &errorMessage)
@@ -720,54 +1247,45 @@ bool SaveFile::enableMysteryGift(QString &errorMessage)
         return false;
     }
 
-    if (m_detectedGame == GameType::RubySapphire) {
+    if (!m_layout->info.hasWonderCard) {
         errorMessage = "Ruby/Sapphire use Mystery Event, not Mystery Gift";
         return false;
     }
 
     // Find Section 2 (where Mystery Gift flag is stored)
-    int section2Pos = findSection(2);
+    int section2Pos = findSection(MYSTERY_GIFT_SECTION);
     if (section2Pos < 0) {
         errorMessage = "Section 2 not found in save file";
         return false;
     }
 
-    // Calculate absolute offset for Section 2
-    size_t slotOffset = m_activeSaveSlot * (SECTION_SIZE * SECTIONS_PER_SAVE);
-    size_t section2Offset = slotOffset + (section2Pos * SECTION_SIZE);
-
-    uint8_t* saveData = reinterpret_cast<uint8_t*>(m_bytes.data());
-    uint8_t* section2Data = saveData + section2Offset;
-
-    // Get game-specific flag offset and bit
-    size_t flagOffset;
-    uint8_t flagBit;
+    (this->*m_layout->setMysteryGiftFlag)(section2Pos);
+    return true;
+}
 
-    if (m_detectedGame == GameType::Emerald) {
-        flagOffset = MYSTERY_GIFT_OFFSET_EMERALD;
-        flagBit = MYSTERY_GIFT_BIT_EMERALD;
+template <typename Layout>
+void SaveFile::setMysteryGiftFlag(int section2Pos)
+{
+    if constexpr (!Layout::HAS_WONDER_CARD) {
+        return;
     } else {
-        flagOffset = MYSTERY_GIFT_OFFSET_FRLG;
-        flagBit = MYSTERY_GIFT_BIT_FRLG;
-    }
+        // Calculate absolute offset for Section 2
+        size_t slotOffset = m_activeSaveSlot * (SECTION_SIZE * SECTIONS_PER_SAVE);
+        size_t section2Offset = slotOffset + (section2Pos * SECTION_SIZE);
 
-    // Check if flag is already set
-    uint8_t currentValue = section2Data[flagOffset];
-    if ((currentValue & flagBit) != 0) {
-        // Already enabled, no need to modify
-        return true;
-    }
+        uint8_t* saveData = reinterpret_cast<uint8_t*>(m_bytes.data());
+        uint8_t* flagData = saveData + section2Offset + Layout::MYSTERY_GIFT_FLAG_OFFSET;
 
-    // Set the Mystery Gift enable bit
-    section2Data[flagOffset] = currentValue | flagBit;
-
-    // Recalculate Section 2 checksum
-    size_t checksumLength = getSectionChecksumLength(2);
-    uint16_t newChecksum = computeSectionChecksum(section2Data, checksumLength);
+        // Check if flag is already set
+        if ((*flagData & Layout::MYSTERY_GIFT_FLAG_BIT) != 0) {
+            // Already enabled, no need to modify
+            return;
+        }
 
-    // Write checksum (little-endian)
-    section2Data[CHECKSUM_OFFSET] = newChecksum & 0xFF;
-    section2Data[CHECKSUM_OFFSET + 1] = (newChecksum >> 8) & 0xFF;
+        // Set the Mystery Gift enable bit
+        *flagData |= Layout::MYSTERY_GIFT_FLAG_BIT;
 
-    return true;
+        // Recalculate Section 2 checksum (default length in every layout)
+        updateSectionChecksum(section2Pos, CHECKSUM_DATA_LENGTH_DEFAULT);
+    }
 }
@@ -19,6 +19,11 @@
  *
  * The active save slot is the one with the higher save index.
  *
+ * ## Per-Game Layouts
+ * Game-specific offsets live in the constexpr policies of savelayout.h. The
+ * game is detected once at load and bound to that layout's template
+ * instantiations, so injection and flag writes use constant offsets.
+ *
  * ## Mystery Gift Data
  * Wonder Card and Script data are stored in Section 4:
  * - FRLG: Wonder Card at 0x460, Script at 0x3A0
@@ -30,6 +35,27 @@
  * - Add upper and lower 16-bit halves
  * - Store result at 0xFF6
  *
+ * The 32-bit word sum uses SSE2 or NEON when available (scalar otherwise).
+ *
+ * ## Save Scan
+ * Loading performs a single sweep over both slots which validates every
+ * section checksum, maps each section ID to its physical position and picks
+ * the active slot. The result is cached; edits recompute only the section
+ * they modify.
+ *
+ * ## Write Modes
+ * - FullRewrite: the whole 128 KB buffer goes to a temp file that replaces
+ *   the original (backup = full .bak copy)
+ * - PatchSections: only sections modified since load are rewritten in place.
+ *   The new section data is first committed to a journal (<save>.journal).
+ *   Loading never writes: write paths call recoverJournal() first, which
+ *   rolls an interrupted patch forward only if the file still matches the
+ *   journal, and saveToFile() refuses a file whose journal is pending. The
+ *   backup is a delta (<base>.bakd) holding just the previous contents of
+ *   those sections. Successive patched writes extend one delta, which
+ *   restores the save as it was before the first of them; a delta that does
+ *   not match the current file is never overwritten
+ *
  * @see mysterygift.h for Wonder Card data structures
  *
  * @author ComradeSean
@@ -44,19 +70,15 @@
 // =============================================================================
 #include <QString>
 #include <QByteArray>
+#include <QDateTime>
+#include <QVector>
 #include <cstdint>
 
 // =============================================================================
 // Project Includes
 // =============================================================================
 #include "mysterygift.h"
-
-enum class GameType {
-    Unknown,
-    FireRedLeafGreen,
-    RubySapphire,
-    Emerald
-};
+#include "savelayout.h"
 
 struct SaveBlockInfo {
     size_t blockIndex;      // Which save slot (0 or 1)
@@ -74,6 +96,12 @@ struct InjectionOptions {
     bool clearMysteryGiftVars = false;   // Clear Mystery Gift variables
 };
 
+// How saveToFile writes the buffer back to disk
+enum class SaveWriteMode {
+    FullRewrite,     // Whole file via temp file + rename
+    PatchSections    // Only dirty 4 KB sections, in place, journaled
+};
+
 class SaveFile
 {
 public:
@@ -82,7 +110,23 @@ public:
 
     // File operations
     bool loadFromFile(const QString &path, QString &errorMessage);
-    bool saveToFile(const QString &path, bool makeBackup, QString &errorMessage);
+    bool saveToFile(const QString &path, bool makeBackup, QString &errorMessage,
+                    SaveWriteMode mode = SaveWriteMode::FullRewrite);
+
+    // Dirty tracking (bit n = physical section n, i.e. slot * 14 + position)
+    bool hasDirtySections() const { return m_dirtySections != 0; }
+    uint32_t dirtySections() const { return m_dirtySections; }
+
+    // Interrupted PatchSections writes: complete one before writing the file
+    // again (refused, leaving both files alone, if the file no longer matches)
+    static bool hasPendingJournal(const QString &savePath);
+    static bool recoverJournal(const QString &savePath, QString &errorMessage);
+
+    // Undo PatchSections writes using their delta backup (removed once applied,
+    // and by any later write that does not extend it)
+    static bool restoreFromDeltaBackup(const QString &savePath, const QString &deltaPath,
+                                       QString &errorMessage);
+    static QString deltaBackupPath(const QString &savePath);
 
     // Game detection
     GameType detectGameType();
@@ -91,6 +135,7 @@ public:
     // Validation
     bool validateChecksums();
     bool isLoaded() const { return !m_bytes.isEmpty(); }
+    static uint16_t computeSectionChecksum(const uint8_t* data, size_t length);   // Gen3 section word sum
 
     // Accessors
     QString filePath() const { return m_filePath; }
@@ -104,6 +149,12 @@ public:
     WonderCardData extractWonderCard(QString &errorMessage) const;
     QByteArray extractWonderCardRaw(QString &errorMessage) const;
     QByteArray extractScript(QString &errorMessage) const;
+
+    // Zero-copy views into the loaded buffer (empty when unavailable); valid
+    // until the save is reloaded or modified
+    ByteView wonderCardRawView() const;   // 336 bytes: CRC header + payload
+    ByteView scriptView() const;          // 1000-byte payload
+    WonderCardView wonderCardView() const;
     bool injectWonderCard(const WonderCardData &wonderCard, const QByteArray &scriptData,
                           const QByteArray &crcTable, QString &errorMessage,
                           const QByteArray &rawWonderCardData = QByteArray(),
@@ -124,21 +175,16 @@ public:
     static const size_t SIGNATURE_OFFSET = 0xFF8;    // 4 bytes (magic: 0x08012025)
     static const size_t SAVE_INDEX_OFFSET = 0xFFC;   // 4 bytes (save counter)
 
-    // Section checksum data lengths (varies by game and section)
-    // Most sections use 0xF80 bytes, but Section 4 varies:
+    // Section checksum data lengths: most sections use 0xF80 bytes, Sections 0
+    // and 4 vary by game (see SaveLayout policies)
     static const size_t CHECKSUM_DATA_LENGTH_DEFAULT = 0xF80;  // Default for most sections
-    static const size_t CHECKSUM_DATA_LENGTH_SECTION4_FRLG = 0xEE8;     // 3816 bytes
-    static const size_t CHECKSUM_DATA_LENGTH_SECTION4_EMERALD = 0xF08;  // 3848 bytes
+    static const size_t CHECKSUM_DATA_LENGTH_SECTION13 = 0x7D0; // 2000 bytes (PC Buffer I)
 
     // Game code offset
     static const size_t GAME_CODE_OFFSET = 0xAC;
 
-    // Wonder Card constants
+    // Wonder Card constants (per-game offsets: see SaveLayout policies)
     static const uint8_t WONDERCARD_BLOCK_MARKER = 0x04;
-    static const size_t WONDERCARD_OFFSET_FRLG = 0x460;
-    static const size_t WONDERCARD_OFFSET_EMERALD = 0x56C;
-    static const size_t GMSCRIPT_OFFSET_FRLG = 0x79C;
-    static const size_t GMSCRIPT_OFFSET_EMERALD = 0x8A8;
 
     // WonderCardMetadata structure (from decomp):
     // struct WonderCardMetadata {
@@ -150,16 +196,12 @@ public:
     // };
     // Note: When game saves WonderCard legitimately, it copies iconSpecies from
     // WonderCard to WonderCardMetadata. We must do the same during injection.
-    static const size_t WCMETADATA_OFFSET_FRLG = 0x5B4;    // 0x460 + 336 + 4 (after WC + CRC)
-    static const size_t WCMETADATA_OFFSET_EMERALD = 0x6C0;  // 0x56C + 336 + 4
     static const size_t WCMETADATA_ICON_OFFSET = 6;         // iconSpecies offset within metadata
     static const size_t WCMETADATA_SIZE = 32;               // Size to clear (includes stampData)
 
     // TrainerIds array (from decomp): u32 trainerIds[2][5] = 40 bytes
     // Stores IDs for 10 trainers - 5 for battles, 5 for trades
     // Located at end of MysteryGiftSave structure, before GMScript
-    static const size_t TRAINERIDS_OFFSET_FRLG = 0x75C;     // 0x79C - 40
-    static const size_t TRAINERIDS_OFFSET_EMERALD = 0x868;  // 0x8A8 - 40
     static const size_t TRAINERIDS_SIZE = 40;               // 10 * sizeof(u32)
 
     // RamScript structure (from decomp):
@@ -178,18 +220,65 @@ public:
     static const size_t RAMSCRIPT_SIZE = 1000;              // Size of RamScript structure
     static const size_t GMSCRIPT_SIZE_WITH_CRC = 1004;      // 4-byte CRC header + 1000-byte payload
 
-    // Mystery Gift enable flag offsets (in Section 2)
-    static const size_t MYSTERY_GIFT_OFFSET_FRLG = 0x067;      // Bit 1 (0x02)
-    static const uint8_t MYSTERY_GIFT_BIT_FRLG = 0x02;
-    static const size_t MYSTERY_GIFT_OFFSET_EMERALD = 0x40B;   // Bit 3 (0x08)
-    static const uint8_t MYSTERY_GIFT_BIT_EMERALD = 0x08;
+    // Mystery Gift enable flag lives in Section 2 (offset/bit: see SaveLayout policies)
+    static const int MYSTERY_GIFT_SECTION = 2;
 
 private:
+    // One 4 KB section image at an absolute file offset (journal / delta entry)
+    struct SectionPatch {
+        uint32_t offset;
+        QByteArray expectedMd5;   // MD5 of the section this image replaces
+        QByteArray data;
+    };
+
+    // Cached result of the single-pass save scan (one per slot)
+    struct SlotScan {
+        SaveBlockInfo info;
+        int sectionPosition[SECTIONS_PER_SAVE];   // Section ID -> physical position (-1 = missing)
+        bool sectionValid[SECTIONS_PER_SAVE];     // Checksum OK, by physical position
+    };
+
+    // Layout-specific operations, bound once per load (see savelayout.h)
+    struct LayoutOps {
+        SaveLayoutInfo info;
+        void (SaveFile::*writeWonderCard)(int wonderCardBlock, const QByteArray &wonderCardPayload,
+                                          const QByteArray &scriptPayload, const QByteArray &crcTable,
+                                          const InjectionOptions &options);
+        void (SaveFile::*setMysteryGiftFlag)(int section2Pos);
+    };
+
+    template <typename Layout>
+    static const LayoutOps& layoutOps();
+
+    // Hot write paths, instantiated per layout with constant offsets
+    template <typename Layout>
+    void writeWonderCard(int wonderCardBlock, const QByteArray &wonderCardPayload,
+                         const QByteArray &scriptPayload, const QByteArray &crcTable,
+                         const InjectionOptions &options);
+    template <typename Layout>
+    void setMysteryGiftFlag(int section2Pos);
+
     // Helper functions
-    uint16_t computeSectionChecksum(const uint8_t* data, size_t length);
+    void scanSave();                                          // Sweep both slots once
+    void scanSection(size_t slotIndex, size_t position);     // Fill one section of the scan
+    void updateSectionChecksum(size_t position, size_t checksumLength);  // Rewrite + rescan one section (active slot)
     SaveBlockInfo analyzeSaveSlot(size_t slotIndex);
     int findActiveSaveSlot();
+
+    // Write-back helpers
+    bool writeFull(const QString &path, bool makeBackup, QString &errorMessage);
+    bool writePatched(const QString &path, bool makeBackup, QString &errorMessage);
+    static bool chainDeltaBackup(const QString &deltaPath, const QByteArray &onDisk,
+                                 QVector<SectionPatch> &previous, QString &errorMessage);
+    static void discardDeltaBackup(const QString &savePath);
+    static bool writePatchFile(const QString &path, const char *magic, const QVector<SectionPatch> &patches,
+                               const QByteArray &targetMd5, QString &errorMessage);
+    static bool readPatchFile(const QString &path, const char *magic, QVector<SectionPatch> &patches,
+                              QByteArray &targetMd5, QString &errorMessage);
+    static bool applyPatches(const QString &path, const QVector<SectionPatch> &patches, QString &errorMessage);
+    static QByteArray sectionMd5(const QByteArray &section);
     int findWonderCardBlock() const;
+    const uint8_t* wonderCardBlockData() const;  // Active slot's Section 4, or nullptr
     int findSection(int sectionId) const;  // Find physical position of a section by ID
     size_t getSection4ChecksumLength() const;  // Get game-specific checksum length for Section 4
     size_t getSectionChecksumLength(int sectionId) const;  // Get checksum length for any section
@@ -198,8 +287,14 @@ private:
     QString m_filePath;
     QByteArray m_bytes;
     GameType m_detectedGame;
+    const LayoutOps *m_layout;   // Matches m_detectedGame
     bool m_checksumValid;
     int m_activeSaveSlot;
+    SlotScan m_slotScan[2];
+    bool m_scanned;
+    uint32_t m_dirtySections;
+    qint64 m_loadedFileSize;     // On-disk state at load, to detect external changes
+    QDateTime m_loadedModified;
 };
 
 #endif // SAVEFILE_H
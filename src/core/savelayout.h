@@ -0,0 +1,164 @@
+/**
+ * @file savelayout.h
+ * @brief Compile-time per-game save layouts.
+ *
+ * Each supported GameType has one policy struct holding every game-specific
+ * offset, length and flag of the save format as constexpr members. Code that
+ * touches game-specific fields is templated on the policy, so the offsets are
+ * immediates in the generated code and the hot inject path has no per-field
+ * branching on the game.
+ *
+ * ## Dispatch
+ * The game is known once the save is loaded. dispatchSaveLayout() maps a
+ * GameType to its policy exactly once (SaveFile::loadFromFile); SaveFile then
+ * keeps the matching template instantiations until the next load. Adding a
+ * layout (a regional variant, Ruby/Sapphire Mystery Event, ...) means adding
+ * one struct and one case in dispatchSaveLayout().
+ *
+ * ## Runtime View
+ * SaveLayoutInfo is a plain copy of a policy's values for the cold paths
+ * (extraction, views, checksum lengths) that do not need their own
+ * instantiation.
+ *
+ * @see savefile.h for the save file structure
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef SAVELAYOUT_H
+#define SAVELAYOUT_H
+
+#include <cstddef>
+#include <cstdint>
+
+enum class GameType {
+    Unknown,
+    FireRedLeafGreen,
+    RubySapphire,
+    Emerald
+};
+
+// =============================================================================
+// LAYOUT POLICIES
+// =============================================================================
+
+/// <summary>
+/// FireRed / LeafGreen. Mystery Gift data in Section 4, enable flag in Section 2.
+/// </summary>
+struct FrlgSaveLayout {
+    static constexpr GameType GAME = GameType::FireRedLeafGreen;
+    static constexpr bool HAS_WONDER_CARD = true;
+
+    // Section 4 (MysteryGiftSave)
+    static constexpr size_t WONDERCARD_OFFSET = 0x460;
+    static constexpr size_t GMSCRIPT_OFFSET = 0x79C;
+    static constexpr size_t WCMETADATA_OFFSET = 0x5B4;   // 0x460 + 336 + 4 (after WC + CRC)
+    static constexpr size_t TRAINERIDS_OFFSET = 0x75C;   // 0x79C - 40
+
+    // Section checksum data lengths
+    static constexpr size_t SECTION0_CHECKSUM_LENGTH = 0xF24;   // 3876 bytes
+    static constexpr size_t SECTION4_CHECKSUM_LENGTH = 0xEE8;   // 3816 bytes
+
+    // Mystery Gift enable flag (Section 2)
+    static constexpr size_t MYSTERY_GIFT_FLAG_OFFSET = 0x067;
+    static constexpr uint8_t MYSTERY_GIFT_FLAG_BIT = 0x02;      // Bit 1
+};
+
+/// <summary>
+/// Emerald. Same structures as FRLG, shifted by the larger SaveBlock1.
+/// </summary>
+struct EmeraldSaveLayout {
+    static constexpr GameType GAME = GameType::Emerald;
+    static constexpr bool HAS_WONDER_CARD = true;
+
+    static constexpr size_t WONDERCARD_OFFSET = 0x56C;
+    static constexpr size_t GMSCRIPT_OFFSET = 0x8A8;
+    static constexpr size_t WCMETADATA_OFFSET = 0x6C0;   // 0x56C + 336 + 4
+    static constexpr size_t TRAINERIDS_OFFSET = 0x868;   // 0x8A8 - 40
+
+    static constexpr size_t SECTION0_CHECKSUM_LENGTH = 0xF2C;   // 3884 bytes
+    static constexpr size_t SECTION4_CHECKSUM_LENGTH = 0xF08;   // 3848 bytes
+
+    static constexpr size_t MYSTERY_GIFT_FLAG_OFFSET = 0x40B;
+    static constexpr uint8_t MYSTERY_GIFT_FLAG_BIT = 0x08;      // Bit 3
+};
+
+/// <summary>
+/// Ruby / Sapphire. Mystery Event instead of Mystery Gift: no Wonder Card,
+/// script or enable flag locations; only the checksum lengths apply.
+/// </summary>
+struct RubySapphireSaveLayout {
+    static constexpr GameType GAME = GameType::RubySapphire;
+    static constexpr bool HAS_WONDER_CARD = false;
+
+    static constexpr size_t WONDERCARD_OFFSET = 0;
+    static constexpr size_t GMSCRIPT_OFFSET = 0;
+    static constexpr size_t WCMETADATA_OFFSET = 0;
+    static constexpr size_t TRAINERIDS_OFFSET = 0;
+
+    static constexpr size_t SECTION0_CHECKSUM_LENGTH = 0x890;   // 2192 bytes
+    static constexpr size_t SECTION4_CHECKSUM_LENGTH = 0xEE8;   // FRLG length (not yet mapped)
+
+    static constexpr size_t MYSTERY_GIFT_FLAG_OFFSET = 0;
+    static constexpr uint8_t MYSTERY_GIFT_FLAG_BIT = 0;
+};
+
+/// <summary>
+/// Unrecognized game: Ruby/Sapphire checksum lengths, nothing injectable.
+/// </summary>
+struct UnknownSaveLayout : RubySapphireSaveLayout {
+    static constexpr GameType GAME = GameType::Unknown;
+};
+
+// =============================================================================
+// RUNTIME VIEW AND DISPATCH
+// =============================================================================
+
+/// <summary>
+/// Runtime copy of a layout policy's values.
+/// </summary>
+struct SaveLayoutInfo {
+    GameType game;
+    bool hasWonderCard;
+    size_t wonderCardOffset;
+    size_t gmScriptOffset;
+    size_t metadataOffset;
+    size_t trainerIdsOffset;
+    size_t section0ChecksumLength;
+    size_t section4ChecksumLength;
+    size_t mysteryGiftFlagOffset;
+    uint8_t mysteryGiftFlagBit;
+
+    template <typename Layout>
+    static constexpr SaveLayoutInfo of()
+    {
+        return {Layout::GAME, Layout::HAS_WONDER_CARD,
+                Layout::WONDERCARD_OFFSET, Layout::GMSCRIPT_OFFSET,
+                Layout::WCMETADATA_OFFSET, Layout::TRAINERIDS_OFFSET,
+                Layout::SECTION0_CHECKSUM_LENGTH, Layout::SECTION4_CHECKSUM_LENGTH,
+                Layout::MYSTERY_GIFT_FLAG_OFFSET, Layout::MYSTERY_GIFT_FLAG_BIT};
+    }
+};
+
+/// <summary>
+/// Calls fn(Layout{}) with the policy for a game and returns its result.
+///
+/// USAGE:
+///   size_t length = dispatchSaveLayout(game, [](auto layout) {
+///       return decltype(layout)::SECTION4_CHECKSUM_LENGTH;
+///   });
+/// </summary>
+template <typename Fn>
+decltype(auto) dispatchSaveLayout(GameType game, Fn &&fn)
+{
+    switch (game) {
+        case GameType::FireRedLeafGreen: return fn(FrlgSaveLayout{});
+        case GameType::Emerald:          return fn(EmeraldSaveLayout{});
+        case GameType::RubySapphire:     return fn(RubySapphireSaveLayout{});
+        case GameType::Unknown:
+        default:                         return fn(UnknownSaveLayout{});
+    }
+}
+
+#endif // SAVELAYOUT_H
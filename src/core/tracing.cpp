@@ -0,0 +1,249 @@
+/**
+ * @file tracing.cpp
+ * @brief Implementation of the scoped span recorder.
+ *
+ * Every thread that records a span gets its own buffer, registered once in
+ * a global list. Buffers outlive their threads (pool threads come and go),
+ * so an export after a batch still sees every span.
+ *
+ * @see tracing.h for the cost model and the environment variables
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "tracing.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QSharedPointer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QHash>
+#include <QSaveFile>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+
+const char Tracing::TRACE_FILE_ENV[] = "MGI_TRACE";
+const char Tracing::TRACE_COUNTERS_ENV[] = "MGI_TRACE_COUNTERS";
+
+std::atomic<bool> Tracing::s_enabled(false);
+
+namespace {
+
+struct TraceEvent {
+    const char *name;
+    qint64 startNs;
+    qint64 durationNs;
+};
+
+/// Spans and counters of one thread.
+struct ThreadBuffer {
+    QMutex mutex;
+    quint64 threadId = 0;
+    QVector<TraceEvent> events;
+    QHash<const char *, TraceCounter> counters;
+};
+
+struct Registry {
+    QMutex mutex;
+    QVector<QSharedPointer<ThreadBuffer>> buffers;
+    QString traceFile;       // MGI_TRACE target, written on exit
+    bool printCounters = false;
+};
+
+Registry &registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+const QElapsedTimer &clock()
+{
+    static const QElapsedTimer timer = [] {
+        QElapsedTimer started;
+        started.start();
+        return started;
+    }();
+    return timer;
+}
+
+ThreadBuffer &threadBuffer()
+{
+    thread_local QSharedPointer<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer.reset(new ThreadBuffer);
+        buffer->threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+        Registry &reg = registry();
+        QMutexLocker locker(&reg.mutex);
+        reg.buffers.append(buffer);
+    }
+    return *buffer;
+}
+
+QVector<QSharedPointer<ThreadBuffer>> allBuffers()
+{
+    Registry &reg = registry();
+    QMutexLocker locker(&reg.mutex);
+    return reg.buffers;
+}
+
+void writeOnExit()
+{
+    Registry &reg = registry();
+    if (!reg.traceFile.isEmpty()) {
+        QString errorMessage;
+        if (!Tracing::writeChromeTrace(reg.traceFile, errorMessage)) {
+            qWarning() << "Tracing:" << errorMessage;
+        }
+    }
+    if (reg.printCounters) {
+        QTextStream(stderr) << Tracing::formatCounters();
+    }
+}
+
+// Chrome trace strings are JSON; trace point names are plain identifiers
+QString jsonString(const char *text)
+{
+    QString escaped = QString::fromLatin1(text);
+    escaped.replace('\\', "\\\\").replace('"', "\\\"");
+    return '"' + escaped + '"';
+}
+}
+
+// =============================================================================
+// RECORDING
+// =============================================================================
+
+void Tracing::setEnabled(bool enabled)
+{
+    clock();   // Start the time base before the first span
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Tracing::initFromEnvironment()
+{
+    Registry &reg = registry();
+    reg.traceFile = qEnvironmentVariable(TRACE_FILE_ENV);
+    reg.printCounters = qEnvironmentVariableIntValue(TRACE_COUNTERS_ENV) != 0;
+
+    if (reg.traceFile.isEmpty() && !reg.printCounters) {
+        return;
+    }
+#ifndef MGI_TRACING_ENABLED
+    qWarning() << "Tracing: built with MGI_TRACING=OFF; the trace will be empty";
+#endif
+    setEnabled(true);
+    qAddPostRoutine(writeOnExit);
+}
+
+qint64 Tracing::now()
+{
+    return clock().nsecsElapsed();
+}
+
+void Tracing::record(const char *name, qint64 startNs, qint64 endNs)
+{
+    ThreadBuffer &buffer = threadBuffer();
+    qint64 duration = endNs - startNs;
+    QMutexLocker locker(&buffer.mutex);
+
+    if (buffer.events.size() < MAX_EVENTS_PER_THREAD) {
+        buffer.events.append({name, startNs, duration});
+    }
+
+    TraceCounter &counter = buffer.counters[name];
+    counter.name = name;
+    ++counter.count;
+    counter.totalNs += duration;
+    counter.maxNs = qMax(counter.maxNs, duration);
+}
+
+void Tracing::reset()
+{
+    for (const QSharedPointer<ThreadBuffer> &buffer : allBuffers()) {
+        QMutexLocker locker(&buffer->mutex);
+        buffer->events.clear();
+        buffer->counters.clear();
+    }
+}
+
+// =============================================================================
+// EXPORT
+// =============================================================================
+
+bool Tracing::writeChromeTrace(const QString &path, QString &errorMessage)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        errorMessage = QString("Failed to open %1: %2").arg(path, file.errorString());
+        return false;
+    }
+
+    // Complete ("X") events; Chrome expects microseconds
+    QTextStream out(&file);
+    qint64 pid = QCoreApplication::applicationPid();
+    bool first = true;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (const QSharedPointer<ThreadBuffer> &buffer : allBuffers()) {
+        QMutexLocker locker(&buffer->mutex);
+        for (const TraceEvent &event : buffer->events) {
+            out << (first ? "" : ",\n")
+                << "{\"name\":" << jsonString(event.name) << ",\"cat\":\"mgi\",\"ph\":\"X\""
+                << ",\"ts\":" << QString::number(event.startNs / 1000.0, 'f', 3)
+                << ",\"dur\":" << QString::number(event.durationNs / 1000.0, 'f', 3)
+                << ",\"pid\":" << pid << ",\"tid\":" << buffer->threadId << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    out.flush();
+
+    if (!file.commit()) {
+        errorMessage = QString("Failed to write %1: %2").arg(path, file.errorString());
+        return false;
+    }
+    return true;
+}
+
+QVector<TraceCounter> Tracing::counters()
+{
+    QHash<const char *, TraceCounter> merged;
+    for (const QSharedPointer<ThreadBuffer> &buffer : allBuffers()) {
+        QMutexLocker locker(&buffer->mutex);
+        for (const TraceCounter &counter : buffer->counters) {
+            TraceCounter &total = merged[counter.name];
+            total.name = counter.name;
+            total.count += counter.count;
+            total.totalNs += counter.totalNs;
+            total.maxNs = qMax(total.maxNs, counter.maxNs);
+        }
+    }
+
+    QVector<TraceCounter> sorted = merged.values().toVector();
+    std::sort(sorted.begin(), sorted.end(), [](const TraceCounter &a, const TraceCounter &b) {
+        return a.totalNs > b.totalNs;
+    });
+    return sorted;
+}
+
+QString Tracing::formatCounters()
+{
+    QString text = QString("%1 %2 %3 %4\n")
+                       .arg("Trace point", -48).arg("Count", 10).arg("Total ms", 12).arg("Max ms", 10);
+    for (const TraceCounter &counter : counters()) {
+        text += QString("%1 %2 %3 %4\n")
+                    .arg(QString::fromLatin1(counter.name), -48)
+                    .arg(counter.count, 10)
+                    .arg(counter.totalNs / 1e6, 12, 'f', 3)
+                    .arg(counter.maxNs / 1e6, 10, 'f', 3);
+    }
+    return text;
+}
@@ -0,0 +1,440 @@
+/**
+ * @file cardrasterizer.cpp
+ * @brief Implementation of the offscreen Wonder Card renderer.
+ *
+ * Rendering follows AuthenticWonderCardWidget::renderCard(): copy the
+ * background, draw each text line at its field position, then the icon. All
+ * state lives on the stack of the calling thread; the shared CardAssets are
+ * only read.
+ *
+ * @see cardrasterizer.h for the processing model
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "cardrasterizer.h"
+#include "logcategories.h"
+#include "tracing.h"
+#include "fallbackgraphics.h"
+#include "spritecache.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QPainter>
+#include <QThread>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <cstring>
+
+namespace {
+
+// Text fields in card order (y positions from wonder_card_editor.py TEXT_FIELDS)
+struct FieldLayout {
+    QString WonderCardData::*text;
+    int yStart;
+    bool isHeader;      // Uses header color scheme if true
+    bool isIdField;     // Emerald draws the ID number with FONT_NORMAL
+    bool rightAligned;  // Subtitle right-aligns within the header window
+};
+
+const FieldLayout FIELD_LAYOUT[] = {
+    {&WonderCardData::title, 9, true, false, false},
+    {&WonderCardData::subtitle, 25, true, false, true},
+    {&WonderCardData::contentLine1, 50, false, false, false},
+    {&WonderCardData::contentLine2, 66, false, false, false},
+    {&WonderCardData::contentLine3, 82, false, false, false},
+    {&WonderCardData::contentLine4, 98, false, false, false},
+    {&WonderCardData::warningLine1, 119, false, false, false},
+    {&WonderCardData::warningLine2, 135, false, false, false},
+};
+
+const int BACKGROUND_COUNT = 8;
+const int EMERALD_INVALID_ICON = 260;  // SPECIES_OLD_UNOWN_J in Emerald
+const int FRLG_INVALID_ICON = 0;       // SPECIES_NONE in FRLG
+
+} // namespace
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+CardRasterizer::CardRasterizer()
+    : m_threadCount(0)
+{
+}
+
+CardRasterizer::CardRasterizer(QSharedPointer<const CardAssets> assets)
+    : m_assets(assets)
+    , m_threadCount(0)
+{
+}
+
+int CardRasterizer::threadCount() const
+{
+    return m_threadCount > 0 ? m_threadCount : qMax(1, QThread::idealThreadCount());
+}
+
+// =============================================================================
+// ASSET LOADING
+// =============================================================================
+
+QSharedPointer<const CardAssets> CardRasterizer::loadAssets(const QString &romPath, QString &errorMessage)
+{
+    QSharedPointer<CardAssets> assets(new CardAssets());
+    assets->reader.reset(new GBAROReader());
+    if (!assets->reader->loadROM(romPath, errorMessage)) {
+        return QSharedPointer<const CardAssets>();
+    }
+    assets->fontRenderer.reset(new Gen3FontRenderer());
+
+    // Prefer the persistent asset cache; decode from ROM only on a miss
+    QString cacheError;
+    assets->assetCache.reset(new RomAssetCache());
+    if (assets->assetCache->open(assets->reader->md5(), RomAssetCache::databaseFingerprint(), cacheError) &&
+        loadAssetsFromCache(*assets, cacheError)) {
+        qCDebug(lcRender) << "CardRasterizer: assets loaded from cache";
+    } else {
+        qCDebug(lcRender) << "CardRasterizer: asset cache miss:" << cacheError;
+        assets->assetCache.reset();
+        assets->fontRenderer.reset(new Gen3FontRenderer());
+        if (!decodeAssetsFromROM(*assets, errorMessage)) {
+            return QSharedPointer<const CardAssets>();
+        }
+    }
+
+    assets->romFonts = true;
+    return assets;
+}
+
+QSharedPointer<const CardAssets> CardRasterizer::fallbackAssets(QString &errorMessage)
+{
+    QSharedPointer<CardAssets> assets(new CardAssets());
+
+    QImage placeholderFont = FallbackGraphics::placeholderFont();
+    if (placeholderFont.isNull()) {
+        errorMessage = "Failed to load fallback font";
+        return QSharedPointer<const CardAssets>();
+    }
+    assets->fontHeader = placeholderFont.convertToFormat(QImage::Format_ARGB32);
+    assets->fontBody = assets->fontHeader;
+
+    assets->backgrounds.resize(BACKGROUND_COUNT);
+    for (int i = 0; i < BACKGROUND_COUNT; ++i) {
+        assets->backgrounds[i] = FallbackGraphics::placeholderBackground(i)
+                                     .convertToFormat(QImage::Format_ARGB32);
+    }
+
+    assets->fontRenderer.reset(new Gen3FontRenderer());
+    assets->fontRenderer->setFallbackGlyphWidths(FallbackGraphics::generateDefaultGlyphWidths());
+    assets->fallback = true;
+    return assets;
+}
+
+bool CardRasterizer::decodeAssetsFromROM(CardAssets &assets, QString &errorMessage)
+{
+    Gen3FontRenderer &fonts = *assets.fontRenderer;
+    if (!fonts.loadFromROM(assets.reader.data(), errorMessage)) {
+        return false;
+    }
+
+    // Colored sheets are only a fallback; ROM fonts render through the atlas
+    assets.fontHeader = fonts.createColoredFont(Gen3FontRenderer::TitleHeader);
+    assets.fontBody = fonts.createColoredFont(Gen3FontRenderer::BodyFooter);
+    if (fonts.isEmerald()) {
+        assets.fontIdHeader = fonts.createColoredIdFont(Gen3FontRenderer::TitleHeader);
+        assets.fontIdBody = fonts.createColoredIdFont(Gen3FontRenderer::BodyFooter);
+    }
+
+    // LZ77 decoding runs in parallel
+    QVector<GBAROReader::WonderCardGraphicsData> graphics = assets.reader->decompressWonderCardGraphics();
+    assets.backgrounds.resize(BACKGROUND_COUNT);
+    for (int i = 0; i < BACKGROUND_COUNT; ++i) {
+        if (i < graphics.size() && graphics[i].error.isEmpty()) {
+            assets.backgrounds[i] = assets.reader->renderWonderCard(graphics[i].entry, graphics[i].tileset,
+                                                                    graphics[i].tilemap)
+                                        .convertToFormat(QImage::Format_ARGB32);
+        }
+        if (assets.backgrounds[i].isNull()) {
+            qWarning() << "CardRasterizer: failed to load Wonder Card background" << i
+                       << (i < graphics.size() ? graphics[i].error : QString());
+        }
+    }
+
+    return true;
+}
+
+bool CardRasterizer::loadAssetsFromCache(CardAssets &assets, QString &errorMessage)
+{
+    if (!assets.fontRenderer->loadFromCache(assets.reader.data(), *assets.assetCache, errorMessage)) {
+        return false;
+    }
+
+    const RomAssetCache &cache = *assets.assetCache;
+    assets.fontHeader = cache.image(RomAssetCache::ColoredFont, RomAssetCache::MainHeader);
+    assets.fontBody = cache.image(RomAssetCache::ColoredFont, RomAssetCache::MainBody);
+    if (assets.fontRenderer->isEmerald()) {
+        assets.fontIdHeader = cache.image(RomAssetCache::ColoredFont, RomAssetCache::IdHeader);
+        assets.fontIdBody = cache.image(RomAssetCache::ColoredFont, RomAssetCache::IdBody);
+    }
+
+    assets.backgrounds.resize(BACKGROUND_COUNT);
+    for (int i = 0; i < BACKGROUND_COUNT; ++i) {
+        assets.backgrounds[i] = cache.image(RomAssetCache::Background, i).convertToFormat(QImage::Format_ARGB32);
+        if (assets.backgrounds[i].isNull()) {
+            errorMessage = QString("Asset cache has no Wonder Card background %1").arg(i);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// =============================================================================
+// LAYOUT
+// =============================================================================
+
+int CardRasterizer::lineX(bool rightAligned, int lineWidth)
+{
+    if (!rightAligned) {
+        return PADDING_LEFT;
+    }
+
+    // x = 160 - string_width; if (x < 0) x = 0; then add the window offset
+    return PADDING_LEFT + qMax(0, SUBTITLE_RIGHT_EDGE - lineWidth);
+}
+
+int CardRasterizer::iconDisplaySpecies(int species, bool emerald)
+{
+    // Only raw 0x0000 has no icon; clamped values (e.g. from 0xFFFF) still show one
+    if (species == 0) {
+        return -1;
+    }
+
+    // Invalid species (from decomp): FRLG shows SPECIES_NONE, Emerald the ?-icon
+    if (species > ICON_SPECIES_LIMIT) {
+        return emerald ? EMERALD_INVALID_ICON : FRLG_INVALID_ICON;
+    }
+    return species;
+}
+
+QImage CardRasterizer::iconFrame(const QImage &iconSheet)
+{
+    if (iconSheet.isNull()) {
+        return QImage();
+    }
+
+    // Icons are 32x64 (2 frames stacked); the card shows the first frame
+    QImage frame = iconSheet.copy(0, 0, ICON_SIZE, ICON_SIZE);
+    QImage result = frame.convertToFormat(QImage::Format_ARGB32);
+
+    // Palette index 0 is transparent
+    if (frame.format() == QImage::Format_Indexed8) {
+        for (int y = 0; y < frame.height(); ++y) {
+            const uchar *indices = frame.constScanLine(y);
+            QRgb *dest = reinterpret_cast<QRgb*>(result.scanLine(y));
+            for (int x = 0; x < frame.width(); ++x) {
+                if (indices[x] == 0) {
+                    dest[x] = qRgba(0, 0, 0, 0);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+QImage CardRasterizer::icon(int species) const
+{
+    const CardAssets &assets = *m_assets;
+    if (assets.fallback) {
+        return FallbackGraphics::placeholderPokemonIcon(species);
+    }
+
+    int displaySpecies = iconDisplaySpecies(species, assets.fontRenderer->isEmerald());
+    if (displaySpecies < 0 || assets.reader.isNull()) {
+        return QImage();
+    }
+
+    QImage sheet = (assets.assetCache && assets.assetCache->contains(RomAssetCache::PokemonIcon, displaySpecies))
+        ? assets.assetCache->image(RomAssetCache::PokemonIcon, displaySpecies)
+        : SpriteCache::instance().icon(assets.reader.data(), static_cast<uint16_t>(displaySpecies));
+    return iconFrame(sheet);
+}
+
+// =============================================================================
+// RENDERING
+// =============================================================================
+
+QImage CardRasterizer::render(const WonderCardData &card, int scale) const
+{
+    MGI_TRACE_SCOPE("CardRasterizer::render");
+    if (!m_assets) {
+        return QImage();
+    }
+    const CardAssets &assets = *m_assets;
+    const Gen3FontRenderer &fonts = *assets.fontRenderer;
+
+    int bgIndex = card.color();
+    QImage image;
+    if (bgIndex < assets.backgrounds.size() && !assets.backgrounds.at(bgIndex).isNull()) {
+        image = assets.backgrounds.at(bgIndex).copy();
+    } else {
+        image = QImage(CARD_WIDTH, CARD_HEIGHT, QImage::Format_ARGB32);
+        image.fill(Qt::white);
+    }
+
+    QPainter painter(&image);
+
+    for (const FieldLayout &field : FIELD_LAYOUT) {
+        const QString &text = card.*field.text;
+        if (text.isEmpty()) {
+            continue;
+        }
+
+        bool useIdFont = field.isIdField && fonts.isEmerald() && !assets.fontIdHeader.isNull();
+        QImage line;
+        if (assets.romFonts && fonts.hasAtlas()) {
+            line = fonts.renderLine(text, field.isHeader ? Gen3FontRenderer::TitleHeader
+                                                         : Gen3FontRenderer::BodyFooter,
+                                    0, useIdFont);
+        } else {
+            const QImage &fontImg = useIdFont ? (field.isHeader ? assets.fontIdHeader : assets.fontIdBody)
+                                              : (field.isHeader ? assets.fontHeader : assets.fontBody);
+            line = fonts.renderLine(text, fontImg, 0);
+        }
+
+        if (line.width() > 0) {
+            painter.drawImage(lineX(field.rightAligned, line.width()), field.yStart, line);
+        }
+    }
+
+    QImage iconImage = icon(card.icon);
+    if (!iconImage.isNull()) {
+        painter.drawImage(ICON_CENTER_X - (ICON_SIZE / 2), ICON_CENTER_Y - (ICON_SIZE / 2), iconImage);
+    }
+    painter.end();
+
+    if (scale > 1) {
+        // Nearest neighbor for crisp pixels
+        image = image.scaled(image.width() * scale, image.height() * scale,
+                             Qt::IgnoreAspectRatio, Qt::FastTransformation);
+    }
+    return image;
+}
+
+// =============================================================================
+// BATCH RENDERING
+// =============================================================================
+
+CardRenderReport CardRasterizer::renderToFiles(const QVector<WonderCardData> &cards,
+                                               const QStringList &outputPaths, int scale) const
+{
+    CardRenderReport report;
+    report.total = qMin(cards.size(), outputPaths.size());
+    report.threadCount = qMin(threadCount(), qMax(1, report.total));
+    report.results.resize(report.total);
+
+    if (report.total == 0) {
+        return report;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Workers pull the next index from a shared cursor (see BatchInjector::run)
+    QAtomicInt cursor(0);
+    CardRenderResult *results = report.results.data();
+    int total = report.total;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(report.threadCount);
+
+    for (int worker = 0; worker < report.threadCount; ++worker) {
+        pool.start([this, &cards, &outputPaths, results, total, scale, &cursor]() {
+            int index;
+            while ((index = cursor.fetchAndAddRelaxed(1)) < total) {
+                CardRenderResult &result = results[index];
+                result.outputPath = outputPaths.at(index);
+
+                QImage image = render(cards.at(index), scale);
+                if (image.isNull()) {
+                    result.errorMessage = "No render assets loaded";
+                } else if (!image.save(result.outputPath, "PNG")) {
+                    result.errorMessage = QString("Failed to write %1").arg(result.outputPath);
+                } else {
+                    result.success = true;
+                }
+            }
+        });
+    }
+
+    pool.waitForDone();
+    report.elapsedMs = timer.elapsed();
+
+    for (const CardRenderResult &result : report.results) {
+        if (result.success) {
+            ++report.succeeded;
+        }
+    }
+
+    return report;
+}
+
+QImage CardRasterizer::renderSpriteSheet(const QVector<WonderCardData> &cards, int columns, int scale) const
+{
+    if (!m_assets || cards.isEmpty() || columns <= 0) {
+        return QImage();
+    }
+
+    scale = qMax(1, scale);
+    int cellWidth = CARD_WIDTH * scale;
+    int cellHeight = CARD_HEIGHT * scale;
+    int rows = (cards.size() + columns - 1) / columns;
+
+    QImage sheet(qMin(columns, cards.size()) * cellWidth, rows * cellHeight, QImage::Format_ARGB32);
+    if (sheet.isNull()) {
+        qWarning() << "CardRasterizer: sprite sheet too large:" << cards.size() << "cards";
+        return QImage();
+    }
+    sheet.fill(Qt::transparent);
+
+    // Cells are disjoint, so workers copy into the sheet without locking.
+    // Detach once here; workers only use the raw pointer.
+    uchar *bits = sheet.bits();
+    qsizetype bytesPerLine = sheet.bytesPerLine();
+
+    QAtomicInt cursor(0);
+    int workers = qMin(threadCount(), cards.size());
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(workers);
+
+    for (int worker = 0; worker < workers; ++worker) {
+        pool.start([this, &cards, bits, bytesPerLine, columns, cellWidth, cellHeight, scale, &cursor]() {
+            int index;
+            while ((index = cursor.fetchAndAddRelaxed(1)) < cards.size()) {
+                QImage cell = render(cards.at(index), scale);
+                if (cell.isNull()) {
+                    continue;
+                }
+
+                int copyWidth = qMin(cell.width(), cellWidth) * static_cast<int>(sizeof(QRgb));
+                int copyHeight = qMin(cell.height(), cellHeight);
+                uchar *origin = bits + (index / columns) * cellHeight * bytesPerLine
+                              + (index % columns) * cellWidth * static_cast<int>(sizeof(QRgb));
+                for (int y = 0; y < copyHeight; ++y) {
+                    std::memcpy(origin + y * bytesPerLine, cell.constScanLine(y), copyWidth);
+                }
+            }
+        });
+    }
+
+    pool.waitForDone();
+    return sheet;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file cardrasterizer.h
+ * @brief Thread-safe offscreen Wonder Card renderer for bulk previews.
+ *
+ * CardRasterizer draws a WonderCardData exactly like AuthenticWonderCardWidget
+ * (ROM background, Gen3 font, Pokemon icon) but has no QWidget or GUI-thread
+ * state. Everything it reads is held by one CardAssets set that is loaded
+ * once and never modified afterwards; rasterizers share it through a
+ * QSharedPointer, so any number of threads can render at the same time.
+ *
+ * ## Processing Model
+ * Same as BatchInjector: a QThreadPool of workers pulls card indices from an
+ * atomic cursor. Each worker renders into its own image and writes its result
+ * into a pre-sized slot (or sprite sheet cell) without locking.
+ *
+ * ## Icons
+ * Icons come from the persistent asset cache when present, otherwise from the
+ * shared SpriteCache (which decodes from the ROM on a miss and is safe to
+ * call from any thread).
+ *
+ * @see AuthenticWonderCardWidget for the interactive editor
+ * @see main_render.cpp for the command-line front end
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef CARDRASTERIZER_H
+#define CARDRASTERIZER_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QString>
+#include <QStringList>
+#include <QImage>
+#include <QVector>
+#include <QSharedPointer>
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "mysterygift.h"
+#include "gbaromreader.h"
+#include "gen3fontrenderer.h"
+#include "romassetcache.h"
+
+/// <summary>
+/// Immutable ROM (or fallback) assets shared by every rasterizer and thread.
+/// </summary>
+struct CardAssets {
+    QSharedPointer<GBAROReader> reader;            // Icon source (null in fallback mode)
+    QSharedPointer<RomAssetCache> assetCache;      // Backs cached images; null on a cache miss
+    QSharedPointer<Gen3FontRenderer> fontRenderer;
+
+    // Colored font sheets (ARGB32), used when there is no glyph atlas
+    QImage fontHeader;
+    QImage fontBody;
+    QImage fontIdHeader;
+    QImage fontIdBody;
+
+    QVector<QImage> backgrounds;   // 8 ARGB32 backgrounds (null if missing)
+    bool romFonts = false;         // Fonts (and glyph atlas) come from a ROM
+    bool fallback = false;         // Placeholder graphics, no ROM
+};
+
+/// <summary>
+/// Outcome of rendering one card to a file.
+/// </summary>
+struct CardRenderResult {
+    QString outputPath;
+    bool success = false;
+    QString errorMessage;
+};
+
+/// <summary>
+/// Aggregate results of one CardRasterizer::renderToFiles() call.
+/// </summary>
+struct CardRenderReport {
+    int total = 0;           // Cards submitted
+    int succeeded = 0;       // Cards written
+    int threadCount = 0;     // Worker threads used
+    qint64 elapsedMs = 0;    // Wall-clock time for the whole run
+    QVector<CardRenderResult> results;  // One entry per card, in input order
+
+    double cardsPerSecond() const {
+        return elapsedMs > 0 ? (total * 1000.0) / elapsedMs : 0.0;
+    }
+};
+
+/// <summary>
+/// Renders Wonder Cards offscreen, one at a time or in parallel batches.
+///
+/// USAGE:
+///   QSharedPointer<const CardAssets> assets = CardRasterizer::loadAssets(romPath, error);
+///   CardRasterizer rasterizer(assets);
+///   QImage card = rasterizer.render(wonderCard, 2);
+///   CardRenderReport report = rasterizer.renderToFiles(cards, pngPaths);
+///   QImage sheet = rasterizer.renderSpriteSheet(cards, 8);
+/// </summary>
+class CardRasterizer
+{
+public:
+    CardRasterizer();
+    explicit CardRasterizer(QSharedPointer<const CardAssets> assets);
+
+    // Asset loading (persistent asset cache first, then the ROM itself)
+    static QSharedPointer<const CardAssets> loadAssets(const QString &romPath, QString &errorMessage);
+    static QSharedPointer<const CardAssets> fallbackAssets(QString &errorMessage);
+
+    bool isValid() const { return !m_assets.isNull(); }
+    QSharedPointer<const CardAssets> assets() const { return m_assets; }
+
+    void setThreadCount(int threadCount) { m_threadCount = threadCount; }
+    int threadCount() const;
+
+    /// Render one card at scale x (nearest neighbor). Thread-safe.
+    QImage render(const WonderCardData &card, int scale = 1) const;
+
+    /// Render every card in parallel and save each as PNG to the matching path
+    CardRenderReport renderToFiles(const QVector<WonderCardData> &cards,
+                                   const QStringList &outputPaths, int scale = 1) const;
+
+    /// Render every card in parallel into one grid, row-major, columns wide
+    QImage renderSpriteSheet(const QVector<WonderCardData> &cards, int columns, int scale = 1) const;
+
+    // Layout shared with AuthenticWonderCardWidget
+    static int lineX(bool rightAligned, int lineWidth);
+    static int iconDisplaySpecies(int species, bool emerald);   // -1 = no icon
+    static QImage iconFrame(const QImage &iconSheet);           // First frame, index 0 transparent
+
+    // Layout constants (GBA screen: 240x160)
+    static const int CARD_WIDTH = 240;
+    static const int CARD_HEIGHT = 160;
+    static const int PADDING_LEFT = 8;
+    static const int SUBTITLE_RIGHT_EDGE = 160;   // Subtitle window, right-aligned
+    static const int ICON_CENTER_X = 220;
+    static const int ICON_CENTER_Y = 20;
+    static const int ICON_SIZE = 32;
+    static const int ICON_SPECIES_LIMIT = 412;    // Highest species with its own icon
+
+private:
+    static bool decodeAssetsFromROM(CardAssets &assets, QString &errorMessage);
+    static bool loadAssetsFromCache(CardAssets &assets, QString &errorMessage);
+
+    QImage icon(int species) const;
+
+    QSharedPointer<const CardAssets> m_assets;
+    int m_threadCount;       // <= 0 = QThread::idealThreadCount()
+};
+
+#endif // CARDRASTERIZER_H
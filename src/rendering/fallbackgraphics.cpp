@@ -1,4 +1,6 @@
 #include "fallbackgraphics.h"
+#include "logcategories.h"
+#include "compileddata.h"
 #include <QPainter>
 #include <QFont>
 #include <QFontMetrics>
@@ -6,6 +8,8 @@
 #include <QDebug>
 #include <QHash>
 #include <QSet>
+#include <QDataStream>
+#include <cstring>
 
 // 5x7 pixel font definitions (each character is 7 rows of 5-bit patterns)
 // Bit order: MSB is leftmost pixel
@@ -420,8 +424,8 @@ QImage FallbackGraphics::generatePlaceholderFont()
         drawGlyph(fontSheet, it.key(), it.value(), SHEET_WIDTH, SHEET_HEIGHT);
     }
 
-    qDebug() << "Generated fallback font:" << SHEET_WIDTH << "x" << SHEET_HEIGHT
-             << "with" << positions.size() << "characters";
+    qCDebug(lcRender) << "Generated fallback font:" << SHEET_WIDTH << "x" << SHEET_HEIGHT
+                      << "with" << positions.size() << "characters";
 
     return fontSheet;
 }
@@ -742,3 +746,137 @@ QImage FallbackGraphics::convertToIndexed(const QImage &source, int numColors)
 
     return indexed;
 }
+
+// Embedded placeholders (see mgi_fallbackgen / main_fallbackgen.cpp)
+
+const char FallbackGraphics::FONT_RESOURCE[] = ":/Resources/fallback_font.mgfb";
+const char FallbackGraphics::ICONS_RESOURCE[] = ":/Resources/fallback_icons.mgfb";
+const char FallbackGraphics::BACKGROUNDS_RESOURCE[] = ":/Resources/fallback_backgrounds.mgfb";
+
+static const char ASSET_MAGIC[] = "MGFB";
+static const uint32_t ASSET_FORMAT_VERSION = 1;
+static const int MAX_ASSET_DIMENSION = 4096;
+
+// Decode one embedded set; empty if it is missing or does not match
+static QVector<QImage> loadEmbeddedSet(const char *path, int expectedCount, int width, int height)
+{
+    QVector<QImage> images;
+    QString errorMessage;
+    if (!FallbackGraphics::readAssetBlob(QString::fromLatin1(path), images, errorMessage)) {
+        qCDebug(lcRender) << "No embedded fallback assets, generating at runtime:" << errorMessage;
+        return QVector<QImage>();
+    }
+    if (images.size() != expectedCount) {
+        qCDebug(lcRender) << "Embedded fallback set" << path << "has" << images.size() << "images, expected" << expectedCount;
+        return QVector<QImage>();
+    }
+    for (const QImage &image : images) {
+        if (image.width() != width || image.height() != height) {
+            qCDebug(lcRender) << "Embedded fallback set" << path << "has the wrong image size";
+            return QVector<QImage>();
+        }
+    }
+    return images;
+}
+
+QImage FallbackGraphics::placeholderFont()
+{
+    static const QVector<QImage> font = loadEmbeddedSet(FONT_RESOURCE, 1, CHARS_PER_ROW * GLYPH_WIDTH,
+                                                        16 * GLYPH_HEIGHT);
+    return font.isEmpty() ? generatePlaceholderFont() : font.first();
+}
+
+QImage FallbackGraphics::placeholderBackground(int index)
+{
+    static const QVector<QImage> backgrounds = loadEmbeddedSet(BACKGROUNDS_RESOURCE, BACKGROUND_COUNT,
+                                                               BG_WIDTH, BG_HEIGHT);
+    if (backgrounds.isEmpty()) {
+        return generatePlaceholderBackground(index);
+    }
+    return backgrounds[index % BACKGROUND_COUNT];
+}
+
+QImage FallbackGraphics::placeholderPokemonIcon(int index)
+{
+    static const QVector<QImage> icons = loadEmbeddedSet(ICONS_RESOURCE, ICON_COUNT, ICON_WIDTH, ICON_HEIGHT);
+    if (index < 0 || index >= icons.size()) {
+        return generatePlaceholderPokemonIcon(index);
+    }
+    return icons[index];
+}
+
+bool FallbackGraphics::writeAssetBlob(const QString &path, const QVector<QImage> &images, QString &errorMessage)
+{
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(CompiledData::STREAM_VERSION);
+    stream << static_cast<quint32>(images.size());
+
+    for (QImage image : images) {
+        if (image.format() != QImage::Format_Indexed8 && image.format() != QImage::Format_RGB32) {
+            image = image.convertToFormat(QImage::Format_ARGB32);
+        }
+
+        // Rows are stored unpadded
+        int rowBytes = image.width() * image.depth() / 8;
+        QByteArray pixels;
+        pixels.reserve(rowBytes * image.height());
+        for (int y = 0; y < image.height(); ++y) {
+            pixels.append(reinterpret_cast<const char*>(image.constScanLine(y)), rowBytes);
+        }
+
+        stream << static_cast<qint32>(image.format()) << static_cast<qint32>(image.width())
+               << static_cast<qint32>(image.height()) << image.colorTable() << pixels;
+    }
+
+    return CompiledData::write(path, ASSET_MAGIC, ASSET_FORMAT_VERSION, payload, errorMessage);
+}
+
+bool FallbackGraphics::readAssetBlob(const QString &path, QVector<QImage> &images, QString &errorMessage)
+{
+    QByteArray payload;
+    if (!CompiledData::read(path, ASSET_MAGIC, ASSET_FORMAT_VERSION, payload, errorMessage)) {
+        return false;
+    }
+
+    QDataStream stream(payload);
+    stream.setVersion(CompiledData::STREAM_VERSION);
+
+    quint32 count = 0;
+    stream >> count;
+    QVector<QImage> loaded;
+    loaded.reserve(static_cast<int>(qMin<quint32>(count, 4096)));
+
+    for (quint32 i = 0; i < count; ++i) {
+        qint32 format = 0;
+        qint32 width = 0;
+        qint32 height = 0;
+        QVector<QRgb> colorTable;
+        QByteArray pixels;
+        stream >> format >> width >> height >> colorTable >> pixels;
+
+        bool supported = format == QImage::Format_Indexed8 || format == QImage::Format_RGB32
+                      || format == QImage::Format_ARGB32;
+        int bytesPerPixel = (format == QImage::Format_Indexed8) ? 1 : 4;
+        if (stream.status() != QDataStream::Ok || !supported || width <= 0 || height <= 0
+            || width > MAX_ASSET_DIMENSION || height > MAX_ASSET_DIMENSION
+            || pixels.size() != width * bytesPerPixel * height) {
+            errorMessage = QString("%1: image %2 is malformed").arg(path).arg(i);
+            return false;
+        }
+
+        QImage image(width, height, static_cast<QImage::Format>(format));
+        int rowBytes = width * bytesPerPixel;
+
+        for (int y = 0; y < height; ++y) {
+            memcpy(image.scanLine(y), pixels.constData() + y * rowBytes, rowBytes);
+        }
+        if (format == QImage::Format_Indexed8) {
+            image.setColorTable(colorTable);
+        }
+        loaded.append(image);
+    }
+
+    images = loaded;
+    return true;
+}
@@ -5,6 +5,7 @@
 #include <QColor>
 #include <QByteArray>
 #include <QVector>
+#include <QString>
 
 class FallbackGraphics
 {
@@ -23,6 +24,29 @@ public:
     static constexpr int BG_WIDTH = 240;
     static constexpr int BG_HEIGHT = 160;
 
+    // Placeholder sets rendered at build time
+    static constexpr int ICON_COUNT = 413;        // Species 0-412 (CardRasterizer::ICON_SPECIES_LIMIT)
+    static constexpr int BACKGROUND_COUNT = 8;
+
+    // Embedded placeholders, written by mgi_fallbackgen at build time and
+    // decoded on first use (each set once per process). When the build did
+    // not embed them they are generated at runtime instead.
+    static QImage placeholderFont();
+    static QImage placeholderBackground(int index = 0);
+    static QImage placeholderPokemonIcon(int index = 0);
+
+    // Asset blobs (CompiledData container): Indexed8 images keep their color
+    // table and indices, RGB32/ARGB32 images their pixels, bit for bit
+    static bool writeAssetBlob(const QString &path, const QVector<QImage> &images, QString &errorMessage);
+    static bool readAssetBlob(const QString &path, QVector<QImage> &images, QString &errorMessage);
+
+    // Embedded blob paths
+    static const char FONT_RESOURCE[];
+    static const char ICONS_RESOURCE[];
+    static const char BACKGROUNDS_RESOURCE[];
+
+    // Runtime generators (used by mgi_fallbackgen, or when nothing is embedded)
+
     // Generate a simple bitmap font using Qt's built-in rendering
     // Returns an indexed image with 4 colors (matching 2bpp format)
     static QImage generatePlaceholderFont();
@@ -1,10 +1,14 @@
 #include "gen3fontrenderer.h"
+#include "logcategories.h"
+#include "tracing.h"
 #include <QDebug>
 #include <QPainter>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
+#include <cstring>
+#include <algorithm>
 
 // Text color tables from mystery_gift_show_card.c sTextColorTable
 // [background_idx, foreground_idx, shadow_idx]
@@ -17,6 +21,9 @@ Gen3FontRenderer::Gen3FontRenderer()
     , m_romReader(nullptr)
     , m_fontType(FontNormalCopy2)
 {
+    std::fill(std::begin(m_positionLut), std::end(m_positionLut), int16_t(-1));
+    std::memset(m_paletteLut, 0, sizeof(m_paletteLut));
+
     // Load default font mapping (FRLG)
     loadCharacterMappingFromJson(FontNormalCopy2);
 }
@@ -27,6 +34,7 @@ Gen3FontRenderer::~Gen3FontRenderer()
 
 bool Gen3FontRenderer::loadFromROM(GBAROReader *reader, QString &errorMessage)
 {
+    MGI_TRACE_SCOPE("Gen3FontRenderer::loadFromROM");
     if (!reader || !reader->isLoaded()) {
         errorMessage = "ROM not loaded";
         return false;
@@ -50,19 +58,19 @@ bool Gen3FontRenderer::loadFromROM(GBAROReader *reader, QString &errorMessage)
         return false;
     }
 
-    qDebug() << "Main font sheet extracted:" << m_fontSheet.width() << "x" << m_fontSheet.height();
+    qCDebug(lcRender) << "Main font sheet extracted:" << m_fontSheet.width() << "x" << m_fontSheet.height();
 
     // Extract glyph widths for main font
     m_glyphWidths = reader->getDefaultGlyphWidths();
-    qDebug() << "Loaded" << m_glyphWidths.size() << "glyph widths for main font";
+    qCDebug(lcRender) << "Loaded" << m_glyphWidths.size() << "glyph widths for main font";
 
     // For Emerald, also load FONT_NORMAL (index 1) for ID number
     if (m_isEmerald) {
         m_idFontSheet = reader->extractFontByIndex(1);  // FONT_NORMAL
         if (!m_idFontSheet.isNull()) {
-            qDebug() << "Emerald ID font sheet extracted:" << m_idFontSheet.width() << "x" << m_idFontSheet.height();
+            qCDebug(lcRender) << "Emerald ID font sheet extracted:" << m_idFontSheet.width() << "x" << m_idFontSheet.height();
             m_idGlyphWidths = reader->getGlyphWidthsByIndex(1);
-            qDebug() << "Loaded" << m_idGlyphWidths.size() << "glyph widths for ID font";
+            qCDebug(lcRender) << "Loaded" << m_idGlyphWidths.size() << "glyph widths for ID font";
         } else {
             qWarning() << "Failed to extract Emerald ID font (FONT_NORMAL), will use main font";
         }
@@ -76,12 +84,88 @@ bool Gen3FontRenderer::loadFromROM(GBAROReader *reader, QString &errorMessage)
         return false;
     }
     m_textPalette = reader->extractPalette(stdpal3Offset, 16);
-    qDebug() << "Loaded text palette with" << m_textPalette.size() << "colors";
+    qCDebug(lcRender) << "Loaded text palette with" << m_textPalette.size() << "colors";
+
+    buildAtlases();
 
     m_loaded = true;
     return true;
 }
 
+bool Gen3FontRenderer::loadFromCache(GBAROReader *reader, const RomAssetCache &cache,
+                                     QString &errorMessage)
+{
+    if (!reader || !reader->isLoaded()) {
+        errorMessage = "ROM not loaded";
+        return false;
+    }
+
+    if (!cache.isOpen()) {
+        errorMessage = "Asset cache not open";
+        return false;
+    }
+
+    m_romReader = reader;
+    m_isEmerald = reader->isEmerald();
+
+    FontType fontType = m_isEmerald ? FontShortCopy1 : FontNormalCopy2;
+    if (!loadCharacterMappingFromJson(fontType)) {
+        qWarning() << "Failed to load character mapping from JSON, using defaults";
+    }
+
+    // Font sheets are small; detach them so the renderer does not depend on
+    // the cache mapping staying alive
+    m_fontSheet = cache.image(RomAssetCache::FontSheet, 0).copy();
+    if (m_fontSheet.isNull()) {
+        errorMessage = "Asset cache has no font sheet";
+        return false;
+    }
+
+    QByteArray widths = cache.blob(RomAssetCache::GlyphWidths, 0);
+    m_glyphWidths = QVector<uint8_t>(widths.constBegin(), widths.constEnd());
+
+    m_idFontSheet = QImage();
+    m_idGlyphWidths.clear();
+    if (m_isEmerald && cache.contains(RomAssetCache::FontSheet, 1)) {
+        m_idFontSheet = cache.image(RomAssetCache::FontSheet, 1).copy();
+        QByteArray idWidths = cache.blob(RomAssetCache::GlyphWidths, 1);
+        m_idGlyphWidths = QVector<uint8_t>(idWidths.constBegin(), idWidths.constEnd());
+    }
+
+    QByteArray palette = cache.blob(RomAssetCache::TextPalette, 0);
+    if (palette.size() != 16 * static_cast<int>(sizeof(QRgb))) {
+        errorMessage = "Asset cache has no text palette";
+        return false;
+    }
+    m_textPalette.resize(16);
+    std::memcpy(m_textPalette.data(), palette.constData(), palette.size());
+
+    qCDebug(lcRender) << "Font loaded from asset cache:" << m_fontSheet.width() << "x" << m_fontSheet.height()
+                      << "," << m_glyphWidths.size() << "glyph widths";
+
+    buildAtlases();
+
+    m_loaded = true;
+    return true;
+}
+
+void Gen3FontRenderer::storeInCache(RomAssetCache::Builder &builder) const
+{
+    builder.addImage(RomAssetCache::FontSheet, 0, m_fontSheet);
+    builder.addBlob(RomAssetCache::GlyphWidths, 0,
+                    QByteArray(reinterpret_cast<const char*>(m_glyphWidths.constData()), m_glyphWidths.size()));
+
+    if (!m_idFontSheet.isNull()) {
+        builder.addImage(RomAssetCache::FontSheet, 1, m_idFontSheet);
+        builder.addBlob(RomAssetCache::GlyphWidths, 1,
+                        QByteArray(reinterpret_cast<const char*>(m_idGlyphWidths.constData()), m_idGlyphWidths.size()));
+    }
+
+    builder.addBlob(RomAssetCache::TextPalette, 0,
+                    QByteArray(reinterpret_cast<const char*>(m_textPalette.constData()),
+                               m_textPalette.size() * static_cast<int>(sizeof(QRgb))));
+}
+
 bool Gen3FontRenderer::loadCharacterMappingFromJson(FontType fontType)
 {
     QString resourcePath;
@@ -138,18 +222,34 @@ bool Gen3FontRenderer::loadCharacterMappingFromJson(const QString &resourcePath)
         // They would need special handling in text rendering
     }
 
-    qDebug() << "Loaded" << m_charToPos.size() << "character mappings from" << resourcePath;
+    rebuildPositionLut();
+
+    qCDebug(lcRender) << "Loaded" << m_charToPos.size() << "character mappings from" << resourcePath;
     return true;
 }
 
+void Gen3FontRenderer::rebuildPositionLut()
+{
+    std::fill(std::begin(m_positionLut), std::end(m_positionLut), int16_t(-1));
+    for (auto it = m_charToPos.constBegin(); it != m_charToPos.constEnd(); ++it) {
+        if (it.key().unicode() < 256) {
+            m_positionLut[it.key().unicode()] = static_cast<int16_t>(it.value());
+        }
+    }
+}
+
 int Gen3FontRenderer::getCharPosition(QChar ch) const
 {
+    ushort code = ch.unicode();
+    if (code < 256) {
+        return m_positionLut[code];
+    }
     return m_charToPos.value(ch, -1);
 }
 
 bool Gen3FontRenderer::canEncodeChar(QChar ch) const
 {
-    return m_charToPos.contains(ch);
+    return getCharPosition(ch) >= 0;
 }
 
 int Gen3FontRenderer::getEncodedLength(const QString &text) const
@@ -167,15 +267,19 @@ int Gen3FontRenderer::getEncodedLength(const QString &text) const
 
 int Gen3FontRenderer::getCharWidth(QChar ch) const
 {
-    int pos = getCharPosition(ch);
-    if (pos < 0) {
+    return glyphWidthAt(getCharPosition(ch));
+}
+
+int Gen3FontRenderer::glyphWidthAt(int position) const
+{
+    if (position < 0) {
         return 6;  // Default width for unknown characters
     }
 
     // Width index = font_position / 2 (since font positions are double-spaced)
-    int widthIndex = pos / 2;
+    int widthIndex = position / 2;
 
-    if (widthIndex >= 0 && widthIndex < m_glyphWidths.size()) {
+    if (widthIndex < m_glyphWidths.size()) {
         return m_glyphWidths[widthIndex];
     }
 
@@ -220,59 +324,98 @@ QSize Gen3FontRenderer::measureText(const QString &text, int charSpacing) const
     return QSize(width, RENDER_HEIGHT);
 }
 
-QImage Gen3FontRenderer::applyPaletteToFont(const int colorTable[3])
+// =============================================================================
+// GLYPH ATLAS & PALETTE LUTS
+// =============================================================================
+
+void Gen3FontRenderer::buildPaletteLuts()
 {
-    if (m_fontSheet.isNull() || m_textPalette.isEmpty()) {
-        return QImage();
+    // Font uses indices 0-2 for 2bpp:
+    // 0 = Background (transparent)
+    // 1 = Main glyph (foreground) -> colorTable[1]
+    // 2 = Shadow/highlight        -> colorTable[2]
+    // (3 is remapped to 0 by the font decoder)
+    const int *tables[2] = {TEXT_COLOR_TABLE_0, TEXT_COLOR_TABLE_1};
+    for (int scheme = 0; scheme < 2; ++scheme) {
+        QRgb *lut = m_paletteLut[scheme];
+        lut[0] = lut[3] = qRgba(0, 0, 0, 0);
+        for (int index = 1; index <= 2; ++index) {
+            int paletteIdx = tables[scheme][index];
+            lut[index] = (paletteIdx >= 0 && paletteIdx < m_textPalette.size())
+                             ? m_textPalette[paletteIdx] : qRgba(0, 0, 0, 0);
+        }
     }
+}
 
-    // Create a copy of the font sheet
-    QImage result(m_fontSheet.size(), QImage::Format_ARGB32);
-    result.fill(Qt::transparent);
+Gen3FontRenderer::GlyphAtlas Gen3FontRenderer::buildAtlas(const QImage &sheet)
+{
+    GlyphAtlas atlas;
+    if (sheet.isNull() || sheet.format() != QImage::Format_Indexed8) {
+        return atlas;
+    }
 
-    // Font uses indices 0-2 for 2bpp:
-    // 0 = Background (transparent)
-    // 1 = Main glyph (foreground)
-    // 2 = Shadow/highlight
-
-    // colorTable maps: [background, foreground, shadow]
-    // colorTable[0] -> palette index for background
-    // colorTable[1] -> palette index for foreground
-    // colorTable[2] -> palette index for shadow
-
-    for (int y = 0; y < m_fontSheet.height(); ++y) {
-        for (int x = 0; x < m_fontSheet.width(); ++x) {
-            int fontIdx = m_fontSheet.pixelIndex(x, y);
-
-            if (fontIdx == 0) {
-                // Background - transparent
-                result.setPixel(x, y, qRgba(0, 0, 0, 0));
-            } else if (fontIdx == 1) {
-                // Foreground
-                int paletteIdx = colorTable[1];
-                if (paletteIdx >= 0 && paletteIdx < m_textPalette.size()) {
-                    result.setPixel(x, y, m_textPalette[paletteIdx]);
-                }
-            } else if (fontIdx == 2) {
-                // Shadow
-                int paletteIdx = colorTable[2];
-                if (paletteIdx >= 0 && paletteIdx < m_textPalette.size()) {
-                    result.setPixel(x, y, m_textPalette[paletteIdx]);
-                }
+    // Same grid as getCharacter(): CHARS_PER_ROW glyphs per CHAR_HEIGHT row
+    int rows = sheet.height() / CHAR_HEIGHT;
+    atlas.glyphCount = rows * CHARS_PER_ROW;
+    atlas.pixels.fill(0, atlas.glyphCount * GLYPH_BYTES);
+
+    uint8_t *out = atlas.pixels.data();
+    for (int glyph = 0; glyph < atlas.glyphCount; ++glyph) {
+        int x0 = (glyph % CHARS_PER_ROW) * CHAR_WIDTH;
+        int y0 = (glyph / CHARS_PER_ROW) * CHAR_HEIGHT;
+        int cols = qBound(0, sheet.width() - x0, static_cast<int>(CHAR_WIDTH));
+
+        for (int y = 0; y < RENDER_HEIGHT; ++y) {
+            const uchar *src = sheet.constScanLine(y0 + y) + x0;
+            uint8_t *dst = out + glyph * GLYPH_BYTES + y * CHAR_WIDTH;
+            for (int x = 0; x < cols; ++x) {
+                dst[x] = src[x] & 0x03;
             }
         }
     }
 
+    return atlas;
+}
+
+void Gen3FontRenderer::buildAtlases()
+{
+    buildPaletteLuts();
+    m_atlas = buildAtlas(m_fontSheet);
+    m_idAtlas = buildAtlas(m_idFontSheet);
+    qCDebug(lcRender) << "Glyph atlas built:" << m_atlas.glyphCount << "glyphs,"
+                      << m_idAtlas.glyphCount << "ID font glyphs";
+}
+
+QImage Gen3FontRenderer::applyPaletteToFont(const QImage &sheet, ColorScheme scheme) const
+{
+    MGI_TRACE_SCOPE("Gen3FontRenderer::applyPaletteToFont");
+    if (sheet.isNull() || m_textPalette.isEmpty()) {
+        return QImage();
+    }
+
+    if (sheet.format() != QImage::Format_Indexed8) {
+        qWarning() << "Font sheet is not indexed, cannot apply text palette";
+        return QImage();
+    }
+
+    // One LUT lookup per pixel, written a scanline at a time
+    const QRgb *lut = m_paletteLut[scheme == TitleHeader ? 1 : 0];
+    QImage result(sheet.size(), QImage::Format_ARGB32);
+
+    for (int y = 0; y < sheet.height(); ++y) {
+        const uchar *src = sheet.constScanLine(y);
+        QRgb *dst = reinterpret_cast<QRgb*>(result.scanLine(y));
+        for (int x = 0; x < sheet.width(); ++x) {
+            dst[x] = lut[src[x] & 0x03];
+        }
+    }
+
     return result;
 }
 
 QImage Gen3FontRenderer::createColoredFont(ColorScheme scheme)
 {
-    if (scheme == TitleHeader) {
-        return applyPaletteToFont(TEXT_COLOR_TABLE_1);
-    } else {
-        return applyPaletteToFont(TEXT_COLOR_TABLE_0);
-    }
+    return applyPaletteToFont(m_fontSheet, scheme);
 }
 
 QImage Gen3FontRenderer::createColoredIdFont(ColorScheme scheme)
@@ -283,33 +426,7 @@ QImage Gen3FontRenderer::createColoredIdFont(ColorScheme scheme)
         return createColoredFont(scheme);
     }
 
-    // Apply palette to ID font sheet
-    const int *colorTable = (scheme == TitleHeader) ? TEXT_COLOR_TABLE_1 : TEXT_COLOR_TABLE_0;
-
-    QImage result(m_idFontSheet.size(), QImage::Format_ARGB32);
-    result.fill(Qt::transparent);
-
-    for (int y = 0; y < m_idFontSheet.height(); ++y) {
-        for (int x = 0; x < m_idFontSheet.width(); ++x) {
-            int fontIdx = m_idFontSheet.pixelIndex(x, y);
-
-            if (fontIdx == 0) {
-                result.setPixel(x, y, qRgba(0, 0, 0, 0));
-            } else if (fontIdx == 1) {
-                int paletteIdx = colorTable[1];
-                if (paletteIdx >= 0 && paletteIdx < m_textPalette.size()) {
-                    result.setPixel(x, y, m_textPalette[paletteIdx]);
-                }
-            } else if (fontIdx == 2) {
-                int paletteIdx = colorTable[2];
-                if (paletteIdx >= 0 && paletteIdx < m_textPalette.size()) {
-                    result.setPixel(x, y, m_textPalette[paletteIdx]);
-                }
-            }
-        }
-    }
-
-    return result;
+    return applyPaletteToFont(m_idFontSheet, scheme);
 }
 
 QImage Gen3FontRenderer::getCharacter(QChar ch, const QImage &coloredFont) const
@@ -331,7 +448,7 @@ QImage Gen3FontRenderer::getCharacter(QChar ch, const QImage &coloredFont) const
     return coloredFont.copy(x, y, CHAR_WIDTH, RENDER_HEIGHT);
 }
 
-QImage Gen3FontRenderer::renderLine(const QString &text, const QImage &coloredFont, int charSpacing)
+QImage Gen3FontRenderer::renderLine(const QString &text, const QImage &coloredFont, int charSpacing) const
 {
     QSize size = measureText(text, charSpacing);
     if (size.width() == 0) {
@@ -341,17 +458,102 @@ QImage Gen3FontRenderer::renderLine(const QString &text, const QImage &coloredFo
     QImage result(size.width(), RENDER_HEIGHT, QImage::Format_ARGB32);
     result.fill(Qt::transparent);
 
-    QPainter painter(&result);
-    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    // Blit glyph cells straight from the colored sheet (no per-glyph images)
+    QImage font = (coloredFont.format() == QImage::Format_ARGB32) ? coloredFont
+                      : coloredFont.convertToFormat(QImage::Format_ARGB32);
+    QRgb *dest = reinterpret_cast<QRgb*>(result.bits());
+    int destStride = result.bytesPerLine() / static_cast<int>(sizeof(QRgb));
 
     int xOffset = 0;
     for (const QChar &ch : text) {
-        QImage charImg = getCharacter(ch, coloredFont);
-        painter.drawImage(xOffset, 0, charImg);
-        xOffset += getCharWidth(ch) + charSpacing;
+        int pos = getCharPosition(ch);
+        if (pos >= 0) {
+            int srcX = (pos % CHARS_PER_ROW) * CHAR_WIDTH;
+            int srcY = (pos / CHARS_PER_ROW) * CHAR_HEIGHT;
+            int cols = qMin(qMin(static_cast<int>(CHAR_WIDTH), font.width() - srcX), size.width() - xOffset);
+            int rows = qMin(static_cast<int>(RENDER_HEIGHT), font.height() - srcY);
+
+            for (int y = 0; y < rows; ++y) {
+                const QRgb *src = reinterpret_cast<const QRgb*>(font.constScanLine(srcY + y)) + srcX;
+                QRgb *dst = dest + y * destStride + xOffset;
+                for (int x = 0; x < cols; ++x) {
+                    if (qAlpha(src[x])) {
+                        dst[x] = src[x];
+                    }
+                }
+            }
+        }
+        xOffset += glyphWidthAt(pos) + charSpacing;
     }
 
-    painter.end();
+    return result;
+}
+
+int Gen3FontRenderer::renderLine(const QString &text, ColorScheme scheme, QRgb *dest, int destStride,
+                                 int clipWidth, int clipHeight, int charSpacing, bool idFont) const
+{
+    const GlyphAtlas &atlas = (idFont && m_idAtlas.glyphCount > 0) ? m_idAtlas : m_atlas;
+    const QRgb *lut = m_paletteLut[scheme == TitleHeader ? 1 : 0];
+    const uint8_t *glyphs = atlas.pixels.constData();
+    int rows = qMin(clipHeight, static_cast<int>(RENDER_HEIGHT));
+    bool draw = dest && atlas.glyphCount > 0 && rows > 0;
+
+    int xOffset = 0;
+    const QChar *chars = text.constData();
+    const int length = text.length();
+    for (int i = 0; i < length; ++i) {
+        int pos = getCharPosition(chars[i]);
+        int cols = qMin(static_cast<int>(CHAR_WIDTH), clipWidth - xOffset);
+
+        if (draw && pos >= 0 && pos < atlas.glyphCount && cols > 0) {
+            const uint8_t *glyph = glyphs + pos * GLYPH_BYTES;
+            for (int y = 0; y < rows; ++y) {
+                const uint8_t *src = glyph + y * CHAR_WIDTH;
+                QRgb *dst = dest + y * destStride + xOffset;
+                for (int x = 0; x < cols; ++x) {
+                    QRgb color = lut[src[x]];
+                    if (qAlpha(color)) {
+                        dst[x] = color;
+                    }
+                }
+            }
+        }
+        xOffset += glyphWidthAt(pos) + charSpacing;
+    }
+
+    // Trailing spacing is not part of the line width (matches measureText)
+    return length > 0 ? xOffset - charSpacing : 0;
+}
+
+int Gen3FontRenderer::drawLine(QImage &target, int x, int y, const QString &text, ColorScheme scheme,
+                               int charSpacing, bool idFont) const
+{
+    if (target.format() != QImage::Format_ARGB32 && target.format() != QImage::Format_ARGB32_Premultiplied) {
+        qWarning() << "drawLine requires an ARGB32 target";
+        return measureText(text, charSpacing).width();
+    }
+
+    if (x < 0 || y < 0 || x >= target.width() || y >= target.height()) {
+        return measureText(text, charSpacing).width();
+    }
+
+    QRgb *dest = reinterpret_cast<QRgb*>(target.scanLine(y)) + x;
+    int destStride = target.bytesPerLine() / static_cast<int>(sizeof(QRgb));
+    return renderLine(text, scheme, dest, destStride, target.width() - x, target.height() - y,
+                      charSpacing, idFont);
+}
+
+QImage Gen3FontRenderer::renderLine(const QString &text, ColorScheme scheme, int charSpacing,
+                                    bool idFont) const
+{
+    QSize size = measureText(text, charSpacing);
+    QImage result(size.width(), RENDER_HEIGHT, QImage::Format_ARGB32);
+    if (size.width() == 0) {
+        return result;
+    }
+
+    result.fill(Qt::transparent);
+    drawLine(result, 0, 0, text, scheme, charSpacing, idFont);
     return result;
 }
 
@@ -408,5 +610,5 @@ void Gen3FontRenderer::setFallbackGlyphWidths(const QByteArray &widths)
         m_glyphWidths.append(static_cast<uint8_t>(widths[i]));
     }
 
-    qDebug() << "Set" << m_glyphWidths.size() << "fallback glyph widths";
+    qCDebug(lcRender) << "Set" << m_glyphWidths.size() << "fallback glyph widths";
 }
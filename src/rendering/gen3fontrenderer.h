@@ -9,6 +9,7 @@
 #include <QColor>
 #include <cstdint>
 #include "gbaromreader.h"
+#include "romassetcache.h"
 
 /**
  * @brief Renders text using ROM-extracted Gen3 Pokemon font
@@ -24,6 +25,13 @@
  * Text color tables from mystery_gift_show_card.c:
  * - Color table 0 [0, 2, 3]: for body/footer text
  * - Color table 1 [0, 1, 2]: for title/header text
+ *
+ * Glyph atlas:
+ * Once a ROM (or asset cache) is loaded, every glyph is decoded into a packed
+ * 8bpp atlas (one 2bpp color index per byte, CHAR_WIDTH x RENDER_HEIGHT per
+ * glyph) and each ColorScheme gets a 4-entry palette LUT. The scanline
+ * renderLine() overload blits glyphs straight into a caller-provided ARGB32
+ * buffer through those LUTs, with no per-glyph (or per-line) allocation.
  */
 class Gen3FontRenderer
 {
@@ -41,6 +49,10 @@ public:
     bool loadFromROM(GBAROReader *reader, QString &errorMessage);
     bool isLoaded() const { return m_loaded; }
 
+    // Initialize from a persistent asset cache (skips ROM font decoding)
+    bool loadFromCache(GBAROReader *reader, const RomAssetCache &cache, QString &errorMessage);
+    void storeInCache(RomAssetCache::Builder &builder) const;
+
     // Emerald-specific support
     bool isEmerald() const { return m_isEmerald; }
     bool hasIdFont() const { return !m_idFontSheet.isNull(); }
@@ -77,7 +89,25 @@ public:
     QImage getCharacter(QChar ch, const QImage &coloredFont) const;
 
     // Render a single line of text
-    QImage renderLine(const QString &text, const QImage &coloredFont, int charSpacing = 0);
+    QImage renderLine(const QString &text, const QImage &coloredFont, int charSpacing = 0) const;
+
+    // Glyph atlas rendering (available after loadFromROM / loadFromCache)
+    bool hasAtlas() const { return m_atlas.glyphCount > 0; }
+
+    // Blit a line into an ARGB32 buffer (destStride in pixels), clipped to
+    // clipWidth x clipHeight. Transparent pixels leave the buffer untouched.
+    // Returns the line width (same as measureText()).
+    int renderLine(const QString &text, ColorScheme scheme, QRgb *dest, int destStride,
+                   int clipWidth, int clipHeight = RENDER_HEIGHT,
+                   int charSpacing = 0, bool idFont = false) const;
+
+    // Convenience: blit into an ARGB32 image at (x, y)
+    int drawLine(QImage &target, int x, int y, const QString &text, ColorScheme scheme,
+                 int charSpacing = 0, bool idFont = false) const;
+
+    // Convenience: render into a new image sized to the text
+    QImage renderLine(const QString &text, ColorScheme scheme, int charSpacing = 0,
+                      bool idFont = false) const;
 
     // Render multi-line text area
     QImage renderTextArea(const QStringList &lines, const QImage &coloredFont,
@@ -124,12 +154,35 @@ private:
     // Character mapping: Unicode char -> font sheet position
     QMap<QChar, int> m_charToPos;
 
+    // Latin-1 fast path for getCharPosition (-1 = unmapped)
+    int16_t m_positionLut[256];
+    void rebuildPositionLut();
+
     // Text color tables: [background, foreground, shadow]
     static const int TEXT_COLOR_TABLE_0[3];  // Body/footer: [0, 2, 3]
     static const int TEXT_COLOR_TABLE_1[3];  // Title/header: [0, 1, 2]
 
-    // Apply palette remapping to font
-    QImage applyPaletteToFont(const int colorTable[3]);
+    // Packed glyph atlas: glyph N occupies GLYPH_BYTES bytes at N * GLYPH_BYTES,
+    // one 2bpp color index (0-2) per pixel, RENDER_HEIGHT rows of CHAR_WIDTH
+    struct GlyphAtlas {
+        QVector<uint8_t> pixels;
+        int glyphCount = 0;
+    };
+    static const int GLYPH_BYTES = CHAR_WIDTH * RENDER_HEIGHT;
+    GlyphAtlas m_atlas;      // Main font
+    GlyphAtlas m_idAtlas;    // Emerald ID font (empty otherwise)
+    static GlyphAtlas buildAtlas(const QImage &sheet);
+
+    // Per-ColorScheme LUT: 2bpp color index -> ARGB (alpha 0 = not drawn)
+    QRgb m_paletteLut[2][4];
+    void buildPaletteLuts();
+    void buildAtlases();
+
+    // Glyph advance for a font sheet position (-1 = unknown character)
+    int glyphWidthAt(int position) const;
+
+    // Apply a palette LUT to an indexed font sheet
+    QImage applyPaletteToFont(const QImage &sheet, ColorScheme scheme) const;
 
     // Current font type
     FontType m_fontType;
@@ -0,0 +1,93 @@
+/**
+ * @file main_fallbackgen.cpp
+ * @brief Build-time generator for the ROM-less placeholder graphics.
+ *
+ * Usage:
+ *   mgi_fallbackgen <output-dir>
+ *
+ * Renders the placeholder font sheet, the ICON_COUNT species icons and the
+ * BACKGROUND_COUNT Wonder Card backgrounds once, through the same
+ * FallbackGraphics generators the application would otherwise run on every
+ * ROM-less start, and writes them as asset blobs:
+ *
+ *   fallback_font.mgfb          1 Indexed8 sheet (256x256)
+ *   fallback_icons.mgfb         Indexed8 icons (32x32), indexed by species
+ *   fallback_backgrounds.mgfb   RGB32 backgrounds (240x160)
+ *
+ * Each blob is read back to validate it. CMake runs this and embeds the
+ * output through fallback_assets.qrc; see FallbackGraphics::placeholderFont()
+ * and friends for the loading side.
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QGuiApplication>
+#include <QTextStream>
+#include <QDir>
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "fallbackgraphics.h"
+
+int main(int argc, char *argv[])
+{
+    // Icons are painted with QPainter text; no window is ever shown
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app(argc, argv);
+    QTextStream err(stderr);
+
+    QStringList args = app.arguments().mid(1);
+    if (args.size() != 1) {
+        err << "Usage: mgi_fallbackgen <output-dir>" << Qt::endl;
+        return 2;
+    }
+
+    QDir outputDir(args.at(0));
+    if (!outputDir.mkpath(".")) {
+        err << "Failed to create " << args.at(0) << Qt::endl;
+        return 1;
+    }
+
+    QVector<QImage> icons;
+    icons.reserve(FallbackGraphics::ICON_COUNT);
+    for (int i = 0; i < FallbackGraphics::ICON_COUNT; ++i) {
+        icons.append(FallbackGraphics::generatePlaceholderPokemonIcon(i));
+    }
+
+    QVector<QImage> backgrounds;
+    for (int i = 0; i < FallbackGraphics::BACKGROUND_COUNT; ++i) {
+        backgrounds.append(FallbackGraphics::generatePlaceholderBackground(i));
+    }
+
+    const QList<QPair<QString, QVector<QImage>>> sets = {
+        {"fallback_font.mgfb", {FallbackGraphics::generatePlaceholderFont()}},
+        {"fallback_icons.mgfb", icons},
+        {"fallback_backgrounds.mgfb", backgrounds}
+    };
+
+    for (const auto &set : sets) {
+        QString path = outputDir.filePath(set.first);
+        QString errorMessage;
+        if (!FallbackGraphics::writeAssetBlob(path, set.second, errorMessage)) {
+            err << errorMessage << Qt::endl;
+            return 1;
+        }
+
+        // Read back, so a broken blob fails the build instead of the first ROM-less run
+        QVector<QImage> check;
+        if (!FallbackGraphics::readAssetBlob(path, check, errorMessage) || check.size() != set.second.size()) {
+            err << "Validation failed for " << path << ": " << errorMessage << Qt::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
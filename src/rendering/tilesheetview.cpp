@@ -0,0 +1,304 @@
+/**
+ * @file tilesheetview.cpp
+ * @brief Implementation of the virtualized tile sheet view.
+ *
+ * @see tilesheetview.h for the band/caching model
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "tilesheetview.h"
+#include "tilecompositor.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QPainter>
+#include <QPaintEvent>
+#include <QScrollBar>
+
+namespace {
+
+// 2bpp font colors (as GBAROReader::extractFont2bpp shows them, opaque)
+const QVector<QRgb> &fontPalette2bpp()
+{
+    static const QVector<QRgb> palette = {
+        qRgb(144, 200, 255),   // 0: Background
+        qRgb(56, 56, 56),      // 1: Foreground
+        qRgb(216, 216, 216),   // 2: Shadow
+        qRgb(144, 200, 255)    // 3: Glyph background
+    };
+    return palette;
+}
+
+// Stand-in until a palette is set
+QVector<QRgb> grayscalePalette()
+{
+    QVector<QRgb> palette;
+    for (int i = 0; i < 16; ++i) {
+        palette.append(qRgb(i * 17, i * 17, i * 17));
+    }
+    return palette;
+}
+
+const QColor BACKGROUND_COLOR(0x30, 0x30, 0x30);
+const QColor PLACEHOLDER_COLOR(0x40, 0x40, 0x40);
+}
+
+// =============================================================================
+// CONSTRUCTOR & DESTRUCTOR
+// =============================================================================
+
+TileSheetView::TileSheetView(QWidget *parent)
+    : QAbstractScrollArea(parent)
+    , m_sourceKey(0)
+    , m_phase(0)
+    , m_columns(16)
+    , m_bpp(4)
+    , m_scale(2)
+    , m_palette(grayscalePalette())
+    , m_paletteKey(0)
+    , m_bands(CACHE_COST_KB)
+{
+    verticalScrollBar()->setSingleStep(1);
+    horizontalScrollBar()->setSingleStep(8);
+}
+
+TileSheetView::~TileSheetView()
+{
+    // Workers read m_source; nothing may outlive the view
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+// =============================================================================
+// SETTINGS
+// =============================================================================
+
+void TileSheetView::setSource(const QByteArray &source, uint32_t sourceKey)
+{
+    m_source = source;
+    m_sourceKey = sourceKey;
+    dropQueuedBands();
+    updateScrollBars();
+    viewport()->update();
+}
+
+void TileSheetView::setSheetLayout(int columns, int bpp)
+{
+    uint32_t top = topOffset();
+    m_columns = qMax(1, columns);
+    m_bpp = (bpp == 2) ? 2 : 4;
+    dropQueuedBands();
+    scrollToOffset(top);
+}
+
+void TileSheetView::setTilePalette(const QVector<QRgb> &palette, uint32_t paletteKey)
+{
+    if (palette.size() < 16) {
+        return;
+    }
+    m_palette = palette;
+    m_paletteKey = paletteKey;
+    dropQueuedBands();
+    viewport()->update();
+}
+
+void TileSheetView::setScale(int scale)
+{
+    uint32_t top = topOffset();
+    m_scale = qMax(1, scale);
+    scrollToOffset(top);
+}
+
+// =============================================================================
+// SCROLLING
+// =============================================================================
+
+int TileSheetView::rowCount() const
+{
+    qint64 bytes = m_source.size() - static_cast<qint64>(m_phase);
+    return bytes > 0 ? static_cast<int>((bytes + rowBytes() - 1) / rowBytes()) : 0;
+}
+
+uint32_t TileSheetView::topOffset() const
+{
+    return m_phase + static_cast<uint32_t>(verticalScrollBar()->value()) * rowBytes();
+}
+
+void TileSheetView::scrollToOffset(uint32_t offset)
+{
+    uint32_t previous = topOffset();
+    m_phase = offset % rowBytes();
+    updateScrollBars();
+
+    int row = static_cast<int>(offset / rowBytes());
+    if (verticalScrollBar()->value() != row) {
+        verticalScrollBar()->setValue(row);   // scrollContentsBy() notifies
+    } else if (previous != topOffset()) {
+        emit topOffsetChanged(topOffset());
+    }
+    viewport()->update();
+}
+
+void TileSheetView::updateScrollBars()
+{
+    int rowPixels = 8 * m_scale;
+    int visibleRows = qMax(1, viewport()->height() / rowPixels);
+    verticalScrollBar()->setPageStep(visibleRows);
+    // The last row may start at the top, so the end of the ROM is reachable
+    verticalScrollBar()->setRange(0, qMax(0, rowCount() - 1));
+
+    int sheetWidth = m_columns * 8 * m_scale;
+    horizontalScrollBar()->setPageStep(viewport()->width());
+    horizontalScrollBar()->setRange(0, qMax(0, sheetWidth - viewport()->width()));
+}
+
+void TileSheetView::resizeEvent(QResizeEvent *event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollBars();
+}
+
+void TileSheetView::scrollContentsBy(int dx, int dy)
+{
+    Q_UNUSED(dx);
+
+    if (dy != 0) {
+        // Bands queued for rows that just left the screen are not worth decoding
+        dropQueuedBands();
+        emit topOffsetChanged(topOffset());
+    }
+    viewport()->update();
+}
+
+// =============================================================================
+// BAND STREAMING
+// =============================================================================
+
+uint32_t TileSheetView::bandOffset(int band) const
+{
+    return m_phase + static_cast<uint32_t>(band) * BAND_ROWS * rowBytes();
+}
+
+TileSheetView::BandKey TileSheetView::bandKey(int band) const
+{
+    return BandKey((static_cast<quint64>(m_sourceKey) << 32) | bandOffset(band),
+                   (static_cast<quint64>(m_paletteKey) << 32) | (static_cast<quint64>(m_columns) << 8) | m_bpp);
+}
+
+void TileSheetView::requestBand(int band)
+{
+    BandKey key = bandKey(band);
+    if (m_pending.contains(key) || m_bands.contains(key)) {
+        return;
+    }
+    m_pending.insert(key);
+
+    QByteArray source = m_source;
+    qint64 offset = bandOffset(band);
+    int columns = m_columns;
+    int bpp = m_bpp;
+    int rows = qMin(BAND_ROWS, rowCount() - band * BAND_ROWS);
+    QVector<QRgb> palette = m_palette;
+
+    m_pool.start([this, key, source, offset, columns, bpp, rows, palette]() {
+        QImage image = decodeRows(source, offset, columns, bpp, rows, palette);
+        QMetaObject::invokeMethod(this, [this, key, image]() {
+            m_pending.remove(key);
+            int costKb = qMax(1, static_cast<int>(static_cast<qint64>(image.bytesPerLine()) * image.height() / 1024));
+            m_bands.insert(key, new QImage(image), costKb);
+            viewport()->update();
+        }, Qt::QueuedConnection);
+    });
+}
+
+void TileSheetView::dropQueuedBands()
+{
+    // Decodes already running still land in the cache (their keys stay valid)
+    m_pool.clear();
+    m_pending.clear();
+}
+
+QImage TileSheetView::decodeRows(const QByteArray &source, qint64 offset, int columns, int bpp,
+                                 int rows, const QVector<QRgb> &palette)
+{
+    if (rows <= 0 || columns <= 0) {
+        return QImage();
+    }
+
+    const int tileBytes = (bpp == 4) ? 32 : 16;
+    const uint8_t *data = reinterpret_cast<const uint8_t*>(source.constData());
+    const qint64 size = source.size();
+
+    TileCompositor::Framebuffer fb(columns * 8, rows * 8);
+    for (int i = 0; i < rows * columns; ++i) {
+        qint64 position = offset + static_cast<qint64>(i) * tileBytes;
+        if (position + tileBytes > size) {
+            break;
+        }
+        uint8_t *dest = fb.scanLine((i / columns) * 8) + (i % columns) * 8;
+        if (bpp == 4) {
+            TileCompositor::decodeTile4bpp(data + position, dest, fb.width);
+        } else {
+            TileCompositor::decodeTile2bpp(data + position, dest, fb.width);
+        }
+    }
+
+    TileCompositor::PaletteLut lut;
+    TileCompositor::paletteLut(bpp == 4 ? palette : fontPalette2bpp(), lut);
+    return TileCompositor::toArgb(fb, lut);
+}
+
+QImage TileSheetView::renderRows(uint32_t offset, int rowCount) const
+{
+    return decodeRows(m_source, offset, m_columns, m_bpp, rowCount, m_palette);
+}
+
+// =============================================================================
+// PAINTING
+// =============================================================================
+
+void TileSheetView::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(viewport());
+    painter.fillRect(event->rect(), BACKGROUND_COLOR);
+
+    int rows = rowCount();
+    if (rows == 0) {
+        return;
+    }
+
+    int rowPixels = 8 * m_scale;
+    int firstRow = verticalScrollBar()->value();
+    int visibleRows = viewport()->height() / rowPixels + 1;
+    int lastBandIndex = (rows - 1) / BAND_ROWS;
+    int firstBand = firstRow / BAND_ROWS;
+    int lastBand = qMin((firstRow + visibleRows) / BAND_ROWS, lastBandIndex);
+    int x = -horizontalScrollBar()->value();
+    int sheetWidth = m_columns * 8 * m_scale;
+
+    for (int band = firstBand; band <= lastBand; ++band) {
+        int y = (band * BAND_ROWS - firstRow) * rowPixels;
+
+        if (const QImage *image = m_bands.object(bandKey(band))) {
+            painter.drawImage(QRect(x, y, image->width() * m_scale, image->height() * m_scale), *image);
+        } else {
+            int bandRows = qMin(BAND_ROWS, rows - band * BAND_ROWS);
+            painter.fillRect(QRect(x, y, sheetWidth, bandRows * rowPixels), PLACEHOLDER_COLOR);
+            requestBand(band);
+        }
+    }
+
+    // Prefetch one band each way so slow scrolling never shows placeholders
+    if (firstBand > 0) {
+        requestBand(firstBand - 1);
+    }
+    if (lastBand < lastBandIndex) {
+        requestBand(lastBand + 1);
+    }
+}
@@ -0,0 +1,133 @@
+/**
+ * @file tilesheetview.h
+ * @brief Virtualized, tile-streamed view of raw GBA tile data.
+ *
+ * TileSheetView shows a whole byte source (the ROM, or a decompressed LZ77
+ * stream) as one tall sheet of 8x8 tiles, without ever building an image of
+ * the whole sheet. The sheet is cut into bands of BAND_ROWS tile rows:
+ *
+ * - Only bands intersecting the viewport (plus one above and below) are
+ *   requested; everything else costs nothing.
+ * - Bands are decoded on a worker pool through TileCompositor and posted
+ *   back to the GUI thread; until then the band is drawn as a placeholder.
+ * - Decoded bands live in a QCache keyed by (source, band offset, bpp,
+ *   columns, palette), so scrolling back, or toggling a setting back, is a
+ *   straight blit. Queued decodes that scrolled out of view are dropped.
+ *
+ * The vertical scroll bar counts tile rows, so a 32 MB ROM at 2bpp stays
+ * well inside the int range.
+ *
+ * ## Thread Safety
+ * Workers only read the source QByteArray (a shared copy, or a raw view
+ * over the ROM mapping that the owner keeps alive) and the palette copy
+ * captured with the request. The owner must keep the source alive until the
+ * view is destroyed (the destructor joins the workers).
+ *
+ * @see TileViewer for the dialog around the view
+ * @see TileCompositor for the tile decoders
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef TILESHEETVIEW_H
+#define TILESHEETVIEW_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QAbstractScrollArea>
+#include <QByteArray>
+#include <QVector>
+#include <QImage>
+#include <QCache>
+#include <QPair>
+#include <QSet>
+#include <QThreadPool>
+#include <cstdint>
+
+/**
+ * @class TileSheetView
+ * @brief Scrollable sheet of 4bpp/2bpp tiles, decoded band by band in the background.
+ *
+ * USAGE:
+ *   view->setSource(QByteArray::fromRawData(rom, romSize), 0);
+ *   view->setSheetLayout(16, 4);
+ *   view->setTilePalette(reader->extractPalette(paletteOffset), paletteOffset);
+ *   view->scrollToOffset(0x467FBC);
+ */
+class TileSheetView : public QAbstractScrollArea
+{
+    Q_OBJECT
+
+public:
+    explicit TileSheetView(QWidget *parent = nullptr);
+    ~TileSheetView();
+
+    // Bytes to display. sourceKey identifies the contents in the band cache
+    // (use a new key whenever different bytes are passed).
+    void setSource(const QByteArray &source, uint32_t sourceKey);
+
+    // 8x8 tiles per row and bits per pixel (4 or 2)
+    void setSheetLayout(int columns, int bpp);
+
+    // 16-color palette for 4bpp tiles; paletteKey identifies it in the cache
+    void setTilePalette(const QVector<QRgb> &palette, uint32_t paletteKey);
+
+    // Display scale (integer zoom)
+    void setScale(int scale);
+
+    // Scroll so that the row starting at offset is at the top. Rows are
+    // aligned to offset, so unaligned offsets keep their phase.
+    void scrollToOffset(uint32_t offset);
+    uint32_t topOffset() const;
+    int rowBytes() const { return m_columns * bytesPerTile(); }
+
+    // Synchronous decode of rowCount rows starting at offset (1x scale), for saving
+    QImage renderRows(uint32_t offset, int rowCount) const;
+
+    // Constants
+    static const int BAND_ROWS = 16;                 // Tile rows per decoded band
+    static const int CACHE_COST_KB = 64 * 1024;      // Band cache budget (decoded ARGB)
+
+signals:
+    // The top visible row changed (scrolling or scrollToOffset)
+    void topOffsetChanged(uint32_t offset);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void scrollContentsBy(int dx, int dy) override;
+
+private:
+    typedef QPair<quint64, quint64> BandKey;   // (source << 32 | offset, palette << 32 | columns << 8 | bpp)
+
+    int bytesPerTile() const { return m_bpp == 4 ? 32 : 16; }
+    int rowCount() const;
+    uint32_t bandOffset(int band) const;
+    BandKey bandKey(int band) const;
+    void requestBand(int band);
+    void dropQueuedBands();
+    void updateScrollBars();
+
+    // Decode rows of tiles into an ARGB image (any thread)
+    static QImage decodeRows(const QByteArray &source, qint64 offset, int columns, int bpp,
+                             int rows, const QVector<QRgb> &palette);
+
+    // Sheet
+    QByteArray m_source;
+    uint32_t m_sourceKey;
+    uint32_t m_phase;          // Offset of row 0 (topOffset() modulo rowBytes())
+    int m_columns;
+    int m_bpp;
+    int m_scale;
+    QVector<QRgb> m_palette;
+    uint32_t m_paletteKey;
+
+    // Streaming
+    QCache<BandKey, QImage> m_bands;
+    QSet<BandKey> m_pending;   // Requested, not yet inserted
+    QThreadPool m_pool;
+};
+
+#endif // TILESHEETVIEW_H
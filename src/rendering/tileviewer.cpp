@@ -1,4 +1,5 @@
 #include "tileviewer.h"
+#include "logcategories.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
@@ -6,6 +7,8 @@
 #include <QFileDialog>
 #include <QMessageBox>
 #include <QPainter>
+#include <QGuiApplication>
+#include <QClipboard>
 #include <QDebug>
 
 TileViewer::TileViewer(GBAROReader *romReader, QWidget *parent)
@@ -17,20 +20,31 @@ TileViewer::TileViewer(GBAROReader *romReader, QWidget *parent)
       m_tilesPerPage(256),
       m_tileWidth(8),
       m_tileHeight(8),
-      m_bpp(4)
+      m_bpp(4),
+      m_scanProgress(0),
+      m_cancelScan(0),
+      m_scanning(false),
+      m_scanTimer(nullptr),
+      m_previewActive(false),
+      m_previewOffset(0),
+      m_previewGeneration(0)
 {
     setupUI();
+    loadScanIndex();
     updateDisplay();
 }
 
 TileViewer::~TileViewer()
 {
+    // Workers reference the reader and this dialog; stop and join them first
+    m_cancelScan.storeRelaxed(1);
+    m_pool.waitForDone();
 }
 
 void TileViewer::setupUI()
 {
     setWindowTitle("GBA ROM Tile Viewer");
-    resize(800, 700);
+    resize(1080, 700);
 
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
 
@@ -39,15 +53,16 @@ void TileViewer::setupUI()
     m_infoLabel->setStyleSheet("background-color: #f0f0f0; padding: 5px; border: 1px solid #ccc;");
     mainLayout->addWidget(m_infoLabel);
 
-    // Tile display area (scrollable)
-    m_scrollArea = new QScrollArea();
-    m_scrollArea->setWidgetResizable(false);
-    m_scrollArea->setStyleSheet("background-color: #303030;");
+    // Tile display area (virtualized; only visible rows are decoded)
+    m_sheetView = new TileSheetView();
+    m_sheetView->setScale(2);
+    connect(m_sheetView, &TileSheetView::topOffsetChanged, this, &TileViewer::onSheetScrolled);
 
-    m_tileDisplay = new QLabel();
-    m_tileDisplay->setAlignment(Qt::AlignCenter);
-    m_scrollArea->setWidget(m_tileDisplay);
-    mainLayout->addWidget(m_scrollArea, 1);
+    // Tiles on the left, ROM index on the right
+    QHBoxLayout *viewLayout = new QHBoxLayout();
+    viewLayout->addWidget(m_sheetView, 1);
+    viewLayout->addWidget(createIndexPanel());
+    mainLayout->addLayout(viewLayout, 1);
 
     // Controls panel
     QGroupBox *controlsGroup = new QGroupBox("Controls");
@@ -151,8 +166,11 @@ void TileViewer::updateDisplay()
     m_bpp = m_bppCombo->currentData().toInt();
 
     renderTiles();
+    updateInfoLabel();
+}
 
-    // Update info label
+void TileViewer::updateInfoLabel()
+{
     QString info = QString("Offset: 0x%1 | Palette: 0x%2 | %3bpp | Tile Size: %4x%5 | Tiles: %6")
                        .arg(m_currentOffset, 8, 16, QChar('0'))
                        .arg(m_paletteOffset, 8, 16, QChar('0'))
@@ -160,49 +178,53 @@ void TileViewer::updateDisplay()
                        .arg(m_tileWidth)
                        .arg(m_tileHeight)
                        .arg(m_tilesPerPage);
+    if (m_previewActive) {
+        info = QString("LZ77 at 0x%1 (%2 bytes decompressed, shown as 4bpp) | Palette: 0x%3 | Tiles: %4")
+                   .arg(m_previewOffset, 8, 16, QChar('0'))
+                   .arg(m_previewData.size())
+                   .arg(m_paletteOffset, 8, 16, QChar('0'))
+                   .arg(m_tilesPerPage);
+    }
     m_infoLabel->setText(info);
 }
 
 void TileViewer::renderTiles()
 {
-    // Calculate image dimensions
-    int tilesX = m_tilesPerRow;
-    int tilesY = (m_tilesPerPage + tilesX - 1) / tilesX;
-    int imageWidth = tilesX * m_tileWidth;
-    int imageHeight = tilesY * m_tileHeight;
-
-    QImage tileImage;
-
-    if (m_bpp == 4) {
-        // 4bpp mode - use palette from ROM
-        QVector<QRgb> palette = m_romReader->extractPalette(m_paletteOffset, 16);
-        tileImage = m_romReader->extractTile4bpp(m_currentOffset, palette, imageWidth, imageHeight);
+    // Point the sheet at the current source; it decodes visible bands itself.
+    // A row holds m_tilesPerRow tiles of m_tileWidth pixels, as 8x8 tiles
+    int columns = m_tilesPerRow * m_tileWidth / 8;
+
+    if (m_previewActive) {
+        // LZ77 previews always decode as 4bpp (compressed Gen3 graphics are).
+        // Bit 31 keeps preview cache keys apart from ROM offsets (< 32 MB)
+        m_sheetView->setSource(m_previewData, 0x80000000u | m_previewOffset);
+        m_sheetView->setSheetLayout(columns, 4);
     } else {
-        // 2bpp mode - extract font-style tiles
-        // Calculate number of 8x8 tiles needed
-        int tileColumns = imageWidth / 8;
-        int tileRows = imageHeight / 8;
-        int numChars = tileColumns * tileRows;
-
-        tileImage = m_romReader->extractFont2bpp(m_currentOffset, numChars, 8, 8, tileColumns);
+        m_sheetView->setSource(QByteArray::fromRawData(reinterpret_cast<const char*>(m_romReader->romBytes()),
+                                                       static_cast<int>(m_romReader->romSize())), 0);
+        m_sheetView->setSheetLayout(columns, m_bpp);
     }
 
-    if (tileImage.isNull()) {
-        m_tileDisplay->setText("Failed to extract tiles");
+    m_sheetView->setTilePalette(m_romReader->extractPalette(m_paletteOffset, 16), m_paletteOffset);
+    m_sheetView->scrollToOffset(m_previewActive ? 0 : m_currentOffset);
+}
+
+void TileViewer::onSheetScrolled(uint32_t offset)
+{
+    // The sheet scrolls through the whole ROM; keep the offset field in step
+    if (m_previewActive) {
         return;
     }
 
-    // Convert to RGB for display (indexed images don't display well in Qt sometimes)
-    QImage rgbImage = tileImage.convertToFormat(QImage::Format_RGB888);
-
-    // Scale up for better visibility (2x)
-    m_currentImage = QPixmap::fromImage(rgbImage.scaled(imageWidth * 2, imageHeight * 2, Qt::KeepAspectRatio, Qt::FastTransformation));
-    m_tileDisplay->setPixmap(m_currentImage);
-    m_tileDisplay->adjustSize();
+    m_currentOffset = offset;
+    m_offsetInput->setText(QString::number(m_currentOffset, 16).toUpper());
+    updateInfoLabel();
 }
 
 void TileViewer::onPrevPage()
 {
+    leavePreview();
+
     // Calculate bytes per page based on bpp mode
     // 4bpp: 32 bytes per 8x8 tile, 2bpp: 16 bytes per 8x8 tile
     int bytesPerTile = (m_bpp == 4) ? 32 : 16;
@@ -221,6 +243,8 @@ void TileViewer::onPrevPage()
 
 void TileViewer::onNextPage()
 {
+    leavePreview();
+
     // Calculate bytes per page based on bpp mode
     // 4bpp: 32 bytes per 8x8 tile, 2bpp: 16 bytes per 8x8 tile
     int bytesPerTile = (m_bpp == 4) ? 32 : 16;
@@ -244,6 +268,7 @@ void TileViewer::onJumpToOffset()
     uint32_t newOffset = m_offsetInput->text().toUInt(&ok, 16);
 
     if (ok && newOffset < static_cast<uint32_t>(m_romReader->romSize())) {
+        leavePreview();
         m_currentOffset = newOffset;
         updateDisplay();
     } else {
@@ -268,21 +293,332 @@ void TileViewer::onPaletteOffsetChanged()
 
 void TileViewer::onSaveImage()
 {
-    if (m_currentImage.isNull()) {
+    // One page (m_tilesPerPage tiles) from the top of the view, at the 2x display scale
+    int tilesY = (m_tilesPerPage + m_tilesPerRow - 1) / m_tilesPerRow;
+    int imageWidth = m_tilesPerRow * m_tileWidth;
+    int imageHeight = tilesY * m_tileHeight;
+    QImage page = m_sheetView->renderRows(m_sheetView->topOffset(), imageHeight / 8);
+    if (page.isNull()) {
         QMessageBox::warning(this, "No Image", "No tiles to save");
         return;
     }
+    QImage scaled = page.scaled(imageWidth * 2, imageHeight * 2, Qt::KeepAspectRatio, Qt::FastTransformation);
 
-    QString defaultName = QString("tiles_0x%1.png").arg(m_currentOffset, 8, 16, QChar('0'));
+    QString defaultName = QString(m_previewActive ? "lz77_0x%1.png" : "tiles_0x%1.png")
+                              .arg(m_previewActive ? m_previewOffset : m_currentOffset, 8, 16, QChar('0'));
     QString fileName = QFileDialog::getSaveFileName(this, "Save Tile Image",
                                                      defaultName,
                                                      "PNG Images (*.png)");
 
     if (!fileName.isEmpty()) {
-        if (m_currentImage.save(fileName)) {
+        if (scaled.save(fileName)) {
             QMessageBox::information(this, "Saved", QString("Tiles saved to %1").arg(fileName));
         } else {
             QMessageBox::warning(this, "Save Failed", "Failed to save image");
         }
     }
 }
+
+// =============================================================================
+// ROM INDEX
+// =============================================================================
+
+QWidget *TileViewer::createIndexPanel()
+{
+    QGroupBox *indexGroup = new QGroupBox("ROM Index");
+    indexGroup->setFixedWidth(280);
+    QVBoxLayout *indexLayout = new QVBoxLayout(indexGroup);
+
+    m_scanButton = new QPushButton("Scan ROM");
+    connect(m_scanButton, &QPushButton::clicked, this, &TileViewer::onScanRom);
+    indexLayout->addWidget(m_scanButton);
+
+    m_scanStatusLabel = new QLabel("Not scanned yet");
+    m_scanStatusLabel->setWordWrap(true);
+    indexLayout->addWidget(m_scanStatusLabel);
+
+    // Filters
+    QHBoxLayout *filterLayout = new QHBoxLayout();
+    m_hitKindCombo = new QComboBox();
+    m_hitKindCombo->addItem("All", RomScanIndex::ALL_KINDS);
+    m_hitKindCombo->addItem("LZ77", 1 << RomScanHit::Lz77);
+    m_hitKindCombo->addItem("Palettes", 1 << RomScanHit::Palette);
+    m_hitKindCombo->addItem("Pointer tables", 1 << RomScanHit::PointerTable);
+    connect(m_hitKindCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &TileViewer::populateHitList);
+    filterLayout->addWidget(m_hitKindCombo, 1);
+
+    m_referencedOnlyCheck = new QCheckBox("Referenced");
+    m_referencedOnlyCheck->setToolTip("Only hits that some ROM pointer points at");
+    connect(m_referencedOnlyCheck, &QCheckBox::toggled, this, &TileViewer::populateHitList);
+    filterLayout->addWidget(m_referencedOnlyCheck);
+    indexLayout->addLayout(filterLayout);
+
+    // Hits (tens of thousands of rows; uniform sizes keep the list cheap)
+    m_hitList = new QListWidget();
+    m_hitList->setUniformItemSizes(true);
+    m_hitList->setFont(QFont("Courier New", 9));
+    connect(m_hitList, &QListWidget::currentRowChanged, this, &TileViewer::onHitSelected);
+    indexLayout->addWidget(m_hitList, 1);
+
+    // Hit navigation
+    QHBoxLayout *hitNavLayout = new QHBoxLayout();
+    m_prevHitButton = new QPushButton("◄ Hit");
+    m_nextHitButton = new QPushButton("Hit ►");
+    m_copyOffsetButton = new QPushButton("Copy Offset");
+    m_copyOffsetButton->setToolTip("Copy the selected offset in gen3_rom_data.yaml notation");
+    connect(m_prevHitButton, &QPushButton::clicked, this, &TileViewer::onPrevHit);
+    connect(m_nextHitButton, &QPushButton::clicked, this, &TileViewer::onNextHit);
+    connect(m_copyOffsetButton, &QPushButton::clicked, this, &TileViewer::onCopyHitOffset);
+    hitNavLayout->addWidget(m_prevHitButton);
+    hitNavLayout->addWidget(m_nextHitButton);
+    hitNavLayout->addWidget(m_copyOffsetButton);
+    indexLayout->addLayout(hitNavLayout);
+
+    m_scanTimer = new QTimer(this);
+    m_scanTimer->setInterval(100);
+    connect(m_scanTimer, &QTimer::timeout, this, &TileViewer::onScanProgress);
+
+    return indexGroup;
+}
+
+void TileViewer::loadScanIndex()
+{
+    if (!m_romReader || !m_romReader->isLoaded()) {
+        m_scanButton->setEnabled(false);
+        return;
+    }
+
+    QString error;
+    if (!m_scanIndex.load(m_romReader->md5(), error)) {
+        qCDebug(lcRom) << "TileViewer: no scan index:" << error;
+        return;
+    }
+
+    m_scanButton->setText("Rescan ROM");
+    m_scanStatusLabel->setText(QString("%1 LZ77, %2 palettes, %3 pointer tables (saved index)")
+                                   .arg(m_scanIndex.count(RomScanHit::Lz77))
+                                   .arg(m_scanIndex.count(RomScanHit::Palette))
+                                   .arg(m_scanIndex.count(RomScanHit::PointerTable)));
+    populateHitList();
+}
+
+void TileViewer::onScanRom()
+{
+    if (m_scanning) {
+        m_cancelScan.storeRelaxed(1);
+        return;
+    }
+
+    m_scanning = true;
+    m_scanProgress.storeRelaxed(0);
+    m_cancelScan.storeRelaxed(0);
+    m_scanButton->setText("Cancel Scan");
+    m_scanStatusLabel->setText("Scanning... 0%");
+    m_scanTimer->start();
+
+    // The scanner fans out over its own pool; this worker just waits for it
+    GBAROReader *reader = m_romReader;
+    m_pool.start([this, reader]() {
+        RomScanIndex index = RomScanner::scan(*reader, RomScanner::Options(), &m_scanProgress, &m_cancelScan);
+        bool cancelled = m_cancelScan.loadRelaxed() != 0;
+        QMetaObject::invokeMethod(this, [this, index, cancelled]() { onScanFinished(index, cancelled); },
+                                  Qt::QueuedConnection);
+    });
+}
+
+void TileViewer::onScanProgress()
+{
+    qint64 total = qMax<qint64>(1, m_romReader->romSize());
+    int percent = static_cast<int>(qMin<qint64>(100, m_scanProgress.loadRelaxed() * 100 / total));
+    m_scanStatusLabel->setText(QString("Scanning... %1%").arg(percent));
+}
+
+void TileViewer::onScanFinished(const RomScanIndex &index, bool cancelled)
+{
+    m_scanning = false;
+    m_scanTimer->stop();
+    m_scanButton->setText(m_scanIndex.isEmpty() && cancelled ? "Scan ROM" : "Rescan ROM");
+
+    if (cancelled) {
+        // Keep whatever index was shown before
+        m_scanStatusLabel->setText("Scan cancelled");
+        return;
+    }
+
+    m_scanIndex = index;
+
+    QString error;
+    if (!m_scanIndex.save(error)) {
+        qWarning() << "TileViewer: failed to save scan index:" << error;
+    }
+
+    m_scanStatusLabel->setText(QString("%1 LZ77, %2 palettes, %3 pointer tables")
+                                   .arg(m_scanIndex.count(RomScanHit::Lz77))
+                                   .arg(m_scanIndex.count(RomScanHit::Palette))
+                                   .arg(m_scanIndex.count(RomScanHit::PointerTable)));
+    populateHitList();
+}
+
+bool TileViewer::hitPassesFilter(const RomScanHit &hit) const
+{
+    int kindMask = m_hitKindCombo->currentData().toInt();
+    if (!(kindMask & (1 << hit.kind))) {
+        return false;
+    }
+    return !m_referencedOnlyCheck->isChecked() || hit.isReferenced();
+}
+
+void TileViewer::populateHitList()
+{
+    m_hitList->blockSignals(true);
+    m_hitList->clear();
+    m_hitRows.clear();
+
+    for (int i = 0; i < m_scanIndex.hits.size(); ++i) {
+        const RomScanHit &hit = m_scanIndex.hits.at(i);
+        if (!hitPassesFilter(hit)) {
+            continue;
+        }
+
+        QString detail;
+        switch (hit.kind) {
+            case RomScanHit::Lz77:
+                detail = QString("LZ77    %1 -> %2 B").arg(hit.length).arg(hit.size);
+                break;
+            case RomScanHit::Palette:
+                detail = QString("Palette");
+                break;
+            case RomScanHit::PointerTable:
+                detail = QString("Table   %1 x %2 B").arg(hit.size).arg(hit.stride);
+                break;
+            default:
+                break;
+        }
+
+        // "*" marks hits some ROM pointer points at
+        QString offset = QString::number(hit.offset, 16).toUpper().rightJustified(6, QChar('0'));
+        QListWidgetItem *item = new QListWidgetItem(
+            QString("%1 0x%2  %3").arg(hit.isReferenced() ? "*" : " ", offset, detail), m_hitList);
+        item->setData(Qt::UserRole, i);
+        m_hitRows.insert(i, m_hitList->count() - 1);
+    }
+
+    m_hitList->blockSignals(false);
+    m_prevHitButton->setEnabled(m_hitList->count() > 0);
+    m_nextHitButton->setEnabled(m_hitList->count() > 0);
+    m_copyOffsetButton->setEnabled(false);
+}
+
+void TileViewer::onHitSelected(int row)
+{
+    QListWidgetItem *item = m_hitList->item(row);
+    m_copyOffsetButton->setEnabled(item != nullptr);
+    if (!item) {
+        return;
+    }
+
+    showHit(m_scanIndex.hits.at(item->data(Qt::UserRole).toInt()));
+}
+
+void TileViewer::showHit(const RomScanHit &hit)
+{
+    switch (hit.kind) {
+        case RomScanHit::Palette:
+            // Recolor whatever is on screen with the palette
+            m_paletteOffset = hit.offset;
+            m_paletteInput->setText(QString::number(hit.offset, 16).toUpper());
+            updateDisplay();
+            return;
+
+        case RomScanHit::Lz77: {
+            // Decompress on a worker; only the latest selection is shown
+            m_currentOffset = hit.offset;
+            m_offsetInput->setText(QString::number(hit.offset, 16).toUpper());
+            int generation = ++m_previewGeneration;
+            uint32_t offset = hit.offset;
+            GBAROReader *reader = m_romReader;
+
+            m_pool.start([this, reader, offset, generation]() {
+                QByteArray data;
+                QString error;
+                reader->decompressLZ77(offset, data, error);
+                QMetaObject::invokeMethod(this, [this, offset, generation, data, error]() {
+                    if (generation != m_previewGeneration) {
+                        return;
+                    }
+                    if (data.isEmpty()) {
+                        leavePreview();
+                        m_infoLabel->setText(QString("LZ77 at 0x%1: %2").arg(offset, 8, 16, QChar('0')).arg(error));
+                        return;
+                    }
+                    m_previewActive = true;
+                    m_previewOffset = offset;
+                    m_previewData = data;
+                    updateDisplay();
+                }, Qt::QueuedConnection);
+            });
+            return;
+        }
+
+        case RomScanHit::PointerTable:
+        default:
+            leavePreview();
+            m_currentOffset = hit.offset;
+            m_offsetInput->setText(QString::number(hit.offset, 16).toUpper());
+            updateDisplay();
+            return;
+    }
+}
+
+void TileViewer::stepHit(bool forward)
+{
+    if (m_hitList->count() == 0) {
+        return;
+    }
+
+    // Step from the selected hit, or from the offset on screen when nothing is selected
+    QListWidgetItem *current = m_hitList->currentItem();
+    uint32_t from = current ? m_scanIndex.hits.at(current->data(Qt::UserRole).toInt()).offset
+                            : (m_previewActive ? m_previewOffset : m_currentOffset);
+    int kindMask = m_hitKindCombo->currentData().toInt();
+
+    int hitIndex = forward ? m_scanIndex.nextHit(from, kindMask) : m_scanIndex.previousHit(from, kindMask);
+    while (hitIndex >= 0 && !m_hitRows.contains(hitIndex)) {
+        const RomScanHit &hit = m_scanIndex.hits.at(hitIndex);
+        hitIndex = forward ? m_scanIndex.nextHit(hit.offset, kindMask) : m_scanIndex.previousHit(hit.offset, kindMask);
+    }
+
+    if (hitIndex >= 0) {
+        m_hitList->setCurrentRow(m_hitRows.value(hitIndex));
+    }
+}
+
+void TileViewer::onPrevHit()
+{
+    stepHit(false);
+}
+
+void TileViewer::onNextHit()
+{
+    stepHit(true);
+}
+
+void TileViewer::onCopyHitOffset()
+{
+    QListWidgetItem *item = m_hitList->currentItem();
+    if (!item) {
+        return;
+    }
+
+    // Same notation as gen3_rom_data.yaml (ROM file offsets, uppercase hex)
+    const RomScanHit &hit = m_scanIndex.hits.at(item->data(Qt::UserRole).toInt());
+    QGuiApplication::clipboard()->setText("0x" + QString::number(hit.offset, 16).toUpper());
+}
+
+void TileViewer::leavePreview()
+{
+    ++m_previewGeneration;
+    m_previewActive = false;
+    m_previewData.clear();
+}
@@ -7,8 +7,15 @@
 #include <QPushButton>
 #include <QComboBox>
 #include <QLineEdit>
-#include <QScrollArea>
+#include <QListWidget>
+#include <QCheckBox>
+#include <QTimer>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QHash>
 #include "gbaromreader.h"
+#include "romscanner.h"
+#include "tilesheetview.h"
 
 /**
  * @brief Dialog for viewing and scanning GBA ROM graphics
@@ -16,6 +23,16 @@
  * Allows browsing through ROM tiles at different offsets to find
  * graphics data. Useful for locating Wonder Card backgrounds, borders,
  * fonts, and other UI elements.
+ *
+ * The ROM Index panel runs RomScanner in the background and lists the LZ77
+ * streams, palettes and pointer tables it found (persisted per ROM, so the
+ * scan runs once). Selecting an LZ77 hit decompresses it on a worker and
+ * previews the result as 4bpp tiles; a palette hit becomes the current
+ * palette; a pointer table hit jumps to the raw bytes.
+ *
+ * Tiles are shown through a TileSheetView: the whole ROM is one scrollable
+ * sheet whose visible bands decode in the background, so page size, offset,
+ * palette or bpp changes never build a full-page image.
  */
 class TileViewer : public QDialog
 {
@@ -32,10 +49,28 @@ private slots:
     void onJumpToOffset();
     void onSaveImage();
     void onPaletteOffsetChanged();
+    void onSheetScrolled(uint32_t offset);
+
+    // ROM index
+    void onScanRom();
+    void onScanProgress();
+    void onHitSelected(int row);
+    void onPrevHit();
+    void onNextHit();
+    void onCopyHitOffset();
+    void populateHitList();
 
 private:
     void setupUI();
+    QWidget *createIndexPanel();
     void renderTiles();
+    void updateInfoLabel();
+    void loadScanIndex();
+    void onScanFinished(const RomScanIndex &index, bool cancelled);
+    void showHit(const RomScanHit &hit);
+    void stepHit(bool forward);
+    bool hitPassesFilter(const RomScanHit &hit) const;
+    void leavePreview();
 
     // ROM reader
     GBAROReader *m_romReader;
@@ -49,10 +84,23 @@ private:
     int m_tileHeight;  // 8, 16, or 32
     int m_bpp;         // 2 or 4 bits per pixel
 
+    // ROM index (scan results) and background work
+    RomScanIndex m_scanIndex;
+    QHash<int, int> m_hitRows;        // Hit index -> list row (current filter)
+    QThreadPool m_pool;               // Scan + LZ77 previews; joined in the destructor
+    QAtomicInt m_scanProgress;        // Bytes scanned
+    QAtomicInt m_cancelScan;
+    bool m_scanning;
+    QTimer *m_scanTimer;              // Polls m_scanProgress while scanning
+
+    // LZ77 preview (decompressed hit shown instead of raw ROM tiles)
+    bool m_previewActive;
+    uint32_t m_previewOffset;
+    QByteArray m_previewData;
+    int m_previewGeneration;          // Drops results of superseded previews
+
     // UI Elements
-    QLabel *m_tileDisplay;
-    QPixmap m_currentImage;
-    QScrollArea *m_scrollArea;
+    TileSheetView *m_sheetView;
 
     // Controls
     QLineEdit *m_offsetInput;
@@ -66,6 +114,16 @@ private:
     QPushButton *m_jumpButton;
     QPushButton *m_saveButton;
     QLabel *m_infoLabel;
+
+    // ROM index panel
+    QPushButton *m_scanButton;
+    QLabel *m_scanStatusLabel;
+    QComboBox *m_hitKindCombo;
+    QCheckBox *m_referencedOnlyCheck;
+    QListWidget *m_hitList;
+    QPushButton *m_prevHitButton;
+    QPushButton *m_nextHitButton;
+    QPushButton *m_copyOffsetButton;
 };
 
 #endif // TILEVIEWER_H
@@ -1,4 +1,6 @@
 #include "wondercardrenderer.h"
+#include "logcategories.h"
+#include "spritecache.h"
 #include <QPainter>
 #include <QFontMetrics>
 #include <QFontDatabase>
@@ -6,7 +8,6 @@
 
 // Static member initialization
 GBAROReader *WonderCardRenderer::s_romReader = nullptr;
-QMap<uint16_t, QPixmap> WonderCardRenderer::s_iconCache;
 
 // Background colors for the 8 Wonder Card types (from Mystic Ticket screenshot)
 // Color index is derived from typeColorResend byte: (byte >> 2) & 0x07
@@ -50,20 +51,13 @@ void WonderCardRenderer::setWonderCard(const WonderCardData &wonderCard)
 
     // Extract icon from ROM if available
     if (m_hasData && isROMLoaded()) {
-        // Check cache first
-        if (s_iconCache.contains(wonderCard.icon)) {
-            m_cachedIcon = s_iconCache[wonderCard.icon];
+        // Shared sprite cache (decodes from ROM on a miss)
+        QImage iconImg = SpriteCache::instance().icon(s_romReader, wonderCard.icon);
+        if (!iconImg.isNull()) {
+            m_cachedIcon = QPixmap::fromImage(iconImg);
         } else {
-            // Extract from ROM
-            QImage iconImg = s_romReader->extractPokemonIcon(wonderCard.icon);
-            if (!iconImg.isNull()) {
-                m_cachedIcon = QPixmap::fromImage(iconImg);
-                s_iconCache[wonderCard.icon] = m_cachedIcon;  // Cache it
-                qDebug() << "Extracted Pokemon icon" << wonderCard.icon << "from ROM";
-            } else {
-                m_cachedIcon = QPixmap();  // Clear cache
-                qDebug() << "Failed to extract Pokemon icon" << wonderCard.icon;
-            }
+            m_cachedIcon = QPixmap();  // Clear cache
+            qCDebug(lcRender) << "Failed to extract Pokemon icon" << wonderCard.icon;
         }
     } else {
         m_cachedIcon = QPixmap();  // Clear cache
@@ -85,7 +79,6 @@ bool WonderCardRenderer::loadROM(const QString &romPath, QString &errorMessage)
     if (s_romReader) {
         delete s_romReader;
         s_romReader = nullptr;
-        s_iconCache.clear();
     }
 
     // Create new ROM reader
@@ -96,9 +89,12 @@ bool WonderCardRenderer::loadROM(const QString &romPath, QString &errorMessage)
         return false;
     }
 
-    qDebug() << "ROM loaded successfully for Wonder Card rendering";
-    qDebug() << "Game:" << s_romReader->gameTitle();
-    qDebug() << "Code:" << s_romReader->gameCode();
+    qCDebug(lcRender) << "ROM loaded successfully for Wonder Card rendering";
+    qCDebug(lcRender) << "Game:" << s_romReader->gameTitle();
+    qCDebug(lcRender) << "Code:" << s_romReader->gameCode();
+
+    // Warm the shared icon cache so species changes never decode on the GUI thread
+    SpriteCache::instance().prefetchIcons(s_romReader);
 
     return true;
 }
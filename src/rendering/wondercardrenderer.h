@@ -69,7 +69,6 @@ private:
 
     // Static ROM reader (shared across all instances)
     static GBAROReader *s_romReader;
-    static QMap<uint16_t, QPixmap> s_iconCache;  // Cache extracted icons
 
     // Layout constants (based on GBA screen: 240x160)
     static const int CARD_WIDTH = 240;
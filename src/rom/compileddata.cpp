@@ -0,0 +1,106 @@
+/**
+ * @file compileddata.cpp
+ * @brief Implementation of the compiled table container.
+ *
+ * @see compileddata.h for the blob layout
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "compileddata.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QFile>
+#include <QSaveFile>
+#include <QDir>
+#include <cstring>
+
+const char CompiledData::YAML_OVERRIDE_ENV[] = "MGI_YAML_DIR";
+
+namespace {
+const int MAGIC_SIZE = 4;
+}
+
+// =============================================================================
+// OVERRIDE
+// =============================================================================
+
+QString CompiledData::yamlOverride(const QString &fileName)
+{
+    QString dir = qEnvironmentVariable(YAML_OVERRIDE_ENV);
+    if (dir.isEmpty()) {
+        return QString();
+    }
+
+    QString path = QDir(dir).filePath(fileName);
+    if (!QFile::exists(path)) {
+        return QString();
+    }
+    return path;
+}
+
+// =============================================================================
+// READING & WRITING
+// =============================================================================
+
+bool CompiledData::read(const QString &path, const char *magic, uint32_t version,
+                        QByteArray &payload, QString &errorMessage)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        errorMessage = QString("Failed to open %1: %2").arg(path, file.errorString());
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(STREAM_VERSION);
+
+    char fileMagic[MAGIC_SIZE];
+    quint32 fileVersion = 0;
+    if (stream.readRawData(fileMagic, MAGIC_SIZE) != MAGIC_SIZE
+        || std::memcmp(fileMagic, magic, MAGIC_SIZE) != 0) {
+        errorMessage = QString("%1 is not a compiled %2 table").arg(path, QString::fromLatin1(magic, MAGIC_SIZE));
+        return false;
+    }
+
+    stream >> fileVersion;
+    if (fileVersion != version) {
+        errorMessage = QString("%1 has format version %2 (expected %3)").arg(path).arg(fileVersion).arg(version);
+        return false;
+    }
+
+    stream >> payload;
+    if (stream.status() != QDataStream::Ok) {
+        errorMessage = QString("%1 is truncated").arg(path);
+        return false;
+    }
+    return true;
+}
+
+bool CompiledData::write(const QString &path, const char *magic, uint32_t version,
+                         const QByteArray &payload, QString &errorMessage)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        errorMessage = QString("Failed to create %1: %2").arg(path, file.errorString());
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(STREAM_VERSION);
+    stream.writeRawData(magic, MAGIC_SIZE);
+    stream << static_cast<quint32>(version);
+    stream << payload;
+
+    if (stream.status() != QDataStream::Ok || !file.commit()) {
+        errorMessage = QString("Failed to write %1: %2").arg(path, file.errorString());
+        return false;
+    }
+    return true;
+}
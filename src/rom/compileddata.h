@@ -0,0 +1,61 @@
+/**
+ * @file compileddata.h
+ * @brief Container format for data tables compiled from the YAML resources.
+ *
+ * gen3_rom_data.yaml, script_commands.yaml and script_data.yaml are parsed
+ * at build time by mgi_datac and embedded as compact QDataStream blobs
+ * (":/Resources/*.mgdb", ":/Resources/*.mgsd"). Loading a blob at startup
+ * is a straight deserialization with no text scanning or regex matching.
+ *
+ * ## Blob Layout
+ * - Magic (4 bytes), identifying the table kind
+ * - Format version (quint32), bumped when the serialized structs change
+ * - Payload (length-prefixed QByteArray, QDataStream::Qt_5_12 encoding)
+ *
+ * ## Development Override
+ * When the MGI_YAML_DIR environment variable names a folder, any of the
+ * YAML files found there are parsed at runtime instead of using the
+ * compiled tables, so offsets and script symbols can be edited without
+ * rebuilding.
+ *
+ * @see RomDatabase::load, ScriptData::load, main_datac.cpp
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef COMPILEDDATA_H
+#define COMPILEDDATA_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QString>
+#include <QByteArray>
+#include <QDataStream>
+#include <cstdint>
+
+/**
+ * @class CompiledData
+ * @brief Reads and writes compiled table blobs; resolves YAML overrides.
+ */
+class CompiledData
+{
+public:
+    // Path of fileName inside MGI_YAML_DIR, or empty when no override applies
+    static QString yamlOverride(const QString &fileName);
+
+    // Validate magic/version and return the payload
+    static bool read(const QString &path, const char *magic, uint32_t version,
+                     QByteArray &payload, QString &errorMessage);
+
+    // Write a blob atomically
+    static bool write(const QString &path, const char *magic, uint32_t version,
+                      const QByteArray &payload, QString &errorMessage);
+
+    // Constants
+    static const char YAML_OVERRIDE_ENV[];
+    static const QDataStream::Version STREAM_VERSION = QDataStream::Qt_5_12;
+};
+
+#endif // COMPILEDDATA_H
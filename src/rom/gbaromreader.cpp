@@ -13,8 +13,9 @@
  * ## Graphics Extraction
  * - 4bpp tile extraction (32 bytes/tile for sprites and backgrounds)
  * - 2bpp tile extraction (16 bytes/tile for fonts)
- * - LZ77 decompression for compressed sprite data
- * - Wonder Card background rendering from tilemap + tileset
+ * - LZ77 decompression for compressed sprite data (bulk back-reference copies,
+ *   caller-supplied output buffers, parallel decode of all Wonder Card graphics)
+ * - Wonder Card background rendering from tilemap + tileset (TileCompositor)
  * - Pokemon icon extraction with proper palette mapping
  *
  * ## Palette Handling
@@ -44,21 +45,29 @@
 // Project Includes
 // =============================================================================
 #include "gbaromreader.h"
+#include "logcategories.h"
+#include "tracing.h"
 #include "romdatabase.h"
 #include "romloader.h"
+#include "spritecache.h"
+#include "tilecompositor.h"
+#include "gen3text.h"
 
 // =============================================================================
 // Qt Framework Includes
 // =============================================================================
 #include <QFile>
+#include <QThreadPool>
 #include <QDebug>
+#include <cstring>
 
 // =============================================================================
 // CONSTRUCTOR & DESTRUCTOR
 // =============================================================================
 
 GBAROReader::GBAROReader()
-    : m_versionIdentified(false)
+    : m_mappedData(nullptr)
+    , m_versionIdentified(false)
     , m_iconSprites(0)
     , m_iconPalettes(0)
     , m_iconPaletteIndices(0)
@@ -75,6 +84,51 @@ GBAROReader::GBAROReader()
 
 GBAROReader::~GBAROReader()
 {
+    unloadROM();
+}
+
+void GBAROReader::unloadROM()
+{
+    // A background icon prefetch may still be reading this ROM
+    SpriteCache::instance().cancelPrefetch(this);
+
+    // Drop the raw-data view before the memory behind it goes away
+    m_romData.clear();
+
+    if (m_mappedData) {
+        m_romFile.unmap(m_mappedData);
+        m_mappedData = nullptr;
+    }
+    if (m_romFile.isOpen()) {
+        m_romFile.close();
+    }
+    m_filePath.clear();
+    m_md5.clear();
+
+    // Identity and database offsets, so a reload (or a failed one) never
+    // reports or reads through the previous ROM's values
+    m_versionIdentified = false;
+    m_versionName.clear();
+    m_gameFamily.clear();
+    m_iconSprites = 0;
+    m_iconPalettes = 0;
+    m_iconPaletteIndices = 0;
+    m_iconPaletteSet.clear();
+    m_wondercardTable = 0;
+    m_wondercardCount = 8;
+    m_stdpalOffsets.clear();
+    m_fontOffset = 0;
+    m_glyphWidthsOffset = 0;
+    m_fontOffsets.clear();
+    m_glyphWidthOffsets.clear();
+
+    m_hasNameTables = false;
+    m_itemTable = {0, 0, 0, 0};
+    m_pokemonTable = {0, 0, 0, 0};
+    m_moveTable = {0, 0, 0, 0};
+    m_itemNames = NameTable();
+    m_pokemonNames = NameTable();
+    m_moveNames = NameTable();
 }
 
 bool GBAROReader::loadROM(const QString &path, QString &errorMessage)
@@ -82,7 +136,7 @@ bool GBAROReader::loadROM(const QString &path, QString &errorMessage)
     // Load without database - uses embedded resource for identification
     RomDatabase db;
     QString dbError;
-    if (db.loadFromYaml(":/Resources/gen3_rom_data.yaml", dbError)) {
+    if (db.load(dbError)) {
         return loadROM(path, &db, errorMessage);
     } else {
         errorMessage = "Failed to load ROM database: " + dbError;
@@ -92,26 +146,40 @@ bool GBAROReader::loadROM(const QString &path, QString &errorMessage)
 
 bool GBAROReader::loadROM(const QString &path, RomDatabase *database, QString &errorMessage)
 {
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly)) {
-        errorMessage = QString("Could not open ROM file: %1").arg(file.errorString());
+    MGI_TRACE_SCOPE("GBAROReader::loadROM");
+    unloadROM();
+
+    m_romFile.setFileName(path);
+    if (!m_romFile.open(QIODevice::ReadOnly)) {
+        errorMessage = QString("Could not open ROM file: %1").arg(m_romFile.errorString());
         return false;
     }
 
-    m_romData = file.readAll();
-    file.close();
+    // Map the ROM instead of copying it; fall back to a full read if the
+    // platform or file system does not support mapping
+    qint64 fileSize = m_romFile.size();
+    m_mappedData = (fileSize > 0) ? m_romFile.map(0, fileSize) : nullptr;
+    if (m_mappedData) {
+        m_romData = QByteArray::fromRawData(reinterpret_cast<const char*>(m_mappedData),
+                                            static_cast<int>(fileSize));
+    } else {
+        qCDebug(lcRom) << "ROM mapping unavailable, reading into memory:" << m_romFile.errorString();
+        m_romData = m_romFile.readAll();
+        m_romFile.close();
+    }
 
     m_filePath = path;
 
     if (!validateROM()) {
         errorMessage = "Invalid GBA ROM file";
-        m_romData.clear();
+        unloadROM();
         return false;
     }
 
-    // Identify ROM version using MD5
+    // Identify ROM version using MD5 (hashed over the mapping, no second read)
     if (database && database->isLoaded()) {
-        QString md5 = RomLoader::computeMD5(path);
+        m_md5 = RomLoader::computeMD5(m_romData);
+        const QString &md5 = m_md5;
         const RomDatabase::RomVersion *version = database->identifyRom(md5);
 
         if (version) {
@@ -160,9 +228,9 @@ bool GBAROReader::loadROM(const QString &path, RomDatabase *database, QString &e
                         }
                     }
 
-                    qDebug() << "  Emerald fonts loaded:";
-                    qDebug() << "    FONT_SHORT_COPY_1 (main):" << QString("0x%1").arg(m_fontOffsets.value(mainFontIndex, 0), 0, 16);
-                    qDebug() << "    FONT_NORMAL (ID):" << QString("0x%1").arg(m_fontOffsets.value(idFontIndex, 0), 0, 16);
+                    qCDebug(lcRom) << "  Emerald fonts loaded:";
+                    qCDebug(lcRom) << "    FONT_SHORT_COPY_1 (main):" << QString("0x%1").arg(m_fontOffsets.value(mainFontIndex, 0), 0, 16);
+                    qCDebug(lcRom) << "    FONT_NORMAL (ID):" << QString("0x%1").arg(m_fontOffsets.value(idFontIndex, 0), 0, 16);
                 } else {
                     // FRLG uses FONT_NORMAL_COPY_2 (index 3) for everything
                     // (identical to FONT_NORMAL index 2, uses sFontNormalLatinGlyphWidths)
@@ -197,31 +265,38 @@ bool GBAROReader::loadROM(const QString &path, RomDatabase *database, QString &e
                 m_moveTable.entrySize = version->moveTable.entrySize;
                 m_moveTable.nameLength = 0;  // Not used for moves
                 m_moveTable.count = version->moveTable.count;
+
+                buildNameTables();
+            }
+
+            // The 3 icon palettes are shared by every species; decode them once
+            for (int i = 0; i < ICON_PALETTE_COUNT; ++i) {
+                m_iconPaletteSet.append(extractPalette(m_iconPalettes + i * 32, 16));
             }
 
-            qDebug() << "ROM identified:" << m_versionName;
-            qDebug() << "  Icon sprites:" << QString("0x%1").arg(m_iconSprites, 0, 16);
-            qDebug() << "  Wonder Card table:" << QString("0x%1").arg(m_wondercardTable, 0, 16);
-            qDebug() << "  Font offset:" << QString("0x%1").arg(m_fontOffset, 0, 16);
-            qDebug() << "  Glyph widths:" << QString("0x%1").arg(m_glyphWidthsOffset, 0, 16);
-            qDebug() << "  version->hasNameTables:" << version->hasNameTables;
-            qDebug() << "  m_hasNameTables:" << m_hasNameTables;
+            qCDebug(lcRom) << "ROM identified:" << m_versionName;
+            qCDebug(lcRom) << "  Icon sprites:" << QString("0x%1").arg(m_iconSprites, 0, 16);
+            qCDebug(lcRom) << "  Wonder Card table:" << QString("0x%1").arg(m_wondercardTable, 0, 16);
+            qCDebug(lcRom) << "  Font offset:" << QString("0x%1").arg(m_fontOffset, 0, 16);
+            qCDebug(lcRom) << "  Glyph widths:" << QString("0x%1").arg(m_glyphWidthsOffset, 0, 16);
+            qCDebug(lcRom) << "  version->hasNameTables:" << version->hasNameTables;
+            qCDebug(lcRom) << "  m_hasNameTables:" << m_hasNameTables;
             if (m_hasNameTables) {
-                qDebug() << "  Name tables: items @" << QString("0x%1").arg(m_itemTable.offset, 0, 16)
-                         << ", pokemon @" << QString("0x%1").arg(m_pokemonTable.offset, 0, 16)
-                         << ", moves @" << QString("0x%1").arg(m_moveTable.offset, 0, 16);
-                qDebug() << "    item table count:" << m_itemTable.count << "entry size:" << m_itemTable.entrySize;
+                qCDebug(lcRom) << "  Name tables: items @" << QString("0x%1").arg(m_itemTable.offset, 0, 16)
+                               << ", pokemon @" << QString("0x%1").arg(m_pokemonTable.offset, 0, 16)
+                               << ", moves @" << QString("0x%1").arg(m_moveTable.offset, 0, 16);
+                qCDebug(lcRom) << "    item table count:" << m_itemTable.count << "entry size:" << m_itemTable.entrySize;
             } else {
-                qDebug() << "  Name tables NOT loaded";
+                qCDebug(lcRom) << "  Name tables NOT loaded";
             }
         } else {
             errorMessage = QString("Unknown ROM (MD5: %1). Supported ROMs: FireRed, LeafGreen, Emerald").arg(md5);
-            m_romData.clear();
+            unloadROM();
             return false;
         }
     } else {
         errorMessage = "ROM database not available for version identification";
-        m_romData.clear();
+        unloadROM();
         return false;
     }
 
@@ -344,29 +419,6 @@ QVector<QRgb> GBAROReader::extractPalette(uint32_t offset, int colorCount)
     return palette;
 }
 
-QImage GBAROReader::tile4bppToImage(const uint8_t *tileData, const QVector<QRgb> &palette)
-{
-    QImage tile(8, 8, QImage::Format_Indexed8);
-    tile.setColorTable(palette);
-
-    // 4bpp: each byte contains 2 pixels (4 bits each)
-    for (int y = 0; y < 8; ++y) {
-        for (int x = 0; x < 8; x += 2) {
-            int byteIndex = y * 4 + x / 2;
-            uint8_t byte = tileData[byteIndex];
-
-            // Low nibble = left pixel, high nibble = right pixel
-            uint8_t pixel1 = byte & 0x0F;
-            uint8_t pixel2 = (byte >> 4) & 0x0F;
-
-            tile.setPixel(x, y, pixel1);
-            tile.setPixel(x + 1, y, pixel2);
-        }
-    }
-
-    return tile;
-}
-
 QImage GBAROReader::extractTile4bpp(uint32_t offset, const QVector<QRgb> &palette, int width, int height)
 {
     if (width % 8 != 0 || height % 8 != 0) {
@@ -374,34 +426,19 @@ QImage GBAROReader::extractTile4bpp(uint32_t offset, const QVector<QRgb> &palett
         return QImage();
     }
 
-    int tilesX = width / 8;
-    int tilesY = height / 8;
-    QImage result(width, height, QImage::Format_Indexed8);
-    result.setColorTable(palette);
-
-    const uint8_t *romData = reinterpret_cast<const uint8_t*>(m_romData.constData());
-
-    for (int ty = 0; ty < tilesY; ++ty) {
-        for (int tx = 0; tx < tilesX; ++tx) {
-            int tileIndex = ty * tilesX + tx;
-            uint32_t tileOffset = offset + tileIndex * TILE_SIZE_4BPP;
+    // Tiles that would run past the end of the ROM are left blank
+    int tileCount = (width / 8) * (height / 8);
+    qint64 available = offset < static_cast<uint32_t>(m_romData.size())
+        ? (m_romData.size() - offset) / TILE_SIZE_4BPP : 0;
+    tileCount = static_cast<int>(qMin<qint64>(tileCount, available));
 
-            if (tileOffset + TILE_SIZE_4BPP > static_cast<uint32_t>(m_romData.size())) {
-                continue;
-            }
-
-            QImage tile = tile4bppToImage(romData + tileOffset, palette);
-
-            // Copy tile to result image
-            for (int y = 0; y < 8; ++y) {
-                for (int x = 0; x < 8; ++x) {
-                    result.setPixel(tx * 8 + x, ty * 8 + y, tile.pixelIndex(x, y));
-                }
-            }
-        }
+    TileCompositor::Framebuffer fb(width, height);
+    if (tileCount > 0) {
+        const uint8_t *romData = reinterpret_cast<const uint8_t*>(m_romData.constData());
+        TileCompositor::decodeTileSheet4bpp(fb, romData + offset, tileCount);
     }
 
-    return result;
+    return TileCompositor::toIndexed8(fb, palette);
 }
 
 QImage GBAROReader::extractTileset4bpp(uint32_t offset, int tileCount, const QVector<QRgb> &palette, int tilesPerRow)
@@ -415,21 +452,13 @@ QImage GBAROReader::extractTileset4bpp(uint32_t offset, int tileCount, const QVe
 
 QImage GBAROReader::extractPokemonIcon(uint16_t iconIndex)
 {
+    MGI_TRACE_SCOPE("GBAROReader::extractPokemonIcon");
     if (!isLoaded()) {
         return QImage();
     }
 
-    qDebug() << "extractPokemonIcon: iconIndex =" << iconIndex;
-    qDebug() << "  m_iconSprites =" << QString("0x%1").arg(m_iconSprites, 0, 16);
-    qDebug() << "  m_iconPalettes =" << QString("0x%1").arg(m_iconPalettes, 0, 16);
-    qDebug() << "  m_iconPaletteIndices =" << QString("0x%1").arg(m_iconPaletteIndices, 0, 16);
-
     // Icon sprites table contains 4-byte pointers to icon data
-    uint32_t iconPtrOffset = m_iconSprites + iconIndex * 4;
-    uint32_t iconPtr = readWord(iconPtrOffset);
-
-    qDebug() << "  iconPtrOffset =" << QString("0x%1").arg(iconPtrOffset, 0, 16);
-    qDebug() << "  iconPtr (raw) =" << QString("0x%1").arg(iconPtr, 0, 16);
+    uint32_t iconPtr = readWord(m_iconSprites + iconIndex * 4);
 
     // Convert GBA address to ROM offset
     if (iconPtr < 0x08000000 || iconPtr > 0x09FFFFFF) {
@@ -437,22 +466,19 @@ QImage GBAROReader::extractPokemonIcon(uint16_t iconIndex)
         return QImage();
     }
     uint32_t iconOffset = iconPtr - 0x08000000;
-    qDebug() << "  iconOffset (ROM) =" << QString("0x%1").arg(iconOffset, 0, 16);
+
+    if (m_iconPaletteSet.isEmpty()) {
+        return QImage();
+    }
 
     // Read palette index for this Pokemon (0-2, there are only 3 icon palettes)
     uint8_t paletteIndex = readByte(m_iconPaletteIndices + iconIndex);
-    qDebug() << "  paletteIndex =" << paletteIndex;
-    if (paletteIndex > 2) {
+    if (paletteIndex >= m_iconPaletteSet.size()) {
         paletteIndex = 0;  // Fallback to first palette
     }
 
-    // Calculate palette offset (3 palettes, 32 bytes each)
-    uint32_t paletteOffset = m_iconPalettes + paletteIndex * 32;
-    qDebug() << "  paletteOffset =" << QString("0x%1").arg(paletteOffset, 0, 16);
-    QVector<QRgb> palette = extractPalette(paletteOffset, 16);
-
     // Icons are 32x64 (2 frames stacked), extract first frame (32x32)
-    return extractTile4bpp(iconOffset, palette, ICON_SIZE, ICON_SIZE);
+    return extractTile4bpp(iconOffset, m_iconPaletteSet.at(paletteIndex), ICON_SIZE, ICON_SIZE);
 }
 
 QImage GBAROReader::extractFont()
@@ -485,7 +511,7 @@ QImage GBAROReader::extractFontByIndex(int fontIndex)
         return QImage();
     }
 
-    qDebug() << "Extracting font index" << fontIndex << "at offset" << QString("0x%1").arg(offset, 0, 16);
+    qCDebug(lcRom) << "Extracting font index" << fontIndex << "at offset" << QString("0x%1").arg(offset, 0, 16);
     return extractFont2bpp(offset, 512, 8, 16, 2);
 }
 
@@ -610,8 +636,8 @@ QImage GBAROReader::extractFont2bpp(uint32_t offset, int numChars, int charWidth
         }
     }
 
-    qDebug() << "Extracted 2bpp font:" << numChars << "characters,"
-             << outputWidth << "x" << outputHeight << "px";
+    qCDebug(lcRom) << "Extracted 2bpp font:" << numChars << "characters,"
+                   << outputWidth << "x" << outputHeight << "px";
 
     return result;
 }
@@ -654,100 +680,209 @@ QVector<uint8_t> GBAROReader::getGlyphWidthsByIndex(int fontIndex)
         return defaults;
     }
 
-    qDebug() << "Extracting glyph widths for font index" << fontIndex << "at offset" << QString("0x%1").arg(offset, 0, 16);
+    qCDebug(lcRom) << "Extracting glyph widths for font index" << fontIndex << "at offset" << QString("0x%1").arg(offset, 0, 16);
     return extractGlyphWidths(offset, GLYPH_WIDTHS_SIZE);
 }
 
-QByteArray GBAROReader::decompressLZ77(uint32_t offset, QString &errorMessage) const
+int GBAROReader::lz77DecompressedSize(uint32_t offset, QString &errorMessage) const
 {
-    if (offset + 4 > static_cast<uint32_t>(m_romData.size())) {
+    if (static_cast<qint64>(offset) + 4 > m_romData.size()) {
         errorMessage = "Offset out of bounds";
-        return QByteArray();
+        return -1;
     }
 
-    // Read header
-    uint8_t compressionType = readByte(offset);
-    if (compressionType != 0x10) {
+    // Header: type byte followed by the decompressed size (3 bytes, little endian)
+    const uint8_t *header = reinterpret_cast<const uint8_t*>(m_romData.constData()) + offset;
+    if (header[0] != 0x10) {
         errorMessage = QString("Not LZ77 compressed data (expected 0x10, got 0x%1)")
-            .arg(compressionType, 2, 16, QChar('0'));
-        return QByteArray();
+            .arg(header[0], 2, 16, QChar('0'));
+        return -1;
     }
 
-    // Read decompressed size (3 bytes, little endian)
-    uint32_t decompressedSize = readByte(offset + 1) |
-                                (readByte(offset + 2) << 8) |
-                                (readByte(offset + 3) << 16);
-
-    if (decompressedSize == 0 || decompressedSize > 0x100000) {  // Max 1MB sanity check
+    uint32_t decompressedSize = header[1] | (header[2] << 8) | (header[3] << 16);
+    if (decompressedSize == 0 || decompressedSize > LZ77_MAX_SIZE) {
         errorMessage = QString("Invalid decompressed size: %1").arg(decompressedSize);
-        return QByteArray();
+        return -1;
     }
 
-    QByteArray decompressed;
-    decompressed.reserve(decompressedSize);
+    return static_cast<int>(decompressedSize);
+}
+
+int GBAROReader::lz77StreamLength(uint32_t offset, QString &errorMessage) const
+{
+    int size = lz77DecompressedSize(offset, errorMessage);
+    if (size < 0) {
+        return -1;
+    }
 
-    uint32_t srcPos = offset + 4;  // Start after header
+    // Same walk as decompressLZ77, but only tracks positions: no output buffer
     const uint8_t *src = reinterpret_cast<const uint8_t*>(m_romData.constData());
+    const qint64 srcEnd = m_romData.size();
+    qint64 srcPos = static_cast<qint64>(offset) + 4;
+    int outPos = 0;
 
-    while (decompressed.size() < static_cast<int>(decompressedSize)) {
-        if (srcPos >= static_cast<uint32_t>(m_romData.size())) {
+    while (outPos < size) {
+        if (srcPos >= srcEnd) {
             errorMessage = "Unexpected end of compressed data";
-            return QByteArray();
+            return -1;
         }
 
-        // Read flag byte
         uint8_t flags = src[srcPos++];
 
-        // Process 8 blocks
-        for (int i = 0; i < 8; ++i) {
-            if (decompressed.size() >= static_cast<int>(decompressedSize)) {
-                break;  // Done
+        for (int i = 0; i < 8 && outPos < size; ++i, flags <<= 1) {
+            if (!(flags & 0x80)) {
+                if (srcPos >= srcEnd) {
+                    errorMessage = "Unexpected end of compressed data";
+                    return -1;
+                }
+                ++srcPos;
+                ++outPos;
+                continue;
             }
 
-            if (srcPos >= static_cast<uint32_t>(m_romData.size())) {
+            if (srcPos + 1 >= srcEnd) {
                 errorMessage = "Unexpected end of compressed data";
-                return QByteArray();
+                return -1;
+            }
+            uint8_t byte1 = src[srcPos++];
+            uint8_t byte2 = src[srcPos++];
+            int displacement = (((byte1 & 0x0F) << 8) | byte2) + 1;
+            if (outPos - displacement < 0) {
+                errorMessage = "Invalid LZ77 displacement";
+                return -1;
             }
+            outPos += qMin(((byte1 >> 4) & 0x0F) + 3, size - outPos);
+        }
+    }
 
-            if (flags & 0x80) {
-                // Compressed block - read 2 bytes
-                if (srcPos + 1 >= static_cast<uint32_t>(m_romData.size())) {
-                    errorMessage = "Unexpected end of compressed data";
-                    return QByteArray();
-                }
+    return static_cast<int>(srcPos - offset);
+}
 
-                uint8_t byte1 = src[srcPos++];
-                uint8_t byte2 = src[srcPos++];
+bool GBAROReader::decompressLZ77(uint32_t offset, uint8_t *dest, int destCapacity,
+                                 int &outputSize, QString &errorMessage) const
+{
+    outputSize = 0;
+    int size = lz77DecompressedSize(offset, errorMessage);
+    if (size < 0) {
+        return false;
+    }
+    if (!dest || size > destCapacity) {
+        errorMessage = QString("Output buffer too small (%1 bytes, need %2)").arg(destCapacity).arg(size);
+        return false;
+    }
 
-                // Extract length and displacement
-                int length = ((byte1 >> 4) & 0x0F) + 3;  // 3-18 bytes
-                int displacement = (((byte1 & 0x0F) << 8) | byte2) + 1;  // 1-4096
+    const uint8_t *src = reinterpret_cast<const uint8_t*>(m_romData.constData());
+    const qint64 srcEnd = m_romData.size();
+    qint64 srcPos = static_cast<qint64>(offset) + 4;  // Start after header
+    int outPos = 0;
 
-                // Copy from earlier in the decompressed buffer
-                int copyPos = decompressed.size() - displacement;
-                if (copyPos < 0) {
-                    errorMessage = "Invalid LZ77 displacement";
-                    return QByteArray();
+    while (outPos < size) {
+        if (srcPos >= srcEnd) {
+            errorMessage = "Unexpected end of compressed data";
+            return false;
+        }
+
+        // Flag byte covers the next 8 blocks (MSB first)
+        uint8_t flags = src[srcPos++];
+
+        for (int i = 0; i < 8 && outPos < size; ++i, flags <<= 1) {
+            if (!(flags & 0x80)) {
+                // Literal byte
+                if (srcPos >= srcEnd) {
+                    errorMessage = "Unexpected end of compressed data";
+                    return false;
                 }
+                dest[outPos++] = src[srcPos++];
+                continue;
+            }
+
+            // Back-reference: 2 bytes of length (3-18) and displacement (1-4096)
+            if (srcPos + 1 >= srcEnd) {
+                errorMessage = "Unexpected end of compressed data";
+                return false;
+            }
+            uint8_t byte1 = src[srcPos++];
+            uint8_t byte2 = src[srcPos++];
+            int length = ((byte1 >> 4) & 0x0F) + 3;
+            int displacement = (((byte1 & 0x0F) << 8) | byte2) + 1;
+
+            int copyPos = outPos - displacement;
+            if (copyPos < 0) {
+                errorMessage = "Invalid LZ77 displacement";
+                return false;
+            }
+            length = qMin(length, size - outPos);
 
+            if (displacement >= length) {
+                // Source and destination don't overlap
+                std::memcpy(dest + outPos, dest + copyPos, length);
+                outPos += length;
+            } else {
+                // Overlapping run (repeats the last `displacement` bytes): must go forward byte by byte
                 for (int j = 0; j < length; ++j) {
-                    if (decompressed.size() >= static_cast<int>(decompressedSize)) {
-                        break;
-                    }
-                    decompressed.append(decompressed[copyPos + j]);
+                    dest[outPos++] = dest[copyPos + j];
                 }
-            } else {
-                // Uncompressed byte
-                decompressed.append(src[srcPos++]);
             }
-
-            flags <<= 1;  // Next flag bit
         }
     }
 
+    outputSize = outPos;
+    return true;
+}
+
+bool GBAROReader::decompressLZ77(uint32_t offset, QByteArray &output, QString &errorMessage) const
+{
+    int size = lz77DecompressedSize(offset, errorMessage);
+    if (size < 0) {
+        output.clear();
+        return false;
+    }
+
+    // resize() keeps the existing allocation when it is already large enough
+    output.resize(size);
+    int written = 0;
+    if (!decompressLZ77(offset, reinterpret_cast<uint8_t*>(output.data()), size, written, errorMessage)) {
+        output.clear();
+        return false;
+    }
+    return true;
+}
+
+QByteArray GBAROReader::decompressLZ77(uint32_t offset, QString &errorMessage) const
+{
+    QByteArray decompressed;
+    decompressLZ77(offset, decompressed, errorMessage);
     return decompressed;
 }
 
+QVector<GBAROReader::WonderCardGraphicsData> GBAROReader::decompressWonderCardGraphics() const
+{
+    QVector<WonderCardGraphicsData> results(isLoaded() ? m_wondercardCount : 0);
+    WonderCardGraphicsData *data = results.data();
+
+    // Each worker only touches its own element; the ROM is read-only here
+    QThreadPool pool;
+    for (int i = 0; i < results.size(); ++i) {
+        pool.start([this, data, i]() {
+            WonderCardGraphicsData &item = data[i];
+            item.entry = readWonderCardEntry(i);
+            if (item.entry.tilesetPtr == 0 || item.entry.tilemapPtr == 0 || item.entry.palettePtr == 0) {
+                item.error = "Invalid Wonder Card entry";
+                return;
+            }
+            QString error;
+            if (!decompressLZ77(item.entry.tilesetPtr, item.tileset, error)) {
+                item.error = "Failed to decompress tileset: " + error;
+            } else if (!decompressLZ77(item.entry.tilemapPtr, item.tilemap, error)) {
+                item.error = "Failed to decompress tilemap: " + error;
+            }
+        });
+    }
+    pool.waitForDone();
+
+    return results;
+}
+
 QImage GBAROReader::extractWonderCardFrame()
 {
     // Note: Frame extraction requires version-specific offsets not yet in YAML
@@ -780,53 +915,38 @@ uint32_t readPointer(const QByteArray &data, uint32_t offset)
     return 0;
 }
 
-GBAROReader::WonderCardGraphicsEntry GBAROReader::loadWonderCardEntry(int index)
+GBAROReader::WonderCardGraphicsEntry GBAROReader::readWonderCardEntry(int index) const
 {
     WonderCardGraphicsEntry entry = {0, 0, 0, 0};
-
-    qDebug() << "loadWonderCardEntry: index =" << index;
-    qDebug() << "  m_wondercardTable =" << QString("0x%1").arg(m_wondercardTable, 0, 16);
-    qDebug() << "  m_wondercardCount =" << m_wondercardCount;
-
     if (!isLoaded() || index < 0 || index >= m_wondercardCount) {
-        qWarning() << "  Invalid index or not loaded";
         return entry;
     }
 
     uint32_t entryOffset = m_wondercardTable + (index * 16);
-    qDebug() << "  entryOffset =" << QString("0x%1").arg(entryOffset, 0, 16);
-
     entry.tilesetPtr = readPointer(m_romData, entryOffset);
     entry.tilemapPtr = readPointer(m_romData, entryOffset + 4);
     entry.palettePtr = readPointer(m_romData, entryOffset + 8);
-
-    qDebug() << "  tilesetPtr =" << QString("0x%1").arg(entry.tilesetPtr, 0, 16);
-    qDebug() << "  tilemapPtr =" << QString("0x%1").arg(entry.tilemapPtr, 0, 16);
-    qDebug() << "  palettePtr =" << QString("0x%1").arg(entry.palettePtr, 0, 16);
-
     return entry;
 }
 
-QVector<GBAROReader::TilemapEntry> GBAROReader::loadTilemap(const QByteArray &data)
+GBAROReader::WonderCardGraphicsEntry GBAROReader::loadWonderCardEntry(int index)
 {
-    QVector<TilemapEntry> tilemap;
+    qCDebug(lcRom) << "loadWonderCardEntry: index =" << index;
+    qCDebug(lcRom) << "  m_wondercardTable =" << QString("0x%1").arg(m_wondercardTable, 0, 16);
+    qCDebug(lcRom) << "  m_wondercardCount =" << m_wondercardCount;
 
-    for (int i = 0; i + 1 < data.size(); i += 2) {
-        // Cast to uint8_t first, then to uint16_t for safe bit operations
-        uint8_t lo = static_cast<uint8_t>(data[i]);
-        uint8_t hi = static_cast<uint8_t>(data[i + 1]);
-        uint16_t value = static_cast<uint16_t>(lo) | (static_cast<uint16_t>(hi) << 8);
+    if (!isLoaded() || index < 0 || index >= m_wondercardCount) {
+        qWarning() << "  Invalid index or not loaded";
+        return WonderCardGraphicsEntry{0, 0, 0, 0};
+    }
 
-        TilemapEntry entry;
-        entry.tileIndex = value & 0x3FF;
-        entry.hFlip = (value & 0x400) != 0;
-        entry.vFlip = (value & 0x800) != 0;
-        entry.paletteIndex = (value >> 12) & 0xF;
+    WonderCardGraphicsEntry entry = readWonderCardEntry(index);
 
-        tilemap.append(entry);
-    }
+    qCDebug(lcRom) << "  tilesetPtr =" << QString("0x%1").arg(entry.tilesetPtr, 0, 16);
+    qCDebug(lcRom) << "  tilemapPtr =" << QString("0x%1").arg(entry.tilemapPtr, 0, 16);
+    qCDebug(lcRom) << "  palettePtr =" << QString("0x%1").arg(entry.palettePtr, 0, 16);
 
-    return tilemap;
+    return entry;
 }
 
 QImage GBAROReader::renderWonderCard(const WonderCardGraphicsEntry &entry)
@@ -852,63 +972,39 @@ QImage GBAROReader::renderWonderCard(const WonderCardGraphicsEntry &entry)
         return QImage();
     }
 
-    // Load palette
-    QVector<QRgb> palette = extractPalette(entry.palettePtr, 16);
+    return renderWonderCard(entry, tilesetData, tilemapData);
+}
 
-    // Parse tilemap
-    QVector<TilemapEntry> tilemap = loadTilemap(tilemapData);
+QImage GBAROReader::renderWonderCard(const WonderCardGraphicsEntry &entry,
+                                     const QByteArray &tilesetData, const QByteArray &tilemapData)
+{
+    if (!isLoaded() || entry.palettePtr == 0 || tilesetData.isEmpty() || tilemapData.isEmpty()) {
+        qWarning() << "Invalid Wonder Card graphics";
+        return QImage();
+    }
 
-    // Create tilesheet image
-    int numTiles = tilesetData.size() / TILE_SIZE_4BPP;
-    int tileSheetWidth = 16;
-    int tileSheetHeight = (numTiles + tileSheetWidth - 1) / tileSheetWidth;
+    // Load palette
+    QVector<QRgb> palette = extractPalette(entry.palettePtr, 16);
 
-    // Wonder Card is 30x20 tiles (240x160 pixels)
+    // Wonder Card is 30x20 tiles (240x160 pixels). The card uses a single
+    // 16-color palette, so screen-entry palette banks are ignored; cells with
+    // an out-of-range tile stay transparent via an otherwise unused index.
     const int CARD_TILES_WIDE = 30;
     const int CARD_TILES_TALL = 20;
+    const uint8_t TRANSPARENT_INDEX = 0x10;
 
-    QImage result(CARD_TILES_WIDE * 8, CARD_TILES_TALL * 8, QImage::Format_ARGB32);
-    result.fill(Qt::transparent);
-
-    const uint8_t *tileData = reinterpret_cast<const uint8_t*>(tilesetData.constData());
-
-    for (int ty = 0; ty < CARD_TILES_TALL; ++ty) {
-        for (int tx = 0; tx < CARD_TILES_WIDE; ++tx) {
-            int mapIndex = ty * CARD_TILES_WIDE + tx;
-            if (mapIndex >= tilemap.size()) continue;
-
-            const TilemapEntry &mapEntry = tilemap[mapIndex];
-            int tileNum = mapEntry.tileIndex;
-
-            if (tileNum >= numTiles) continue;
-
-            // Decode this tile
-            const uint8_t *currentTile = tileData + tileNum * TILE_SIZE_4BPP;
-            QImage tileImg = tile4bppToImage(currentTile, palette);
-
-            // Apply flips
-            if (mapEntry.hFlip) {
-                tileImg = tileImg.mirrored(true, false);
-            }
-            if (mapEntry.vFlip) {
-                tileImg = tileImg.mirrored(false, true);
-            }
+    TileCompositor::Framebuffer fb(CARD_TILES_WIDE * 8, CARD_TILES_TALL * 8);
+    TileCompositor::composeTilemap(fb, reinterpret_cast<const uint8_t*>(tilesetData.constData()),
+                                   tilesetData.size() / TILE_SIZE_4BPP,
+                                   reinterpret_cast<const uint8_t*>(tilemapData.constData()),
+                                   tilemapData.size() / 2, CARD_TILES_WIDE, CARD_TILES_TALL,
+                                   false, TRANSPARENT_INDEX);
 
-            // Convert to ARGB32 for compositing
-            QImage tileArgb = tileImg.convertToFormat(QImage::Format_ARGB32);
+    TileCompositor::PaletteLut lut;
+    TileCompositor::paletteLut(palette, lut);
+    lut[TRANSPARENT_INDEX] = qRgba(0, 0, 0, 0);
 
-            // Copy tile to result
-            for (int py = 0; py < 8; ++py) {
-                for (int px = 0; px < 8; ++px) {
-                    int destX = tx * 8 + px;
-                    int destY = ty * 8 + py;
-                    result.setPixel(destX, destY, tileArgb.pixel(px, py));
-                }
-            }
-        }
-    }
-
-    return result;
+    return TileCompositor::toArgb(fb, lut);
 }
 
 QImage GBAROReader::extractWonderCardBackground(int index)
@@ -927,90 +1023,48 @@ QImage GBAROReader::extractWonderCardBackground(int index)
     return renderWonderCard(entry);
 }
 
-// Gen3 character encoding table for name decoding
-static const QHash<uint8_t, QString>& getGen3Charset()
+NameTable GBAROReader::decodeNameTable(const NameTableInfo &table, int nameLength, bool itemStyle) const
 {
-    static QHash<uint8_t, QString> charset = {
-        {0x00, " "},
-        // Numbers
-        {0xA1, "0"}, {0xA2, "1"}, {0xA3, "2"}, {0xA4, "3"}, {0xA5, "4"},
-        {0xA6, "5"}, {0xA7, "6"}, {0xA8, "7"}, {0xA9, "8"}, {0xAA, "9"},
-        // Punctuation
-        {0xAB, "!"}, {0xAC, "?"}, {0xAD, "."}, {0xAE, "-"},
-        // Uppercase letters
-        {0xBB, "A"}, {0xBC, "B"}, {0xBD, "C"}, {0xBE, "D"}, {0xBF, "E"},
-        {0xC0, "F"}, {0xC1, "G"}, {0xC2, "H"}, {0xC3, "I"}, {0xC4, "J"},
-        {0xC5, "K"}, {0xC6, "L"}, {0xC7, "M"}, {0xC8, "N"}, {0xC9, "O"},
-        {0xCA, "P"}, {0xCB, "Q"}, {0xCC, "R"}, {0xCD, "S"}, {0xCE, "T"},
-        {0xCF, "U"}, {0xD0, "V"}, {0xD1, "W"}, {0xD2, "X"}, {0xD3, "Y"},
-        {0xD4, "Z"},
-        // Lowercase letters
-        {0xD5, "a"}, {0xD6, "b"}, {0xD7, "c"}, {0xD8, "d"}, {0xD9, "e"},
-        {0xDA, "f"}, {0xDB, "g"}, {0xDC, "h"}, {0xDD, "i"}, {0xDE, "j"},
-        {0xDF, "k"}, {0xE0, "l"}, {0xE1, "m"}, {0xE2, "n"}, {0xE3, "o"},
-        {0xE4, "p"}, {0xE5, "q"}, {0xE6, "r"}, {0xE7, "s"}, {0xE8, "t"},
-        {0xE9, "u"}, {0xEA, "v"}, {0xEB, "w"}, {0xEC, "x"}, {0xED, "y"},
-        {0xEE, "z"},
-        // Special
-        {0xB4, "'"}, {0xB8, ","}, {0xBA, "/"}, {0xF0, ":"},
-    };
-    return charset;
-}
-
-QString GBAROReader::decodeGen3String(const QByteArray &data) const
-{
-    QString result;
-    const QHash<uint8_t, QString> &charset = getGen3Charset();
-
-    for (int i = 0; i < data.size(); i++) {
-        uint8_t byte = static_cast<uint8_t>(data[i]);
-        if (byte == 0xFF) break;  // String terminator
-
-        QString ch = charset.value(byte, "");
-        if (!ch.isEmpty()) {
-            result += ch;
+    // One bulk decode over the mapped table; entries past the ROM end stay empty.
+    // Names use the ASCII charset so they match the YAML identifiers.
+    qint64 available = qMax<qint64>(0, m_romData.size() - static_cast<qint64>(table.offset));
+    const uint8_t *base = reinterpret_cast<const uint8_t*>(m_romData.constData()) + qMin<qint64>(table.offset, m_romData.size());
+    QVector<QString> names = Gen3Text::decodeRecords(base, available, table.count, table.entrySize,
+                                                     nameLength, Gen3Text::RomNames);
+
+    NameTable::Builder builder;
+    builder.reserve(table.count);
+    for (QString &name : names) {
+        name = name.trimmed();
+        if (itemStyle) {
+            // Convert to ITEM_UPPERCASE format
+            name = name.toUpper().replace(" ", "").replace(".", "");
         }
+        builder.append(name);
     }
 
-    return result.trimmed();
+    return builder.build();
 }
 
-QString GBAROReader::getItemName(uint16_t id) const
+void GBAROReader::buildNameTables()
 {
-    if (!m_hasNameTables || id >= static_cast<uint16_t>(m_itemTable.count)) {
-        return QString();
-    }
-
-    // Check cache first
-    if (m_itemNameCache.contains(id)) {
-        return m_itemNameCache[id];
-    }
-
-    // Read item name from ROM
-    uint32_t offset = m_itemTable.offset + (id * m_itemTable.entrySize);
-    if (offset + m_itemTable.nameLength > static_cast<uint32_t>(m_romData.size())) {
-        return QString();
-    }
-
-    QByteArray nameData = m_romData.mid(offset, m_itemTable.nameLength);
-    QString name = decodeGen3String(nameData);
-
-    // Convert to ITEM_UPPERCASE format
-    name = name.toUpper().replace(" ", "").replace(".", "");
+    // Items store the name at the start of a larger entry; Pokemon and move
+    // entries are the name itself
+    m_itemNames = decodeNameTable(m_itemTable, m_itemTable.nameLength, true);
+    m_pokemonNames = decodeNameTable(m_pokemonTable, m_pokemonTable.entrySize, false);
+    m_moveNames = decodeNameTable(m_moveTable, m_moveTable.entrySize, false);
+}
 
-    m_itemNameCache[id] = name;
-    return name;
+QString GBAROReader::getItemName(uint16_t id) const
+{
+    return m_itemNames.name(id);
 }
 
 QStringList GBAROReader::getAllItemNames() const
 {
     QStringList items;
-    if (!m_hasNameTables) {
-        return items;
-    }
-
-    for (int i = 0; i < m_itemTable.count; ++i) {
-        QString name = getItemName(static_cast<uint16_t>(i));
+    for (int i = 0; i < m_itemNames.count(); ++i) {
+        QString name = m_itemNames.name(i);
         if (!name.isEmpty()) {
             items << name;
         } else {
@@ -1022,48 +1076,10 @@ QStringList GBAROReader::getAllItemNames() const
 
 QString GBAROReader::getPokemonName(uint16_t id) const
 {
-    if (!m_hasNameTables || id >= static_cast<uint16_t>(m_pokemonTable.count)) {
-        return QString();
-    }
-
-    // Check cache first
-    if (m_pokemonNameCache.contains(id)) {
-        return m_pokemonNameCache[id];
-    }
-
-    // Read pokemon name from ROM
-    uint32_t offset = m_pokemonTable.offset + (id * m_pokemonTable.entrySize);
-    if (offset + m_pokemonTable.entrySize > static_cast<uint32_t>(m_romData.size())) {
-        return QString();
-    }
-
-    QByteArray nameData = m_romData.mid(offset, m_pokemonTable.entrySize);
-    QString name = decodeGen3String(nameData);
-
-    m_pokemonNameCache[id] = name;
-    return name;
+    return m_pokemonNames.name(id);
 }
 
 QString GBAROReader::getMoveName(uint16_t id) const
 {
-    if (!m_hasNameTables || id >= static_cast<uint16_t>(m_moveTable.count)) {
-        return QString();
-    }
-
-    // Check cache first
-    if (m_moveNameCache.contains(id)) {
-        return m_moveNameCache[id];
-    }
-
-    // Read move name from ROM
-    uint32_t offset = m_moveTable.offset + (id * m_moveTable.entrySize);
-    if (offset + m_moveTable.entrySize > static_cast<uint32_t>(m_romData.size())) {
-        return QString();
-    }
-
-    QByteArray nameData = m_romData.mid(offset, m_moveTable.entrySize);
-    QString name = decodeGen3String(nameData);
-
-    m_moveNameCache[id] = name;
-    return name;
+    return m_moveNames.name(id);
 }
@@ -10,7 +10,7 @@
  * - **2bpp tiles**: Font tiles (16 bytes per 8x8 tile)
  * - **LZ77 decompression**: GBA standard compression for sprites
  * - **Wonder Card backgrounds**: 8 different event card backgrounds
- * - **Pokemon icons**: 32x32 sprite icons for all Pokemon
+ * - **Pokemon icons**: 32x32 sprite icons for all Pokemon (shared through SpriteCache)
  *
  * ## Palette Handling
  * - BGR555 to RGB conversion (GBA uses 15-bit color)
@@ -30,6 +30,13 @@
  * The class uses dynamic offset loading from RomDatabase (YAML configuration)
  * to support different ROM versions without hardcoding offsets.
  *
+ * ## ROM Storage
+ * The ROM file is memory-mapped (QFile::map) rather than read into memory, so
+ * only the pages actually touched (header, graphics, name tables) become
+ * resident. The MD5 used for version identification is computed over the same
+ * mapping, so the file is opened and paged in only once per load. If mapping
+ * is unavailable the reader falls back to reading the whole file.
+ *
  * @see RomDatabase for ROM identification and offset data
  * @see WonderCardRenderer for graphics rendering
  * @see Gen3FontRenderer for text rendering
@@ -46,6 +53,7 @@
 // =============================================================================
 #include <QString>
 #include <QByteArray>
+#include <QFile>
 #include <QImage>
 #include <QPixmap>
 #include <QColor>
@@ -53,6 +61,11 @@
 #include <QMap>
 #include <cstdint>
 
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "nametable.h"
+
 // Forward declarations
 class RomDatabase;
 
@@ -99,6 +112,8 @@ public:
     bool isVersionIdentified() const { return m_versionIdentified; }
     QString versionName() const { return m_versionName; }
     QString gameFamily() const { return m_gameFamily; }
+    QString md5() const { return m_md5; }
+    bool isMemoryMapped() const { return m_mappedData != nullptr; }
 
     // ROM info
     QString gameTitle() const;
@@ -108,7 +123,7 @@ public:
     // Graphics extraction
     QImage extractTile4bpp(uint32_t offset, const QVector<QRgb> &palette, int width = 8, int height = 8);
     QImage extractTileset4bpp(uint32_t offset, int tileCount, const QVector<QRgb> &palette, int tilesPerRow = 16);
-    QImage extractPokemonIcon(uint16_t iconIndex);
+    QImage extractPokemonIcon(uint16_t iconIndex);   // Uncached; prefer SpriteCache::icon()
 
     // Palette extraction
     QVector<QRgb> extractPalette(uint32_t offset, int colorCount = 16);
@@ -132,17 +147,28 @@ public:
     QString getPokemonName(uint16_t id) const;
     QString getMoveName(uint16_t id) const;
     bool hasNameTables() const { return m_hasNameTables; }
-    int getItemCount() const { return m_hasNameTables ? m_itemTable.count : 0; }
+    int getItemCount() const { return m_itemNames.count(); }
     QStringList getAllItemNames() const;
 
+    // Name tables, decoded once at load (immutable; thread-safe reads)
+    const NameTable &itemNames() const { return m_itemNames; }
+    const NameTable &pokemonNames() const { return m_pokemonNames; }
+    const NameTable &moveNames() const { return m_moveNames; }
+
     // Raw data reading
     uint8_t readByte(uint32_t offset) const;
     uint16_t readHalfWord(uint32_t offset) const;
     uint32_t readWord(uint32_t offset) const;
     QByteArray readBytes(uint32_t offset, int length) const;
+    const uint8_t *romBytes() const { return reinterpret_cast<const uint8_t*>(m_romData.constData()); }   // romSize() bytes
 
     // LZ77 decompression
     QByteArray decompressLZ77(uint32_t offset, QString &errorMessage) const;
+    bool decompressLZ77(uint32_t offset, QByteArray &output, QString &errorMessage) const;   // Reuses output's allocation
+    bool decompressLZ77(uint32_t offset, uint8_t *dest, int destCapacity, int &outputSize,
+                        QString &errorMessage) const;                                       // Caller-owned buffer/arena
+    int lz77DecompressedSize(uint32_t offset, QString &errorMessage) const;                 // From header; -1 on error
+    int lz77StreamLength(uint32_t offset, QString &errorMessage) const;                     // Compressed bytes incl. header; -1 if invalid
 
     // Wonder Card graphics extraction
     QImage extractWonderCardBackground(int index = 0);
@@ -161,6 +187,19 @@ public:
 
     // Render Wonder Card from entry
     QImage renderWonderCard(const WonderCardGraphicsEntry &entry);
+    QImage renderWonderCard(const WonderCardGraphicsEntry &entry,
+                            const QByteArray &tilesetData, const QByteArray &tilemapData);
+
+    // Decompressed graphics of one Wonder Card table entry
+    struct WonderCardGraphicsData {
+        WonderCardGraphicsEntry entry = {0, 0, 0, 0};
+        QByteArray tileset;
+        QByteArray tilemap;
+        QString error;          // Empty on success
+    };
+
+    // Decompress every Wonder Card tileset/tilemap in parallel (thread-safe, read-only)
+    QVector<WonderCardGraphicsData> decompressWonderCardGraphics() const;
 
     // Dynamic offset getters (from RomDatabase based on detected version)
     uint32_t getIconSpritesOffset() const { return m_iconSprites; }
@@ -180,10 +219,26 @@ public:
     static const int TILE_SIZE_2BPP = 16;  // 8x8 tile in 2bpp = 16 bytes
     static const int ICON_SIZE = 32;       // Pokemon icons are 32x32 pixels
     static const int ICON_TILES = 16;      // 32x32 = 4x4 tiles = 16 tiles
+    static const int ICON_PALETTE_COUNT = 3;
+
+    // LZ77 sanity limit for decompressed size
+    static const uint32_t LZ77_MAX_SIZE = 0x100000;   // 1 MB
 
 private:
+    // ROM bytes. When mapped, this is a QByteArray::fromRawData() view over
+    // m_mappedData (no copy); it must only be accessed through const paths so
+    // that it never detaches into a 16 MB heap copy.
     QByteArray m_romData;
+    QFile m_romFile;           // Kept open for the lifetime of the mapping
+    uchar *m_mappedData;       // Mapped ROM base (nullptr when read into memory)
     QString m_filePath;
+    QString m_md5;             // MD5 of the loaded ROM (lowercase hex)
+
+    // Release the current mapping/buffer
+    void unloadROM();
+
+    // Wonder Card table read without logging (safe from worker threads)
+    WonderCardGraphicsEntry readWonderCardEntry(int index) const;
 
     // ROM version info
     bool m_versionIdentified;
@@ -194,6 +249,7 @@ private:
     uint32_t m_iconSprites;
     uint32_t m_iconPalettes;
     uint32_t m_iconPaletteIndices;
+    QVector<QVector<QRgb>> m_iconPaletteSet;   // Decoded once at load (read-only afterwards)
     uint32_t m_wondercardTable;
     int m_wondercardCount;
     QVector<uint32_t> m_stdpalOffsets;
@@ -215,29 +271,19 @@ private:
     NameTableInfo m_itemTable;
     NameTableInfo m_pokemonTable;
     NameTableInfo m_moveTable;
-    mutable QMap<uint16_t, QString> m_itemNameCache;
-    mutable QMap<uint16_t, QString> m_pokemonNameCache;
-    mutable QMap<uint16_t, QString> m_moveNameCache;
+    NameTable m_itemNames;
+    NameTable m_pokemonNames;
+    NameTable m_moveNames;
 
-    // Gen3 string decoder
-    QString decodeGen3String(const QByteArray &data) const;
+    void buildNameTables();
+    NameTable decodeNameTable(const NameTableInfo &table, int nameLength, bool itemStyle) const;
 
     // Helper functions
     bool validateROM();
-    QImage tile4bppToImage(const uint8_t *tileData, const QVector<QRgb> &palette);
     QImage tile2bppToImage(const uint8_t *tileData, int width = 8, int height = 8);
 
     // 2bpp decoding helper
     QVector<QVector<uint8_t>> decode2bppTiles(uint32_t offset, int tileColumns, int tileRows);
-
-    // Tilemap loading
-    struct TilemapEntry {
-        uint16_t tileIndex;
-        uint8_t paletteIndex;
-        bool hFlip;
-        bool vFlip;
-    };
-    QVector<TilemapEntry> loadTilemap(const QByteArray &data);
 };
 
 #endif // GBAROMREADER_H
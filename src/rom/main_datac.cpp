@@ -0,0 +1,111 @@
+/**
+ * @file main_datac.cpp
+ * @brief Build-time compiler for the YAML data resources.
+ *
+ * Usage:
+ *   mgi_datac rom <gen3_rom_data.yaml> <out.mgdb>
+ *   mgi_datac script <script_commands.yaml> <script_data.yaml> <out.mgsd>
+ *
+ * Parses the YAML with the same code the application used to run at
+ * startup, writes the result as a compiled table, then re-reads the table
+ * to validate it. CMake runs this for every build of Mystery_Gift_Injector
+ * and embeds the outputs as Qt resources.
+ *
+ * @see CompiledData for the blob layout and the runtime YAML override
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "romdatabase.h"
+#include "scriptdata.h"
+
+static int compileRomDatabase(const QStringList &args, QTextStream &out, QTextStream &err)
+{
+    RomDatabase database;
+    QString errorMessage;
+    if (!database.loadFromYaml(args.at(0), errorMessage)) {
+        err << errorMessage << Qt::endl;
+        return 2;
+    }
+    if (!database.saveToBinary(args.at(1), errorMessage)) {
+        err << errorMessage << Qt::endl;
+        return 1;
+    }
+
+    RomDatabase compiled;
+    if (!compiled.loadFromBinary(args.at(1), errorMessage)
+        || compiled.getSupportedMD5Hashes() != database.getSupportedMD5Hashes()) {
+        err << "Compiled ROM database failed validation: " << errorMessage << Qt::endl;
+        return 1;
+    }
+
+    out << QString("Compiled %1 ROM versions into %2")
+               .arg(compiled.getSupportedMD5Hashes().size()).arg(args.at(1)) << Qt::endl;
+    return 0;
+}
+
+static int compileScriptData(const QStringList &args, QTextStream &out, QTextStream &err)
+{
+    ScriptData data;
+    QString errorMessage;
+    if (!data.loadCommandsYaml(args.at(0), errorMessage) || !data.loadDataYaml(args.at(1), errorMessage)) {
+        err << errorMessage << Qt::endl;
+        return 2;
+    }
+    if (!data.saveToBinary(args.at(2), errorMessage)) {
+        err << errorMessage << Qt::endl;
+        return 1;
+    }
+
+    ScriptData compiled;
+    if (!compiled.loadFromBinary(args.at(2), errorMessage)
+        || compiled.commands.size() != data.commands.size() || compiled.flags.size() != data.flags.size()) {
+        err << "Compiled script data failed validation: " << errorMessage << Qt::endl;
+        return 1;
+    }
+
+    out << QString("Compiled %1 commands and %2 flags into %3")
+               .arg(compiled.commands.size()).arg(compiled.flags.size()).arg(args.at(2)) << Qt::endl;
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("mgi_datac");
+    QCoreApplication::setApplicationVersion("1.0");
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Compiles the YAML data resources into binary tables.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("kind", "Table to compile: rom or script.");
+    parser.addPositionalArgument("files", "Input YAML file(s) followed by the output file.", "<yaml...> <out>");
+    parser.process(app);
+
+    QStringList args = parser.positionalArguments();
+    QString kind = args.isEmpty() ? QString() : args.takeFirst();
+
+    if (kind == "rom" && args.size() == 2) {
+        return compileRomDatabase(args, out, err);
+    }
+    if (kind == "script" && args.size() == 3) {
+        return compileScriptData(args, out, err);
+    }
+
+    parser.showHelp(1);
+}
@@ -0,0 +1,157 @@
+/**
+ * @file nametable.cpp
+ * @brief Implementation of the immutable name table and its search index.
+ *
+ * @see nametable.h for the storage layout
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "nametable.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QStringView>
+#include <algorithm>
+
+// =============================================================================
+// LOOKUP
+// =============================================================================
+
+QString NameTable::name(int id) const
+{
+    if (id < 0 || id >= m_spans.size()) {
+        return QString();
+    }
+    const Span &span = m_spans.at(id);
+    return m_pool.mid(span.offset, span.length);
+}
+
+QStringList NameTable::names() const
+{
+    QStringList result;
+    result.reserve(m_spans.size());
+    for (int id = 0; id < m_spans.size(); ++id) {
+        result << name(id);
+    }
+    return result;
+}
+
+// =============================================================================
+// SEARCH
+// =============================================================================
+
+QString NameTable::searchKey(const QString &text)
+{
+    // "Master Ball" / "MASTERBALL" / "master-ball" all share one key
+    QString key;
+    key.reserve(text.size());
+    for (const QChar &ch : text) {
+        if (ch.isLetterOrNumber()) {
+            key.append(ch.toCaseFolded());
+        }
+    }
+    return key;
+}
+
+QVector<int> NameTable::search(const QString &query, int limit) const
+{
+    QVector<int> result;
+    QString key = searchKey(query);
+    if (key.isEmpty()) {
+        int count = (limit < 0) ? m_spans.size() : qMin(limit, m_spans.size());
+        for (int id = 0; id < count; ++id) {
+            result.append(id);
+        }
+        return result;
+    }
+
+    auto keyOf = [this](int id) {
+        const Span &span = m_keySpans.at(id);
+        return QStringView(m_keyPool).mid(span.offset, span.length);
+    };
+    auto full = [&result, limit]() { return limit >= 0 && result.size() >= limit; };
+
+    // 1. Prefix matches: one contiguous run of the sorted index
+    auto first = std::lower_bound(m_sortedIds.cbegin(), m_sortedIds.cend(), key,
+                                  [&keyOf](int id, const QString &k) { return keyOf(id) < QStringView(k); });
+    QVector<bool> taken(m_spans.size(), false);
+    for (auto it = first; it != m_sortedIds.cend() && keyOf(*it).startsWith(key) && !full(); ++it) {
+        result.append(*it);
+        taken[*it] = true;
+    }
+
+    // 2. Substring matches, then 3. in-order subsequence (fuzzy) matches, by ID
+    for (int pass = 0; pass < 2 && !full(); ++pass) {
+        for (int id = 0; id < m_spans.size() && !full(); ++id) {
+            if (taken.at(id)) {
+                continue;
+            }
+            QStringView candidate = keyOf(id);
+            bool match = false;
+            if (pass == 0) {
+                match = candidate.contains(key);
+            } else {
+                int k = 0;
+                for (int i = 0; i < candidate.size() && k < key.size(); ++i) {
+                    if (candidate.at(i) == key.at(k)) {
+                        ++k;
+                    }
+                }
+                match = (k == key.size());
+            }
+            if (match) {
+                result.append(id);
+                taken[id] = true;
+            }
+        }
+    }
+
+    return result;
+}
+
+// =============================================================================
+// BUILDER
+// =============================================================================
+
+void NameTable::Builder::append(const QString &name)
+{
+    Span span;
+    span.offset = m_pool.size();
+    span.length = name.size();
+    m_pool.append(name);
+    m_spans.append(span);
+}
+
+NameTable NameTable::Builder::build()
+{
+    NameTable table;
+    table.m_pool = m_pool;
+    table.m_spans = m_spans;
+    table.m_keySpans.resize(m_spans.size());
+    table.m_sortedIds.resize(m_spans.size());
+
+    for (int id = 0; id < m_spans.size(); ++id) {
+        QString key = searchKey(table.name(id));
+        table.m_keySpans[id] = {static_cast<int>(table.m_keyPool.size()), static_cast<int>(key.size())};
+        table.m_keyPool.append(key);
+        table.m_sortedIds[id] = id;
+    }
+
+    // Stable so equal keys keep ID order
+    std::stable_sort(table.m_sortedIds.begin(), table.m_sortedIds.end(), [&table](int a, int b) {
+        const Span &sa = table.m_keySpans.at(a);
+        const Span &sb = table.m_keySpans.at(b);
+        return QStringView(table.m_keyPool).mid(sa.offset, sa.length) <
+               QStringView(table.m_keyPool).mid(sb.offset, sb.length);
+    });
+
+    m_pool.clear();
+    m_spans.clear();
+    return table;
+}
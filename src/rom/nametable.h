@@ -0,0 +1,91 @@
+/**
+ * @file nametable.h
+ * @brief Immutable, index-addressed table of decoded ROM names.
+ *
+ * GBAROReader decodes each Gen3 name table (items, Pokemon, moves) exactly
+ * once when a ROM is loaded. The names are stored back to back in a single
+ * string pool with one (offset, length) span per ID, so lookups are an array
+ * access and the table never changes after it is built. Concurrent reads
+ * from any number of threads are safe.
+ *
+ * ## Search
+ * A sorted index over case-folded names supports instant filtering (used by
+ * the gift combo box): prefix matches come first, then substring matches,
+ * then fuzzy (in-order subsequence) matches.
+ *
+ * @see GBAROReader::itemNames, GBAROReader::pokemonNames, GBAROReader::moveNames
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef NAMETABLE_H
+#define NAMETABLE_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @class NameTable
+ * @brief String pool + span array, with a prefix/fuzzy search index.
+ *
+ * USAGE:
+ *   NameTable::Builder builder;
+ *   builder.append("MASTERBALL");
+ *   NameTable table = builder.build();
+ *   QString name = table.name(0);
+ *   QVector<int> ids = table.search("mas");
+ */
+class NameTable
+{
+    struct Span {
+        int offset;
+        int length;
+    };
+
+public:
+    NameTable() {}
+
+    int count() const { return m_spans.size(); }
+    bool isEmpty() const { return m_spans.isEmpty(); }
+
+    // Name for an ID (empty when out of range)
+    QString name(int id) const;
+    QStringList names() const;
+
+    // IDs matching query, best matches first (all IDs for an empty query)
+    QVector<int> search(const QString &query, int limit = -1) const;
+
+    /**
+     * @class Builder
+     * @brief Appends names in ID order and produces the immutable table.
+     */
+    class Builder
+    {
+    public:
+        void reserve(int count) { m_spans.reserve(count); }
+        void append(const QString &name);
+        NameTable build();
+
+    private:
+        QString m_pool;
+        QVector<Span> m_spans;
+    };
+
+private:
+    static QString searchKey(const QString &text);
+
+    QString m_pool;              // All names, back to back
+    QVector<Span> m_spans;       // Indexed by ID
+
+    // Search index
+    QString m_keyPool;           // Case-folded, alphanumeric-only names
+    QVector<Span> m_keySpans;    // Indexed by ID
+    QVector<int> m_sortedIds;    // IDs ordered by search key
+};
+
+#endif // NAMETABLE_H
@@ -0,0 +1,352 @@
+/**
+ * @file romassetcache.cpp
+ * @brief Implementation of the persistent decoded ROM asset cache.
+ *
+ * Reading maps the whole cache file once and indexes the entry table into a
+ * hash; images are then wrapped around the mapped scanlines without copying.
+ * Writing lays out header, entry table and 16-byte aligned payloads in memory
+ * and commits them through QSaveFile (synced temp file + rename), so an
+ * interrupted write never leaves a truncated cache behind.
+ *
+ * @see romassetcache.h for the file layout and invalidation rules
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "romassetcache.h"
+#include "logcategories.h"
+#include "romdatabase.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDebug>
+#include <cstring>
+
+// =============================================================================
+// STATIC CONSTANTS
+// =============================================================================
+
+namespace {
+const char CACHE_MAGIC[4] = {'M', 'G', 'A', 'C'};
+const char CACHE_SUFFIX[] = ".mgac";
+const uint32_t PAYLOAD_ALIGNMENT = 16;
+
+uint32_t alignUp(uint32_t value)
+{
+    return (value + PAYLOAD_ALIGNMENT - 1) & ~(PAYLOAD_ALIGNMENT - 1);
+}
+}
+
+// =============================================================================
+// CONSTRUCTOR & DESTRUCTOR
+// =============================================================================
+
+RomAssetCache::RomAssetCache()
+    : m_mapped(nullptr)
+    , m_size(0)
+{
+}
+
+RomAssetCache::~RomAssetCache()
+{
+    close();
+}
+
+// =============================================================================
+// CACHE LOCATION & INVALIDATION
+// =============================================================================
+
+QString RomAssetCache::cacheDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/rom_assets";
+}
+
+QString RomAssetCache::cacheFilePath(const QString &romMd5)
+{
+    return cacheDirectory() + "/" + romMd5.toLower() + CACHE_SUFFIX;
+}
+
+QByteArray RomAssetCache::databaseFingerprint(const QString &yamlPath)
+{
+    QString path = yamlPath.isEmpty() ? RomDatabase::yamlPath() : yamlPath;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "RomAssetCache: cannot read ROM database for fingerprint:" << path;
+        return QByteArray();
+    }
+
+    return QCryptographicHash::hash(file.readAll(), QCryptographicHash::Md5).toHex();
+}
+
+// =============================================================================
+// READING
+// =============================================================================
+
+bool RomAssetCache::open(const QString &romMd5, const QByteArray &fingerprint, QString &errorMessage)
+{
+    return openFile(cacheFilePath(romMd5), romMd5, fingerprint, errorMessage);
+}
+
+bool RomAssetCache::openFile(const QString &path, const QString &romMd5,
+                             const QByteArray &fingerprint, QString &errorMessage)
+{
+    close();
+
+    if (romMd5.size() != 32 || fingerprint.size() != 32) {
+        errorMessage = "Invalid ROM MD5 or database fingerprint";
+        return false;
+    }
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        errorMessage = "No asset cache for this ROM: " + path;
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (m_size < static_cast<qint64>(sizeof(FileHeader))) {
+        errorMessage = "Asset cache is truncated";
+        close();
+        return false;
+    }
+
+    m_mapped = m_file.map(0, m_size);
+    if (!m_mapped) {
+        errorMessage = "Failed to map asset cache: " + m_file.errorString();
+        close();
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, m_mapped, sizeof(header));
+
+    if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0) {
+        errorMessage = "Asset cache has an invalid signature";
+        close();
+        return false;
+    }
+
+    if (header.version != FORMAT_VERSION) {
+        errorMessage = QString("Asset cache format %1 is stale (current %2)")
+                          .arg(header.version).arg(FORMAT_VERSION);
+        close();
+        return false;
+    }
+
+    if (QByteArray(header.romMd5, 32) != romMd5.toLower().toLatin1()) {
+        errorMessage = "Asset cache belongs to a different ROM";
+        close();
+        return false;
+    }
+
+    if (QByteArray(header.fingerprint, 32) != fingerprint) {
+        errorMessage = "Asset cache is stale (ROM database changed)";
+        close();
+        return false;
+    }
+
+    qint64 tableEnd = sizeof(FileHeader) + static_cast<qint64>(header.entryCount) * sizeof(EntryRecord);
+    if (tableEnd > m_size) {
+        errorMessage = "Asset cache entry table is truncated";
+        close();
+        return false;
+    }
+
+    const EntryRecord *records = reinterpret_cast<const EntryRecord*>(m_mapped + sizeof(FileHeader));
+    m_entries.reserve(header.entryCount);
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        const EntryRecord &record = records[i];
+        qint64 dataEnd = static_cast<qint64>(record.dataOffset) + record.dataSize;
+        qint64 colorEnd = static_cast<qint64>(record.colorOffset) + record.colorCount * sizeof(QRgb);
+        if (dataEnd > m_size || colorEnd > m_size) {
+            errorMessage = QString("Asset cache entry %1 points outside the file").arg(i);
+            close();
+            return false;
+        }
+        m_entries.insert(key(static_cast<AssetKind>(record.kind), static_cast<int>(record.index)), &record);
+    }
+
+    qCDebug(lcRom) << "RomAssetCache: opened" << path << "with" << header.entryCount << "entries";
+    return true;
+}
+
+void RomAssetCache::close()
+{
+    m_entries.clear();
+    if (m_mapped) {
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_size = 0;
+}
+
+const RomAssetCache::EntryRecord *RomAssetCache::findEntry(AssetKind kind, int index) const
+{
+    return m_entries.value(key(kind, index), nullptr);
+}
+
+bool RomAssetCache::contains(AssetKind kind, int index) const
+{
+    return findEntry(kind, index) != nullptr;
+}
+
+QImage RomAssetCache::image(AssetKind kind, int index) const
+{
+    const EntryRecord *record = findEntry(kind, index);
+    if (!record || record->width == 0 || record->height == 0) {
+        return QImage();
+    }
+
+    qint64 required = static_cast<qint64>(record->bytesPerLine) * record->height;
+    if (required > record->dataSize) {
+        qWarning() << "RomAssetCache: image entry too small for its geometry" << kind << index;
+        return QImage();
+    }
+
+    // Read-only view over the mapping; QImage copies on first write
+    QImage result(m_mapped + record->dataOffset,
+                  static_cast<int>(record->width),
+                  static_cast<int>(record->height),
+                  static_cast<int>(record->bytesPerLine),
+                  static_cast<QImage::Format>(record->format));
+
+    if (record->colorCount > 0) {
+        QVector<QRgb> colors(static_cast<int>(record->colorCount));
+        std::memcpy(colors.data(), m_mapped + record->colorOffset, record->colorCount * sizeof(QRgb));
+        result.setColorTable(colors);
+    }
+
+    return result;
+}
+
+QByteArray RomAssetCache::blob(AssetKind kind, int index) const
+{
+    const EntryRecord *record = findEntry(kind, index);
+    if (!record) {
+        return QByteArray();
+    }
+
+    return QByteArray::fromRawData(reinterpret_cast<const char*>(m_mapped + record->dataOffset),
+                                   static_cast<int>(record->dataSize));
+}
+
+// =============================================================================
+// WRITING
+// =============================================================================
+
+void RomAssetCache::Builder::addImage(AssetKind kind, int index, const QImage &image)
+{
+    if (image.isNull()) {
+        return;
+    }
+    m_items.append({kind, index, image, QByteArray()});
+}
+
+void RomAssetCache::Builder::addBlob(AssetKind kind, int index, const QByteArray &data)
+{
+    m_items.append({kind, index, QImage(), data});
+}
+
+bool RomAssetCache::Builder::write(const QString &path, const QString &romMd5,
+                                   const QByteArray &fingerprint, QString &errorMessage) const
+{
+    if (romMd5.size() != 32 || fingerprint.size() != 32) {
+        errorMessage = "Invalid ROM MD5 or database fingerprint";
+        return false;
+    }
+
+    // Lay out header + entry table, then payloads
+    uint32_t offset = alignUp(sizeof(FileHeader) + m_items.size() * sizeof(EntryRecord));
+    QVector<EntryRecord> records(m_items.size());
+
+    for (int i = 0; i < m_items.size(); ++i) {
+        const Item &item = m_items.at(i);
+        EntryRecord &record = records[i];
+        std::memset(&record, 0, sizeof(record));
+        record.kind = item.kind;
+        record.index = static_cast<uint32_t>(item.index);
+
+        if (!item.image.isNull()) {
+            record.width = static_cast<uint32_t>(item.image.width());
+            record.height = static_cast<uint32_t>(item.image.height());
+            record.format = static_cast<uint32_t>(item.image.format());
+            record.bytesPerLine = static_cast<uint32_t>(item.image.bytesPerLine());
+            record.dataSize = record.bytesPerLine * record.height;
+            record.dataOffset = offset;
+            offset = alignUp(offset + record.dataSize);
+
+            if (item.image.colorCount() > 0) {
+                record.colorCount = static_cast<uint32_t>(item.image.colorCount());
+                record.colorOffset = offset;
+                offset = alignUp(offset + record.colorCount * sizeof(QRgb));
+            }
+        } else {
+            record.dataSize = static_cast<uint32_t>(item.data.size());
+            record.dataOffset = offset;
+            offset = alignUp(offset + record.dataSize);
+        }
+    }
+
+    QByteArray buffer(static_cast<int>(offset), '\0');
+    char *out = buffer.data();
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = FORMAT_VERSION;
+    std::memcpy(header.romMd5, romMd5.toLower().toLatin1().constData(), 32);
+    std::memcpy(header.fingerprint, fingerprint.constData(), 32);
+    header.entryCount = static_cast<uint32_t>(records.size());
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), records.constData(), records.size() * sizeof(EntryRecord));
+
+    for (int i = 0; i < m_items.size(); ++i) {
+        const Item &item = m_items.at(i);
+        const EntryRecord &record = records.at(i);
+
+        if (!item.image.isNull()) {
+            std::memcpy(out + record.dataOffset, item.image.constBits(), record.dataSize);
+            if (record.colorCount > 0) {
+                QVector<QRgb> colors = item.image.colorTable();
+                std::memcpy(out + record.colorOffset, colors.constData(), record.colorCount * sizeof(QRgb));
+            }
+        } else if (record.dataSize > 0) {
+            std::memcpy(out + record.dataOffset, item.data.constData(), record.dataSize);
+        }
+    }
+
+    // Write atomically: temp file, then replace
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        errorMessage = "Failed to create asset cache directory: " + QFileInfo(path).absolutePath();
+        return false;
+    }
+
+    // QSaveFile writes a unique temp file, syncs it and renames it over the
+    // target, so concurrent writers and crashes never truncate the cache
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        errorMessage = "Failed to create asset cache: " + file.errorString();
+        return false;
+    }
+
+    if (file.write(buffer) != buffer.size() || !file.commit()) {
+        errorMessage = "Failed to write asset cache: " + file.errorString();
+        return false;
+    }
+
+    qCDebug(lcRom) << "RomAssetCache: wrote" << path << "(" << m_items.size() << "entries," << buffer.size() << "bytes)";
+    return true;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file romassetcache.h
+ * @brief Persistent on-disk cache of decoded ROM graphics, keyed by ROM MD5.
+ *
+ * Decoding the Wonder Card assets from a ROM (8 backgrounds through tilemap
+ * composition, 2bpp font sheets, colored font variants and Pokemon icons) is
+ * the dominant cost of a cold start. RomAssetCache stores the decoded results
+ * in one compact binary file per ROM so later launches can map that file and
+ * skip ROM decoding altogether.
+ *
+ * ## File Layout (host byte order and struct layout)
+ * The cache is a machine-local artifact holding raw QImage scanlines and
+ * QRgb color tables, so records are written in host order, not portably;
+ * the header and record layouts are pinned with static_asserts.
+ * - Header: magic "MGAC", format version, ROM MD5, database fingerprint,
+ *   entry count
+ * - Entry table: one fixed-size record per asset (kind, index, geometry,
+ *   QImage format, data/color-table offsets)
+ * - Payload: raw scanlines / byte blobs, each 16-byte aligned
+ *
+ * ## Invalidation
+ * A cache file is only accepted when its format version, ROM MD5 and
+ * database fingerprint all match. The fingerprint is the MD5 of the ROM
+ * database YAML (the compiled table is built from the same file), so editing
+ * gen3_rom_data.yaml (offsets, fonts, palettes) automatically invalidates
+ * every cache built from the old data.
+ *
+ * ## Lifetime
+ * Images and blobs returned by a RomAssetCache reference the mapped file
+ * directly (no copy). They stay valid only while the cache object that
+ * produced them is alive; callers that keep assets must keep the cache too,
+ * or detach the data (e.g. QImage::copy()).
+ *
+ * @see GBAROReader for the decoders whose output is cached
+ * @see AuthenticWonderCardWidget for the cache consumer
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef ROMASSETCACHE_H
+#define ROMASSETCACHE_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QString>
+#include <QByteArray>
+#include <QImage>
+#include <QFile>
+#include <QVector>
+#include <QHash>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class RomAssetCache
+ * @brief Memory-mapped reader and writer for per-ROM decoded asset files.
+ *
+ * USAGE (read):
+ *   RomAssetCache cache;
+ *   if (cache.open(reader->md5(), RomAssetCache::databaseFingerprint(), error)) {
+ *       QImage bg = cache.image(RomAssetCache::Background, 0);
+ *   }
+ *
+ * USAGE (write):
+ *   RomAssetCache::Builder builder;
+ *   builder.addImage(RomAssetCache::Background, 0, bgImage);
+ *   builder.write(RomAssetCache::cacheFilePath(md5), md5, fingerprint, error);
+ */
+class RomAssetCache
+{
+public:
+    /// Kind of asset stored in an entry; the entry index disambiguates within a kind.
+    enum AssetKind : uint32_t {
+        Background = 1,     ///< Wonder Card background, index 0-7 (240x160)
+        FontSheet = 2,      ///< Indexed 2bpp font sheet, index: 0 = main, 1 = ID font
+        ColoredFont = 3,    ///< ARGB font, index: ColoredFontIndex
+        GlyphWidths = 4,    ///< Glyph width table blob, index: 0 = main, 1 = ID font
+        TextPalette = 5,    ///< stdpal_3 as QRgb blob, index 0
+        PokemonIcon = 6     ///< Raw indexed icon (both frames), index = species
+    };
+
+    /// Index layout for ColoredFont entries.
+    enum ColoredFontIndex {
+        MainHeader = 0,
+        MainBody = 1,
+        IdHeader = 2,
+        IdBody = 3
+    };
+
+    RomAssetCache();
+    ~RomAssetCache();
+
+    // Open and validate an existing cache file for the given ROM
+    bool open(const QString &romMd5, const QByteArray &fingerprint, QString &errorMessage);
+    bool openFile(const QString &path, const QString &romMd5, const QByteArray &fingerprint,
+                  QString &errorMessage);
+    void close();
+    bool isOpen() const { return m_mapped != nullptr; }
+
+    // Asset access (zero-copy views over the mapping; see Lifetime above)
+    bool contains(AssetKind kind, int index = 0) const;
+    QImage image(AssetKind kind, int index = 0) const;
+    QByteArray blob(AssetKind kind, int index = 0) const;
+
+    // Cache location and invalidation
+    static QString cacheDirectory();
+    static QString cacheFilePath(const QString &romMd5);
+    static QByteArray databaseFingerprint(const QString &yamlPath = QString());  // Default: RomDatabase::yamlPath()
+
+    /**
+     * @class Builder
+     * @brief Collects decoded assets in memory and writes a cache file atomically.
+     */
+    class Builder
+    {
+    public:
+        void addImage(AssetKind kind, int index, const QImage &image);
+        void addBlob(AssetKind kind, int index, const QByteArray &data);
+        bool isEmpty() const { return m_items.isEmpty(); }
+
+        bool write(const QString &path, const QString &romMd5, const QByteArray &fingerprint,
+                   QString &errorMessage) const;
+
+    private:
+        struct Item {
+            AssetKind kind;
+            int index;
+            QImage image;       // Null for blobs
+            QByteArray data;    // Used for blobs
+        };
+        QVector<Item> m_items;
+    };
+
+    // Constants
+    static const uint32_t FORMAT_VERSION = 1;   // Bump when decoders or layout change
+
+private:
+    // On-disk records
+    struct FileHeader {
+        char magic[4];          // "MGAC"
+        uint32_t version;       // FORMAT_VERSION
+        char romMd5[32];        // Lowercase hex
+        char fingerprint[32];   // Lowercase hex MD5 of the database YAML
+        uint32_t entryCount;
+        uint32_t reserved;
+    };
+
+    struct EntryRecord {
+        uint32_t kind;
+        uint32_t index;
+        uint32_t width;         // 0 for blobs
+        uint32_t height;
+        uint32_t format;        // QImage::Format (0 for blobs)
+        uint32_t bytesPerLine;
+        uint32_t dataOffset;    // From start of file
+        uint32_t dataSize;
+        uint32_t colorOffset;   // Color table for indexed images (0 = none)
+        uint32_t colorCount;
+    };
+
+    static_assert(sizeof(FileHeader) == 80 && offsetof(FileHeader, entryCount) == 72,
+                  "RomAssetCache::FileHeader layout changed");
+    static_assert(sizeof(EntryRecord) == 40 && offsetof(EntryRecord, colorCount) == 36,
+                  "RomAssetCache::EntryRecord layout changed");
+
+    static uint64_t key(AssetKind kind, int index) {
+        return (static_cast<uint64_t>(kind) << 32) | static_cast<uint32_t>(index);
+    }
+
+    const EntryRecord *findEntry(AssetKind kind, int index) const;
+
+    QFile m_file;
+    uchar *m_mapped;
+    qint64 m_size;
+    QHash<uint64_t, const EntryRecord*> m_entries;
+};
+
+#endif // ROMASSETCACHE_H
@@ -13,6 +13,11 @@
  * - Glyph/font offset tables
  * - Name table offsets for script disassembly
  *
+ * ## Compiled Form
+ * saveToBinary() streams the parsed families with QDataStream; mgi_datac runs
+ * it at build time so the application only calls loadFromBinary(). Versions
+ * are stored inside their family and the lookup maps are rebuilt on load.
+ *
  * ## Offset Resolution
  * When looking up offsets, the database applies the version-specific offsetDelta
  * to base offsets, allowing shared glyph tables across versions while maintaining
@@ -29,6 +34,9 @@
 // Project Includes
 // =============================================================================
 #include "romdatabase.h"
+#include "logcategories.h"
+#include "tracing.h"
+#include "compileddata.h"
 
 // =============================================================================
 // Qt Framework Includes
@@ -38,6 +46,92 @@
 #include <QDebug>
 #include <QRegularExpression>
 
+const QString RomDatabase::YAML_FILENAME = "gen3_rom_data.yaml";
+const QString RomDatabase::EMBEDDED_YAML_PATH = ":/Resources/gen3_rom_data.yaml";
+const QString RomDatabase::COMPILED_PATH = ":/Resources/gen3_rom_data.mgdb";
+
+namespace {
+const char COMPILED_MAGIC[] = "MGDB";
+}
+
+// =============================================================================
+// SERIALIZATION
+// =============================================================================
+
+static QDataStream &operator<<(QDataStream &out, const RomDatabase::GlyphInfo &glyph)
+{
+    return out << glyph.offset << glyph.size
+               << glyph.dimensions[0] << glyph.dimensions[1]
+               << glyph.charSize[0] << glyph.charSize[1]
+               << glyph.sourceTileColumns << glyph.widthTableName << glyph.fixedWidth;
+}
+
+static QDataStream &operator>>(QDataStream &in, RomDatabase::GlyphInfo &glyph)
+{
+    return in >> glyph.offset >> glyph.size
+              >> glyph.dimensions[0] >> glyph.dimensions[1]
+              >> glyph.charSize[0] >> glyph.charSize[1]
+              >> glyph.sourceTileColumns >> glyph.widthTableName >> glyph.fixedWidth;
+}
+
+static QDataStream &operator<<(QDataStream &out, const RomDatabase::GlyphWidthTable &table)
+{
+    return out << table.offset << table.size;
+}
+
+static QDataStream &operator>>(QDataStream &in, RomDatabase::GlyphWidthTable &table)
+{
+    return in >> table.offset >> table.size;
+}
+
+static QDataStream &operator<<(QDataStream &out, const RomDatabase::NameTableInfo &table)
+{
+    return out << table.offset << table.entrySize << table.nameLength << table.count;
+}
+
+static QDataStream &operator>>(QDataStream &in, RomDatabase::NameTableInfo &table)
+{
+    return in >> table.offset >> table.entrySize >> table.nameLength >> table.count;
+}
+
+static QDataStream &operator<<(QDataStream &out, const RomDatabase::RomVersion &version)
+{
+    return out << version.name << version.gameFamily << version.code << version.md5
+               << version.offsetDelta
+               << version.stdpalOffsets << version.wondercardPaletteOffsets << version.stampShadowOffsets
+               << version.frontSprites << version.backSprites
+               << version.frontPalettes << version.backPalettes << version.shinyPalettes
+               << version.iconSprites << version.iconPalettes << version.iconPaletteIndices
+               << version.wondercardTable << version.wondercardCount
+               << version.hasNameTables << version.itemTable << version.pokemonTable << version.moveTable;
+}
+
+static QDataStream &operator>>(QDataStream &in, RomDatabase::RomVersion &version)
+{
+    return in >> version.name >> version.gameFamily >> version.code >> version.md5
+              >> version.offsetDelta
+              >> version.stdpalOffsets >> version.wondercardPaletteOffsets >> version.stampShadowOffsets
+              >> version.frontSprites >> version.backSprites
+              >> version.frontPalettes >> version.backPalettes >> version.shinyPalettes
+              >> version.iconSprites >> version.iconPalettes >> version.iconPaletteIndices
+              >> version.wondercardTable >> version.wondercardCount
+              >> version.hasNameTables >> version.itemTable >> version.pokemonTable >> version.moveTable;
+}
+
+static QDataStream &operator<<(QDataStream &out, const RomDatabase::GameFamily &family)
+{
+    return out << family.name << family.bpp << family.pokemonCount
+               << family.glyphsLatin << family.glyphsJapanese << family.glyphWidths
+               << family.versions;
+}
+
+static QDataStream &operator>>(QDataStream &in, RomDatabase::GameFamily &family)
+{
+    return in >> family.name >> family.bpp >> family.pokemonCount
+              >> family.glyphsLatin >> family.glyphsJapanese >> family.glyphWidths
+              >> family.versions;
+}
+
 // =============================================================================
 // CONSTRUCTOR & DESTRUCTOR
 // =============================================================================
@@ -51,8 +145,34 @@ RomDatabase::~RomDatabase()
 {
 }
 
+// =============================================================================
+// LOADING
+// =============================================================================
+
+bool RomDatabase::load(QString &error)
+{
+    QString overridePath = CompiledData::yamlOverride(YAML_FILENAME);
+    if (!overridePath.isEmpty()) {
+        qCDebug(lcRomData) << "RomDatabase: using YAML override" << overridePath;
+        return loadFromYaml(overridePath, error);
+    }
+
+    // Builds without the data compiler only embed the YAML
+    if (!QFile::exists(COMPILED_PATH)) {
+        return loadFromYaml(EMBEDDED_YAML_PATH, error);
+    }
+    return loadFromBinary(COMPILED_PATH, error);
+}
+
+QString RomDatabase::yamlPath()
+{
+    QString overridePath = CompiledData::yamlOverride(YAML_FILENAME);
+    return overridePath.isEmpty() ? EMBEDDED_YAML_PATH : overridePath;
+}
+
 bool RomDatabase::loadFromYaml(const QString &path, QString &error)
 {
+    MGI_TRACE_SCOPE("RomDatabase::loadFromYaml");
     QFile file(path);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         error = QString("Failed to open YAML file: %1").arg(path);
@@ -70,14 +190,60 @@ bool RomDatabase::loadFromYaml(const QString &path, QString &error)
     m_loaded = true;
 
     // Debug: Print all loaded ROM versions and their MD5s
-    qDebug() << "ROM Database loaded. Versions found:";
+    qCDebug(lcRomData) << "ROM Database loaded. Versions found:";
     for (const QString &md5 : m_versionsByMd5.keys()) {
-        qDebug() << "  MD5:" << md5 << "-> Version:" << m_versionsByMd5[md5]->name;
+        qCDebug(lcRomData) << "  MD5:" << md5 << "-> Version:" << m_versionsByMd5[md5]->name;
+    }
+
+    return true;
+}
+
+bool RomDatabase::loadFromBinary(const QString &path, QString &error)
+{
+    MGI_TRACE_SCOPE("RomDatabase::loadFromBinary");
+    QByteArray payload;
+    if (!CompiledData::read(path, COMPILED_MAGIC, COMPILED_VERSION, payload, error)) {
+        return false;
+    }
+
+    QDataStream in(payload);
+    in.setVersion(CompiledData::STREAM_VERSION);
+    QMap<QString, GameFamily> families;
+    in >> families;
+    if (in.status() != QDataStream::Ok) {
+        error = QString("Corrupt ROM database: %1").arg(path);
+        return false;
+    }
+
+    m_gameFamilies = families;
+    for (const GameFamily &family : m_gameFamilies) {
+        for (const RomVersion &version : family.versions) {
+            m_versionsByName[version.name] = new RomVersion(version);
+            if (!version.md5.isEmpty()) {
+                m_versionsByMd5[version.md5] = m_versionsByName[version.name];
+            }
+        }
     }
 
+    m_loaded = true;
+    qCDebug(lcRomData) << "ROM Database loaded from" << path << "-" << m_versionsByMd5.size() << "versions";
     return true;
 }
 
+bool RomDatabase::saveToBinary(const QString &path, QString &error) const
+{
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(CompiledData::STREAM_VERSION);
+    out << m_gameFamilies;
+
+    return CompiledData::write(path, COMPILED_MAGIC, COMPILED_VERSION, payload, error);
+}
+
+// =============================================================================
+// LOOKUP
+// =============================================================================
+
 const RomDatabase::RomVersion* RomDatabase::identifyRom(const QString &md5Hash) const
 {
     QString lowerMd5 = md5Hash.toLower();
@@ -136,6 +302,18 @@ QStringList RomDatabase::getSupportedMD5Hashes() const
     return m_versionsByMd5.keys();
 }
 
+bool RomDatabase::isKnownGameCode(const QString &gameCode) const
+{
+    // Version codes may carry a revision suffix ("BPRE_Rev1"); the ROM header
+    // only holds the 4-character code
+    for (const RomVersion *version : m_versionsByName) {
+        if (version->code.left(4) == gameCode) {
+            return true;
+        }
+    }
+    return false;
+}
+
 int RomDatabase::getIndentLevel(const QString &line) const
 {
     int spaces = 0;
@@ -7,8 +7,10 @@
  *
  * ## Purpose
  * Different ROM versions (FireRed 1.0, 1.1, LeafGreen, Emerald) have data at
- * different offsets. Rather than hardcoding these, we load them from a YAML
- * configuration file (gen3_rom_data.yaml) at runtime.
+ * different offsets. Rather than hardcoding these, we keep them in a YAML
+ * configuration file (gen3_rom_data.yaml). The build compiles it into a binary
+ * table (gen3_rom_data.mgdb) that load() deserializes directly; the YAML is
+ * still parsed at runtime when overridden for development (MGI_YAML_DIR).
  *
  * ## ROM Identification
  * ROMs are identified by their MD5 checksum, which provides reliable version
@@ -128,9 +130,18 @@ public:
     RomDatabase();
     ~RomDatabase();
 
+    // Compiled table embedded at build time, or the MGI_YAML_DIR override
+    bool load(QString &error);
     bool loadFromYaml(const QString &path, QString &error);
     bool isLoaded() const { return m_loaded; }
 
+    // Compiled form (written by mgi_datac)
+    bool loadFromBinary(const QString &path, QString &error);
+    bool saveToBinary(const QString &path, QString &error) const;
+
+    // YAML that load() reads or was compiled from (override or embedded)
+    static QString yamlPath();
+
     // Find ROM version by MD5 hash
     const RomVersion* identifyRom(const QString &md5Hash) const;
 
@@ -147,6 +158,15 @@ public:
     // Get all supported MD5 hashes
     QStringList getSupportedMD5Hashes() const;
 
+    // Cheap pre-filter: is this 4-character header game code (0xAC) in the database?
+    bool isKnownGameCode(const QString &gameCode) const;
+
+    // Constants
+    static const QString YAML_FILENAME;
+    static const QString EMBEDDED_YAML_PATH;
+    static const QString COMPILED_PATH;
+    static const uint32_t COMPILED_VERSION = 1;   // Bump when the structs above change
+
 private:
     bool m_loaded;
     QMap<QString, GameFamily> m_gameFamilies;
@@ -1,17 +1,29 @@
 #include "romloader.h"
+#include "logcategories.h"
+#include "tracing.h"
 #include "romdatabase.h"
 #include <QFile>
+#include <QSaveFile>
 #include <QDir>
 #include <QFileInfo>
 #include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QDateTime>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QMutexLocker>
 #include <QDebug>
 
 RomLoader::RomLoader()
+    : m_indexDirty(false)
 {
+    loadIndex();
 }
 
 RomLoader::~RomLoader()
 {
+    saveIndex();
 }
 
 QStringList RomLoader::getStandardFilenames() const
@@ -48,31 +60,12 @@ QStringList RomLoader::getStandardFilenames() const
     };
 }
 
-QStringList RomLoader::findRomsBySize(const QString &dir, qint64 expectedSize, bool recursive) const
+bool RomLoader::searchDirectoryRecursive(const QString &dir, qint64 expectedSize,
+                                         const std::function<bool(const QFileInfo&)> &visit,
+                                         const QAtomicInt *abort, int maxDepth) const
 {
-    QStringList result;
-
-    if (recursive) {
-        searchDirectoryRecursive(dir, expectedSize, result, 3);  // Max 3 levels deep
-    } else {
-        QDir directory(dir);
-        QStringList filters;
-        filters << "*.gba" << "*.GBA";
-
-        QFileInfoList files = directory.entryInfoList(filters, QDir::Files);
-        for (const QFileInfo &fileInfo : files) {
-            if (fileInfo.size() == expectedSize) {
-                result.append(fileInfo.absoluteFilePath());
-            }
-        }
-    }
-
-    return result;
-}
-
-void RomLoader::searchDirectoryRecursive(const QString &dir, qint64 expectedSize, QStringList &results, int maxDepth) const
-{
-    if (maxDepth <= 0) return;
+    if (maxDepth <= 0) return true;
+    if (abort && abort->loadRelaxed()) return false;
 
     QDir directory(dir);
 
@@ -82,8 +75,8 @@ void RomLoader::searchDirectoryRecursive(const QString &dir, qint64 expectedSize
 
     QFileInfoList files = directory.entryInfoList(filters, QDir::Files);
     for (const QFileInfo &fileInfo : files) {
-        if (fileInfo.size() == expectedSize) {
-            results.append(fileInfo.absoluteFilePath());
+        if (fileInfo.size() == expectedSize && !visit(fileInfo)) {
+            return false;
         }
     }
 
@@ -96,18 +89,34 @@ void RomLoader::searchDirectoryRecursive(const QString &dir, qint64 expectedSize
             name == "__pycache__" || name == ".cache") {
             continue;
         }
-        searchDirectoryRecursive(subdir.absoluteFilePath(), expectedSize, results, maxDepth - 1);
+        if (!searchDirectoryRecursive(subdir.absoluteFilePath(), expectedSize, visit, abort, maxDepth - 1)) {
+            return false;
+        }
     }
+
+    return true;
 }
 
 QString RomLoader::computeMD5(const QString &filePath)
 {
+    MGI_TRACE_SCOPE("RomLoader::computeMD5");
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly)) {
         qWarning() << "Failed to open file for MD5:" << filePath;
         return QString();
     }
 
+    // Hash straight from a read-only mapping when possible (no buffer copies)
+    qint64 fileSize = file.size();
+    uchar *mapped = (fileSize > 0) ? file.map(0, fileSize) : nullptr;
+    if (mapped) {
+        QString md5 = computeMD5(QByteArray::fromRawData(reinterpret_cast<const char*>(mapped),
+                                                         static_cast<int>(fileSize)));
+        file.unmap(mapped);
+        file.close();
+        return md5;
+    }
+
     QCryptographicHash hash(QCryptographicHash::Md5);
 
     // Read in chunks to handle large files efficiently
@@ -122,7 +131,164 @@ QString RomLoader::computeMD5(const QString &filePath)
     return hash.result().toHex().toLower();
 }
 
-RomLoader::RomSearchResult RomLoader::tryRomFile(const QString &path, RomDatabase *db)
+QString RomLoader::computeMD5(const QByteArray &data)
+{
+    MGI_TRACE_SCOPE("RomLoader::computeMD5");
+    return QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Md5).toHex().toLower());
+}
+
+QString RomLoader::computeMD5Cancellable(const QString &filePath, const QAtomicInt *cancel)
+{
+    MGI_TRACE_SCOPE("RomLoader::computeMD5Cancellable");
+    if (!cancel) {
+        return computeMD5(filePath);
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "Failed to open file for MD5:" << filePath;
+        return QString();
+    }
+
+    // Hash in 1 MB slices so a cancelled search stops within one slice
+    const qint64 chunkSize = 1024 * 1024;
+    qint64 fileSize = file.size();
+    uchar *mapped = (fileSize > 0) ? file.map(0, fileSize) : nullptr;
+
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    QByteArray chunk;
+    for (qint64 pos = 0; pos < fileSize; pos += chunkSize) {
+        if (cancel->loadRelaxed()) {
+            return QString();
+        }
+
+        int length = static_cast<int>(qMin(chunkSize, fileSize - pos));
+        if (mapped) {
+            hash.addData(QByteArray::fromRawData(reinterpret_cast<const char*>(mapped + pos), length));
+        } else {
+            chunk = file.read(length);
+            hash.addData(chunk);
+        }
+    }
+
+    if (mapped) {
+        file.unmap(mapped);
+    }
+    file.close();
+
+    return hash.result().toHex().toLower();
+}
+
+QString RomLoader::readGameCode(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(GAME_CODE_OFFSET)) {
+        return QString();
+    }
+
+    QByteArray code = file.read(GAME_CODE_LENGTH);
+    if (code.size() != GAME_CODE_LENGTH) {
+        return QString();
+    }
+
+    return QString::fromLatin1(code);
+}
+
+// =============================================================================
+// PERSISTENT HASH INDEX
+// =============================================================================
+
+QString RomLoader::indexFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/rom_index.tsv";
+}
+
+void RomLoader::loadIndex()
+{
+    QFile file(indexFilePath());
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return;  // No index yet
+    }
+
+    // One entry per line: md5 <TAB> size <TAB> mtime <TAB> absolute path
+    QTextStream in(&file);
+    while (!in.atEnd()) {
+        QStringList parts = in.readLine().split('\t');
+        if (parts.size() != 4 || parts[0].size() != 32) {
+            continue;
+        }
+
+        IndexEntry entry;
+        entry.md5 = parts[0];
+        entry.size = parts[1].toLongLong();
+        entry.mtime = parts[2].toLongLong();
+        m_index.insert(parts[3], entry);
+    }
+
+    qCDebug(lcRom) << "ROM index loaded:" << m_index.size() << "entries";
+}
+
+void RomLoader::saveIndex()
+{
+    QMutexLocker locker(&m_indexMutex);
+    if (!m_indexDirty) {
+        return;
+    }
+
+    QString path = indexFilePath();
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        qWarning() << "Failed to create ROM index directory for" << path;
+        return;
+    }
+
+    // Replaced on commit, so readers never see a half-written index
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning() << "Failed to write ROM index:" << file.errorString();
+        return;
+    }
+
+    QTextStream out(&file);
+    for (auto it = m_index.constBegin(); it != m_index.constEnd(); ++it) {
+        out << it.value().md5 << '\t' << it.value().size << '\t'
+            << it.value().mtime << '\t' << it.key() << '\n';
+    }
+    out.flush();
+
+    if (out.status() != QTextStream::Ok || !file.commit()) {
+        qWarning() << "Failed to write ROM index:" << file.errorString();
+        return;
+    }
+
+    m_indexDirty = false;
+}
+
+QString RomLoader::cachedMD5(const QFileInfo &fileInfo, const QAtomicInt *cancel)
+{
+    QString path = fileInfo.absoluteFilePath();
+    qint64 size = fileInfo.size();
+    qint64 mtime = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    {
+        QMutexLocker locker(&m_indexMutex);
+        auto it = m_index.constFind(path);
+        if (it != m_index.constEnd() && it.value().size == size && it.value().mtime == mtime) {
+            return it.value().md5;
+        }
+    }
+
+    QString md5 = computeMD5Cancellable(path, cancel);
+    if (!md5.isEmpty()) {
+        QMutexLocker locker(&m_indexMutex);
+        m_index.insert(path, {size, mtime, md5});
+        m_indexDirty = true;
+    }
+
+    return md5;
+}
+
+RomLoader::RomSearchResult RomLoader::tryRomFile(const QString &path, RomDatabase *db,
+                                                 const QAtomicInt *cancel)
 {
     RomSearchResult result;
     result.found = false;
@@ -142,8 +308,16 @@ RomLoader::RomSearchResult RomLoader::tryRomFile(const QString &path, RomDatabas
         return result;
     }
 
-    // Compute MD5
-    result.md5 = computeMD5(path);
+    // Cheap header check before committing to a full 16 MB hash
+    QString gameCode = readGameCode(path);
+    if (!db->isKnownGameCode(gameCode)) {
+        result.errorMessage = QString("Unsupported game code: %1").arg(gameCode);
+        qCDebug(lcRom) << "Skipping ROM with unsupported game code" << gameCode << ":" << path;
+        return result;
+    }
+
+    // Compute MD5 (reused from the index when the file is unchanged)
+    result.md5 = cachedMD5(fileInfo, cancel);
     if (result.md5.isEmpty()) {
         result.errorMessage = "Failed to compute MD5 hash";
         return result;
@@ -154,16 +328,17 @@ RomLoader::RomSearchResult RomLoader::tryRomFile(const QString &path, RomDatabas
     if (version) {
         result.found = true;
         result.versionName = version->name;
-        qDebug() << "ROM identified:" << result.versionName << "MD5:" << result.md5;
+        qCDebug(lcRom) << "ROM identified:" << result.versionName << "MD5:" << result.md5;
     } else {
         result.errorMessage = QString("Unknown ROM (MD5: %1)").arg(result.md5);
-        qDebug() << "ROM not recognized:" << result.md5;
+        qCDebug(lcRom) << "ROM not recognized:" << result.md5;
     }
 
     return result;
 }
 
-RomLoader::RomSearchResult RomLoader::findRom(const QString &appDir, RomDatabase *db)
+RomLoader::RomSearchResult RomLoader::findRom(const QString &appDir, RomDatabase *db,
+                                              const QAtomicInt *abort)
 {
     RomSearchResult result;
     result.found = false;
@@ -173,7 +348,7 @@ RomLoader::RomSearchResult RomLoader::findRom(const QString &appDir, RomDatabase
         return result;
     }
 
-    qDebug() << "Searching for ROM in:" << appDir;
+    qCDebug(lcRom) << "Searching for ROM in:" << appDir;
 
     // Phase 1: Check standard filenames
     QStringList standardNames = getStandardFilenames();
@@ -182,8 +357,8 @@ RomLoader::RomSearchResult RomLoader::findRom(const QString &appDir, RomDatabase
         QFileInfo fileInfo(fullPath);
 
         if (fileInfo.exists()) {
-            qDebug() << "Found standard filename:" << filename;
-            result = tryRomFile(fullPath, db);
+            qCDebug(lcRom) << "Found standard filename:" << filename;
+            result = tryRomFile(fullPath, db, abort);
             if (result.found) {
                 return result;
             }
@@ -191,22 +366,63 @@ RomLoader::RomSearchResult RomLoader::findRom(const QString &appDir, RomDatabase
         }
     }
 
-    // Phase 2: Search for any .gba file with correct size
-    qDebug() << "No standard filenames found, searching by size...";
-    QStringList romsBySize = findRomsBySize(appDir, GBA_ROM_SIZE);
+    // Phase 2: Search for any .gba file with correct size. The walk keeps
+    // enumerating while candidates are hashed on the pool; the first match
+    // cancels both the walk and any in-flight hashes.
+    qCDebug(lcRom) << "No standard filenames found, searching by size...";
+
+    QAtomicInt cancelled(0);
+    QMutex matchMutex;
+    RomSearchResult match;
+    match.found = false;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(qMax(1, QThread::idealThreadCount()));
+
+    searchDirectoryRecursive(appDir, GBA_ROM_SIZE, [&](const QFileInfo &fileInfo) {
+        if (abort && abort->loadRelaxed()) {
+            cancelled.storeRelaxed(1);
+        }
+        if (cancelled.loadRelaxed()) {
+            return false;
+        }
 
-    for (const QString &romPath : romsBySize) {
-        qDebug() << "Checking ROM by size:" << romPath;
-        result = tryRomFile(romPath, db);
-        if (result.found) {
-            return result;
+        QString romPath = fileInfo.absoluteFilePath();
+        qCDebug(lcRom) << "Checking ROM by size:" << romPath;
+        pool.start([this, romPath, db, &cancelled, &matchMutex, &match]() {
+            if (cancelled.loadRelaxed()) {
+                return;
+            }
+            RomSearchResult candidate = tryRomFile(romPath, db, &cancelled);
+            if (candidate.found) {
+                QMutexLocker locker(&matchMutex);
+                if (!match.found) {
+                    match = candidate;
+                    cancelled.storeRelaxed(1);
+                }
+            }
+        });
+        return true;
+    }, abort);
+
+    // Forward an external abort to the hashes still in flight
+    while (!pool.waitForDone(50)) {
+        if (abort && abort->loadRelaxed()) {
+            cancelled.storeRelaxed(1);
         }
     }
+    saveIndex();
+
+    if (match.found) {
+        return match;
+    }
 
     // Phase 3: No ROM found
     result.found = false;
-    result.errorMessage = "No valid Pokemon Gen3 ROM found in application directory";
-    qDebug() << result.errorMessage;
+    result.errorMessage = (abort && abort->loadRelaxed())
+        ? "ROM search cancelled"
+        : "No valid Pokemon Gen3 ROM found in application directory";
+    qCDebug(lcRom) << result.errorMessage;
 
     return result;
 }
@@ -3,6 +3,12 @@
 
 #include <QString>
 #include <QStringList>
+#include <QByteArray>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+#include <functional>
 
 class RomDatabase;
 
@@ -20,27 +26,65 @@ public:
     RomLoader();
     ~RomLoader();
 
-    // Search for a valid ROM in the given directory and subdirectories
-    RomSearchResult findRom(const QString &searchDir, RomDatabase *db);
+    // Search for a valid ROM in the given directory and subdirectories.
+    // Directory enumeration runs on the calling thread while candidates are
+    // hashed on a worker pool; the search stops as soon as one ROM matches,
+    // or once abort (if given) is set from another thread.
+    RomSearchResult findRom(const QString &searchDir, RomDatabase *db,
+                            const QAtomicInt *abort = nullptr);
 
-    // Compute MD5 hash of a file
+    // Compute MD5 hash of a file (memory-mapped when possible)
     static QString computeMD5(const QString &filePath);
 
+    // Compute MD5 hash of data already in memory or mapped (e.g. GBAROReader's ROM view)
+    static QString computeMD5(const QByteArray &data);
+
+    // Read the 4-character game code from the ROM header (empty if unreadable)
+    static QString readGameCode(const QString &filePath);
+
+    // Location of the persistent path -> (size, mtime, md5) index
+    static QString indexFilePath();
+
     // Expected GBA ROM size (16 MB)
     static constexpr qint64 GBA_ROM_SIZE = 16777216;
 
+    // ROM header game code location
+    static constexpr qint64 GAME_CODE_OFFSET = 0xAC;
+    static constexpr int GAME_CODE_LENGTH = 4;
+
 private:
+    // Entry in the persistent hash index; a file is only rehashed when its
+    // size or modification time changes
+    struct IndexEntry {
+        qint64 size;
+        qint64 mtime;       // Milliseconds since epoch
+        QString md5;
+    };
+
     // Get list of standard ROM filenames to check
     QStringList getStandardFilenames() const;
 
-    // Find all .gba files with expected size (recursive)
-    QStringList findRomsBySize(const QString &dir, qint64 expectedSize, bool recursive = true) const;
+    // Recursive directory search; visit() is called for each .gba file with the
+    // expected size and returns false to stop the walk, as does a set abort
+    bool searchDirectoryRecursive(const QString &dir, qint64 expectedSize,
+                                  const std::function<bool(const QFileInfo&)> &visit,
+                                  const QAtomicInt *abort, int maxDepth = 3) const;
+
+    // Try to identify and validate a ROM file (cancel may abort hashing early)
+    RomSearchResult tryRomFile(const QString &path, RomDatabase *db,
+                               const QAtomicInt *cancel = nullptr);
+
+    // MD5 via the index, hashing (and recording) only on a miss
+    QString cachedMD5(const QFileInfo &fileInfo, const QAtomicInt *cancel);
+    static QString computeMD5Cancellable(const QString &filePath, const QAtomicInt *cancel);
 
-    // Recursive directory search helper
-    void searchDirectoryRecursive(const QString &dir, qint64 expectedSize, QStringList &results, int maxDepth = 3) const;
+    // Persistent index
+    void loadIndex();
+    void saveIndex();
 
-    // Try to identify and validate a ROM file
-    RomSearchResult tryRomFile(const QString &path, RomDatabase *db);
+    QHash<QString, IndexEntry> m_index;   // Absolute path -> entry
+    QMutex m_indexMutex;
+    bool m_indexDirty;
 };
 
 #endif // ROMLOADER_H
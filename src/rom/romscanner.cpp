@@ -0,0 +1,360 @@
+/**
+ * @file romscanner.cpp
+ * @brief Implementation of the whole-ROM graphics signature scanner.
+ *
+ * Each chunk is walked once at 4-byte alignment (GBA data is word aligned):
+ * every word is tested as a ROM pointer, as the start of a pointer table, an
+ * LZ77 header and a palette. Chunk results are concatenated in chunk order,
+ * which keeps them sorted, and a single merge pass applies the reference
+ * flags and the containment rules.
+ *
+ * @see romscanner.h for the heuristics and index file
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "romscanner.h"
+#include "logcategories.h"
+#include "gbaromreader.h"
+#include "compileddata.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QThread>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QStandardPaths>
+#include <QDataStream>
+#include <QFileInfo>
+#include <QDir>
+#include <QDebug>
+#include <algorithm>
+
+// =============================================================================
+// STATIC CONSTANTS
+// =============================================================================
+
+namespace {
+const char INDEX_MAGIC[] = "MGSI";
+const char INDEX_SUFFIX[] = ".mgsi";
+const int PALETTE_BYTES = 32;   // 16 colors, BGR555
+
+/// Per-chunk output; every worker writes only its own slot.
+struct ChunkResult {
+    QVector<RomScanHit> hits;       // Sorted by offset
+    QVector<uint32_t> targets;      // ROM offsets pointed to from this chunk
+};
+
+inline uint32_t readWord(const uint8_t *p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+         | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline bool isRomPointer(uint32_t value, qint64 romSize)
+{
+    return value >= RomScanner::ROM_BASE && static_cast<qint64>(value - RomScanner::ROM_BASE) < romSize;
+}
+
+bool looksLikePalette(const uint8_t *data)
+{
+    uint16_t colors[16];
+    int distinct = 0;
+
+    for (int i = 0; i < 16; ++i) {
+        uint16_t color = static_cast<uint16_t>(data[i * 2] | (data[i * 2 + 1] << 8));
+        if (color & 0x8000) {
+            return false;   // BGR555 leaves bit 15 clear
+        }
+
+        bool seen = false;
+        for (int j = 0; j < distinct; ++j) {
+            if (colors[j] == color) {
+                seen = true;
+                break;
+            }
+        }
+        if (!seen) {
+            colors[distinct++] = color;
+        }
+    }
+
+    return distinct >= RomScanner::PALETTE_MIN_DISTINCT_COLORS;
+}
+
+void scanChunk(const GBAROReader &rom, const RomScanner::Options &options,
+               uint32_t begin, uint32_t end, ChunkResult &out)
+{
+    const uint8_t *data = rom.romBytes();
+    const qint64 romSize = rom.romSize();
+    uint32_t nextPalette = begin;
+    uint32_t nextTable = begin;
+    QString error;
+
+    for (uint32_t offset = begin; offset < end && offset + 4 <= romSize; offset += 4) {
+        const uint8_t *p = data + offset;
+        uint32_t word = readWord(p);
+        bool pointer = isRomPointer(word, romSize);
+
+        if (pointer) {
+            out.targets.append(word - RomScanner::ROM_BASE);
+        }
+
+        // LZ77: cheap header test first, then walk the stream
+        if (options.lz77 && p[0] == 0x10) {
+            uint32_t size = word >> 8;
+            if (size >= RomScanner::LZ77_MIN_SIZE && size <= GBAROReader::LZ77_MAX_SIZE) {
+                int length = rom.lz77StreamLength(offset, error);
+                if (length > 0) {
+                    out.hits.append({offset, static_cast<uint32_t>(length), size, RomScanHit::Lz77, 0, 0});
+                }
+            }
+        }
+
+        // Pointer table: only starts where the previous word is not a pointer,
+        // at the smallest stride that gives a long enough run
+        if (options.pointerTables && pointer && offset >= nextTable
+            && (offset < 4 || !isRomPointer(readWord(p - 4), romSize))) {
+            for (int stride = 4; stride <= RomScanner::MAX_TABLE_STRIDE; stride += 4) {
+                uint32_t entries = 1;
+                while (offset + entries * stride + 4 <= romSize
+                       && isRomPointer(readWord(p + entries * stride), romSize)) {
+                    ++entries;
+                }
+                if (entries >= static_cast<uint32_t>(RomScanner::MIN_TABLE_ENTRIES)) {
+                    uint32_t length = (entries - 1) * stride + 4;
+                    out.hits.append({offset, length, entries, RomScanHit::PointerTable,
+                                     static_cast<uint8_t>(stride), 0});
+                    nextTable = offset + length;
+                    break;
+                }
+            }
+        }
+
+        if (options.palettes && offset >= nextPalette && offset + PALETTE_BYTES <= romSize
+            && looksLikePalette(p)) {
+            out.hits.append({offset, PALETTE_BYTES, 16, RomScanHit::Palette, 0, 0});
+            nextPalette = offset + PALETTE_BYTES;
+        }
+    }
+}
+}
+
+// =============================================================================
+// HIT
+// =============================================================================
+
+QString RomScanHit::kindName(Kind kind)
+{
+    switch (kind) {
+        case Lz77:         return "LZ77";
+        case Palette:      return "Palette";
+        case PointerTable: return "Pointer table";
+        default:           return "Unknown";
+    }
+}
+
+// =============================================================================
+// INDEX
+// =============================================================================
+
+int RomScanIndex::count(RomScanHit::Kind kind) const
+{
+    return static_cast<int>(std::count_if(hits.cbegin(), hits.cend(),
+                                          [kind](const RomScanHit &hit) { return hit.kind == kind; }));
+}
+
+int RomScanIndex::nextHit(uint32_t offset, int kindMask) const
+{
+    auto it = std::upper_bound(hits.cbegin(), hits.cend(), offset,
+                               [](uint32_t value, const RomScanHit &hit) { return value < hit.offset; });
+    for (; it != hits.cend(); ++it) {
+        if (kindMask & (1 << it->kind)) {
+            return static_cast<int>(it - hits.cbegin());
+        }
+    }
+    return -1;
+}
+
+int RomScanIndex::previousHit(uint32_t offset, int kindMask) const
+{
+    auto it = std::lower_bound(hits.cbegin(), hits.cend(), offset,
+                               [](const RomScanHit &hit, uint32_t value) { return hit.offset < value; });
+    while (it != hits.cbegin()) {
+        --it;
+        if (kindMask & (1 << it->kind)) {
+            return static_cast<int>(it - hits.cbegin());
+        }
+    }
+    return -1;
+}
+
+QString RomScanIndex::indexFilePath(const QString &romMd5)
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/rom_scans/"
+         + romMd5.toLower() + INDEX_SUFFIX;
+}
+
+bool RomScanIndex::load(const QString &md5, QString &errorMessage)
+{
+    QByteArray payload;
+    if (!CompiledData::read(indexFilePath(md5), INDEX_MAGIC, FORMAT_VERSION, payload, errorMessage)) {
+        return false;
+    }
+
+    QDataStream stream(payload);
+    stream.setVersion(CompiledData::STREAM_VERSION);
+
+    QString fileMd5;
+    qint64 fileRomSize = 0;
+    quint32 hitCount = 0;
+    stream >> fileMd5 >> fileRomSize >> hitCount;
+    if (fileMd5.compare(md5, Qt::CaseInsensitive) != 0) {
+        errorMessage = "Scan index belongs to a different ROM";
+        return false;
+    }
+
+    QVector<RomScanHit> loaded(static_cast<int>(hitCount));
+    for (RomScanHit &hit : loaded) {
+        stream >> hit.offset >> hit.length >> hit.size >> hit.kind >> hit.stride >> hit.flags;
+    }
+    if (stream.status() != QDataStream::Ok) {
+        errorMessage = "Scan index is truncated";
+        return false;
+    }
+
+    romMd5 = fileMd5;
+    romSize = fileRomSize;
+    hits = loaded;
+    return true;
+}
+
+bool RomScanIndex::save(QString &errorMessage) const
+{
+    if (romMd5.isEmpty()) {
+        errorMessage = "Scan index has no ROM MD5";
+        return false;
+    }
+
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(CompiledData::STREAM_VERSION);
+    stream << romMd5 << romSize << static_cast<quint32>(hits.size());
+    for (const RomScanHit &hit : hits) {
+        stream << hit.offset << hit.length << hit.size << hit.kind << hit.stride << hit.flags;
+    }
+
+    QString path = indexFilePath(romMd5);
+    if (!QDir().mkpath(QFileInfo(path).absolutePath())) {
+        errorMessage = "Failed to create scan index directory: " + QFileInfo(path).absolutePath();
+        return false;
+    }
+    return CompiledData::write(path, INDEX_MAGIC, FORMAT_VERSION, payload, errorMessage);
+}
+
+// =============================================================================
+// SCANNING
+// =============================================================================
+
+RomScanIndex RomScanner::scan(const GBAROReader &rom, const Options &options,
+                              QAtomicInt *progress, const QAtomicInt *cancel)
+{
+    RomScanIndex index;
+    index.romMd5 = rom.md5();
+    index.romSize = rom.romSize();
+    if (index.romSize <= 0) {
+        return index;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    int chunkCount = static_cast<int>((index.romSize + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    QVector<ChunkResult> chunks(chunkCount);
+    ChunkResult *results = chunks.data();
+
+    int threads = options.threadCount > 0 ? options.threadCount : QThread::idealThreadCount();
+    threads = qBound(1, threads, chunkCount);
+
+    // Workers pull the next chunk from a shared cursor (see BatchInjector::run)
+    QAtomicInt cursor(0);
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    for (int worker = 0; worker < threads; ++worker) {
+        pool.start([&rom, &options, results, chunkCount, progress, cancel, &cursor]() {
+            int chunk;
+            while ((chunk = cursor.fetchAndAddRelaxed(1)) < chunkCount) {
+                if (cancel && cancel->loadRelaxed()) {
+                    return;
+                }
+                uint32_t begin = static_cast<uint32_t>(chunk) * CHUNK_SIZE;
+                scanChunk(rom, options, begin, begin + CHUNK_SIZE, results[chunk]);
+                if (progress) {
+                    progress->fetchAndAddRelaxed(static_cast<int>(CHUNK_SIZE));
+                }
+            }
+        });
+    }
+    pool.waitForDone();
+
+    // Every pointed-to offset, for the Referenced flag
+    QVector<uint32_t> targets;
+    for (const ChunkResult &chunk : chunks) {
+        targets += chunk.targets;
+    }
+    std::sort(targets.begin(), targets.end());
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+
+    // Chunks are in offset order, so the concatenation is sorted
+    uint32_t lz77End = 0;
+    uint32_t tableEnd = 0;
+    uint32_t paletteEnd = 0;
+
+    for (const ChunkResult &chunk : chunks) {
+        for (RomScanHit hit : chunk.hits) {
+            if (hit.offset < lz77End) {
+                continue;   // Inside an accepted compressed stream
+            }
+            if (std::binary_search(targets.cbegin(), targets.cend(), hit.offset)) {
+                hit.flags |= RomScanHit::Referenced;
+            }
+
+            switch (hit.kind) {
+                case RomScanHit::Lz77:
+                    lz77End = hit.end();
+                    break;
+                case RomScanHit::PointerTable:
+                    if (hit.offset < tableEnd) {
+                        continue;
+                    }
+                    tableEnd = hit.end();
+                    break;
+                case RomScanHit::Palette:
+                    if (hit.offset < tableEnd) {
+                        continue;
+                    }
+                    if (!options.unreferencedPalettes && !hit.isReferenced() && hit.offset != paletteEnd) {
+                        continue;
+                    }
+                    paletteEnd = hit.end();
+                    break;
+                default:
+                    break;
+            }
+
+            index.hits.append(hit);
+        }
+    }
+
+    qCDebug(lcRom) << "RomScanner: scanned" << index.romSize << "bytes in" << timer.elapsed() << "ms with"
+                   << threads << "threads:" << index.count(RomScanHit::Lz77) << "LZ77,"
+                   << index.count(RomScanHit::Palette) << "palettes,"
+                   << index.count(RomScanHit::PointerTable) << "pointer tables";
+    return index;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file romscanner.h
+ * @brief Whole-ROM signature scanner for graphics data, and its persistent index.
+ *
+ * Mapping graphics for a ROM revision that gen3_rom_data.yaml does not cover
+ * yet means finding tilesets, tilemaps, palettes and the tables that point at
+ * them. RomScanner walks the whole (memory-mapped) ROM once, in parallel, and
+ * records every plausible:
+ *
+ * - **LZ77 stream**: 0x10 header, sane decompressed size, and a stream that
+ *   walks to completion without an invalid back-reference.
+ * - **4bpp palette**: 16 BGR555 colors (bit 15 clear) with several distinct
+ *   values. Only palettes that are pointed to, or that directly follow a kept
+ *   palette (stdpal-style runs), are kept; tile data looks like palettes too
+ *   often otherwise.
+ * - **Pointer table**: at least MIN_TABLE_ENTRIES ROM pointers at a fixed
+ *   4-16 byte stride (plain pointer arrays, {tileset, tilemap, palette, pad}
+ *   entries, ...).
+ *
+ * Every hit whose offset is the target of some ROM pointer is flagged
+ * Referenced. Hits that fall inside an accepted LZ77 stream, or inside an
+ * accepted table, are dropped.
+ *
+ * ## Processing Model
+ * The ROM is split into fixed-size chunks; workers pull the next chunk from a
+ * shared cursor and write into that chunk's own result slot, so there is no
+ * locking. Offsets are only ever read (GBAROReader const paths), so a scan can
+ * run while the UI keeps using the same reader.
+ *
+ * ## Index File
+ * RomScanIndex stores the hits of one ROM, keyed by its MD5, as a
+ * CompiledData blob under the cache location ("rom_scans/<md5>.mgsi"), so a
+ * 16 MB ROM is only scanned once.
+ *
+ * @see TileViewer for browsing the index
+ * @see GBAROReader::lz77StreamLength
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef ROMSCANNER_H
+#define ROMSCANNER_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QString>
+#include <QVector>
+#include <QAtomicInt>
+#include <cstdint>
+
+// Forward declarations
+class GBAROReader;
+
+/// <summary>
+/// One scanner result. POD so the index loads with a single pass.
+/// </summary>
+struct RomScanHit {
+    enum Kind : uint8_t {
+        Lz77 = 0,
+        Palette = 1,
+        PointerTable = 2,
+        KindCount
+    };
+
+    enum Flag : uint8_t {
+        Referenced = 0x01   ///< Some ROM word points at this offset
+    };
+
+    uint32_t offset;   ///< ROM file offset
+    uint32_t length;   ///< Bytes covered in the ROM (stream, 32 for a palette, table span)
+    uint32_t size;     ///< LZ77: decompressed bytes; Palette: colors; PointerTable: entries
+    uint8_t kind;      ///< Kind
+    uint8_t stride;    ///< PointerTable: bytes per entry; 0 otherwise
+    uint8_t flags;     ///< Flag bits
+
+    uint32_t end() const { return offset + length; }
+    bool isReferenced() const { return flags & Referenced; }
+
+    static QString kindName(Kind kind);
+};
+
+/// <summary>
+/// Scanner results for one ROM, sorted by offset.
+///
+/// USAGE:
+///   RomScanIndex index;
+///   if (!index.load(reader->md5(), error)) {
+///       index = RomScanner::scan(*reader);
+///       index.save(error);
+///   }
+///   int next = index.nextHit(currentOffset, 1 << RomScanHit::Lz77);
+/// </summary>
+class RomScanIndex
+{
+public:
+    QString romMd5;
+    qint64 romSize = 0;
+    QVector<RomScanHit> hits;
+
+    bool isEmpty() const { return hits.isEmpty(); }
+    int count(RomScanHit::Kind kind) const;
+
+    // Index of the first hit after / last hit before offset whose kind is in kindMask
+    // (bit per RomScanHit::Kind); -1 if there is none
+    int nextHit(uint32_t offset, int kindMask = ALL_KINDS) const;
+    int previousHit(uint32_t offset, int kindMask = ALL_KINDS) const;
+
+    // Persistence (see Index File above)
+    bool load(const QString &romMd5, QString &errorMessage);
+    bool save(QString &errorMessage) const;
+    static QString indexFilePath(const QString &romMd5);
+
+    // Constants
+    static const int ALL_KINDS = (1 << RomScanHit::KindCount) - 1;
+    static const uint32_t FORMAT_VERSION = 1;   // Bump when the heuristics or layout change
+};
+
+/**
+ * @class RomScanner
+ * @brief Parallel LZ77 / palette / pointer table scan over a loaded ROM.
+ */
+class RomScanner
+{
+public:
+    /// <summary>
+    /// What to look for. Defaults find everything worth mapping.
+    /// </summary>
+    struct Options {
+        bool lz77 = true;
+        bool palettes = true;
+        bool pointerTables = true;
+        bool unreferencedPalettes = false;   ///< Keep every palette-like block (noisy)
+        int threadCount = 0;                 ///< <= 0: QThread::idealThreadCount()
+    };
+
+    // Scan the whole ROM. progress (optional) is advanced by the bytes scanned;
+    // setting cancel (optional) to nonzero stops early with a partial index.
+    static RomScanIndex scan(const GBAROReader &rom, const Options &options = Options(),
+                             QAtomicInt *progress = nullptr, const QAtomicInt *cancel = nullptr);
+
+    // Constants
+    static const uint32_t CHUNK_SIZE = 0x10000;         // 64 KB per work item
+    static const uint32_t LZ77_MIN_SIZE = 32;           // One 4bpp tile
+    static const int PALETTE_MIN_DISTINCT_COLORS = 4;
+    static const int MIN_TABLE_ENTRIES = 4;
+    static const int MAX_TABLE_STRIDE = 16;
+    static const uint32_t ROM_BASE = 0x08000000;        // GBA address of ROM offset 0
+};
+
+#endif // ROMSCANNER_H
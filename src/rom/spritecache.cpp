@@ -0,0 +1,201 @@
+/**
+ * @file spritecache.cpp
+ * @brief Implementation of the shared LRU sprite cache.
+ *
+ * Lookups and inserts hold a short mutex around a QCache (which already
+ * implements least-recently-used eviction by cost). Decoding happens outside
+ * the lock, so a slow miss on one thread never blocks hits on another. A miss
+ * claims its key in a pending set under the same lock as the cache check, so
+ * each icon is decoded once: icon() waits for a decode already in flight,
+ * the prefetch skips it.
+ *
+ * @see spritecache.h for lifetime and threading rules
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "spritecache.h"
+#include "logcategories.h"
+#include "gbaromreader.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QDebug>
+
+// =============================================================================
+// CONSTRUCTOR & DESTRUCTOR
+// =============================================================================
+
+SpriteCache &SpriteCache::instance()
+{
+    static SpriteCache cache;
+    return cache;
+}
+
+SpriteCache::SpriteCache()
+    : m_icons(DEFAULT_CAPACITY)
+    , m_cancelPrefetch(0)
+    , m_prefetchReader(nullptr)
+{
+    m_prefetchPool.setMaxThreadCount(1);
+}
+
+SpriteCache::~SpriteCache()
+{
+    m_cancelPrefetch.storeRelaxed(1);
+    m_prefetchPool.waitForDone();
+}
+
+// =============================================================================
+// LOOKUP
+// =============================================================================
+
+QImage SpriteCache::cachedIcon(const QString &romMd5, uint16_t species) const
+{
+    QMutexLocker locker(&m_mutex);
+    const QImage *image = m_icons.object(Key(romMd5, species));
+    return image ? *image : QImage();
+}
+
+QImage SpriteCache::icon(GBAROReader *reader, uint16_t species)
+{
+    if (!reader || !reader->isLoaded()) {
+        return QImage();
+    }
+
+    Key key(reader->md5(), species);
+    QImage image;
+    if (!claim(key, image, true)) {
+        return image;
+    }
+
+    // Decode outside the lock
+    image = reader->extractPokemonIcon(species);
+    finish(key, image);
+    return image;
+}
+
+bool SpriteCache::claim(const Key &key, QImage &cached, bool wait)
+{
+    QMutexLocker locker(&m_mutex);
+    for (;;) {
+        if (const QImage *image = m_icons.object(key)) {
+            cached = *image;
+            return false;
+        }
+        if (!m_pending.contains(key)) {
+            m_pending.insert(key);
+            return true;
+        }
+        if (!wait) {
+            return false;
+        }
+        m_decodeFinished.wait(&m_mutex);
+    }
+}
+
+void SpriteCache::finish(const Key &key, const QImage &image)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!image.isNull()) {
+        m_icons.insert(key, new QImage(image));
+    }
+    m_pending.remove(key);
+    m_decodeFinished.wakeAll();
+}
+
+// =============================================================================
+// PREFETCH
+// =============================================================================
+
+void SpriteCache::prefetchIcons(GBAROReader *reader, uint16_t lastSpecies)
+{
+    if (!reader || !reader->isLoaded()) {
+        return;
+    }
+
+    // One prefetch at a time: stop the previous one first
+    {
+        QMutexLocker locker(&m_prefetchMutex);
+        m_cancelPrefetch.storeRelaxed(1);
+    }
+    m_prefetchPool.waitForDone();
+
+    QMutexLocker locker(&m_prefetchMutex);
+    m_cancelPrefetch.storeRelaxed(0);
+    m_prefetchReader = reader;
+
+    QString md5 = reader->md5();
+    m_prefetchPool.start([this, reader, md5, lastSpecies]() {
+        QElapsedTimer timer;
+        timer.start();
+        int decoded = 0;
+
+        for (uint32_t species = 0; species <= lastSpecies; ++species) {
+            if (m_cancelPrefetch.loadRelaxed()) {
+                qCDebug(lcRom) << "SpriteCache: icon prefetch cancelled after" << decoded << "icons";
+                return;
+            }
+            Key key(md5, static_cast<uint16_t>(species));
+            QImage image;
+            if (!claim(key, image, false)) {
+                continue;  // Cached, or being decoded by icon()
+            }
+            image = reader->extractPokemonIcon(static_cast<uint16_t>(species));
+            finish(key, image);
+            if (!image.isNull()) {
+                ++decoded;
+            }
+        }
+
+        qCDebug(lcRom) << "SpriteCache: prefetched" << decoded << "icons in" << timer.elapsed() << "ms";
+    });
+}
+
+void SpriteCache::cancelPrefetch(GBAROReader *reader)
+{
+    {
+        QMutexLocker locker(&m_prefetchMutex);
+        if (m_prefetchReader != reader) {
+            return;
+        }
+        m_cancelPrefetch.storeRelaxed(1);
+        m_prefetchReader = nullptr;
+    }
+    m_prefetchPool.waitForDone();
+}
+
+// =============================================================================
+// CAPACITY
+// =============================================================================
+
+void SpriteCache::setCapacity(int entries)
+{
+    QMutexLocker locker(&m_mutex);
+    m_icons.setMaxCost(qMax(1, entries));
+}
+
+int SpriteCache::capacity() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_icons.maxCost();
+}
+
+int SpriteCache::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_icons.size();
+}
+
+void SpriteCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_icons.clear();
+}
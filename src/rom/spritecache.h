@@ -0,0 +1,110 @@
+/**
+ * @file spritecache.h
+ * @brief Process-wide, thread-safe LRU cache of decoded ROM sprites.
+ *
+ * Every preview (WonderCardRenderer, EditableWonderCardWidget,
+ * AuthenticWonderCardWidget) shows Pokemon icons decoded from the ROM.
+ * SpriteCache holds those decoded icons once for the whole process, keyed by
+ * ROM MD5 and species, with a bounded least-recently-used eviction policy so
+ * switching between ROMs cannot grow it without limit.
+ *
+ * ## Prefetching
+ * prefetchIcons() decodes the full icon set on a background thread right
+ * after a ROM is loaded, so scrolling the species spinner only ever hits the
+ * cache. GBAROReader cancels (and waits for) any prefetch that uses it before
+ * it unloads or reloads its ROM, so a prefetch never reads a stale mapping.
+ *
+ * ## Thread Safety
+ * All public methods may be called from any thread. Entries are QImages
+ * (implicitly shared, safe to hand across threads); GUI callers convert to
+ * QPixmap themselves.
+ *
+ * @see GBAROReader::extractPokemonIcon for the decoder
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef SPRITECACHE_H
+#define SPRITECACHE_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QString>
+#include <QImage>
+#include <QCache>
+#include <QPair>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QSet>
+#include <QAtomicInt>
+#include <QThreadPool>
+#include <cstdint>
+
+// Forward declarations
+class GBAROReader;
+
+/**
+ * @class SpriteCache
+ * @brief Shared icon cache with background prefetch.
+ *
+ * USAGE:
+ *   QImage icon = SpriteCache::instance().icon(reader, species);
+ *   SpriteCache::instance().prefetchIcons(reader);   // after loadROM()
+ */
+class SpriteCache
+{
+public:
+    static SpriteCache &instance();
+
+    // Icon for a species of the reader's ROM (decoded on a miss; null if unavailable)
+    QImage icon(GBAROReader *reader, uint16_t species);
+
+    // Cached icon only (never decodes)
+    QImage cachedIcon(const QString &romMd5, uint16_t species) const;
+
+    // Decode species 0..lastSpecies in the background; replaces any running prefetch
+    void prefetchIcons(GBAROReader *reader, uint16_t lastSpecies = DEFAULT_PREFETCH_LAST);
+
+    // Stop a prefetch that reads from reader and wait for it (no-op otherwise)
+    void cancelPrefetch(GBAROReader *reader);
+
+    // Capacity in entries (least recently used entries are evicted)
+    void setCapacity(int entries);
+    int capacity() const;
+    int size() const;
+    void clear();
+
+    // Constants
+    static const int DEFAULT_CAPACITY = 1024;            // Two full icon sets
+    static const uint16_t DEFAULT_PREFETCH_LAST = 412;   // Highest species with its own icon
+
+private:
+    SpriteCache();
+    ~SpriteCache();
+
+    SpriteCache(const SpriteCache&) = delete;
+    SpriteCache& operator=(const SpriteCache&) = delete;
+
+    typedef QPair<QString, uint16_t> Key;   // (ROM MD5, species)
+
+    // Miss handling: claim() checks the cache and reserves the key in one
+    // locked step (false = cached, or pending and not waited for); finish()
+    // stores the decoded image (if any) and releases the key
+    bool claim(const Key &key, QImage &cached, bool wait);
+    void finish(const Key &key, const QImage &image);
+
+    mutable QMutex m_mutex;
+    QCache<Key, QImage> m_icons;
+    QSet<Key> m_pending;               // Keys being decoded; guarded by m_mutex
+    QWaitCondition m_decodeFinished;   // Signalled by finish()
+
+    // Single background prefetch at a time
+    QThreadPool m_prefetchPool;
+    QAtomicInt m_cancelPrefetch;
+    GBAROReader *m_prefetchReader;   // Guarded by m_prefetchMutex
+    QMutex m_prefetchMutex;
+};
+
+#endif // SPRITECACHE_H
@@ -0,0 +1,196 @@
+/**
+ * @file tilecompositor.cpp
+ * @brief Implementation of the indexed GBA background compositor.
+ *
+ * 4bpp rows are 4 bytes (8 pixels). Each byte expands to two indices via a
+ * 256-entry table, so a tile row is four table lookups and four 16-bit
+ * stores; horizontal flips use a second table with the nibbles swapped and
+ * walk the row bytes backwards. The inner loops are branch-free and work on
+ * plain byte pointers, which compilers vectorize well.
+ *
+ * @see tilecompositor.h for the pixel encoding
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "tilecompositor.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <cstring>
+
+namespace {
+
+const int TILE_BYTES = 32;
+const int TILE_BYTES_2BPP = 16;
+const int ROW_BYTES = 4;
+
+// Byte -> two pixel indices, stored in memory order (left pixel first)
+struct NibbleTables {
+    uint8_t normal[256][2];
+    uint8_t flipped[256][2];
+
+    NibbleTables()
+    {
+        for (int b = 0; b < 256; ++b) {
+            // Low nibble = left pixel, high nibble = right pixel
+            normal[b][0] = static_cast<uint8_t>(b & 0x0F);
+            normal[b][1] = static_cast<uint8_t>(b >> 4);
+            flipped[b][0] = normal[b][1];
+            flipped[b][1] = normal[b][0];
+        }
+    }
+};
+
+const NibbleTables &nibbleTables()
+{
+    static const NibbleTables tables;
+    return tables;
+}
+
+} // namespace
+
+// =============================================================================
+// TILE DECODING
+// =============================================================================
+
+void TileCompositor::decodeTile4bpp(const uint8_t *tile, uint8_t *dest, int destStride,
+                                    uint8_t paletteBank, bool hFlip, bool vFlip)
+{
+    const NibbleTables &tables = nibbleTables();
+    const uint8_t bank = static_cast<uint8_t>(paletteBank << 4);
+
+    for (int y = 0; y < 8; ++y) {
+        const uint8_t *src = tile + (vFlip ? 7 - y : y) * ROW_BYTES;
+        uint8_t *out = dest + y * destStride;
+
+        if (hFlip) {
+            for (int i = 0; i < ROW_BYTES; ++i) {
+                const uint8_t *pair = tables.flipped[src[ROW_BYTES - 1 - i]];
+                out[i * 2] = pair[0] | bank;
+                out[i * 2 + 1] = pair[1] | bank;
+            }
+        } else {
+            for (int i = 0; i < ROW_BYTES; ++i) {
+                const uint8_t *pair = tables.normal[src[i]];
+                out[i * 2] = pair[0] | bank;
+                out[i * 2 + 1] = pair[1] | bank;
+            }
+        }
+    }
+}
+
+void TileCompositor::decodeTile2bpp(const uint8_t *tile, uint8_t *dest, int destStride)
+{
+    // Same layout as GBAROReader::decode2bppTiles
+    for (int i = 0; i < TILE_BYTES_2BPP; ++i) {
+        uint8_t raw = tile[i];
+        uint8_t *out = dest + (i / 2) * destStride + (1 - (i % 2)) * 4;
+        out[0] = (raw >> 6) & 3;
+        out[1] = (raw >> 4) & 3;
+        out[2] = (raw >> 2) & 3;
+        out[3] = raw & 3;
+    }
+}
+
+void TileCompositor::decodeTileSheet4bpp(Framebuffer &fb, const uint8_t *tiles, int tileCount)
+{
+    int tilesX = fb.width / 8;
+    int tilesY = fb.height / 8;
+
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            int tileIndex = ty * tilesX + tx;
+            if (tileIndex >= tileCount) {
+                return;
+            }
+            decodeTile4bpp(tiles + tileIndex * TILE_BYTES, fb.scanLine(ty * 8) + tx * 8, fb.width);
+        }
+    }
+}
+
+void TileCompositor::composeTilemap(Framebuffer &fb, const uint8_t *tiles, int tileCount,
+                                    const uint8_t *tilemap, int mapEntries, int mapWidth, int mapHeight,
+                                    bool applyPaletteBanks, uint8_t fillIndex)
+{
+    int tilesX = qMin(mapWidth, fb.width / 8);
+    int tilesY = qMin(mapHeight, fb.height / 8);
+
+    for (int ty = 0; ty < tilesY; ++ty) {
+        for (int tx = 0; tx < tilesX; ++tx) {
+            int mapIndex = ty * mapWidth + tx;
+            uint8_t *dest = fb.scanLine(ty * 8) + tx * 8;
+
+            // Screen entry: tile (bits 0-9), hflip (10), vflip (11), palette bank (12-15)
+            int tileNum = tileCount;
+            uint16_t value = 0;
+            if (mapIndex < mapEntries) {
+                value = static_cast<uint16_t>(tilemap[mapIndex * 2] | (tilemap[mapIndex * 2 + 1] << 8));
+                tileNum = value & 0x3FF;
+            }
+
+            if (tileNum >= tileCount) {
+                for (int y = 0; y < 8; ++y) {
+                    std::memset(dest + y * fb.width, fillIndex, 8);
+                }
+                continue;
+            }
+
+            uint8_t bank = applyPaletteBanks ? static_cast<uint8_t>(value >> 12) : 0;
+            decodeTile4bpp(tiles + tileNum * TILE_BYTES, dest, fb.width,
+                           bank, (value & 0x400) != 0, (value & 0x800) != 0);
+        }
+    }
+}
+
+// =============================================================================
+// PALETTE CONVERSION
+// =============================================================================
+
+void TileCompositor::paletteLut(const QVector<QRgb> &palette, PaletteLut &lut)
+{
+    for (int i = 0; i < 256; ++i) {
+        if (i < palette.size()) {
+            lut[i] = palette.at(i);
+        } else {
+            int fallback = i & 0x0F;
+            lut[i] = fallback < palette.size() ? palette.at(fallback) : qRgba(0, 0, 0, 0);
+        }
+    }
+}
+
+QImage TileCompositor::toArgb(const Framebuffer &fb, const PaletteLut &lut)
+{
+    if (fb.isNull()) {
+        return QImage();
+    }
+
+    QImage result(fb.width, fb.height, QImage::Format_ARGB32);
+    for (int y = 0; y < fb.height; ++y) {
+        const uint8_t *src = fb.scanLine(y);
+        QRgb *dest = reinterpret_cast<QRgb*>(result.scanLine(y));
+        for (int x = 0; x < fb.width; ++x) {
+            dest[x] = lut[src[x]];
+        }
+    }
+    return result;
+}
+
+QImage TileCompositor::toIndexed8(const Framebuffer &fb, const QVector<QRgb> &colorTable)
+{
+    if (fb.isNull()) {
+        return QImage();
+    }
+
+    QImage result(fb.width, fb.height, QImage::Format_Indexed8);
+    result.setColorTable(colorTable);
+    for (int y = 0; y < fb.height; ++y) {
+        std::memcpy(result.scanLine(y), fb.scanLine(y), fb.width);
+    }
+    return result;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file tilecompositor.h
+ * @brief GBA-style background compositor over palette-indexed framebuffers.
+ *
+ * The GBA draws backgrounds by looking up 8x8 4bpp tiles through a tilemap
+ * (tile number, horizontal/vertical flip, palette bank) into a 256-color
+ * palette. TileCompositor does the same in software: tiles are decoded
+ * straight into one contiguous 8-bit indexed framebuffer, and palette
+ * colors are applied exactly once at the end through a 256-entry lookup
+ * table. No per-tile QImage, QPainter or setPixel() calls are involved.
+ *
+ * ## Pixel Encoding
+ * Framebuffer values are full palette indices, (bank << 4) | color, so a
+ * single buffer can mix all 16 palette banks. Callers that render with a
+ * single 16-color palette pass applyPaletteBanks = false (values 0-15).
+ *
+ * ## Thread Safety
+ * All functions are static and re-entrant; each call only touches the
+ * framebuffer it is given.
+ *
+ * @see GBAROReader::renderWonderCard, GBAROReader::extractTile4bpp
+ * @see TileSheetView::decodeRows
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef TILECOMPOSITOR_H
+#define TILECOMPOSITOR_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QImage>
+#include <QVector>
+#include <cstdint>
+
+/**
+ * @class TileCompositor
+ * @brief Decodes 4bpp/2bpp tiles and tilemaps into indexed framebuffers.
+ *
+ * USAGE:
+ *   TileCompositor::Framebuffer fb(240, 160);
+ *   TileCompositor::composeTilemap(fb, tiles, tileCount, map, mapEntries, 30, 20, true);
+ *   TileCompositor::PaletteLut lut;
+ *   TileCompositor::paletteLut(palette, lut);
+ *   QImage card = TileCompositor::toArgb(fb, lut);
+ */
+class TileCompositor
+{
+public:
+    /// 8-bit indexed framebuffer with tightly packed scanlines.
+    struct Framebuffer {
+        Framebuffer() : width(0), height(0) {}
+        Framebuffer(int w, int h, uint8_t fill = 0)
+            : width(w), height(h), pixels(w * h, fill) {}
+
+        uint8_t *scanLine(int y) { return pixels.data() + y * width; }
+        const uint8_t *scanLine(int y) const { return pixels.constData() + y * width; }
+        bool isNull() const { return width <= 0 || height <= 0; }
+
+        int width;
+        int height;
+        QVector<uint8_t> pixels;
+    };
+
+    typedef QRgb PaletteLut[256];
+
+    // Decode one 8x8 4bpp tile (32 bytes) at dest, with optional flips
+    static void decodeTile4bpp(const uint8_t *tile, uint8_t *dest, int destStride,
+                               uint8_t paletteBank = 0, bool hFlip = false, bool vFlip = false);
+
+    // Decode one 8x8 2bpp tile (16 bytes, font layout: byte pairs hold the
+    // right then left half of a row, pixels MSB first) at dest
+    static void decodeTile2bpp(const uint8_t *tile, uint8_t *dest, int destStride);
+
+    // Lay out consecutive tiles left-to-right, top-to-bottom (tiles past
+    // tileCount keep the framebuffer's existing contents)
+    static void decodeTileSheet4bpp(Framebuffer &fb, const uint8_t *tiles, int tileCount);
+
+    // Compose a BG tilemap (16-bit GBA screen entries) of mapWidth x mapHeight
+    // tiles. Entries whose tile is out of range are filled with fillIndex.
+    static void composeTilemap(Framebuffer &fb, const uint8_t *tiles, int tileCount,
+                               const uint8_t *tilemap, int mapEntries, int mapWidth, int mapHeight,
+                               bool applyPaletteBanks, uint8_t fillIndex = 0);
+
+    // Expand a palette to a full 256-entry table. Indices past the palette
+    // reuse the color with the same low nibble (bank 0 fallback).
+    static void paletteLut(const QVector<QRgb> &palette, PaletteLut &lut);
+
+    // Final conversion, performed once per image
+    static QImage toArgb(const Framebuffer &fb, const PaletteLut &lut);
+    static QImage toIndexed8(const Framebuffer &fb, const QVector<QRgb> &colorTable);
+};
+
+#endif // TILECOMPOSITOR_H
@@ -0,0 +1,311 @@
+/**
+ * @file scriptanalyzer.cpp
+ * @brief Implementation of the parallel GMScript analyzer.
+ *
+ * @see scriptanalyzer.h for the report contents and the processing model
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "scriptanalyzer.h"
+#include "savefile.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QThread>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <algorithm>
+
+namespace {
+
+const int RAMSCRIPT_HEADER_SIZE = 4;
+const uint8_t RAM_SCRIPT_MAGIC = 0x33;
+
+// Script variable used by the giveitem macro (setorcopyvar VAR_0x8000, item)
+const uint16_t VAR_SPECIAL_0 = 0x8000;
+
+// Insert keeping the vector sorted and unique (scripts touch few IDs)
+void addUnique(QVector<uint16_t> &values, uint16_t value)
+{
+    auto it = std::lower_bound(values.begin(), values.end(), value);
+    if (it == values.end() || *it != value) {
+        values.insert(it, value);
+    }
+}
+
+bool isExternalAddress(uint32_t address)
+{
+    // ROM (scripts shipped with the game) or EWRAM
+    return (address >= 0x08000000 && address < 0x0A000000)
+        || (address >= 0x02000000 && address < 0x02040000);
+}
+
+} // namespace
+
+// =============================================================================
+// CONSTRUCTOR
+// =============================================================================
+
+ScriptAnalyzer::ScriptAnalyzer(const ScriptDisassembler &disassembler)
+    : m_disassembler(disassembler)
+    , m_threadCount(0)
+{
+}
+
+int ScriptAnalyzer::threadCount() const
+{
+    return m_threadCount > 0 ? m_threadCount : qMax(1, QThread::idealThreadCount());
+}
+
+QVector<ScriptSource> ScriptAnalyzer::sourcesForSaves(const QStringList &savePaths)
+{
+    QVector<ScriptSource> sources;
+    sources.reserve(savePaths.size());
+    for (const QString &path : savePaths) {
+        ScriptSource source;
+        source.name = path;
+        source.savePath = path;
+        sources.append(source);
+    }
+    return sources;
+}
+
+// =============================================================================
+// ANALYSIS
+// =============================================================================
+
+bool ScriptAnalyzer::isJumpTargetValid(const DecodedScript &script, int scriptSize,
+                                       const ScriptInstruction &instr) const
+{
+    uint32_t address;
+    bool isVirtual;
+    if (!ScriptDisassembler::jumpOperand(instr, address, isVirtual)) {
+        return true;
+    }
+
+    uint32_t target = address;
+    if (isVirtual) {
+        if (script.inferredBase == 0 || address < script.inferredBase) {
+            return false;
+        }
+        target = address - script.inferredBase;
+    } else if (isExternalAddress(address)) {
+        return true;
+    }
+
+    return target < static_cast<uint32_t>(scriptSize)
+        && ScriptDisassembler::instructionAt(script, static_cast<int>(target)) >= 0;
+}
+
+ScriptAnalysis ScriptAnalyzer::analyze(const QString &name, const QByteArray &ramScript,
+                                       DecodedScript &buffer) const
+{
+    ScriptAnalysis analysis;
+    analysis.source = name;
+
+    if (ramScript.size() <= RAMSCRIPT_HEADER_SIZE) {
+        analysis.errorMessage = QString("RamScript too small: %1 bytes").arg(ramScript.size());
+        return analysis;
+    }
+
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*>(ramScript.constData());
+    analysis.hasScript = (bytes[0] == RAM_SCRIPT_MAGIC);
+    analysis.mapGroup = bytes[1];
+    analysis.mapNum = bytes[2];
+    analysis.objectId = bytes[3];
+    if (!analysis.hasScript) {
+        return analysis;  // Empty slot; nothing would run
+    }
+
+    int scriptSize = ramScript.size() - RAMSCRIPT_HEADER_SIZE;
+    m_disassembler.decode(bytes + RAMSCRIPT_HEADER_SIZE, scriptSize, buffer);
+    analysis.instructionCount = buffer.instructions.size();
+    analysis.inferredBase = buffer.inferredBase;
+
+    // Last immediate written to VAR_0x8000, for giveitem (callstd STD_OBTAIN_ITEM)
+    int pendingItem = -1;
+
+    for (const ScriptInstruction &instr : buffer.instructions) {
+        if (instr.kind == ScriptInstruction::End) {
+            analysis.terminated = true;
+            break;
+        }
+        if (instr.kind == ScriptInstruction::Unknown) {
+            analysis.unknownOpcodes.append(instr.offset);
+            continue;
+        }
+
+        for (int i = 0; i < instr.argCount; ++i) {
+            if (instr.argTypes[i] == ScriptArgType::Var && instr.args[i] >= 0x4000) {
+                addUnique(analysis.vars, static_cast<uint16_t>(instr.args[i]));
+            }
+        }
+
+        if (!isJumpTargetValid(buffer, scriptSize, instr)) {
+            analysis.badJumps.append(instr.offset);
+        }
+
+        if (instr.argCount == 0) {
+            continue;
+        }
+        uint16_t arg0 = static_cast<uint16_t>(instr.args[0]);
+
+        switch (instr.opcode) {
+            case 0x29: // setflag
+                addUnique(analysis.flagsSet, arg0);
+                break;
+            case 0x2A: // clearflag
+                addUnique(analysis.flagsCleared, arg0);
+                break;
+            case 0x2B: // checkflag
+                addUnique(analysis.flagsChecked, arg0);
+                break;
+            case 0x25: // special
+                addUnique(analysis.specials, arg0);
+                break;
+            case 0x44: // additem
+                addUnique(analysis.itemsGiven, arg0);
+                break;
+            case 0x16: // setvar
+            case 0x1A: // setorcopyvar
+                if (arg0 == VAR_SPECIAL_0 && instr.argCount > 1) {
+                    pendingItem = (instr.args[1] < 0x4000) ? static_cast<int>(instr.args[1]) : -1;
+                }
+                break;
+            case 0x08: // gotostd
+            case 0x09: // callstd
+                if ((arg0 == 0 || arg0 == 1) && pendingItem > 0) {  // STD_OBTAIN_ITEM / STD_FIND_ITEM
+                    addUnique(analysis.itemsGiven, static_cast<uint16_t>(pendingItem));
+                }
+                break;
+        }
+    }
+
+    return analysis;
+}
+
+ScriptAnalysisReport ScriptAnalyzer::run(const QVector<ScriptSource> &sources) const
+{
+    ScriptAnalysisReport report;
+    report.total = sources.size();
+    report.threadCount = qMin(threadCount(), qMax(1, report.total));
+    report.results.resize(report.total);
+
+    if (report.total == 0) {
+        return report;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Each worker keeps one SaveFile and one decode buffer for the whole run
+    // and pulls the next index from a shared cursor (see BatchInjector::run)
+    QAtomicInt cursor(0);
+    ScriptAnalysis *results = report.results.data();
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(report.threadCount);
+
+    for (int worker = 0; worker < report.threadCount; ++worker) {
+        pool.start([this, &sources, results, &cursor]() {
+            SaveFile saveFile;
+            DecodedScript buffer;
+            int index;
+            while ((index = cursor.fetchAndAddRelaxed(1)) < sources.size()) {
+                const ScriptSource &source = sources.at(index);
+                if (!source.ramScript.isEmpty()) {
+                    results[index] = analyze(source.name, source.ramScript, buffer);
+                    continue;
+                }
+
+                QString errorMessage;
+                QByteArray ramScript;
+                if (saveFile.loadFromFile(source.savePath, errorMessage)) {
+                    ramScript = saveFile.extractScript(errorMessage);
+                }
+                if (ramScript.isEmpty()) {
+                    results[index].source = source.name;
+                    results[index].errorMessage = errorMessage;
+                    continue;
+                }
+                results[index] = analyze(source.name, ramScript, buffer);
+            }
+        });
+    }
+
+    pool.waitForDone();
+    report.elapsedMs = timer.elapsed();
+
+    for (const ScriptAnalysis &analysis : report.results) {
+        if (analysis.hasScript) {
+            ++report.withScript;
+        }
+        if (analysis.isClean()) {
+            ++report.clean;
+        }
+    }
+
+    return report;
+}
+
+// =============================================================================
+// REPORT
+// =============================================================================
+
+QString ScriptAnalyzer::joinValues(const QVector<uint16_t> &values, ScriptArgType type) const
+{
+    QStringList parts;
+    for (uint16_t value : values) {
+        parts << m_disassembler.formatValue(value, type);
+    }
+    return parts.join(' ');
+}
+
+void ScriptAnalyzer::writeReport(const ScriptAnalysisReport &report, QTextStream &out) const
+{
+    out << "source\tstatus\tmap\tinstructions\tterminated\tvbase\tflags_set\tflags_cleared\t"
+           "flags_checked\tvars\tspecials\titems_given\tunknown_opcodes\tbad_jumps" << Qt::endl;
+
+    for (const ScriptAnalysis &a : report.results) {
+        QString status = !a.isValid() ? "error" : !a.hasScript ? "empty" : a.isClean() ? "ok" : "lint";
+
+        QStringList specials;
+        for (uint16_t id : a.specials) {
+            QString name = m_disassembler.specialName(id);
+            specials << (name.isEmpty() ? QString("0x%1").arg(id, 4, 16, QChar('0')) : name);
+        }
+
+        QStringList unknown;
+        for (int offset : a.unknownOpcodes) {
+            unknown << QString("0x%1").arg(offset, 3, 16, QChar('0'));
+        }
+        QStringList jumps;
+        for (int offset : a.badJumps) {
+            jumps << QString("0x%1").arg(offset, 3, 16, QChar('0'));
+        }
+
+        QStringList row;
+        row << a.source
+            << (a.isValid() ? status : status + ": " + a.errorMessage)
+            << QString("%1.%2.%3").arg(a.mapGroup).arg(a.mapNum).arg(a.objectId)
+            << QString::number(a.instructionCount)
+            << (a.terminated ? "yes" : "no")
+            << (a.inferredBase ? QString("0x%1").arg(a.inferredBase, 8, 16, QChar('0')) : QString())
+            << joinValues(a.flagsSet, ScriptArgType::Flag)
+            << joinValues(a.flagsCleared, ScriptArgType::Flag)
+            << joinValues(a.flagsChecked, ScriptArgType::Flag)
+            << joinValues(a.vars, ScriptArgType::Var)
+            << specials.join(' ')
+            << joinValues(a.itemsGiven, ScriptArgType::Item)
+            << unknown.join(' ')
+            << jumps.join(' ');
+        out << row.join('\t') << Qt::endl;
+    }
+}
@@ -0,0 +1,138 @@
+/**
+ * @file scriptanalyzer.h
+ * @brief Parallel lint/audit of GMScripts (RamScripts) across saves and tickets.
+ *
+ * ScriptAnalyzer decodes every script with ScriptDisassembler::decode() and
+ * reports, per script, what it touches (flags set/cleared/checked, script
+ * variables, specials, items given) and whether it is well formed (RamScript
+ * magic, terminating `end`, unknown opcodes, jump graph). No text is
+ * disassembled, so whole corpora can be audited before injection.
+ *
+ * ## Processing Model
+ * Same as BatchInjector: a QThreadPool of workers pulls indices from an
+ * atomic cursor. Each worker owns one SaveFile and one DecodedScript for the
+ * entire run, and writes its results into pre-sized slots without locking.
+ * The shared ScriptDisassembler is only read.
+ *
+ * ## Jump Graph
+ * A jump/call target is valid when it lands on an instruction start inside
+ * the script, or (for direct jumps) points into ROM or EWRAM outside the
+ * script. Virtual jumps need a preceding setvaddress.
+ *
+ * @see ScriptDisassembler for decoding
+ * @see main_batch.cpp (--analyze) for the columnar report
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef SCRIPTANALYZER_H
+#define SCRIPTANALYZER_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QVector>
+#include <QTextStream>
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "scriptdisassembler.h"
+
+/// <summary>
+/// One script to analyze: a save file, or an in-memory RamScript (tickets).
+/// </summary>
+struct ScriptSource {
+    QString name;            // Save path or ticket ID
+    QString savePath;        // Loaded by the worker when ramScript is empty
+    QByteArray ramScript;    // 1000-byte RamScript (magic, map, object, bytecode)
+};
+
+/// <summary>
+/// Everything one script touches, plus its lint findings.
+/// </summary>
+struct ScriptAnalysis {
+    QString source;                  // ScriptSource::name
+    QString errorMessage;            // Set when the script could not be read
+    bool hasScript = false;          // RamScript magic present (0x33)
+    uint8_t mapGroup = 0;
+    uint8_t mapNum = 0;
+    uint8_t objectId = 0;
+    int instructionCount = 0;
+    bool terminated = false;         // Decoding reached `end`
+    uint32_t inferredBase = 0;       // From setvaddress (0 if none)
+
+    QVector<uint16_t> flagsSet;
+    QVector<uint16_t> flagsCleared;
+    QVector<uint16_t> flagsChecked;
+    QVector<uint16_t> vars;          // Script variables (>= 0x4000) read or written
+    QVector<uint16_t> specials;
+    QVector<uint16_t> itemsGiven;    // additem, or giveitem via STD_OBTAIN/FIND_ITEM
+    QVector<int> unknownOpcodes;     // Offsets of undefined opcodes
+    QVector<int> badJumps;           // Offsets of jumps/calls with invalid targets
+
+    bool isValid() const { return errorMessage.isEmpty(); }
+    bool jumpGraphValid() const { return badJumps.isEmpty(); }
+
+    /// Well formed: readable, terminated, no unknown opcodes or bad jumps
+    bool isClean() const {
+        return isValid() && (!hasScript || (terminated && unknownOpcodes.isEmpty() && badJumps.isEmpty()));
+    }
+};
+
+/// <summary>
+/// Aggregate results of one ScriptAnalyzer::run() call.
+/// </summary>
+struct ScriptAnalysisReport {
+    int total = 0;           // Sources submitted
+    int withScript = 0;      // Sources holding a RamScript
+    int clean = 0;           // Sources passing ScriptAnalysis::isClean()
+    int threadCount = 0;     // Worker threads used
+    qint64 elapsedMs = 0;    // Wall-clock time for the whole run
+    QVector<ScriptAnalysis> results;  // One entry per source, in input order
+
+    double scriptsPerSecond() const {
+        return elapsedMs > 0 ? (total * 1000.0) / elapsedMs : 0.0;
+    }
+};
+
+/// <summary>
+/// Analyzes many RamScripts on a worker pool.
+///
+/// USAGE:
+///   ScriptAnalyzer analyzer(disassembler);
+///   ScriptAnalysisReport report = analyzer.run(ScriptAnalyzer::sourcesForSaves(saves));
+///   analyzer.writeReport(report, out);
+/// </summary>
+class ScriptAnalyzer
+{
+public:
+    explicit ScriptAnalyzer(const ScriptDisassembler &disassembler);
+
+    void setThreadCount(int threadCount) { m_threadCount = threadCount; }
+    int threadCount() const;
+
+    static QVector<ScriptSource> sourcesForSaves(const QStringList &savePaths);
+
+    /// Analyze one RamScript (thread-safe; buffer is reused between calls)
+    ScriptAnalysis analyze(const QString &name, const QByteArray &ramScript, DecodedScript &buffer) const;
+
+    /// Analyze every source in parallel
+    ScriptAnalysisReport run(const QVector<ScriptSource> &sources) const;
+
+    /// Tab-separated report: a header row, then one row per source
+    void writeReport(const ScriptAnalysisReport &report, QTextStream &out) const;
+
+private:
+    bool isJumpTargetValid(const DecodedScript &script, int scriptSize, const ScriptInstruction &instr) const;
+    QString joinValues(const QVector<uint16_t> &values, ScriptArgType type) const;
+
+    const ScriptDisassembler &m_disassembler;
+    int m_threadCount;       // <= 0 = QThread::idealThreadCount()
+};
+
+#endif // SCRIPTANALYZER_H
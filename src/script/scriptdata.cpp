@@ -0,0 +1,232 @@
+/**
+ * @file scriptdata.cpp
+ * @brief YAML parsing and compiled serialization of the script tables.
+ *
+ * @see scriptdata.h for the table contents
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "scriptdata.h"
+#include "logcategories.h"
+#include "compileddata.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QFile>
+#include <QTextStream>
+#include <QRegularExpression>
+#include <QDebug>
+
+const QString ScriptData::COMMANDS_YAML_FILENAME = "script_commands.yaml";
+const QString ScriptData::DATA_YAML_FILENAME = "script_data.yaml";
+const QString ScriptData::COMPILED_PATH = ":/Resources/script_data.mgsd";
+
+namespace {
+const char COMPILED_MAGIC[] = "MGSD";
+const char EMBEDDED_PREFIX[] = ":/Resources/";
+}
+
+static QDataStream &operator<<(QDataStream &out, const CommandDef &cmd)
+{
+    return out << cmd.name << cmd.args << cmd.desc;
+}
+
+static QDataStream &operator>>(QDataStream &in, CommandDef &cmd)
+{
+    return in >> cmd.name >> cmd.args >> cmd.desc;
+}
+
+// =============================================================================
+// LOADING
+// =============================================================================
+
+bool ScriptData::load(QString &error)
+{
+    QString commandsOverride = CompiledData::yamlOverride(COMMANDS_YAML_FILENAME);
+    QString dataOverride = CompiledData::yamlOverride(DATA_YAML_FILENAME);
+
+    // Start from the build's tables unless both files are overridden
+    if (commandsOverride.isEmpty() || dataOverride.isEmpty()) {
+        if (QFile::exists(COMPILED_PATH)) {
+            if (!loadFromBinary(COMPILED_PATH, error)) {
+                return false;
+            }
+        } else if (!loadCommandsYaml(EMBEDDED_PREFIX + COMMANDS_YAML_FILENAME, error)
+                   || !loadDataYaml(EMBEDDED_PREFIX + DATA_YAML_FILENAME, error)) {
+            return false;
+        }
+    }
+
+    if (!commandsOverride.isEmpty()) {
+        qCDebug(lcScript) << "ScriptData: using YAML override" << commandsOverride;
+        if (!loadCommandsYaml(commandsOverride, error)) {
+            return false;
+        }
+    }
+    if (!dataOverride.isEmpty()) {
+        qCDebug(lcScript) << "ScriptData: using YAML override" << dataOverride;
+        if (!loadDataYaml(dataOverride, error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ScriptData::loadFromBinary(const QString &path, QString &error)
+{
+    QByteArray payload;
+    if (!CompiledData::read(path, COMPILED_MAGIC, COMPILED_VERSION, payload, error)) {
+        return false;
+    }
+
+    QDataStream in(payload);
+    in.setVersion(CompiledData::STREAM_VERSION);
+    in >> commands >> conditions >> stdScripts >> variables >> flags >> specials >> varPlaceholders;
+    if (in.status() != QDataStream::Ok || commands.isEmpty()) {
+        error = QString("Corrupt script data: %1").arg(path);
+        return false;
+    }
+    return true;
+}
+
+bool ScriptData::saveToBinary(const QString &path, QString &error) const
+{
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out.setVersion(CompiledData::STREAM_VERSION);
+    out << commands << conditions << stdScripts << variables << flags << specials << varPlaceholders;
+
+    return CompiledData::write(path, COMPILED_MAGIC, COMPILED_VERSION, payload, error);
+}
+
+// =============================================================================
+// YAML PARSING
+// =============================================================================
+
+bool ScriptData::loadCommandsYaml(const QString &yamlPath, QString &error)
+{
+    QFile file(yamlPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error = QString("Failed to open %1: %2").arg(yamlPath, file.errorString());
+        return false;
+    }
+
+    commands.clear();
+    QTextStream in(&file);
+    QString content = in.readAll();
+    file.close();
+
+    // Simple YAML parsing for command definitions
+    // Format: 0xNN: { name: "xxx", args: "xxx", desc: "xxx" }
+    QRegularExpression cmdRegex(
+        "0x([0-9A-Fa-f]+):\\s*\\{\\s*name:\\s*\"([^\"]+)\"\\s*,\\s*args:\\s*\"([^\"]*)\"\\s*,\\s*desc:\\s*\"([^\"]+)\"\\s*\\}");
+
+    QRegularExpressionMatchIterator it = cmdRegex.globalMatch(content);
+    while (it.hasNext()) {
+        QRegularExpressionMatch match = it.next();
+        bool ok;
+        uint8_t opcode = match.captured(1).toUInt(&ok, 16);
+        if (ok) {
+            CommandDef cmd;
+            cmd.name = match.captured(2);
+            cmd.args = match.captured(3);
+            cmd.desc = match.captured(4);
+            commands[opcode] = cmd;
+        }
+    }
+
+    if (commands.isEmpty()) {
+        error = "No commands parsed from YAML file";
+        return false;
+    }
+
+    return true;
+}
+
+bool ScriptData::loadDataYaml(const QString &yamlPath, QString &error)
+{
+    QFile file(yamlPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error = QString("Failed to open %1: %2").arg(yamlPath, file.errorString());
+        return false;
+    }
+
+    QString content = file.readAll();
+    file.close();
+
+    qCDebug(lcScript) << "ScriptData: Loaded script_data.yaml, size:" << content.size() << "bytes";
+
+    conditions.clear();
+    stdScripts.clear();
+    variables.clear();
+    flags.clear();
+    specials.clear();
+    varPlaceholders.clear();
+
+    // Parse conditions (0x00 - 0x05 with symbol)
+    QRegularExpression condRegex("0x0([0-5]):\\s*\\{\\s*symbol:\\s*\"([^\"]+)\"");
+    QRegularExpressionMatchIterator it = condRegex.globalMatch(content);
+    while (it.hasNext()) {
+        QRegularExpressionMatch match = it.next();
+        uint8_t code = match.captured(1).toUInt(nullptr, 16);
+        conditions[code] = match.captured(2);
+    }
+
+    // Parse std_scripts
+    QRegularExpression stdRegex("0x0([0-7]):\\s*\"(STD_[^\"]+)\"");
+    it = stdRegex.globalMatch(content);
+    while (it.hasNext()) {
+        QRegularExpressionMatch match = it.next();
+        uint8_t id = match.captured(1).toUInt(nullptr, 16);
+        stdScripts[id] = match.captured(2);
+    }
+
+    // Parse variables - match both 0x4xxx and 0x8xxx ranges
+    QRegularExpression varRegex("0x([48][0-9A-Fa-f]{3}):\\s*\"(VAR_[^\"]+)\"");
+    it = varRegex.globalMatch(content);
+    while (it.hasNext()) {
+        QRegularExpressionMatch match = it.next();
+        uint16_t id = match.captured(1).toUInt(nullptr, 16);
+        variables[id] = match.captured(2);
+    }
+
+    // Parse flags - match any hex value followed by FLAG_ name
+    // Support both 3 and 4 digit hex values (e.g., 0x820 or 0x0820)
+    QRegularExpression flagRegex("0x([0-9A-Fa-f]{3,4}):\\s*\"(FLAG_[^\"]+)\"");
+    it = flagRegex.globalMatch(content);
+    while (it.hasNext()) {
+        QRegularExpressionMatch match = it.next();
+        uint16_t id = match.captured(1).toUInt(nullptr, 16);
+        flags[id] = match.captured(2);
+    }
+    qCDebug(lcScript) << "ScriptData: Loaded" << flags.size() << "flags";
+
+    // Parse special functions
+    QRegularExpression specialRegex("0x([0-9A-Fa-f]{4}):\\s*\"([A-Za-z][^\"]+)\"");
+    it = specialRegex.globalMatch(content);
+    while (it.hasNext()) {
+        QRegularExpressionMatch match = it.next();
+        uint16_t id = match.captured(1).toUInt(nullptr, 16);
+        QString name = match.captured(2);
+        if (!name.startsWith("FLAG_") && !name.startsWith("VAR_") && !name.startsWith("STD_")) {
+            specials[id] = name;
+        }
+    }
+
+    // Parse var placeholders
+    QRegularExpression placeholderRegex("0x0([0-6]):\\s*\"\\{([^}]+)\\}\"");
+    it = placeholderRegex.globalMatch(content);
+    while (it.hasNext()) {
+        QRegularExpressionMatch match = it.next();
+        uint8_t id = match.captured(1).toUInt(nullptr, 16);
+        varPlaceholders[id] = "{" + match.captured(2) + "}";
+    }
+
+    return true;
+}
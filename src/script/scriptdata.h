@@ -0,0 +1,64 @@
+/**
+ * @file scriptdata.h
+ * @brief Command definitions and symbol tables used by the script disassembler.
+ *
+ * ScriptData holds everything ScriptDisassembler reads from
+ * script_commands.yaml (opcode -> command) and script_data.yaml (conditions,
+ * std scripts, variables, flags, specials, placeholders). It has no GUI or
+ * ROM dependency so the build-time data compiler (mgi_datac) can parse the
+ * YAML once and store the tables as a compiled blob (script_data.mgsd).
+ *
+ * @see ScriptDisassembler::setScriptData
+ * @see CompiledData for the blob container and the MGI_YAML_DIR override
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef SCRIPTDATA_H
+#define SCRIPTDATA_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QString>
+#include <QHash>
+#include <cstdint>
+
+/// Command definition loaded from YAML
+struct CommandDef {
+    QString name;
+    QString args;
+    QString desc;
+};
+
+/// Script command and symbol tables (YAML or compiled)
+struct ScriptData {
+    QHash<uint8_t, CommandDef> commands;       // opcode -> command
+
+    QHash<uint8_t, QString> conditions;        // condition code -> symbol
+    QHash<uint8_t, QString> stdScripts;        // std ID -> name
+    QHash<uint16_t, QString> variables;        // var ID -> name
+    QHash<uint16_t, QString> flags;            // flag ID -> name
+    QHash<uint16_t, QString> specials;         // special ID -> name
+    QHash<uint8_t, QString> varPlaceholders;   // placeholder ID -> string
+
+    // Compiled tables embedded at build time, or the MGI_YAML_DIR override
+    bool load(QString &error);
+
+    // YAML sources
+    bool loadCommandsYaml(const QString &yamlPath, QString &error);
+    bool loadDataYaml(const QString &yamlPath, QString &error);
+
+    // Compiled form (written by mgi_datac)
+    bool loadFromBinary(const QString &path, QString &error);
+    bool saveToBinary(const QString &path, QString &error) const;
+
+    // Constants
+    static const QString COMMANDS_YAML_FILENAME;
+    static const QString DATA_YAML_FILENAME;
+    static const QString COMPILED_PATH;
+    static const uint32_t COMPILED_VERSION = 1;   // Bump when the tables above change
+};
+
+#endif // SCRIPTDATA_H
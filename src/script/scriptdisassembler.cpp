@@ -1,244 +1,110 @@
 #include "scriptdisassembler.h"
-#include "gbaromreader.h"  // GBAROReader class
-#include <QFile>
-#include <QTextStream>
-#include <QRegularExpression>
+#include "gen3text.h"
+#include "tracing.h"
 #include <QSet>
 #include <QDebug>
 #include <algorithm>
 
 ScriptDisassembler::ScriptDisassembler()
-    : m_inferredBase(0)
-    , m_romReader(nullptr)
 {
-    initGen3Charset();
+    buildOpcodeLayouts();
 }
 
 ScriptDisassembler::~ScriptDisassembler()
 {
 }
 
-void ScriptDisassembler::initGen3Charset()
+bool ScriptDisassembler::loadDefaultData(QString &error)
 {
-    // Gen 3 proprietary character encoding
-    // Using QString::fromUtf8 for special characters to avoid encoding issues
-    m_gen3Charset = {
-        {0x00, " "},
-        // Accented uppercase
-        {0x01, QString::fromUtf8("\xC3\x80")}, // A grave
-        {0x02, QString::fromUtf8("\xC3\x81")}, // A acute
-        {0x03, QString::fromUtf8("\xC3\x82")}, // A circumflex
-        {0x04, QString::fromUtf8("\xC3\x87")}, // C cedilla
-        {0x05, QString::fromUtf8("\xC3\x88")}, // E grave
-        {0x06, QString::fromUtf8("\xC3\x89")}, // E acute
-        {0x07, QString::fromUtf8("\xC3\x8A")}, // E circumflex
-        {0x08, QString::fromUtf8("\xC3\x8B")}, // E diaeresis
-        {0x09, QString::fromUtf8("\xC3\x8C")}, // I grave
-        {0x0B, QString::fromUtf8("\xC3\x8E")}, // I circumflex
-        {0x0C, QString::fromUtf8("\xC3\x8F")}, // I diaeresis
-        {0x0D, QString::fromUtf8("\xC3\x92")}, // O grave
-        {0x0E, QString::fromUtf8("\xC3\x93")}, // O acute
-        {0x0F, QString::fromUtf8("\xC3\x94")}, // O circumflex
-        {0x10, QString::fromUtf8("\xC5\x92")}, // OE ligature
-        {0x11, QString::fromUtf8("\xC3\x99")}, // U grave
-        {0x12, QString::fromUtf8("\xC3\x9A")}, // U acute
-        {0x13, QString::fromUtf8("\xC3\x9B")}, // U circumflex
-        {0x14, QString::fromUtf8("\xC3\x91")}, // N tilde
-        {0x15, QString::fromUtf8("\xC3\x9F")}, // German sharp s
-        // Accented lowercase
-        {0x16, QString::fromUtf8("\xC3\xA0")}, // a grave
-        {0x17, QString::fromUtf8("\xC3\xA1")}, // a acute
-        {0x19, QString::fromUtf8("\xC3\xA7")}, // c cedilla
-        {0x1A, QString::fromUtf8("\xC3\xA8")}, // e grave
-        {0x1B, QString::fromUtf8("\xC3\xA9")}, // e acute
-        {0x1C, QString::fromUtf8("\xC3\xAA")}, // e circumflex
-        {0x1D, QString::fromUtf8("\xC3\xAB")}, // e diaeresis
-        {0x1E, QString::fromUtf8("\xC3\xAC")}, // i grave
-        {0x20, QString::fromUtf8("\xC3\xAE")}, // i circumflex
-        {0x21, QString::fromUtf8("\xC3\xAF")}, // i diaeresis
-        {0x22, QString::fromUtf8("\xC3\xB2")}, // o grave
-        {0x23, QString::fromUtf8("\xC3\xB3")}, // o acute
-        {0x24, QString::fromUtf8("\xC3\xB4")}, // o circumflex
-        {0x25, QString::fromUtf8("\xC5\x93")}, // oe ligature
-        {0x26, QString::fromUtf8("\xC3\xB9")}, // u grave
-        {0x27, QString::fromUtf8("\xC3\xBA")}, // u acute
-        {0x28, QString::fromUtf8("\xC3\xBB")}, // u circumflex
-        {0x29, QString::fromUtf8("\xC3\xB1")}, // n tilde
-        // Special characters
-        {0x2A, QString::fromUtf8("\xC2\xBA")}, // masculine ordinal
-        {0x2B, QString::fromUtf8("\xC2\xAA")}, // feminine ordinal
-        {0x2D, "&"},
-        {0x2E, "+"},
-        {0x35, "="},
-        {0x36, ";"},
-        {0x51, QString::fromUtf8("\xC2\xBF")}, // inverted question
-        {0x52, QString::fromUtf8("\xC2\xA1")}, // inverted exclamation
-        {0x5A, QString::fromUtf8("\xC3\x8D")}, // I acute
-        {0x5B, "%"},
-        {0x5C, "("},
-        {0x5D, ")"},
-        {0x68, QString::fromUtf8("\xC3\xA2")}, // a circumflex
-        {0x6F, QString::fromUtf8("\xC3\xAD")}, // i acute
-        // Numbers
-        {0xA1, "0"}, {0xA2, "1"}, {0xA3, "2"}, {0xA4, "3"}, {0xA5, "4"},
-        {0xA6, "5"}, {0xA7, "6"}, {0xA8, "7"}, {0xA9, "8"}, {0xAA, "9"},
-        // Punctuation
-        {0xAB, "!"},
-        {0xAC, "?"},
-        {0xAD, "."},
-        {0xAE, "-"},
-        {0xB0, QString::fromUtf8("\xE2\x80\xA6")}, // ellipsis
-        {0xB1, QString::fromUtf8("\xE2\x80\x9C")}, // left double quote
-        {0xB2, QString::fromUtf8("\xE2\x80\x9D")}, // right double quote
-        {0xB3, QString::fromUtf8("\xE2\x80\x98")}, // left single quote
-        {0xB4, QString::fromUtf8("\xE2\x80\x99")}, // right single quote
-        {0xB5, QString::fromUtf8("\xE2\x99\x82")}, // male symbol
-        {0xB6, QString::fromUtf8("\xE2\x99\x80")}, // female symbol
-        {0xB7, "$"},
-        {0xB8, ","},
-        {0xB9, QString::fromUtf8("\xC3\x97")}, // multiplication sign
-        {0xBA, "/"},
-        // Uppercase letters
-        {0xBB, "A"}, {0xBC, "B"}, {0xBD, "C"}, {0xBE, "D"}, {0xBF, "E"},
-        {0xC0, "F"}, {0xC1, "G"}, {0xC2, "H"}, {0xC3, "I"}, {0xC4, "J"},
-        {0xC5, "K"}, {0xC6, "L"}, {0xC7, "M"}, {0xC8, "N"}, {0xC9, "O"},
-        {0xCA, "P"}, {0xCB, "Q"}, {0xCC, "R"}, {0xCD, "S"}, {0xCE, "T"},
-        {0xCF, "U"}, {0xD0, "V"}, {0xD1, "W"}, {0xD2, "X"}, {0xD3, "Y"},
-        {0xD4, "Z"},
-        // Lowercase letters
-        {0xD5, "a"}, {0xD6, "b"}, {0xD7, "c"}, {0xD8, "d"}, {0xD9, "e"},
-        {0xDA, "f"}, {0xDB, "g"}, {0xDC, "h"}, {0xDD, "i"}, {0xDE, "j"},
-        {0xDF, "k"}, {0xE0, "l"}, {0xE1, "m"}, {0xE2, "n"}, {0xE3, "o"},
-        {0xE4, "p"}, {0xE5, "q"}, {0xE6, "r"}, {0xE7, "s"}, {0xE8, "t"},
-        {0xE9, "u"}, {0xEA, "v"}, {0xEB, "w"}, {0xEC, "x"}, {0xED, "y"},
-        {0xEE, "z"},
-        // Other
-        {0xEF, QString::fromUtf8("\xE2\x96\xB6")}, // right-pointing triangle
-        {0xF0, ":"},
-        {0xF1, QString::fromUtf8("\xC3\x84")}, // A diaeresis
-        {0xF2, QString::fromUtf8("\xC3\x96")}, // O diaeresis
-        {0xF3, QString::fromUtf8("\xC3\x9C")}, // U diaeresis
-        {0xF4, QString::fromUtf8("\xC3\xA4")}, // a diaeresis
-        {0xF5, QString::fromUtf8("\xC3\xB6")}, // o diaeresis
-        {0xF6, QString::fromUtf8("\xC3\xBC")}, // u diaeresis
-        // Control codes
-        {0xFA, "\\l"}, {0xFB, "\\p"}, {0xFC, "\\c"}, {0xFD, "\\v"}, {0xFE, "\\n"},
-    };
-}
-
-bool ScriptDisassembler::loadCommandDefinitions(const QString &yamlPath, QString &error)
-{
-    QFile file(yamlPath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        error = QString("Failed to open %1: %2").arg(yamlPath, file.errorString());
+    MGI_TRACE_SCOPE("ScriptDisassembler::loadDefaultData");
+    ScriptData data;
+    if (!data.load(error)) {
         return false;
     }
+    setScriptData(data);
+    return true;
+}
 
-    m_commands.clear();
-    QTextStream in(&file);
-    QString content = in.readAll();
-    file.close();
-
-    // Simple YAML parsing for command definitions
-    // Format: 0xNN: { name: "xxx", args: "xxx", desc: "xxx" }
-    QRegularExpression cmdRegex(
-        "0x([0-9A-Fa-f]+):\\s*\\{\\s*name:\\s*\"([^\"]+)\"\\s*,\\s*args:\\s*\"([^\"]*)\"\\s*,\\s*desc:\\s*\"([^\"]+)\"\\s*\\}");
-
-    QRegularExpressionMatchIterator it = cmdRegex.globalMatch(content);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        bool ok;
-        uint8_t opcode = match.captured(1).toUInt(&ok, 16);
-        if (ok) {
-            CommandDef cmd;
-            cmd.name = match.captured(2);
-            cmd.args = match.captured(3);
-            cmd.desc = match.captured(4);
-            m_commands[opcode] = cmd;
-        }
-    }
+void ScriptDisassembler::setScriptData(const ScriptData &data)
+{
+    m_commands = data.commands;
+    m_conditions = data.conditions;
+    m_stdScripts = data.stdScripts;
+    m_variables = data.variables;
+    m_flags = data.flags;
+    m_specials = data.specials;
+    m_varPlaceholders = data.varPlaceholders;
+    buildOpcodeLayouts();
+}
 
-    if (m_commands.isEmpty()) {
-        error = "No commands parsed from YAML file";
+bool ScriptDisassembler::loadCommandDefinitions(const QString &yamlPath, QString &error)
+{
+    ScriptData data;
+    if (!data.loadCommandsYaml(yamlPath, error)) {
         return false;
     }
-
+    m_commands = data.commands;
+    buildOpcodeLayouts();
     return true;
 }
 
 bool ScriptDisassembler::loadScriptData(const QString &yamlPath, QString &error)
 {
-    QFile file(yamlPath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        error = QString("Failed to open %1: %2").arg(yamlPath, file.errorString());
+    ScriptData data;
+    if (!data.loadDataYaml(yamlPath, error)) {
         return false;
     }
+    m_conditions = data.conditions;
+    m_stdScripts = data.stdScripts;
+    m_variables = data.variables;
+    m_flags = data.flags;
+    m_specials = data.specials;
+    m_varPlaceholders = data.varPlaceholders;
+    return true;
+}
 
-    QString content = file.readAll();
-    file.close();
-
-    qDebug() << "ScriptDisassembler: Loaded script_data.yaml, size:" << content.size() << "bytes";
-
-    // Parse conditions (0x00 - 0x05 with symbol)
-    QRegularExpression condRegex("0x0([0-5]):\\s*\\{\\s*symbol:\\s*\"([^\"]+)\"");
-    QRegularExpressionMatchIterator it = condRegex.globalMatch(content);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        uint8_t code = match.captured(1).toUInt(nullptr, 16);
-        m_conditions[code] = match.captured(2);
-    }
-
-    // Parse std_scripts
-    QRegularExpression stdRegex("0x0([0-7]):\\s*\"(STD_[^\"]+)\"");
-    it = stdRegex.globalMatch(content);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        uint8_t id = match.captured(1).toUInt(nullptr, 16);
-        m_stdScripts[id] = match.captured(2);
-    }
-
-    // Parse variables - match both 0x4xxx and 0x8xxx ranges
-    QRegularExpression varRegex("0x([48][0-9A-Fa-f]{3}):\\s*\"(VAR_[^\"]+)\"");
-    it = varRegex.globalMatch(content);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        uint16_t id = match.captured(1).toUInt(nullptr, 16);
-        m_variables[id] = match.captured(2);
-    }
+void ScriptDisassembler::setRomNames(const QString &versionName, const NameTable &items,
+                                     const NameTable &pokemon, const NameTable &moves)
+{
+    m_romVersion = versionName;
+    m_itemNames = items;
+    m_pokemonNames = pokemon;
+    m_moveNames = moves;
+}
 
-    // Parse flags - match any hex value followed by FLAG_ name
-    // Support both 3 and 4 digit hex values (e.g., 0x820 or 0x0820)
-    QRegularExpression flagRegex("0x([0-9A-Fa-f]{3,4}):\\s*\"(FLAG_[^\"]+)\"");
-    it = flagRegex.globalMatch(content);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        uint16_t id = match.captured(1).toUInt(nullptr, 16);
-        m_flags[id] = match.captured(2);
-    }
-    qDebug() << "ScriptDisassembler: Loaded" << m_flags.size() << "flags";
+void ScriptDisassembler::buildOpcodeLayouts()
+{
+    for (int opcode = 0; opcode < 256; ++opcode) {
+        OpcodeLayout &layout = m_layouts[opcode];
+        layout.known = false;
+        layout.argCount = 0;
 
-    // Parse special functions
-    QRegularExpression specialRegex("0x([0-9A-Fa-f]{4}):\\s*\"([A-Za-z][^\"]+)\"");
-    it = specialRegex.globalMatch(content);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        uint16_t id = match.captured(1).toUInt(nullptr, 16);
-        QString name = match.captured(2);
-        if (!name.startsWith("FLAG_") && !name.startsWith("VAR_") && !name.startsWith("STD_")) {
-            m_specials[id] = name;
+        auto it = m_commands.constFind(static_cast<uint8_t>(opcode));
+        if (it == m_commands.constEnd()) {
+            continue;
+        }
+        layout.known = true;
+
+        for (QChar c : it->args) {
+            ScriptArgType type;
+            switch (c.unicode()) {
+                case 'b': type = ScriptArgType::Byte; break;
+                case 'w': type = ScriptArgType::Word; break;
+                case 'd': type = ScriptArgType::Dword; break;
+                case 'v': type = ScriptArgType::Var; break;
+                case 'f': type = ScriptArgType::Flag; break;
+                case 'i': type = ScriptArgType::Item; break;
+                case 'p': type = ScriptArgType::Species; break;
+                case 'M': type = ScriptArgType::Move; break;
+                default: continue;  // Not an argument format character
+            }
+            if (layout.argCount == ScriptInstruction::MAX_ARGS) {
+                qWarning() << "ScriptDisassembler: too many arguments for" << it->name;
+                break;
+            }
+            layout.argTypes[layout.argCount++] = type;
         }
     }
-
-    // Parse var placeholders
-    QRegularExpression placeholderRegex("0x0([0-6]):\\s*\"\\{([^}]+)\\}\"");
-    it = placeholderRegex.globalMatch(content);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        uint8_t id = match.captured(1).toUInt(nullptr, 16);
-        m_varPlaceholders[id] = "{" + match.captured(2) + "}";
-    }
-
-    return true;
 }
 
 ScriptDisassembler::RamScriptHeader ScriptDisassembler::parseRamScriptHeader(const QByteArray &data) const
@@ -260,48 +126,40 @@ ScriptDisassembler::RamScriptHeader ScriptDisassembler::parseRamScriptHeader(con
     return header;
 }
 
-int ScriptDisassembler::parseArguments(const QByteArray &data, int offset, const QString &fmt,
-                                       QVector<uint32_t> &args, QStringList &types)
+int ScriptDisassembler::decodeArguments(const uint8_t *data, int size, int offset,
+                                        const OpcodeLayout &layout, ScriptInstruction &instr) const
 {
     int pos = offset;
-    args.clear();
-    types.clear();
+    instr.argCount = 0;
 
-    for (QChar c : fmt) {
-        if (pos >= data.size()) break;
+    for (int i = 0; i < layout.argCount; ++i) {
+        if (pos >= size) break;
 
-        if (c == 'b') {
-            args.append(static_cast<uint8_t>(data[pos]));
-            types.append("b");
+        ScriptArgType type = layout.argTypes[i];
+        if (type == ScriptArgType::Byte) {
+            instr.args[instr.argCount] = data[pos];
             pos += 1;
-        } else if (c == 'w' || c == 'i' || c == 'p' || c == 'M' || c == 'v' || c == 'f') {
-            if (pos + 1 < data.size()) {
-                uint16_t val = static_cast<uint8_t>(data[pos]) |
-                              (static_cast<uint8_t>(data[pos + 1]) << 8);
-                args.append(val);
-                types.append(QString(c));
-                pos += 2;
-            }
-        } else if (c == 'd') {
-            if (pos + 3 < data.size()) {
-                uint32_t val = static_cast<uint8_t>(data[pos]) |
-                              (static_cast<uint8_t>(data[pos + 1]) << 8) |
-                              (static_cast<uint8_t>(data[pos + 2]) << 16) |
-                              (static_cast<uint8_t>(data[pos + 3]) << 24);
-                args.append(val);
-                types.append("d");
-                pos += 4;
-            }
+        } else if (type == ScriptArgType::Dword) {
+            if (pos + 3 >= size) continue;
+            instr.args[instr.argCount] = data[pos] | (data[pos + 1] << 8) |
+                                         (data[pos + 2] << 16) | (static_cast<uint32_t>(data[pos + 3]) << 24);
+            pos += 4;
+        } else {
+            // Word-sized: w, v, f, i, p, M
+            if (pos + 1 >= size) continue;
+            instr.args[instr.argCount] = static_cast<uint16_t>(data[pos] | (data[pos + 1] << 8));
+            pos += 2;
         }
+        instr.argTypes[instr.argCount++] = type;
     }
 
     return pos - offset;
 }
 
-QString ScriptDisassembler::formatArg(uint32_t value, const QString &type, int argIndex,
+QString ScriptDisassembler::formatArg(uint32_t value, ScriptArgType type, int argIndex,
                                       uint8_t opcode) const
 {
-    if (type == "b") {
+    if (type == ScriptArgType::Byte) {
         // Check for condition code - show symbol
         if ((opcode == 0x06 || opcode == 0x07 || opcode == 0xBB || opcode == 0xBC) && argIndex == 0) {
             return m_conditions.value(static_cast<uint8_t>(value), QString("0x%1").arg(value, 2, 16, QChar('0')));
@@ -312,7 +170,7 @@ QString ScriptDisassembler::formatArg(uint32_t value, const QString &type, int a
         }
         return QString::number(value);
     }
-    else if (type == "v") {
+    else if (type == ScriptArgType::Var) {
         // Variable reference - show name if known
         if (value >= 0x4000) {
             QString varName = m_variables.value(static_cast<uint16_t>(value), "");
@@ -324,7 +182,7 @@ QString ScriptDisassembler::formatArg(uint32_t value, const QString &type, int a
         // Immediate value (not a variable)
         return QString::number(value);
     }
-    else if (type == "f") {
+    else if (type == ScriptArgType::Flag) {
         // Flag reference - show name if known
         QString flagName = m_flags.value(static_cast<uint16_t>(value), "");
         if (!flagName.isEmpty()) {
@@ -333,37 +191,37 @@ QString ScriptDisassembler::formatArg(uint32_t value, const QString &type, int a
         // Format: FLAG_0x{uppercase hex} to match Python
         return QString("FLAG_0x%1").arg(value, 4, 16, QChar('0')).toUpper().replace("FLAG_0X", "FLAG_0x");
     }
-    else if (type == "i") {
+    else if (type == ScriptArgType::Item) {
         // Item ID - try ROM lookup first
-        if (m_romReader && m_romReader->hasNameTables()) {
-            QString itemName = m_romReader->getItemName(static_cast<uint16_t>(value));
+        if (!m_itemNames.isEmpty()) {
+            QString itemName = m_itemNames.name(static_cast<uint16_t>(value));
             if (!itemName.isEmpty()) {
                 return QString("ITEM_%1 (0x%2)").arg(itemName).arg(value, 4, 16, QChar('0'));
             }
         }
         return QString("ITEM_0x%1").arg(value, 4, 16, QChar('0')).toUpper();
     }
-    else if (type == "p") {
+    else if (type == ScriptArgType::Species) {
         // Pokemon species - try ROM lookup first
-        if (m_romReader && m_romReader->hasNameTables()) {
-            QString pokemonName = m_romReader->getPokemonName(static_cast<uint16_t>(value));
+        if (!m_pokemonNames.isEmpty()) {
+            QString pokemonName = m_pokemonNames.name(static_cast<uint16_t>(value));
             if (!pokemonName.isEmpty()) {
                 return QString("SPECIES_%1 (%2)").arg(pokemonName.toUpper()).arg(value);
             }
         }
         return QString("SPECIES_%1").arg(value);
     }
-    else if (type == "M") {
+    else if (type == ScriptArgType::Move) {
         // Move ID - try ROM lookup first
-        if (m_romReader && m_romReader->hasNameTables()) {
-            QString moveName = m_romReader->getMoveName(static_cast<uint16_t>(value));
+        if (!m_moveNames.isEmpty()) {
+            QString moveName = m_moveNames.name(static_cast<uint16_t>(value));
             if (!moveName.isEmpty()) {
                 return QString("MOVE_%1 (%2)").arg(moveName.toUpper().replace(" ", "_")).arg(value);
             }
         }
         return QString("MOVE_%1").arg(value);
     }
-    else if (type == "w") {
+    else if (type == ScriptArgType::Word) {
         // Word - check context for how to format
         // Item quantity - show decimal
         if ((opcode == 0x44 || opcode == 0x45 || opcode == 0x46 || opcode == 0x47 ||
@@ -380,22 +238,23 @@ QString ScriptDisassembler::formatArg(uint32_t value, const QString &type, int a
         }
         return QString("0x%1").arg(value, 4, 16, QChar('0'));
     }
-    else if (type == "d") {
+    else if (type == ScriptArgType::Dword) {
         return QString("0x%1").arg(value, 8, 16, QChar('0'));
     }
 
     return QString::number(value);
 }
 
-QString ScriptDisassembler::generateComment(uint8_t opcode, const QString &name,
-                                            const QVector<uint32_t> &args,
-                                            const QStringList &types) const
+QString ScriptDisassembler::generateComment(const QByteArray &data, uint32_t base,
+                                            const ScriptInstruction &instr) const
 {
-    if (!m_commands.contains(opcode)) {
+    uint8_t opcode = instr.opcode;
+    auto it = m_commands.constFind(opcode);
+    if (it == m_commands.constEnd()) {
         return "Unknown command";
     }
 
-    QString comment = m_commands[opcode].desc;
+    QString comment = it->desc;
     QStringList extras;
 
     // Condition descriptions for conditional jumps/calls
@@ -414,8 +273,8 @@ QString ScriptDisassembler::generateComment(uint8_t opcode, const QString &name,
         case 0x07: // call_if
         case 0xBB: // vgoto_if
         case 0xBC: // vcall_if
-            if (!args.isEmpty()) {
-                uint8_t cond = static_cast<uint8_t>(args[0]);
+            if (instr.argCount > 0) {
+                uint8_t cond = static_cast<uint8_t>(instr.args[0]);
                 QString condDesc = conditionDescs.value(cond, "unknown");
                 extras << QString("Condition: %1").arg(condDesc);
             }
@@ -423,8 +282,8 @@ QString ScriptDisassembler::generateComment(uint8_t opcode, const QString &name,
 
         case 0x08: // gotostd
         case 0x09: // callstd
-            if (!args.isEmpty()) {
-                QString stdName = m_stdScripts.value(static_cast<uint8_t>(args[0]), "");
+            if (instr.argCount > 0) {
+                QString stdName = m_stdScripts.value(static_cast<uint8_t>(instr.args[0]), "");
                 if (!stdName.isEmpty()) {
                     extras << QString("-> %1").arg(stdName);
                 }
@@ -432,8 +291,8 @@ QString ScriptDisassembler::generateComment(uint8_t opcode, const QString &name,
             break;
 
         case 0x25: // special
-            if (!args.isEmpty()) {
-                QString specialName = m_specials.value(static_cast<uint16_t>(args[0]), "");
+            if (instr.argCount > 0) {
+                QString specialName = m_specials.value(static_cast<uint16_t>(instr.args[0]), "");
                 if (!specialName.isEmpty()) {
                     extras << QString("-> %1").arg(specialName);
                 }
@@ -441,40 +300,31 @@ QString ScriptDisassembler::generateComment(uint8_t opcode, const QString &name,
             break;
 
         case 0x29: // setflag
-            if (!args.isEmpty()) {
-                uint16_t flagId = static_cast<uint16_t>(args[0]);
+            if (instr.argCount > 0) {
+                uint16_t flagId = static_cast<uint16_t>(instr.args[0]);
                 QString flagName = m_flags.value(flagId, "");
                 if (!flagName.isEmpty()) {
                     extras << QString("Sets %1 to TRUE").arg(flagName);
-                    m_flagsFound.insert(flagId);
-                } else {
-                    m_flagsUnknown.insert(flagId);
                 }
             }
             break;
 
         case 0x2A: // clearflag
-            if (!args.isEmpty()) {
-                uint16_t flagId = static_cast<uint16_t>(args[0]);
+            if (instr.argCount > 0) {
+                uint16_t flagId = static_cast<uint16_t>(instr.args[0]);
                 QString flagName = m_flags.value(flagId, "");
                 if (!flagName.isEmpty()) {
                     extras << QString("Sets %1 to FALSE").arg(flagName);
-                    m_flagsFound.insert(flagId);
-                } else {
-                    m_flagsUnknown.insert(flagId);
                 }
             }
             break;
 
         case 0x2B: // checkflag
-            if (!args.isEmpty()) {
-                uint16_t flagId = static_cast<uint16_t>(args[0]);
+            if (instr.argCount > 0) {
+                uint16_t flagId = static_cast<uint16_t>(instr.args[0]);
                 QString flagName = m_flags.value(flagId, "");
                 if (!flagName.isEmpty()) {
                     extras << QString("Checks %1").arg(flagName);
-                    m_flagsFound.insert(flagId);
-                } else {
-                    m_flagsUnknown.insert(flagId);
                 }
             }
             break;
@@ -484,8 +334,8 @@ QString ScriptDisassembler::generateComment(uint8_t opcode, const QString &name,
         case 0x46: // checkitemspace
         case 0x47: // checkitem
             // Item operations - add item name if available
-            if (!args.isEmpty() && m_romReader && m_romReader->hasNameTables()) {
-                QString itemName = m_romReader->getItemName(static_cast<uint16_t>(args[0]));
+            if (instr.argCount > 0 && !m_itemNames.isEmpty()) {
+                QString itemName = m_itemNames.name(static_cast<uint16_t>(instr.args[0]));
                 if (!itemName.isEmpty()) {
                     extras << QString("Item: %1").arg(itemName);
                 }
@@ -493,14 +343,14 @@ QString ScriptDisassembler::generateComment(uint8_t opcode, const QString &name,
             break;
 
         case 0xBD: // vmessage
-            if (!args.isEmpty() && m_inferredBase) {
-                QString text = readEmbeddedString(args[0]);
+            if (instr.argCount > 0 && base) {
+                QString text = readEmbeddedString(data, base, instr.args[0]);
                 if (!text.isEmpty()) {
                     QString preview = text.left(50).replace("\n", " ").trimmed();
                     if (text.length() > 50) preview += "...";
                     extras << QString("Text: \"%1\"").arg(preview);
 
-                    int offset = args[0] - m_inferredBase;
+                    int offset = instr.args[0] - base;
                     extras << QString("(offset 0x%1 in data)").arg(offset, 0, 16).toUpper();
                 }
             }
@@ -518,121 +368,125 @@ QString ScriptDisassembler::generateComment(uint8_t opcode, const QString &name,
     return comment;
 }
 
-void ScriptDisassembler::findJumpTargets(const QByteArray &data)
+bool ScriptDisassembler::jumpOperand(const ScriptInstruction &instr, uint32_t &address, bool &isVirtual)
 {
-    m_labels.clear();
-    int labelCount = 0;
-    int offset = 0;
-
-    while (offset < data.size()) {
-        uint8_t opcode = static_cast<uint8_t>(data[offset]);
-
-        if (opcode == 0x02) break; // end
-
-        if (m_commands.contains(opcode)) {
-            const CommandDef &cmd = m_commands[opcode];
-            QVector<uint32_t> args;
-            QStringList types;
-            int argLen = parseArguments(data, offset + 1, cmd.args, args, types);
+    if (instr.kind != ScriptInstruction::Command || instr.argCount == 0) {
+        return false;
+    }
 
-            // Check for jump/call targets
-            // Regular goto/call (0x04, 0x05) - target is direct offset
-            if ((opcode == 0x04 || opcode == 0x05) && !args.isEmpty()) {
-                uint32_t target = args.last();
-                if (target < static_cast<uint32_t>(data.size()) && !m_labels.contains(target)) {
-                    m_labels[target] = QString("label_%1").arg(labelCount++);
-                }
-            }
-            // Virtual goto/call (0xB9, 0xBA) - target is virtual address, convert to offset
-            else if ((opcode == 0xB9 || opcode == 0xBA) && !args.isEmpty()) {
-                uint32_t vaddr = args.last();
-                if (m_inferredBase != 0 && vaddr >= m_inferredBase) {
-                    uint32_t target = vaddr - m_inferredBase;
-                    if (target < static_cast<uint32_t>(data.size()) && !m_labels.contains(target)) {
-                        m_labels[target] = QString("label_%1").arg(labelCount++);
-                    }
-                }
-            }
-            // Regular conditional goto/call (0x06, 0x07) - target is direct offset
-            else if ((opcode == 0x06 || opcode == 0x07) && args.size() >= 2) {
-                uint32_t target = args.last();
-                if (target < static_cast<uint32_t>(data.size()) && !m_labels.contains(target)) {
-                    m_labels[target] = QString("label_%1").arg(labelCount++);
-                }
-            }
-            // Virtual conditional goto/call (0xBB, 0xBC) - target is virtual address
-            else if ((opcode == 0xBB || opcode == 0xBC) && args.size() >= 2) {
-                uint32_t vaddr = args.last();
-                if (m_inferredBase != 0 && vaddr >= m_inferredBase) {
-                    uint32_t target = vaddr - m_inferredBase;
-                    if (target < static_cast<uint32_t>(data.size()) && !m_labels.contains(target)) {
-                        m_labels[target] = QString("label_%1").arg(labelCount++);
-                    }
-                }
+    switch (instr.opcode) {
+        case 0x04: // call
+        case 0x05: // goto
+        case 0xB9: // vgoto
+        case 0xBA: // vcall
+            break;
+        case 0x06: // goto_if
+        case 0x07: // call_if
+        case 0xBB: // vgoto_if
+        case 0xBC: // vcall_if
+            if (instr.argCount < 2) {
+                return false;
             }
+            break;
+        default:
+            return false;
+    }
 
-            offset += 1 + argLen;
-        } else {
-            offset += 1;
-        }
+    address = instr.args[instr.argCount - 1];
+    isVirtual = instr.opcode >= 0xB9;
+    return true;
+}
+
+int ScriptDisassembler::instructionAt(const DecodedScript &script, int offset)
+{
+    auto it = std::lower_bound(script.instructions.cbegin(), script.instructions.cend(), offset,
+                               [](const ScriptInstruction &instr, int target) { return instr.offset < target; });
+    if (it == script.instructions.cend() || it->offset != offset) {
+        return -1;
     }
+    return static_cast<int>(it - script.instructions.cbegin());
 }
 
-void ScriptDisassembler::inferBaseAddress(const QByteArray &data)
+void ScriptDisassembler::findJumpTargets(int size, DecodedScript &script) const
 {
-    m_inferredBase = 0;
-    int offset = 0;
+    for (const ScriptInstruction &instr : script.instructions) {
+        uint32_t address;
+        bool isVirtual;
+        if (!jumpOperand(instr, address, isVirtual)) {
+            continue;
+        }
 
-    while (offset < data.size()) {
-        uint8_t opcode = static_cast<uint8_t>(data[offset]);
-        if (opcode == 0x02) break;
+        // Regular goto/call - target is direct offset
+        // Virtual goto/call - target is virtual address, convert to offset
+        uint32_t target = address;
+        if (isVirtual) {
+            if (script.inferredBase == 0 || address < script.inferredBase) {
+                continue;
+            }
+            target = address - script.inferredBase;
+        }
 
-        if (m_commands.contains(opcode)) {
-            const CommandDef &cmd = m_commands[opcode];
-            QVector<uint32_t> args;
-            QStringList types;
-            int argLen = parseArguments(data, offset + 1, cmd.args, args, types);
+        if (target < static_cast<uint32_t>(size) && !script.labels.contains(static_cast<int>(target))) {
+            script.labels.append(static_cast<int>(target));
+        }
+    }
 
-            // setvaddress sets the base
-            if (opcode == 0xB8 && !args.isEmpty() && args[0] >= 0x08000000) {
-                m_inferredBase = args[0] - offset;
-                return;
-            }
+    // Attach labels to the instructions that start at their targets
+    for (int label = 0; label < script.labels.size(); ++label) {
+        int index = instructionAt(script, script.labels.at(label));
+        if (index >= 0) {
+            script.instructions[index].label = label;
+        }
+    }
+}
 
-            offset += 1 + argLen;
-        } else {
-            offset += 1;
+void ScriptDisassembler::inferBaseAddress(DecodedScript &script) const
+{
+    script.inferredBase = 0;
+
+    for (const ScriptInstruction &instr : script.instructions) {
+        // setvaddress sets the base
+        if (instr.kind == ScriptInstruction::Command && instr.opcode == 0xB8
+            && instr.argCount > 0 && instr.args[0] >= 0x08000000) {
+            script.inferredBase = instr.args[0] - instr.offset;
+            return;
         }
     }
 }
 
-QString ScriptDisassembler::readEmbeddedString(uint32_t vaddr) const
+QString ScriptDisassembler::readEmbeddedString(const QByteArray &data, uint32_t base, uint32_t vaddr) const
 {
-    if (m_inferredBase == 0 || m_scriptData.isEmpty()) {
+    if (base == 0 || data.isEmpty()) {
         return QString();
     }
 
-    int offset = vaddr - m_inferredBase;
-    if (offset < 0 || offset >= m_scriptData.size()) {
+    int offset = vaddr - base;
+    if (offset < 0 || offset >= data.size()) {
         return QString();
     }
 
-    return decodeGen3String(m_scriptData, offset);
+    return decodeGen3String(data, offset);
 }
 
 QString ScriptDisassembler::decodeGen3String(const QByteArray &data, int offset, int maxLen) const
 {
+    if (offset < 0 || offset >= data.size()) {
+        return QString();
+    }
+
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*>(data.constData());
+    int end = offset + Gen3Text::terminatedLength(bytes + offset, qMin(maxLen, data.size() - offset));
+    const QChar *charset = Gen3Text::decodeTable(Gen3Text::ScriptText);
+
     QString result;
+    result.reserve(end - offset);
     int i = offset;
-    int end = qMin(offset + maxLen, data.size());
 
     while (i < end) {
-        uint8_t byte = static_cast<uint8_t>(data[i]);
-
-        if (byte == 0xFF) break; // Terminator
+        uint8_t byte = bytes[i];
 
         if (byte == 0xFD && i + 1 < end) { // Variable placeholder
-            uint8_t varId = static_cast<uint8_t>(data[i + 1]);
+            uint8_t varId = bytes[i + 1];
             result += m_varPlaceholders.value(varId, QString("{VAR_%1}").arg(varId, 2, 16, QChar('0')));
             i += 2;
             continue;
@@ -643,13 +497,15 @@ QString ScriptDisassembler::decodeGen3String(const QByteArray &data, int offset,
             continue;
         }
 
-        QString ch = m_gen3Charset.value(byte, "");
-        if (ch == "\\n" || ch == "\\l") {
-            result += "\n";
-        } else if (ch == "\\p") {
+        if (byte == 0xFA || byte == 0xFE) { // \l, \n
+            result += QChar('\n');
+        } else if (byte == 0xFB) { // \p
             result += "\n\n";
-        } else if (!ch.isEmpty() && !ch.startsWith("\\")) {
-            result += ch;
+        } else {
+            QChar ch = charset[byte];
+            if (!ch.isNull()) {
+                result += ch;
+            }
         }
 
         i++;
@@ -658,22 +514,23 @@ QString ScriptDisassembler::decodeGen3String(const QByteArray &data, int offset,
     return result;
 }
 
-QVector<ScriptDisassembler::EmbeddedString> ScriptDisassembler::findEmbeddedStrings() const
+QVector<ScriptDisassembler::EmbeddedString> ScriptDisassembler::findEmbeddedStrings(
+    const QByteArray &data, const DecodedScript &script) const
 {
     QVector<EmbeddedString> strings;
     QSet<uint32_t> seenAddrs;
 
-    for (const ScriptInstruction &instr : m_instructions) {
-        if (instr.opcode == 0xBD) { // vmessage
-            if (!instr.args.isEmpty()) {
+    for (const ScriptInstruction &instr : script.instructions) {
+        if (instr.opcode == 0xBD && instr.kind == ScriptInstruction::Command) { // vmessage
+            if (instr.argCount > 0) {
                 uint32_t vaddr = instr.args[0];
                 if (!seenAddrs.contains(vaddr)) {
                     seenAddrs.insert(vaddr);
-                    QString text = readEmbeddedString(vaddr);
+                    QString text = readEmbeddedString(data, script.inferredBase, vaddr);
                     if (!text.isEmpty()) {
                         EmbeddedString es;
                         es.vaddr = vaddr;
-                        es.offset = vaddr - m_inferredBase;
+                        es.offset = vaddr - script.inferredBase;
                         es.text = text;
                         strings.append(es);
                     }
@@ -691,60 +548,109 @@ QVector<ScriptDisassembler::EmbeddedString> ScriptDisassembler::findEmbeddedStri
     return strings;
 }
 
-QString ScriptDisassembler::disassemble(const QByteArray &data, bool showComments,
-                                        bool showBytes, bool showOffsets)
-{
-    if (m_commands.isEmpty()) {
-        return "; ERROR: Command definitions not loaded\n";
-    }
+// =============================================================================
+// DECODING
+// =============================================================================
 
-    m_instructions.clear();
-    m_scriptData = data;
-    m_flagsFound.clear();
-    m_flagsUnknown.clear();
+void ScriptDisassembler::decode(const QByteArray &data, DecodedScript &out) const
+{
+    decode(reinterpret_cast<const uint8_t*>(data.constData()), data.size(), out);
+}
 
-    // Infer base address first (needed for virtual address conversion)
-    inferBaseAddress(data);
-    // Then find jump targets (can now convert virtual addresses to offsets)
-    findJumpTargets(data);
+void ScriptDisassembler::decode(const uint8_t *data, int size, DecodedScript &out) const
+{
+    MGI_TRACE_SCOPE("ScriptDisassembler::decode");
+    out.clear();
+    if (out.instructions.capacity() < size / 2) {
+        out.instructions.reserve(size / 2);
+    }
 
-    // First pass: parse all instructions
     int offset = 0;
-    while (offset < data.size()) {
-        uint8_t opcode = static_cast<uint8_t>(data[offset]);
-
+    while (offset < size) {
         ScriptInstruction instr;
         instr.offset = offset;
-        instr.opcode = opcode;
-        instr.label = m_labels.value(offset, "");
-
-        if (opcode == 0x02) { // end
-            instr.name = "end";
-            instr.rawBytes = data.mid(offset, 1);
-            instr.comment = "Terminates script execution";
-            m_instructions.append(instr);
+        instr.label = -1;
+        instr.opcode = data[offset];
+        instr.argCount = 0;
+
+        if (instr.opcode == 0x02) { // end
+            instr.kind = ScriptInstruction::End;
+            instr.length = 1;
+            out.instructions.append(instr);
             break;
         }
 
-        if (m_commands.contains(opcode)) {
-            const CommandDef &cmd = m_commands[opcode];
-            instr.name = cmd.name;
-
-            int argLen = parseArguments(data, offset + 1, cmd.args, instr.args, instr.argTypes);
-            instr.rawBytes = data.mid(offset, 1 + argLen);
-            instr.comment = generateComment(opcode, cmd.name, instr.args, instr.argTypes);
-
-            m_instructions.append(instr);
-            offset += 1 + argLen;
+        const OpcodeLayout &layout = m_layouts[instr.opcode];
+        if (layout.known) {
+            instr.kind = ScriptInstruction::Command;
+            instr.length = static_cast<uint8_t>(1 + decodeArguments(data, size, offset + 1, layout, instr));
         } else {
             // Unknown opcode
-            instr.name = "db";
-            instr.args.append(opcode);
-            instr.argTypes.append("b");
-            instr.rawBytes = data.mid(offset, 1);
-            instr.comment = QString("Unknown opcode 0x%1").arg(opcode, 2, 16, QChar('0'));
-            m_instructions.append(instr);
-            offset += 1;
+            instr.kind = ScriptInstruction::Unknown;
+            instr.length = 1;
+            instr.argCount = 1;
+            instr.args[0] = instr.opcode;
+            instr.argTypes[0] = ScriptArgType::Byte;
+        }
+
+        out.instructions.append(instr);
+        offset += instr.length;
+    }
+
+    // Base address first (needed for virtual address conversion), then
+    // jump targets (can now convert virtual addresses to offsets)
+    inferBaseAddress(out);
+    findJumpTargets(size, out);
+}
+
+// =============================================================================
+// FORMATTING
+// =============================================================================
+
+QString ScriptDisassembler::instructionName(const ScriptInstruction &instr) const
+{
+    switch (instr.kind) {
+        case ScriptInstruction::End:
+            return "end";
+        case ScriptInstruction::Unknown:
+            return "db";
+        default:
+            return m_commands.value(instr.opcode).name;
+    }
+}
+
+QString ScriptDisassembler::formatArgument(const ScriptInstruction &instr, int argIndex) const
+{
+    if (argIndex < 0 || argIndex >= instr.argCount) {
+        return QString();
+    }
+    return formatArg(instr.args[argIndex], instr.argTypes[argIndex], argIndex, instr.opcode);
+}
+
+QString ScriptDisassembler::instructionComment(const QByteArray &data, const DecodedScript &script,
+                                               const ScriptInstruction &instr) const
+{
+    switch (instr.kind) {
+        case ScriptInstruction::End:
+            return "Terminates script execution";
+        case ScriptInstruction::Unknown:
+            return QString("Unknown opcode 0x%1").arg(instr.opcode, 2, 16, QChar('0'));
+        default:
+            return generateComment(data, script.inferredBase, instr);
+    }
+}
+
+QString ScriptDisassembler::format(const QByteArray &data, const DecodedScript &script, bool showComments,
+                                   bool showBytes, bool showOffsets) const
+{
+    // Flags touched by setflag/clearflag/checkflag
+    QSet<uint16_t> flagsFound;
+    QSet<uint16_t> flagsUnknown;
+    for (const ScriptInstruction &instr : script.instructions) {
+        if (instr.kind == ScriptInstruction::Command && instr.argCount > 0
+            && (instr.opcode == 0x29 || instr.opcode == 0x2A || instr.opcode == 0x2B)) {
+            uint16_t flagId = static_cast<uint16_t>(instr.args[0]);
+            (m_flags.contains(flagId) ? flagsFound : flagsUnknown).insert(flagId);
         }
     }
 
@@ -752,9 +658,9 @@ QString ScriptDisassembler::disassemble(const QByteArray &data, bool showComment
     QStringList output;
     output << "; Pokemon Gen 3 Mystery Event Script Disassembly";
 
-    if (m_romReader && m_romReader->isLoaded()) {
+    if (!m_romVersion.isEmpty()) {
         // Format ROM name like Python: "FireRed (US)" instead of "FireRed_1.0"
-        QString romName = m_romReader->versionName();
+        QString romName = m_romVersion;
         if (romName.startsWith("FireRed")) {
             romName = "FireRed (US)";
         } else if (romName.startsWith("LeafGreen")) {
@@ -765,15 +671,15 @@ QString ScriptDisassembler::disassemble(const QByteArray &data, bool showComment
         output << QString("; ROM: %1").arg(romName);
     }
 
-    if (m_inferredBase) {
-        output << QString("; Inferred virtual base address: 0x%1").arg(m_inferredBase, 8, 16, QChar('0'));
+    if (script.inferredBase) {
+        output << QString("; Inferred virtual base address: 0x%1").arg(script.inferredBase, 8, 16, QChar('0'));
     }
 
-    output << QString("; Total instructions: %1").arg(m_instructions.size());
-    output << QString("; Labels found: %1").arg(m_labels.size());
-    output << QString("; Flags resolved: %1").arg(m_flagsFound.size());
-    if (!m_flagsUnknown.isEmpty()) {
-        output << QString("; Unknown flags: %1").arg(m_flagsUnknown.size());
+    output << QString("; Total instructions: %1").arg(script.instructions.size());
+    output << QString("; Labels found: %1").arg(script.labels.size());
+    output << QString("; Flags resolved: %1").arg(flagsFound.size());
+    if (!flagsUnknown.isEmpty()) {
+        output << QString("; Unknown flags: %1").arg(flagsUnknown.size());
     }
     output << ";";
     output << "; Legend:";
@@ -781,7 +687,7 @@ QString ScriptDisassembler::disassemble(const QByteArray &data, bool showComment
     output << ";   FLAG_0xxxx = Game flags";
     output << ";   @label_N   = Jump/call target";
     output << ";   STD_xxx    = Standard script ID";
-    if (m_romReader && m_romReader->hasNameTables()) {
+    if (!m_itemNames.isEmpty()) {
         output << ";   ITEM_xxx   = Item name from ROM";
         output << ";   SPECIES_xxx = Pokemon species from ROM";
         output << ";   MOVE_xxx   = Move name from ROM";
@@ -790,10 +696,10 @@ QString ScriptDisassembler::disassemble(const QByteArray &data, bool showComment
     output << ".script_start:";
 
     // Output instructions
-    for (const ScriptInstruction &instr : m_instructions) {
+    for (const ScriptInstruction &instr : script.instructions) {
         // Add label line
-        if (!instr.label.isEmpty()) {
-            output << QString("\n%1:").arg(instr.label);
+        if (instr.label >= 0) {
+            output << QString("\n%1:").arg(labelName(instr.label));
         }
 
         QString line;
@@ -803,23 +709,27 @@ QString ScriptDisassembler::disassemble(const QByteArray &data, bool showComment
 
         if (showBytes) {
             QString hexBytes;
-            for (int i = 0; i < qMin(instr.rawBytes.size(), 8); i++) {
-                hexBytes += QString("%1 ").arg(static_cast<uint8_t>(instr.rawBytes[i]), 2, 16, QChar('0')).toUpper();
+            int byteCount = qMin<int>(instr.length, 8);
+            for (int i = 0; i < byteCount && instr.offset + i < data.size(); i++) {
+                hexBytes += QString("%1 ").arg(static_cast<uint8_t>(data[instr.offset + i]), 2, 16, QChar('0')).toUpper();
             }
             line += QString("  %1").arg(hexBytes, -24);
         }
 
         // Format arguments
         QStringList formattedArgs;
-        for (int i = 0; i < instr.args.size(); i++) {
-            formattedArgs << formatArg(instr.args[i], instr.argTypes[i], i, instr.opcode);
+        for (int i = 0; i < instr.argCount; i++) {
+            formattedArgs << formatArgument(instr, i);
         }
 
         QString argsStr = formattedArgs.join(", ");
-        line += QString("  %1 %2").arg(instr.name.leftJustified(20)).arg(argsStr);
+        line += QString("  %1 %2").arg(instructionName(instr).leftJustified(20)).arg(argsStr);
 
-        if (showComments && !instr.comment.isEmpty()) {
-            line += QString(" # %1").arg(instr.comment);
+        if (showComments) {
+            QString comment = instructionComment(data, script, instr);
+            if (!comment.isEmpty()) {
+                line += QString(" # %1").arg(comment);
+            }
         }
 
         output << line;
@@ -828,8 +738,8 @@ QString ScriptDisassembler::disassemble(const QByteArray &data, bool showComment
     output << "\n.script_end";
 
     // Add embedded strings section
-    if (m_inferredBase && !m_scriptData.isEmpty()) {
-        QVector<EmbeddedString> embeddedStrings = findEmbeddedStrings();
+    if (script.inferredBase && !data.isEmpty()) {
+        QVector<EmbeddedString> embeddedStrings = findEmbeddedStrings(data, script);
         if (!embeddedStrings.isEmpty()) {
             output << "";
             output << "; =========================================";
@@ -856,9 +766,29 @@ QString ScriptDisassembler::disassemble(const QByteArray &data, bool showComment
     return output.join("\n");
 }
 
+QString ScriptDisassembler::disassemble(const QByteArray &data, bool showComments,
+                                        bool showBytes, bool showOffsets) const
+{
+    if (m_commands.isEmpty()) {
+        return "; ERROR: Command definitions not loaded\n";
+    }
+
+    DecodedScript script;
+    decode(data, script);
+    return format(data, script, showComments, showBytes, showOffsets);
+}
+
 QString ScriptDisassembler::disassembleRamScript(const QByteArray &data, bool showComments,
-                                                  bool showBytes, bool showOffsets)
+                                                  bool showBytes, bool showOffsets) const
+{
+    DecodedScript buffer;
+    return disassembleRamScript(data, buffer, showComments, showBytes, showOffsets);
+}
+
+QString ScriptDisassembler::disassembleRamScript(const QByteArray &data, DecodedScript &buffer, bool showComments,
+                                                  bool showBytes, bool showOffsets) const
 {
+    MGI_TRACE_SCOPE("ScriptDisassembler::disassembleRamScript");
     if (data.size() < 4) {
         return "; ERROR: Data too small for RamScript\n";
     }
@@ -882,7 +812,12 @@ QString ScriptDisassembler::disassembleRamScript(const QByteArray &data, bool sh
     // Script data starts at offset 4 (after header)
     QByteArray scriptData = data.mid(4);
 
-    output << disassemble(scriptData, showComments, showBytes, showOffsets);
+    if (m_commands.isEmpty()) {
+        output << "; ERROR: Command definitions not loaded\n";
+    } else {
+        decode(scriptData, buffer);
+        output << format(scriptData, buffer, showComments, showBytes, showOffsets);
+    }
 
     return output.join("\n");
 }
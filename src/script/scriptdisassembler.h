@@ -36,7 +36,8 @@
  *
  * ## Command Definitions
  *
- * Commands are loaded from script_commands.yaml which defines:
+ * Commands come from script_commands.yaml (compiled into the build as
+ * script_data.mgsd, see ScriptData) which defines:
  * - Opcode to command name mapping
  * - Argument format strings
  * - Command descriptions for comments
@@ -57,50 +58,128 @@
 #include <QString>
 #include <QByteArray>
 #include <QHash>
-#include <QSet>
 #include <QVector>
 #include <QStringList>
 
-// Forward declaration
-class GBAROReader;
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "scriptdata.h"
+#include "nametable.h"
+
+/// Interned argument types (one per YAML format character)
+enum class ScriptArgType : uint8_t {
+    Byte,       // b
+    Word,       // w
+    Dword,      // d
+    Var,        // v
+    Flag,       // f
+    Item,       // i
+    Species,    // p
+    Move        // M
+};
 
 /**
  * @struct ScriptInstruction
- * @brief Represents a single disassembled instruction.
+ * @brief One decoded instruction (POD, no heap storage).
+ *
+ * Names, operands and comments are not stored; they are produced on demand
+ * by the formatting functions of ScriptDisassembler.
  */
 struct ScriptInstruction {
-    int offset;             // Byte offset in script
-    uint8_t opcode;         // Raw opcode
-    QString name;           // Command name
-    QVector<uint32_t> args; // Raw argument values
-    QStringList argTypes;   // Argument types (b, w, d, v, f, i, p, M)
-    QByteArray rawBytes;    // Raw instruction bytes
-    QString comment;        // Generated comment
-    QString label;          // Label if jump target
+    enum Kind : uint8_t {
+        Command,                // Known opcode
+        End,                    // 0x02, terminates decoding
+        Unknown                 // Emitted as "db <opcode>"
+    };
+
+    static const int MAX_ARGS = 8;
+
+    int offset;                         // Byte offset in script
+    int label;                          // Label index if jump target, else -1
+    uint8_t opcode;                     // Raw opcode
+    uint8_t length;                     // Opcode + argument bytes
+    uint8_t kind;                       // Kind
+    uint8_t argCount;                   // May be short when the data ends mid-instruction
+    ScriptArgType argTypes[MAX_ARGS];
+    uint32_t args[MAX_ARGS];            // Raw argument values
 };
 
-/// Command definition loaded from YAML
-struct CommandDef {
-    QString name;
-    QString args;
-    QString desc;
+/// Caller-owned decode buffer; reuse it to avoid reallocating per script
+struct DecodedScript {
+    DecodedScript() : inferredBase(0) {}
+
+    void clear()
+    {
+        instructions.clear();
+        labels.clear();
+        inferredBase = 0;
+    }
+
+    QVector<ScriptInstruction> instructions;
+    QVector<int> labels;                // Label index -> target offset
+    uint32_t inferredBase;              // Virtual base from setvaddress (0 if none)
 };
 
-/// Disassembles Pokemon Gen 3 Mystery Event scripts (RamScript/GMScript)
+/**
+ * @class ScriptDisassembler
+ * @brief Disassembles Pokemon Gen 3 Mystery Event scripts (RamScript/GMScript)
+ *
+ * Disassembly runs in two stages: decode() turns bytecode into a compact
+ * ScriptInstruction stream, and the formatting functions render text from
+ * that stream on demand. Both stages are const and keep no per-script
+ * state, so once the tables are loaded one disassembler can serve any
+ * number of threads (loading and setRomNames() must not race with them).
+ */
 class ScriptDisassembler
 {
 public:
     ScriptDisassembler();
     ~ScriptDisassembler();
 
+    /// Load commands and reference data compiled into the build
+    /// (or the MGI_YAML_DIR override, see ScriptData::load)
+    bool loadDefaultData(QString &error);
+
+    /// Replace commands and reference data with pre-loaded tables
+    void setScriptData(const ScriptData &data);
+
     /// Load command definitions from YAML file
     bool loadCommandDefinitions(const QString &yamlPath, QString &error);
 
     /// Load script reference data (flags, specials, etc.) from YAML
     bool loadScriptData(const QString &yamlPath, QString &error);
 
-    /// Set ROM reader for name resolution (optional)
-    void setRomReader(GBAROReader *reader) { m_romReader = reader; }
+    /// ROM version and name tables for name resolution (optional)
+    void setRomNames(const QString &versionName, const NameTable &items,
+                     const NameTable &pokemon, const NameTable &moves);
+    void clearRomNames() { setRomNames(QString(), NameTable(), NameTable(), NameTable()); }
+
+    /// Decode script bytecode (without RamScript header) into out
+    void decode(const uint8_t *data, int size, DecodedScript &out) const;
+    void decode(const QByteArray &data, DecodedScript &out) const;
+
+    /// Lazy text formatting of a decoded stream
+    QString instructionName(const ScriptInstruction &instr) const;
+    QString formatArgument(const ScriptInstruction &instr, int argIndex) const;
+    QString instructionComment(const QByteArray &data, const DecodedScript &script,
+                               const ScriptInstruction &instr) const;
+    QString labelName(int label) const { return QString("label_%1").arg(label); }
+
+    /// Symbolic form of a value of the given type (e.g. a flag or var name)
+    QString formatValue(uint32_t value, ScriptArgType type) const { return formatArg(value, type, -1, 0); }
+    QString specialName(uint16_t id) const { return m_specials.value(id); }
+
+    /// Jump/call operand of instr, if it has one. Virtual targets are
+    /// relative to DecodedScript::inferredBase.
+    static bool jumpOperand(const ScriptInstruction &instr, uint32_t &address, bool &isVirtual);
+
+    /// Index of the instruction starting at offset, or -1
+    static int instructionAt(const DecodedScript &script, int offset);
+
+    /// Full listing of a decoded stream
+    QString format(const QByteArray &data, const DecodedScript &script, bool showComments = true,
+                   bool showBytes = true, bool showOffsets = true) const;
 
     /// Disassemble script data
     /// @param data Raw script bytecode (without RamScript header)
@@ -108,12 +187,15 @@ public:
     /// @param showBytes Show raw hex bytes
     /// @param showOffsets Show byte offsets
     QString disassemble(const QByteArray &data, bool showComments = true,
-                       bool showBytes = true, bool showOffsets = true);
+                       bool showBytes = true, bool showOffsets = true) const;
 
     /// Disassemble full RamScript (with header)
     /// @param data Full RamScript data including 4-byte header
+    /// @param buffer Decode buffer reused between calls
+    QString disassembleRamScript(const QByteArray &data, DecodedScript &buffer, bool showComments = true,
+                                 bool showBytes = true, bool showOffsets = true) const;
     QString disassembleRamScript(const QByteArray &data, bool showComments = true,
-                                 bool showBytes = true, bool showOffsets = true);
+                                 bool showBytes = true, bool showOffsets = true) const;
 
     /// Get parsed header info from RamScript
     struct RamScriptHeader {
@@ -125,34 +207,36 @@ public:
     };
     RamScriptHeader parseRamScriptHeader(const QByteArray &data) const;
 
-    /// Get list of instructions (after disassembly)
-    const QVector<ScriptInstruction>& instructions() const { return m_instructions; }
-
     /// Check if commands are loaded
     bool isReady() const { return !m_commands.isEmpty(); }
 
 private:
-    // Parse arguments based on format string
-    int parseArguments(const QByteArray &data, int offset, const QString &fmt,
-                      QVector<uint32_t> &args, QStringList &types);
+    // Argument layout per opcode, interned from CommandDef::args
+    struct OpcodeLayout {
+        bool known;
+        uint8_t argCount;
+        ScriptArgType argTypes[ScriptInstruction::MAX_ARGS];
+    };
+    void buildOpcodeLayouts();
+
+    // Decode one instruction's arguments; returns bytes consumed
+    int decodeArguments(const uint8_t *data, int size, int offset, const OpcodeLayout &layout,
+                        ScriptInstruction &instr) const;
 
     // Format an argument for display
-    QString formatArg(uint32_t value, const QString &type, int argIndex,
-                     uint8_t opcode) const;
+    QString formatArg(uint32_t value, ScriptArgType type, int argIndex, uint8_t opcode) const;
 
     // Generate comment for instruction
-    QString generateComment(uint8_t opcode, const QString &name,
-                           const QVector<uint32_t> &args,
-                           const QStringList &types) const;
+    QString generateComment(const QByteArray &data, uint32_t base, const ScriptInstruction &instr) const;
 
     // Find jump targets for labeling
-    void findJumpTargets(const QByteArray &data);
+    void findJumpTargets(int size, DecodedScript &script) const;
 
     // Infer virtual base address from setvaddress/vgoto commands
-    void inferBaseAddress(const QByteArray &data);
+    void inferBaseAddress(DecodedScript &script) const;
 
     // Read embedded string at virtual address
-    QString readEmbeddedString(uint32_t vaddr) const;
+    QString readEmbeddedString(const QByteArray &data, uint32_t base, uint32_t vaddr) const;
 
     // Decode Gen3 encoded string
     QString decodeGen3String(const QByteArray &data, int offset, int maxLen = 200) const;
@@ -163,10 +247,11 @@ private:
         int offset;
         QString text;
     };
-    QVector<EmbeddedString> findEmbeddedStrings() const;
+    QVector<EmbeddedString> findEmbeddedStrings(const QByteArray &data, const DecodedScript &script) const;
 
     // Command definitions (opcode -> CommandDef)
     QHash<uint8_t, CommandDef> m_commands;
+    OpcodeLayout m_layouts[256];
 
     // Script reference data
     QHash<uint8_t, QString> m_conditions;     // condition code -> symbol
@@ -176,30 +261,11 @@ private:
     QHash<uint16_t, QString> m_specials;      // special ID -> name
     QHash<uint8_t, QString> m_varPlaceholders; // placeholder ID -> string
 
-    // Gen3 character encoding
-    QHash<uint8_t, QString> m_gen3Charset;
-
-    // Jump targets (offset -> label name)
-    QHash<int, QString> m_labels;
-
-    // Disassembled instructions
-    QVector<ScriptInstruction> m_instructions;
-
-    // Script data for string extraction
-    QByteArray m_scriptData;
-
-    // Inferred base address for virtual commands
-    uint32_t m_inferredBase;
-
-    // ROM reader for name resolution
-    GBAROReader *m_romReader;
-
-    // Track flags found during disassembly
-    mutable QSet<uint16_t> m_flagsFound;      // Flags that were resolved
-    mutable QSet<uint16_t> m_flagsUnknown;    // Flags that weren't in database
-
-    // Initialize Gen3 charset
-    void initGen3Charset();
+    // ROM names for resolution (empty without a ROM)
+    QString m_romVersion;
+    NameTable m_itemNames;
+    NameTable m_pokemonNames;
+    NameTable m_moveNames;
 };
 
 #endif // SCRIPTDISASSEMBLER_H
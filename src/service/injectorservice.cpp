@@ -0,0 +1,665 @@
+/**
+ * @file injectorservice.cpp
+ * @brief Implementation of the resident injection service.
+ *
+ * @see injectorservice.h for the protocol and processing model
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "injectorservice.h"
+#include "logcategories.h"
+#include "tracing.h"
+#include "savefile.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QPointer>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QBuffer>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QDebug>
+
+const QString InjectorService::DEFAULT_SERVER_NAME = "mgi_service";
+
+namespace {
+const int WATCH_DEBOUNCE_MS = 250;
+const int SERVER_PROBE_TIMEOUT_MS = 500;
+const char WATCH_FAILED_FOLDER[] = "failed";
+
+QJsonObject errorResponse(const QString &errorMessage)
+{
+    QJsonObject response;
+    response["ok"] = false;
+    response["error"] = errorMessage;
+    return response;
+}
+}
+
+InjectorService::InjectorService(QObject *parent)
+    : QObject(parent)
+    , m_server(nullptr)
+    , m_requestCount(0)
+    , m_watcher(nullptr)
+    , m_watchTimer(nullptr)
+    , m_watchEnableMysteryGift(false)
+{
+    m_allowedDirectories << QDir::current().canonicalPath();
+    m_uptime.start();
+}
+
+InjectorService::~InjectorService()
+{
+    // Queued responses capture this; let running requests finish first
+    m_pool.waitForDone();
+}
+
+void InjectorService::setThreadCount(int threadCount)
+{
+    m_pool.setMaxThreadCount(threadCount > 0 ? threadCount : qMax(1, QThread::idealThreadCount()));
+}
+
+void InjectorService::setWatchOptions(const InjectionOptions &options, bool enableMysteryGift)
+{
+    m_watchOptions = options;
+    m_watchEnableMysteryGift = enableMysteryGift;
+}
+
+// =============================================================================
+// STARTUP
+// =============================================================================
+
+bool InjectorService::loadContext(const QString &ticketsFolder, const QString &romPath,
+                                  QString &errorMessage)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QSharedPointer<ServiceContext> context(new ServiceContext());
+    if (!context->ticketManager.loadFromFolder(ticketsFolder, errorMessage)) {
+        return false;
+    }
+
+    // Materialize every ticket once; requests only ever read these copies
+    for (const TicketResource &source : context->ticketManager.tickets()) {
+        TicketResource ticket = source;
+        QString ticketError;
+        if (!ticket.isDataLoaded() &&
+            !ticket.loadData(context->ticketManager.ticketsFolderPath(), ticketError)) {
+            qWarning() << "InjectorService: skipping ticket" << ticket.id() << ":" << ticketError;
+            continue;
+        }
+
+        context->cards.insert(ticket.id(), MysteryGift::parseWonderCard(ticket.wonderCardData()));
+
+        BatchInjector injector;
+        if (injector.setTicket(ticket, context->ticketManager.crcTable(), ticketError)) {
+            context->injectors.insert(ticket.id(), injector);
+        }
+    }
+
+    context->assets = romPath.isEmpty()
+        ? CardRasterizer::fallbackAssets(errorMessage)
+        : CardRasterizer::loadAssets(romPath, errorMessage);
+    if (!context->assets) {
+        return false;
+    }
+
+    m_context = context;
+    qCDebug(lcService) << "InjectorService: context loaded in" << timer.elapsed() << "ms -"
+                       << context->cards.size() << "tickets";
+    return true;
+}
+
+bool InjectorService::setAllowedDirectories(const QStringList &directories, QString &errorMessage)
+{
+    QStringList canonical;
+    for (const QString &directory : directories) {
+        QFileInfo info(directory);
+        if (!info.isDir()) {
+            errorMessage = "Not a directory: " + directory;
+            return false;
+        }
+        canonical << info.canonicalFilePath();
+    }
+
+    m_allowedDirectories = canonical;
+    return true;
+}
+
+bool InjectorService::listen(const QString &serverName, QString &errorMessage)
+{
+    if (!m_context) {
+        errorMessage = "Service context not loaded";
+        return false;
+    }
+
+    // A stale socket file from a crashed instance would block listen(), but
+    // only remove it if nothing answers on it
+    QLocalSocket probe;
+    probe.connectToServer(serverName);
+    if (probe.waitForConnected(SERVER_PROBE_TIMEOUT_MS)) {
+        probe.disconnectFromServer();
+        errorMessage = "Another service is already listening on " + serverName;
+        return false;
+    }
+    QLocalServer::removeServer(serverName);
+
+    m_server = new QLocalServer(this);
+    m_server->setSocketOptions(QLocalServer::UserAccessOption);
+    if (!m_server->listen(serverName)) {
+        errorMessage = "Failed to listen on " + serverName + ": " + m_server->errorString();
+        return false;
+    }
+
+    connect(m_server, &QLocalServer::newConnection, this, &InjectorService::acceptConnections);
+    return true;
+}
+
+bool InjectorService::watchFolder(const QString &inbox, const QString &ticketId,
+                                  const QString &outputDirectory, QString &errorMessage)
+{
+    if (!m_context) {
+        errorMessage = "Service context not loaded";
+        return false;
+    }
+
+    auto injector = m_context->injectors.constFind(ticketId);
+    if (injector == m_context->injectors.constEnd()) {
+        errorMessage = "Unknown or non-injectable ticket: " + ticketId;
+        return false;
+    }
+
+    QString inboxPath = QFileInfo(inbox).absoluteFilePath();
+    QString outputPath = QFileInfo(outputDirectory).absoluteFilePath();
+    if (!QDir().mkpath(inboxPath) || !QDir().mkpath(outputPath)) {
+        errorMessage = "Failed to create watch folders";
+        return false;
+    }
+    if (QDir(inboxPath) == QDir(outputPath)) {
+        errorMessage = "Watch output directory must differ from the inbox";
+        return false;
+    }
+
+    m_watchInjector = injector.value();
+    m_watchInjector.setInjectionOptions(m_watchOptions);
+    m_watchInjector.setEnableMysteryGift(m_watchEnableMysteryGift);
+    m_watchInjector.setOutputDirectory(outputPath);
+    m_watchInbox = inboxPath;
+
+    m_watcher = new QFileSystemWatcher(QStringList() << inboxPath, this);
+    m_watchTimer = new QTimer(this);
+    m_watchTimer->setSingleShot(true);
+    m_watchTimer->setInterval(WATCH_DEBOUNCE_MS);
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &InjectorService::scheduleWatchScan);
+    connect(m_watchTimer, &QTimer::timeout, this, &InjectorService::scanWatchFolder);
+
+    // Pick up whatever was dropped while the service was down
+    scheduleWatchScan();
+    return true;
+}
+
+// =============================================================================
+// SOCKET
+// =============================================================================
+
+void InjectorService::acceptConnections()
+{
+    while (QLocalSocket *socket = m_server->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::readyRead, this, &InjectorService::readRequests);
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+    }
+}
+
+void InjectorService::readRequests()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket*>(sender());
+    if (!socket) {
+        return;
+    }
+
+    while (socket->canReadLine()) {
+        QByteArray line = socket->readLine().trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        // Parse and compute off the main thread; only the write comes back here
+        QPointer<QLocalSocket> target(socket);
+        m_pool.start([this, target, line]() {
+            QJsonParseError parseError;
+            QJsonDocument document = QJsonDocument::fromJson(line, &parseError);
+            QJsonObject response = document.isObject()
+                ? handleRequest(document.object())
+                : errorResponse("Invalid request: " + parseError.errorString());
+
+            QByteArray reply = QJsonDocument(response).toJson(QJsonDocument::Compact) + '\n';
+            QMetaObject::invokeMethod(this, [target, reply]() {
+                if (target) {
+                    target->write(reply);
+                }
+            }, Qt::QueuedConnection);
+        });
+    }
+}
+
+// =============================================================================
+// REQUESTS
+// =============================================================================
+
+QJsonObject InjectorService::handleRequest(const QJsonObject &request) const
+{
+    QElapsedTimer timer;
+    timer.start();
+    m_requestCount.fetchAndAddRelaxed(1);
+
+    // Holding a reference keeps the context alive for the whole request
+    QSharedPointer<const ServiceContext> context = m_context;
+    QString op = request.value("op").toString();
+
+    QJsonObject response;
+    if (!context) {
+        response = errorResponse("Service context not loaded");
+    } else if (op == "inject") {
+        response = handleInject(*context, request);
+    } else if (op == "extract") {
+        response = handleExtract(*context, request);
+    } else if (op == "preview") {
+        response = handlePreview(*context, request);
+    } else if (op == "tickets") {
+        response = handleTickets(*context);
+    } else if (op == "status") {
+        response = handleStatus(*context);
+    } else if (op == "trace") {
+        response = handleTrace(request);
+    } else {
+        response = errorResponse("Unknown op: " + op);
+    }
+
+    if (request.contains("id")) {
+        response["id"] = request.value("id");
+    }
+    response["ms"] = static_cast<double>(timer.elapsed());
+    return response;
+}
+
+QJsonObject InjectorService::handleInject(const ServiceContext &context, const QJsonObject &request) const
+{
+    QString ticketId = request.value("ticket").toString();
+    auto configured = context.injectors.constFind(ticketId);
+    if (configured == context.injectors.constEnd()) {
+        return errorResponse("Unknown or non-injectable ticket: " + ticketId);
+    }
+
+    QString savePath;
+    QString errorMessage;
+    if (!resolveClientPath(request.value("save").toString(), savePath, errorMessage)) {
+        return errorResponse(errorMessage);
+    }
+
+    QString outputDirectory;
+    if (request.contains("outputDir") &&
+        !resolveClientPath(request.value("outputDir").toString(), outputDirectory, errorMessage)) {
+        return errorResponse(errorMessage);
+    }
+
+    // Per-request copy; the ticket data inside is shared, not duplicated
+    BatchInjector injector = configured.value();
+    InjectionOptions options;
+    options.clearMetadata = !request.value("keepMetadata").toBool();
+    options.clearTrainerIds = request.value("clearTrainerIds").toBool();
+    injector.setInjectionOptions(options);
+    injector.setOutputDirectory(outputDirectory);
+    injector.setMakeBackup(request.value("backup").toBool());
+    injector.setEnableMysteryGift(request.value("enableMysteryGift").toBool());
+    injector.setWriteMode(request.value("patch").toBool() ? SaveWriteMode::PatchSections
+                                                          : SaveWriteMode::FullRewrite);
+
+    QStringList busy = jobPaths(injector, savePath);
+    if (!claimPaths(busy)) {
+        return errorResponse("Another job is already writing " + savePath);
+    }
+    BatchInjectionResult result = injector.process(savePath);
+    releasePaths(busy);
+
+    if (!result.success) {
+        return errorResponse(result.errorMessage);
+    }
+
+    QJsonObject response;
+    response["ok"] = true;
+    response["output"] = result.outputPath;
+    return response;
+}
+
+QJsonObject InjectorService::handleExtract(const ServiceContext &context, const QJsonObject &request) const
+{
+    SaveFile saveFile;
+    QString savePath;
+    QString errorMessage;
+    if (!resolveClientPath(request.value("save").toString(), savePath, errorMessage) ||
+        !saveFile.loadFromFile(savePath, errorMessage)) {
+        return errorResponse(errorMessage);
+    }
+
+    WonderCardData card = saveFile.extractWonderCard(errorMessage);
+    if (!errorMessage.isEmpty()) {
+        return errorResponse(errorMessage);
+    }
+
+    ByteView raw = saveFile.wonderCardRawView();
+    ByteView script = saveFile.scriptView();
+    const TicketResource *ticket = context.ticketManager.findTicketByWonderCard(raw, saveFile.detectedGame());
+
+    QJsonObject response;
+    response["ok"] = true;
+    response["game"] = saveFile.gameTypeToString(saveFile.detectedGame());
+    response["checksumValid"] = saveFile.checksumValid();
+    response["mysteryGiftEnabled"] = saveFile.isMysteryGiftEnabled();
+    response["hasWonderCard"] = saveFile.hasWonderCard();
+    response["ticket"] = ticket ? QJsonValue(ticket->id()) : QJsonValue();
+    response["eventId"] = card.eventId;
+    response["icon"] = card.icon;
+    response["title"] = card.title;
+    response["subtitle"] = card.subtitle;
+    response["content"] = QJsonArray({card.contentLine1, card.contentLine2,
+                                      card.contentLine3, card.contentLine4});
+    response["warning"] = QJsonArray({card.warningLine1, card.warningLine2});
+    response["wonderCard"] = QString::fromLatin1(
+        QByteArray::fromRawData(reinterpret_cast<const char*>(raw.data), static_cast<int>(raw.size)).toBase64());
+    response["script"] = QString::fromLatin1(
+        QByteArray::fromRawData(reinterpret_cast<const char*>(script.data), static_cast<int>(script.size)).toBase64());
+    return response;
+}
+
+QJsonObject InjectorService::handlePreview(const ServiceContext &context, const QJsonObject &request) const
+{
+    WonderCardData card;
+    if (request.contains("ticket")) {
+        QString ticketId = request.value("ticket").toString();
+        auto found = context.cards.constFind(ticketId);
+        if (found == context.cards.constEnd()) {
+            return errorResponse("Unknown ticket: " + ticketId);
+        }
+        card = found.value();
+    } else {
+        SaveFile saveFile;
+        QString savePath;
+        QString errorMessage;
+        if (!resolveClientPath(request.value("save").toString(), savePath, errorMessage) ||
+            !saveFile.loadFromFile(savePath, errorMessage)) {
+            return errorResponse(errorMessage);
+        }
+        card = saveFile.extractWonderCard(errorMessage);
+        if (!errorMessage.isEmpty()) {
+            return errorResponse(errorMessage);
+        }
+    }
+
+    CardRasterizer rasterizer(context.assets);
+    QImage image = rasterizer.render(card, qBound(1, request.value("scale").toInt(1), 8));
+    if (image.isNull()) {
+        return errorResponse("Failed to render Wonder Card");
+    }
+
+    QJsonObject response;
+    if (request.contains("output")) {
+        QString outputPath;
+        QString errorMessage;
+        if (!resolveClientPath(request.value("output").toString(), outputPath, errorMessage)) {
+            return errorResponse(errorMessage);
+        }
+        if (!image.save(outputPath, "PNG")) {
+            return errorResponse("Failed to write " + outputPath);
+        }
+        response["output"] = outputPath;
+    } else {
+        QByteArray png;
+        QBuffer buffer(&png);
+        buffer.open(QIODevice::WriteOnly);
+        if (!image.save(&buffer, "PNG")) {
+            return errorResponse("Failed to encode Wonder Card as PNG");
+        }
+        response["png"] = QString::fromLatin1(png.toBase64());
+    }
+
+    response["ok"] = true;
+    return response;
+}
+
+QJsonObject InjectorService::handleTickets(const ServiceContext &context) const
+{
+    QJsonArray tickets;
+    for (const TicketResource &ticket : context.ticketManager.tickets()) {
+        QJsonObject entry;
+        entry["id"] = ticket.id();
+        entry["name"] = ticket.name();
+        entry["game"] = ticket.gameTypeString();
+        entry["injectable"] = context.injectors.contains(ticket.id());
+        tickets.append(entry);
+    }
+
+    QJsonObject response;
+    response["ok"] = true;
+    response["tickets"] = tickets;
+    return response;
+}
+
+QJsonObject InjectorService::handleStatus(const ServiceContext &context) const
+{
+    QJsonObject response;
+    response["ok"] = true;
+    response["uptimeMs"] = static_cast<double>(m_uptime.elapsed());
+    response["requests"] = m_requestCount.loadRelaxed();
+    response["threads"] = m_pool.maxThreadCount();
+    response["tickets"] = context.cards.size();
+    response["rom"] = context.assets->reader ? context.assets->reader->versionName() : QString();
+    response["watching"] = m_watchInbox;
+    return response;
+}
+
+QJsonObject InjectorService::handleTrace(const QJsonObject &request) const
+{
+    QString action = request.value("action").toString("counters");
+    QJsonObject response;
+
+    if (action == "start") {
+        Tracing::setEnabled(true);
+    } else if (action == "stop") {
+        Tracing::setEnabled(false);
+    } else if (action == "reset") {
+        Tracing::reset();
+    } else if (action == "counters") {
+        QJsonArray counters;
+        for (const TraceCounter &counter : Tracing::counters()) {
+            counters.append(QJsonObject{
+                {"name", QString::fromLatin1(counter.name)},
+                {"count", static_cast<double>(counter.count)},
+                {"totalMs", counter.totalNs / 1e6},
+                {"maxMs", counter.maxNs / 1e6}
+            });
+        }
+        response["counters"] = counters;
+    } else if (action == "write") {
+        QString output;
+        QString errorMessage;
+        if (!resolveClientPath(request.value("output").toString(), output, errorMessage)) {
+            return errorResponse(errorMessage);
+        }
+        if (!Tracing::writeChromeTrace(output, errorMessage)) {
+            return errorResponse(errorMessage);
+        }
+        response["output"] = output;
+    } else {
+        return errorResponse("Unknown trace action: " + action);
+    }
+
+    response["ok"] = true;
+    response["enabled"] = Tracing::isEnabled();
+    return response;
+}
+
+bool InjectorService::resolveClientPath(const QString &path, QString &resolved, QString &errorMessage) const
+{
+    if (path.isEmpty()) {
+        errorMessage = "Missing path";
+        return false;
+    }
+
+    // Canonicalize the longest existing prefix (follows symlinks); the rest,
+    // already free of ".." after cleanPath, is appended as is
+    QString absolute = QDir::cleanPath(QDir(m_allowedDirectories.value(0)).absoluteFilePath(path));
+    QString existing = absolute;
+    QString remainder;
+    while (!QFileInfo::exists(existing)) {
+        QFileInfo info(existing);
+        remainder = remainder.isEmpty() ? info.fileName() : info.fileName() + "/" + remainder;
+        existing = info.absolutePath();
+    }
+    QString canonical = QFileInfo(existing).canonicalFilePath();
+    resolved = remainder.isEmpty() ? canonical : QDir(canonical).filePath(remainder);
+
+    for (const QString &directory : m_allowedDirectories) {
+        if (resolved == directory || resolved.startsWith(directory.endsWith('/') ? directory : directory + "/")) {
+            return true;
+        }
+    }
+
+    errorMessage = "Path is outside the allowed directories: " + path;
+    return false;
+}
+
+QStringList InjectorService::jobPaths(const BatchInjector &injector, const QString &savePath) const
+{
+    // Output files may not exist yet: canonicalize their directory instead
+    QStringList paths;
+    for (const QString &path : {savePath, injector.outputPathFor(savePath)}) {
+        QFileInfo info(path);
+        QString canonicalDir = QFileInfo(info.absolutePath()).canonicalFilePath();
+        QString key = info.exists() ? info.canonicalFilePath()
+            : (canonicalDir.isEmpty() ? info.absoluteFilePath() : QDir(canonicalDir).filePath(info.fileName()));
+        if (!paths.contains(key)) {
+            paths << key;
+        }
+    }
+    return paths;
+}
+
+bool InjectorService::claimPaths(const QStringList &paths) const
+{
+    QMutexLocker locker(&m_busyMutex);
+    for (const QString &path : paths) {
+        if (m_busyPaths.contains(path)) {
+            return false;
+        }
+    }
+    for (const QString &path : paths) {
+        m_busyPaths.insert(path);
+    }
+    return true;
+}
+
+void InjectorService::releasePaths(const QStringList &paths) const
+{
+    QMutexLocker locker(&m_busyMutex);
+    for (const QString &path : paths) {
+        m_busyPaths.remove(path);
+    }
+}
+
+// =============================================================================
+// WATCH FOLDER
+// =============================================================================
+
+void InjectorService::scheduleWatchScan()
+{
+    m_watchTimer->start();
+}
+
+void InjectorService::scanWatchFolder()
+{
+    bool incomplete = false;
+    const QFileInfoList entries = QDir(m_watchInbox).entryInfoList(QStringList() << "*.sav", QDir::Files);
+    for (const QFileInfo &entry : entries) {
+        QString savePath = entry.absoluteFilePath();
+        if (m_watchInFlight.contains(savePath)) {
+            continue;
+        }
+
+        // An inject request is working on the same file; look again shortly
+        QStringList busy = jobPaths(m_watchInjector, savePath);
+        if (!claimPaths(busy)) {
+            incomplete = true;
+            continue;
+        }
+
+        // Only plain files: a link would make the service read (and later
+        // delete the link to) something outside the inbox
+        if (entry.isSymLink()) {
+            BatchInjectionResult rejected;
+            rejected.savePath = savePath;
+            rejected.errorMessage = "Symbolic links are not accepted";
+            finishWatchedSave(savePath, rejected, busy);
+            continue;
+        }
+
+        // Still being copied in; look again shortly
+        if (entry.size() < SaveFile::EXPECTED_FILE_SIZE) {
+            releasePaths(busy);
+            incomplete = true;
+            continue;
+        }
+
+        m_watchInFlight.insert(savePath);
+        m_pool.start([this, savePath, busy]() {
+            BatchInjectionResult result = m_watchInjector.process(savePath);
+            QMetaObject::invokeMethod(this, [this, savePath, result, busy]() {
+                finishWatchedSave(savePath, result, busy);
+            }, Qt::QueuedConnection);
+        });
+    }
+
+    if (incomplete) {
+        m_watchTimer->start();
+    }
+}
+
+void InjectorService::finishWatchedSave(const QString &savePath, const BatchInjectionResult &result,
+                                        const QStringList &busy)
+{
+    // Only ever remove or move entries of the inbox itself
+    if (QFileInfo(savePath).absolutePath() != m_watchInbox) {
+        releasePaths(busy);
+        m_watchInFlight.remove(savePath);
+        return;
+    }
+
+    if (result.success) {
+        qCDebug(lcService) << "InjectorService: injected" << savePath << "->" << result.outputPath;
+        QFile::remove(savePath);
+    } else {
+        // Park failures so they are not retried on every scan
+        QDir inbox(m_watchInbox);
+        inbox.mkpath(WATCH_FAILED_FOLDER);
+        QString failedPath = inbox.filePath(QString(WATCH_FAILED_FOLDER) + "/" + QFileInfo(savePath).fileName());
+        QFile::remove(failedPath);
+        QFile::rename(savePath, failedPath);
+        qWarning() << "InjectorService: failed" << savePath << ":" << result.errorMessage;
+    }
+
+    releasePaths(busy);
+    m_watchInFlight.remove(savePath);
+}
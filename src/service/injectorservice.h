@@ -0,0 +1,174 @@
+/**
+ * @file injectorservice.h
+ * @brief Resident injection service with warm ROM, ticket and asset state.
+ *
+ * InjectorService loads everything a job needs once at startup (ticket
+ * folder, CRC table, every ticket's data, ROM, font and background assets)
+ * into one immutable ServiceContext, then serves requests against it until
+ * the process exits. Clients skip the per-process startup cost the CLI tools
+ * pay on every run.
+ *
+ * ## Protocol
+ * A QLocalServer (named pipe / Unix socket) accepts newline-delimited JSON.
+ * Each request line is an object with an "op" and an optional "id" that is
+ * echoed back; each response is one JSON line with "ok" and, on failure,
+ * "error". Responses may arrive out of order.
+ *
+ * The socket is only accessible to the user running the service. Every path
+ * a client sends (saves, output directories and files) must resolve, after
+ * following symbolic links, inside one of the allowed directories (default:
+ * the working directory at startup); anything else is rejected.
+ *
+ *   {"op":"inject","save":<path>,"ticket":<id>[,"outputDir":<dir>]
+ *    [,"enableMysteryGift":true][,"clearTrainerIds":true][,"keepMetadata":true]
+ *    [,"backup":true][,"patch":true]}               -> "output"
+ *   {"op":"extract","save":<path>}                   -> "game", "ticket", card fields,
+ *                                                       "wonderCard"/"script" (base64)
+ *   {"op":"preview","ticket":<id> | "save":<path>[,"scale":n][,"output":<png>]}
+ *                                                    -> "output", or "png" (base64)
+ *   {"op":"tickets"}                                 -> "tickets": [{id,name,game}]
+ *   {"op":"status"}                                  -> counters and context info
+ *   {"op":"trace","action":"start"|"stop"|"reset"|"counters"|"write"[,"output":<json>]}
+ *                                                    -> "enabled", "counters" / "output"
+ *
+ * ## Watch Folder
+ * Optionally, *.sav files dropped into an inbox directory are injected with a
+ * fixed ticket and written to an output directory; the input is then removed
+ * (or moved to <inbox>/failed on error).
+ *
+ * ## Processing Model
+ * Sockets and the watcher live on the main thread. Every request runs on the
+ * service's QThreadPool against the shared context (read-only, so no locks)
+ * and posts its response back to the main thread. Saving uses fixed side
+ * file names (.tmp, .bak, .bakd, .journal), so at most one job at a time may
+ * touch a given save or output file: an inject request for a busy file is
+ * rejected, a busy watched save is picked up by a later scan.
+ *
+ * @see BatchInjector for the injection path
+ * @see CardRasterizer for preview rendering
+ * @see main_service.cpp for the command-line front end
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef INJECTORSERVICE_H
+#define INJECTORSERVICE_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QObject>
+#include <QString>
+#include <QHash>
+#include <QSet>
+#include <QJsonObject>
+#include <QSharedPointer>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QAtomicInt>
+#include <QMutex>
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "batchinjector.h"
+#include "ticketmanager.h"
+#include "cardrasterizer.h"
+
+class QLocalServer;
+class QLocalSocket;
+class QFileSystemWatcher;
+class QTimer;
+
+/// <summary>
+/// Everything loaded at startup. Never modified once the service is running.
+/// </summary>
+struct ServiceContext {
+    TicketManager ticketManager;
+    QHash<QString, BatchInjector> injectors;   // Ticket ID -> configured injector (Wonder Card tickets)
+    QHash<QString, WonderCardData> cards;      // Ticket ID -> parsed Wonder Card
+    QSharedPointer<const CardAssets> assets;   // ROM assets, or placeholders without a ROM
+};
+
+/// <summary>
+/// Serves inject/extract/preview requests over a local socket and a watch folder.
+///
+/// USAGE:
+///   InjectorService service;
+///   service.loadContext(ticketsFolder, romPath, error);
+///   service.listen(InjectorService::DEFAULT_SERVER_NAME, error);
+///   service.watchFolder(inbox, "aurora_ticket_frlg_enguk", outbox, error);
+///   app.exec();
+/// </summary>
+class InjectorService : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit InjectorService(QObject *parent = nullptr);
+    ~InjectorService();
+
+    // Startup (romPath may be empty: previews use placeholder graphics)
+    bool loadContext(const QString &ticketsFolder, const QString &romPath, QString &errorMessage);
+    bool setAllowedDirectories(const QStringList &directories, QString &errorMessage);
+    bool listen(const QString &serverName, QString &errorMessage);
+    bool watchFolder(const QString &inbox, const QString &ticketId, const QString &outputDirectory,
+                     QString &errorMessage);
+
+    // Watch-folder injection settings (defaults match mgi_batch); call before watchFolder()
+    void setWatchOptions(const InjectionOptions &options, bool enableMysteryGift);
+    void setThreadCount(int threadCount);
+
+    QSharedPointer<const ServiceContext> context() const { return m_context; }
+
+    /// Handles one request against the context. Thread-safe.
+    QJsonObject handleRequest(const QJsonObject &request) const;
+
+    static const QString DEFAULT_SERVER_NAME;
+
+private slots:
+    void acceptConnections();
+    void readRequests();
+    void scheduleWatchScan();
+    void scanWatchFolder();
+
+private:
+    QJsonObject handleInject(const ServiceContext &context, const QJsonObject &request) const;
+    QJsonObject handleExtract(const ServiceContext &context, const QJsonObject &request) const;
+    QJsonObject handlePreview(const ServiceContext &context, const QJsonObject &request) const;
+    QJsonObject handleTickets(const ServiceContext &context) const;
+    QJsonObject handleStatus(const ServiceContext &context) const;
+    QJsonObject handleTrace(const QJsonObject &request) const;
+
+    // Resolves a client path (symlinks included) and checks it is inside an allowed directory
+    bool resolveClientPath(const QString &path, QString &resolved, QString &errorMessage) const;
+
+    // In-flight save jobs, keyed by canonical input and output path (thread-safe)
+    QStringList jobPaths(const BatchInjector &injector, const QString &savePath) const;
+    bool claimPaths(const QStringList &paths) const;
+    void releasePaths(const QStringList &paths) const;
+
+    void finishWatchedSave(const QString &savePath, const BatchInjectionResult &result,
+                           const QStringList &busy);   // Releases the job's claimed paths
+
+    QSharedPointer<const ServiceContext> m_context;
+    QStringList m_allowedDirectories;   // Canonical; client paths must lie inside one
+    mutable QMutex m_busyMutex;
+    mutable QSet<QString> m_busyPaths;  // Files a running inject or watch job reads or writes
+    QLocalServer *m_server;
+    QThreadPool m_pool;
+    QElapsedTimer m_uptime;
+    mutable QAtomicInt m_requestCount;
+
+    // Watch folder
+    QFileSystemWatcher *m_watcher;
+    QTimer *m_watchTimer;            // Debounces directory change bursts
+    QString m_watchInbox;
+    BatchInjector m_watchInjector;   // Watch ticket + output directory
+    InjectionOptions m_watchOptions;
+    bool m_watchEnableMysteryGift;
+    QSet<QString> m_watchInFlight;   // Absolute paths currently being injected
+};
+
+#endif // INJECTORSERVICE_H
@@ -0,0 +1,119 @@
+/**
+ * @file main_service.cpp
+ * @brief Command-line front end for the resident injection service.
+ *
+ * Usage:
+ *   mgi_service [--rom <rom>] [--tickets <dir>] [--name <socket>]
+ *               [--allow-dir <dir>]... [--watch <inbox> --watch-ticket <id> [--watch-output <dir>]]
+ *               [options]
+ *
+ * Loads tickets, ROM and render assets once, then serves newline-delimited
+ * JSON requests on a local socket (see injectorservice.h for the protocol)
+ * and, with --watch, injects saves dropped into the inbox. Runs until killed.
+ * Clients may only name paths inside the --allow-dir directories (default:
+ * the working directory).
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <QDir>
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "injectorservice.h"
+#include "tracing.h"
+
+int main(int argc, char *argv[])
+{
+    // Previews render offscreen; no window is ever shown
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName("mgi_service");
+    QCoreApplication::setApplicationVersion("1.0");
+    Tracing::initFromEnvironment();   // MGI_TRACE / MGI_TRACE_COUNTERS
+
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Serves Mystery Gift injection, extraction and previews with warm ROM and ticket state.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption romOption("rom", "ROM to take backgrounds, fonts and icons from (default: placeholders).", "rom");
+    QCommandLineOption ticketsOption("tickets", "Tickets folder (default: <app dir>/Tickets).", "dir");
+    QCommandLineOption nameOption("name", "Local socket name (default: mgi_service).", "name",
+                                  InjectorService::DEFAULT_SERVER_NAME);
+    QCommandLineOption threadsOption({"j", "threads"}, "Worker threads (default: ideal thread count).", "n");
+    QCommandLineOption allowDirOption("allow-dir", "Directory clients may read and write (repeatable; default: working directory).", "dir");
+    QCommandLineOption watchOption("watch", "Inject *.sav files dropped into this folder.", "inbox");
+    QCommandLineOption watchTicketOption("watch-ticket", "Ticket ID for the watch folder.", "id");
+    QCommandLineOption watchOutputOption("watch-output", "Where watched saves are written (default: <inbox>/done).", "dir");
+    QCommandLineOption enableMgOption("enable-mystery-gift", "Watch folder: set the Mystery Gift flag if it is not set.");
+    QCommandLineOption clearTrainerIdsOption("clear-trainer-ids", "Watch folder: clear saved Mystery Gift trainer IDs.");
+    QCommandLineOption keepMetadataOption("keep-metadata", "Watch folder: do not clear Wonder Card metadata.");
+
+    parser.addOptions({romOption, ticketsOption, nameOption, threadsOption, allowDirOption, watchOption, watchTicketOption,
+                       watchOutputOption, enableMgOption, clearTrainerIdsOption, keepMetadataOption});
+    parser.process(app);
+
+    QString ticketsFolder = parser.isSet(ticketsOption)
+        ? parser.value(ticketsOption)
+        : QCoreApplication::applicationDirPath() + "/" + TicketManager::DEFAULT_TICKETS_FOLDER;
+
+    InjectorService service;
+    service.setThreadCount(parser.value(threadsOption).toInt());
+
+    QString errorMessage;
+    if (!service.loadContext(ticketsFolder, parser.value(romOption), errorMessage)) {
+        err << "Failed to load service context: " << errorMessage << Qt::endl;
+        return 2;
+    }
+
+    if (parser.isSet(allowDirOption) && !service.setAllowedDirectories(parser.values(allowDirOption), errorMessage)) {
+        err << errorMessage << Qt::endl;
+        return 2;
+    }
+
+    if (!service.listen(parser.value(nameOption), errorMessage)) {
+        err << errorMessage << Qt::endl;
+        return 2;
+    }
+
+    if (parser.isSet(watchOption)) {
+        if (!parser.isSet(watchTicketOption)) {
+            err << "--watch needs --watch-ticket <id>" << Qt::endl;
+            return 2;
+        }
+
+        InjectionOptions options;
+        options.clearMetadata = !parser.isSet(keepMetadataOption);
+        options.clearTrainerIds = parser.isSet(clearTrainerIdsOption);
+        service.setWatchOptions(options, parser.isSet(enableMgOption));
+
+        QString inbox = parser.value(watchOption);
+        QString outbox = parser.isSet(watchOutputOption) ? parser.value(watchOutputOption)
+                                                         : QDir(inbox).filePath("done");
+        if (!service.watchFolder(inbox, parser.value(watchTicketOption), outbox, errorMessage)) {
+            err << errorMessage << Qt::endl;
+            return 2;
+        }
+    }
+
+    err << QString("Listening on %1 (%2 tickets)")
+               .arg(parser.value(nameOption))
+               .arg(service.context()->cards.size())
+        << Qt::endl;
+
+    return app.exec();
+}
@@ -0,0 +1,101 @@
+/**
+ * @file main_pack.cpp
+ * @brief Command-line tool that builds a ticket pack from a Tickets/ folder.
+ *
+ * Usage:
+ *   mgi_pack [--tickets <dir>] [-o <pack>]
+ *
+ * Discovers the loose {NAME}_WonderCard.bin / {NAME}_Script.bin pairs exactly
+ * like the application does (ignoring any existing pack), applies tickets.json
+ * display names and descriptions, and writes them into a single TicketPack
+ * file. The pack defaults to <tickets dir>/tickets.mgtp, where TicketManager
+ * picks it up automatically.
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <QDir>
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "ticketmanager.h"
+#include "ticketpack.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("mgi_pack");
+    QCoreApplication::setApplicationVersion("1.0");
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Builds a single-file ticket pack from a Tickets folder.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption ticketsOption("tickets", "Tickets folder (default: <app dir>/Tickets).", "dir");
+    QCommandLineOption outputOption({"o", "output"}, "Pack file to write (default: <tickets dir>/tickets.mgtp).", "pack");
+    parser.addOptions({ticketsOption, outputOption});
+    parser.process(app);
+
+    QString ticketsFolder = parser.isSet(ticketsOption)
+        ? parser.value(ticketsOption)
+        : QCoreApplication::applicationDirPath() + "/" + TicketManager::DEFAULT_TICKETS_FOLDER;
+    QString packPath = parser.isSet(outputOption)
+        ? parser.value(outputOption)
+        : QDir(ticketsFolder).filePath(TicketPack::DEFAULT_FILENAME);
+
+    // Load loose files only; an existing pack is being replaced
+    TicketManager ticketManager;
+    QString errorMessage;
+    if (!ticketManager.loadFromFolder(ticketsFolder, errorMessage, false)) {
+        err << "Failed to load tickets: " << errorMessage << Qt::endl;
+        return 2;
+    }
+
+    TicketPack::Builder builder;
+    for (const TicketResource &source : ticketManager.tickets()) {
+        TicketResource ticket = source;
+        if (!ticket.isDataLoaded() && !ticket.loadData(ticketManager.ticketsFolderPath(), errorMessage)) {
+            err << "Skipping " << ticket.id() << ": " << errorMessage << Qt::endl;
+            continue;
+        }
+
+        if (!builder.addTicket(ticket.id(), ticket.name(), ticket.description(), ticket.gameType(),
+                               ticket.wonderCardData(), ticket.scriptData(), errorMessage)) {
+            err << "Skipping " << ticket.id() << ": " << errorMessage << Qt::endl;
+            continue;
+        }
+        out << "ADD  " << ticket.id() << "\t" << ticket.name() << Qt::endl;
+    }
+
+    if (builder.count() == 0) {
+        err << "No tickets to pack" << Qt::endl;
+        return 1;
+    }
+
+    if (!builder.write(packPath, errorMessage)) {
+        err << errorMessage << Qt::endl;
+        return 1;
+    }
+
+    // Re-open to validate what was written
+    TicketPack pack;
+    if (!pack.open(packPath, errorMessage) || pack.count() != builder.count()) {
+        err << "Written pack failed validation: " << errorMessage << Qt::endl;
+        return 1;
+    }
+
+    out << QString("Packed %1 tickets into %2").arg(pack.count()).arg(packPath) << Qt::endl;
+    return 0;
+}
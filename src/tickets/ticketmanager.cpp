@@ -1,12 +1,18 @@
 #include "ticketmanager.h"
+#include "logcategories.h"
+#include "tracing.h"
+#include "mysterygift.h"
 #include <QFile>
 #include <QDir>
 #include <QFileInfo>
+#include <QDateTime>
 #include <QRegularExpression>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QCoreApplication>
+#include <QThreadPool>
+#include <algorithm>
 
 const QString TicketManager::DEFAULT_TICKETS_FOLDER = "Tickets";
 
@@ -19,11 +25,16 @@ TicketManager::~TicketManager()
 {
 }
 
-bool TicketManager::loadFromFolder(const QString &ticketsFolderPath, QString &errorMessage)
+bool TicketManager::loadFromFolder(const QString &ticketsFolderPath, QString &errorMessage, bool usePack)
 {
+    MGI_TRACE_SCOPE("TicketManager::loadFromFolder");
     // Clear any existing data
     m_tickets.clear();
     m_crcTable.clear();
+    m_pack.reset();
+    m_indexById.clear();
+    m_indexByEvent.clear();
+    m_indexByContent.clear();
     m_loaded = false;
     m_ticketsFolderPath = ticketsFolderPath;
 
@@ -39,18 +50,51 @@ bool TicketManager::loadFromFolder(const QString &ticketsFolderPath, QString &er
         return false;
     }
 
-    // Discover tickets from folder (dynamic discovery)
-    if (!discoverTickets(errorMessage)) {
-        return false;
+    // Prefer the packed archive (one mapped file, manifest already folded in)
+    QString packPath = ticketsDir.filePath(TicketPack::DEFAULT_FILENAME);
+    bool fromPack = false;
+    if (usePack && QFile::exists(packPath)) {
+        QString packError;
+        fromPack = !isPackStale(packPath, packError) && loadPack(packPath, packError);
+        if (!fromPack) {
+            qWarning() << "Ignoring ticket pack" << packPath << ":" << packError;
+        }
     }
 
-    // Optionally load metadata from manifest (display names, descriptions)
-    loadManifestMetadata();
+    if (!fromPack) {
+        // Discover tickets from folder (dynamic discovery)
+        if (!discoverTickets(errorMessage)) {
+            return false;
+        }
+
+        // Optionally load metadata from manifest (display names, descriptions)
+        loadManifestMetadata();
+    }
+
+    // Index tickets for O(1) lookups
+    buildIndex();
 
     m_loaded = true;
     return true;
 }
 
+bool TicketManager::isPackStale(const QString &packPath, QString &reason) const
+{
+    // The pack is a snapshot of the loose files; editing any of them (or the
+    // manifest) after it was built means the pack no longer reflects the
+    // folder. A pack shipped without loose files is never stale.
+    QDateTime packModified = QFileInfo(packPath).lastModified();
+    const QFileInfoList sources = QDir(m_ticketsFolderPath).entryInfoList(
+        QStringList() << "*_WonderCard.bin" << "*_Script.bin" << "tickets.json", QDir::Files);
+    for (const QFileInfo &source : sources) {
+        if (source.lastModified() > packModified) {
+            reason = QString("%1 is newer than the pack (rebuild it with mgi_pack)").arg(source.fileName());
+            return true;
+        }
+    }
+    return false;
+}
+
 bool TicketManager::loadCrcTable(QString &errorMessage)
 {
     // Load CRC table from embedded resource
@@ -78,6 +122,13 @@ bool TicketManager::loadCrcTable(QString &errorMessage)
         return false;
     }
 
+    // CRCs are computed from built-in tables; tab.bin only cross-checks them
+    if (!MysteryGift::validateCRCTable(m_crcTable)) {
+        errorMessage = "CRC table does not match the built-in CRC16 table";
+        m_crcTable.clear();
+        return false;
+    }
+
     return true;
 }
 
@@ -189,6 +240,31 @@ bool TicketManager::discoverTickets(QString &errorMessage)
     return true;
 }
 
+bool TicketManager::loadPack(const QString &packPath, QString &errorMessage)
+{
+    QSharedPointer<TicketPack> pack(new TicketPack());
+    if (!pack->open(packPath, errorMessage)) {
+        return false;
+    }
+
+    if (pack->count() == 0) {
+        errorMessage = "Ticket pack contains no tickets";
+        return false;
+    }
+
+    m_tickets.reserve(pack->count());
+    for (int i = 0; i < pack->count(); ++i) {
+        TicketPack::Entry entry = pack->entry(i);
+        TicketResource ticket(entry.id, entry.name, entry.gameType, QString(), QString(), entry.description);
+        ticket.setPackSource(pack, i);
+        m_tickets.append(ticket);
+    }
+
+    m_pack = pack;
+    qInfo() << "Loaded" << m_tickets.size() << "tickets from pack" << packPath;
+    return true;
+}
+
 bool TicketManager::loadManifestMetadata()
 {
     // Optional: Load display names and descriptions from tickets.json if it exists
@@ -232,10 +308,18 @@ bool TicketManager::loadManifestMetadata()
     }
 
     // Update discovered tickets with manifest metadata
-    // Note: This requires making TicketResource mutable or adding setters
-    // For now, we just log what we found
-    for (const auto &id : metadata.keys()) {
-        qInfo() << "Manifest metadata for" << id << ":" << metadata[id].first;
+    for (TicketResource &ticket : m_tickets) {
+        auto it = metadata.constFind(ticket.id());
+        if (it == metadata.constEnd()) {
+            continue;
+        }
+        if (!it.value().first.isEmpty()) {
+            ticket.setName(it.value().first);
+        }
+        if (!it.value().second.isEmpty()) {
+            ticket.setDescription(it.value().second);
+        }
+        qInfo() << "Manifest metadata for" << ticket.id() << ":" << ticket.name();
     }
 
     return true;
@@ -385,75 +469,131 @@ QVector<const TicketResource*> TicketManager::ticketsForGame(GameType gameType)
 
 const TicketResource* TicketManager::findTicketById(const QString &id) const
 {
-    for (const TicketResource &ticket : m_tickets) {
-        if (ticket.id() == id) {
-            return &ticket;
-        }
-    }
-
-    return nullptr;
+    auto it = m_indexById.constFind(id);
+    return it != m_indexById.constEnd() ? &m_tickets[it.value()] : nullptr;
 }
 
-const TicketResource* TicketManager::findTicketByWonderCard(const QByteArray &wonderCardData,
-                                                             GameType gameType)
+QVector<const TicketResource*> TicketManager::ticketsForEvent(GameType gameType, uint16_t eventId) const
 {
-    if (wonderCardData.isEmpty() || wonderCardData.size() != TicketResource::WONDERCARD_SIZE) {
-        return nullptr;
+    QList<int> indices = m_indexByEvent.values(eventKey(gameType, eventId));
+    std::sort(indices.begin(), indices.end());  // Discovery order
+
+    QVector<const TicketResource*> result;
+    result.reserve(indices.size());
+    for (int index : indices) {
+        result.append(&m_tickets[index]);
     }
 
-    // Search through tickets matching the game type
-    for (TicketResource &ticket : m_tickets) {
-        if (ticket.gameType() != gameType) {
-            continue;
+    return result;
+}
+
+quint64 TicketManager::wonderCardContentKey(GameType gameType, ByteView wonderCardData)
+{
+    // FNV-1a over the payload minus COUNT (payload bytes 4-7), seeded with the
+    // game type; the CRC header is skipped so it does not affect matching
+    const uint8_t *payload = wonderCardData.data + TicketResource::WONDERCARD_HEADER_SIZE;
+    const int afterCount = 8;
+
+    quint64 hash = 14695981039346656037ULL ^ static_cast<quint64>(gameType);
+    auto mix = [&hash](const uint8_t *bytes, int length) {
+        for (int i = 0; i < length; ++i) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
         }
+    };
+    mix(payload, 4);
+    mix(payload + afterCount, TicketResource::WONDERCARD_PAYLOAD_SIZE - afterCount);
+
+    return hash;
+}
 
-        // Load ticket data if not already loaded
-        if (!ticket.isDataLoaded()) {
-            QString error;
-            if (!ticket.loadData(m_ticketsFolderPath, error)) {
-                qWarning() << "Failed to load ticket data for comparison:" << ticket.id() << error;
-                continue;
-            }
+void TicketManager::buildIndex()
+{
+    m_indexById.clear();
+    m_indexByEvent.clear();
+    m_indexByContent.clear();
+    m_indexById.reserve(m_tickets.size());
+
+    // Wonder Card keys need the 336-byte data. Pack-backed tickets read it
+    // straight from the mapping (and stay lazy); loose tickets are loaded in
+    // full here, in parallel, each worker touching only its own element.
+    TicketResource *tickets = m_tickets.data();
+    QVector<QString> loadErrors(m_tickets.size());
+    QString *errors = loadErrors.data();
+    QThreadPool pool;
+    for (int i = 0; i < m_tickets.size(); ++i) {
+        if (!tickets[i].isPacked() && !tickets[i].isDataLoaded()) {
+            QString folder = m_ticketsFolderPath;
+            pool.start([tickets, errors, folder, i]() {
+                tickets[i].loadData(folder, errors[i]);
+            });
         }
+    }
+    pool.waitForDone();
 
-        // Compare wonder card data, skipping CRC header and variable fields
-        // 336-byte format: CRC(0-3), payload(4-335)
-        // Payload: eventId(0-1), icon(2-3), COUNT(4-7), data(8-331)
-        // Skip: CRC header (0-3), COUNT (bytes 8-11 of file / 4-7 of payload)
-        const QByteArray &ticketData = ticket.wonderCardData();
+    for (int i = 0; i < m_tickets.size(); ++i) {
+        const TicketResource &ticket = m_tickets.at(i);
 
-        // Both files should be 336 bytes (with CRC header)
-        const int HEADER_SIZE = TicketResource::WONDERCARD_HEADER_SIZE;  // 4
-        const int PAYLOAD_SIZE = TicketResource::WONDERCARD_PAYLOAD_SIZE;  // 332
+        // First ticket with a given ID wins (same as the former linear scan)
+        if (!m_indexById.contains(ticket.id())) {
+            m_indexById.insert(ticket.id(), i);
+        }
 
-        // Verify both are 336 bytes
-        if (ticketData.size() != TicketResource::WONDERCARD_SIZE) {
+        if (!loadErrors.at(i).isEmpty()) {
+            qWarning() << "Failed to load ticket data for index:" << ticket.id() << loadErrors.at(i);
             continue;
         }
 
-        const char* savePtr = wonderCardData.constData() + HEADER_SIZE;
-        const char* ticketPtr = ticketData.constData() + HEADER_SIZE;
+        ByteView wonderCard = ticket.wonderCardBytes();
+        if (wonderCard.size != static_cast<size_t>(TicketResource::WONDERCARD_SIZE)) {
+            continue;
+        }
+        WonderCardView view(wonderCard);
+        m_indexByEvent.insert(eventKey(ticket.gameType(), view.eventId()), i);
+        m_indexByContent.insert(wonderCardContentKey(ticket.gameType(), wonderCard), i);
+    }
 
-        bool match = true;
+    qCDebug(lcTickets) << "Ticket index built:" << m_indexById.size() << "IDs," << m_indexByContent.size() << "Wonder Cards";
+}
 
-        // Compare eventId + icon (first 4 bytes of payload)
-        if (memcmp(savePtr, ticketPtr, 4) != 0) {
-            match = false;
-        }
+const TicketResource* TicketManager::findTicketByWonderCard(const QByteArray &wonderCardData,
+                                                             GameType gameType) const
+{
+    return findTicketByWonderCard(ByteView(wonderCardData), gameType);
+}
+
+const TicketResource* TicketManager::findTicketByWonderCard(ByteView wonderCardData, GameType gameType) const
+{
+    if (wonderCardData.size != static_cast<size_t>(TicketResource::WONDERCARD_SIZE)) {
+        return nullptr;
+    }
 
-        // Skip COUNT (bytes 4-7 of payload), compare rest (bytes 8+)
-        if (match) {
-            int afterCount = 8;  // Skip first 4 bytes (eventId+icon) and COUNT (4 bytes)
-            int remainingSize = PAYLOAD_SIZE - afterCount;
-            if (memcmp(savePtr + afterCount, ticketPtr + afterCount, remainingSize) != 0) {
-                match = false;
-            }
+    // Compare wonder card data, skipping CRC header and variable fields
+    // 336-byte format: CRC(0-3), payload(4-335)
+    // Payload: eventId(0-1), icon(2-3), COUNT(4-7), data(8-331)
+    // Skip: CRC header (0-3), COUNT (bytes 8-11 of file / 4-7 of payload)
+    const int HEADER_SIZE = TicketResource::WONDERCARD_HEADER_SIZE;  // 4
+    const int PAYLOAD_SIZE = TicketResource::WONDERCARD_PAYLOAD_SIZE;  // 332
+    const int afterCount = 8;
+    const uint8_t* savePtr = wonderCardData.data + HEADER_SIZE;
+
+    // Hash lookup; candidates are verified byte-for-byte to rule out collisions.
+    // The lowest index wins so results match discovery order.
+    const TicketResource *match = nullptr;
+    int matchIndex = m_tickets.size();
+    quint64 key = wonderCardContentKey(gameType, wonderCardData);
+    for (auto it = m_indexByContent.constFind(key); it != m_indexByContent.constEnd() && it.key() == key; ++it) {
+        const TicketResource &ticket = m_tickets[it.value()];
+        if (it.value() >= matchIndex || ticket.gameType() != gameType) {
+            continue;
         }
 
-        if (match) {
-            return &ticket;
+        const uint8_t* ticketPtr = ticket.wonderCardBytes().data + HEADER_SIZE;
+        if (memcmp(savePtr, ticketPtr, 4) == 0 &&
+            memcmp(savePtr + afterCount, ticketPtr + afterCount, PAYLOAD_SIZE - afterCount) == 0) {
+            match = &ticket;
+            matchIndex = it.value();
         }
     }
 
-    return nullptr;
+    return match;
 }
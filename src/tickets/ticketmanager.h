@@ -4,7 +4,11 @@
 #include <QString>
 #include <QByteArray>
 #include <QVector>
+#include <QHash>
+#include <QMultiHash>
+#include <QSharedPointer>
 #include "ticketresource.h"
+#include "ticketpack.h"
 
 /// <summary>
 /// Manages loading and accessing Mystery Gift ticket resources from external folder.
@@ -36,6 +40,23 @@
 ///   Language is extracted for display name formatting.
 ///   Each WonderCard is matched to its Script by the shared prefix.
 ///   Optional tickets.json manifest can provide additional metadata.
+///
+/// TICKET PACK:
+///   If the folder contains tickets.mgtp (built with mgi_pack), it is used
+///   instead of the loose files: one memory-mapped file holds every Wonder
+///   Card, script and manifest entry, and TicketResource data is only copied
+///   out of the mapping when loadData() is called. An unreadable pack, or a
+///   stale one (a loose ticket file or tickets.json modified after the pack),
+///   falls back to dynamic discovery with a warning.
+///
+/// LOOKUP INDEX:
+///   loadFromFolder() reads every Wonder Card once and indexes the tickets by
+///   ID, by (GameType, eventId) and by a content hash of the Wonder Card
+///   payload (excluding the CRC header and the variable COUNT field), so
+///   findTicketById / findTicketByWonderCard are O(1) regardless of library size.
+///   Only pack-backed tickets stay lazy: loose tickets are loaded in full
+///   (in parallel) while the index is built, so isDataLoaded() is true for
+///   every readable loose ticket afterwards.
 /// </summary>
 class TicketManager
 {
@@ -43,11 +64,12 @@ public:
     TicketManager();
     ~TicketManager();
 
-    // Initialize from Tickets folder
-    bool loadFromFolder(const QString &ticketsFolderPath, QString &errorMessage);
+    // Initialize from Tickets folder (usePack = false ignores tickets.mgtp, e.g. when rebuilding it)
+    bool loadFromFolder(const QString &ticketsFolderPath, QString &errorMessage, bool usePack = true);
 
     // Check if tickets are loaded
     bool isLoaded() const { return m_loaded; }
+    bool isPackLoaded() const { return !m_pack.isNull(); }
 
     // Get all tickets
     const QVector<TicketResource>& tickets() const { return m_tickets; }
@@ -58,10 +80,14 @@ public:
     // Find ticket by ID
     const TicketResource* findTicketById(const QString &id) const;
 
+    // Find tickets sharing a Wonder Card event ID (e.g. regional/language variants)
+    QVector<const TicketResource*> ticketsForEvent(GameType gameType, uint16_t eventId) const;
+
     // Find ticket by matching wonder card data (for identifying save file contents)
     // Returns the matching ticket or nullptr if no match found
     const TicketResource* findTicketByWonderCard(const QByteArray &wonderCardData,
-                                                  GameType gameType);
+                                                  GameType gameType) const;
+    const TicketResource* findTicketByWonderCard(ByteView wonderCardData, GameType gameType) const;
 
     // Get CRC table
     const QByteArray& crcTable() const { return m_crcTable; }
@@ -77,16 +103,30 @@ public:
 private:
     bool loadCrcTable(QString &errorMessage);
     bool discoverTickets(QString &errorMessage);
+    bool loadPack(const QString &packPath, QString &errorMessage);
+    bool isPackStale(const QString &packPath, QString &reason) const;   // Loose files newer than the pack
     bool loadManifestMetadata();  // Optional: load display names/descriptions from manifest
     GameType parseGameType(const QString &gameTypeStr) const;
     GameType parseGameFromFilename(const QString &gameCode) const;
     QString formatEventName(const QString &eventCode) const;
     QString formatDisplayName(const QString &baseName, GameType gameType, const QString &language) const;
 
+    // Lookup index
+    void buildIndex();
+    static quint64 wonderCardContentKey(GameType gameType, ByteView wonderCardData);
+    static quint32 eventKey(GameType gameType, uint16_t eventId) {
+        return (static_cast<quint32>(gameType) << 16) | eventId;
+    }
+
     QString m_ticketsFolderPath;
     QVector<TicketResource> m_tickets;
     QByteArray m_crcTable;
+    QSharedPointer<const TicketPack> m_pack;    // Set when loaded from tickets.mgtp
     bool m_loaded;
+
+    QHash<QString, int> m_indexById;             // Ticket ID -> m_tickets index
+    QMultiHash<quint32, int> m_indexByEvent;     // eventKey() -> m_tickets indices
+    QMultiHash<quint64, int> m_indexByContent;   // wonderCardContentKey() -> m_tickets indices
 };
 
 #endif // TICKETMANAGER_H
@@ -0,0 +1,289 @@
+/**
+ * @file ticketpack.cpp
+ * @brief Implementation of the binary ticket pack reader and writer.
+ *
+ * Reading maps the pack once and validates every entry's string and payload
+ * ranges up front, so later accessors can hand out views without checks.
+ * Writing lays out header, entry table, string table and payloads in memory
+ * and commits them through QSaveFile. Record fields are quint32_le, so the
+ * same pack reads back on hosts of either byte order.
+ *
+ * @see ticketpack.h for the file layout
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "ticketpack.h"
+#include "logcategories.h"
+#include "ticketresource.h"
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QSaveFile>
+#include <QDebug>
+#include <cstring>
+
+// =============================================================================
+// STATIC CONSTANTS
+// =============================================================================
+
+const QString TicketPack::DEFAULT_FILENAME = "tickets.mgtp";
+
+namespace {
+const char PACK_MAGIC[4] = {'M', 'G', 'T', 'P'};
+}
+
+// =============================================================================
+// CONSTRUCTOR & DESTRUCTOR
+// =============================================================================
+
+TicketPack::TicketPack()
+    : m_mapped(nullptr)
+    , m_size(0)
+    , m_count(0)
+    , m_records(nullptr)
+    , m_strings(nullptr)
+    , m_stringsSize(0)
+{
+}
+
+TicketPack::~TicketPack()
+{
+    close();
+}
+
+// =============================================================================
+// READING
+// =============================================================================
+
+bool TicketPack::open(const QString &path, QString &errorMessage)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        errorMessage = QString("Failed to open ticket pack: %1").arg(m_file.errorString());
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (m_size < static_cast<qint64>(sizeof(FileHeader))) {
+        errorMessage = "Ticket pack is truncated";
+        close();
+        return false;
+    }
+
+    m_mapped = m_file.map(0, m_size);
+    if (!m_mapped) {
+        errorMessage = "Failed to map ticket pack: " + m_file.errorString();
+        close();
+        return false;
+    }
+
+    FileHeader header;
+    std::memcpy(&header, m_mapped, sizeof(header));
+
+    if (std::memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0) {
+        errorMessage = "Ticket pack has an invalid signature";
+        close();
+        return false;
+    }
+
+    if (header.version != FORMAT_VERSION) {
+        errorMessage = QString("Unsupported ticket pack format %1 (expected %2)")
+                          .arg(static_cast<uint32_t>(header.version)).arg(FORMAT_VERSION);
+        close();
+        return false;
+    }
+
+    qint64 tableEnd = sizeof(FileHeader) + static_cast<qint64>(header.ticketCount) * sizeof(EntryRecord);
+    qint64 stringsEnd = static_cast<qint64>(header.stringsOffset) + header.stringsSize;
+    if (tableEnd > m_size || stringsEnd > m_size) {
+        errorMessage = "Ticket pack index is truncated";
+        close();
+        return false;
+    }
+
+    m_records = reinterpret_cast<const EntryRecord*>(m_mapped + sizeof(FileHeader));
+    m_strings = reinterpret_cast<const char*>(m_mapped + header.stringsOffset);
+    m_stringsSize = header.stringsSize;
+
+    // Validate all ranges once so accessors never read outside the mapping
+    for (uint32_t i = 0; i < header.ticketCount; ++i) {
+        const EntryRecord &entry = m_records[i];
+        bool stringsOk = static_cast<qint64>(entry.idOffset) + entry.idLength <= m_stringsSize &&
+                         static_cast<qint64>(entry.nameOffset) + entry.nameLength <= m_stringsSize &&
+                         static_cast<qint64>(entry.descriptionOffset) + entry.descriptionLength <= m_stringsSize;
+        bool payloadOk = static_cast<qint64>(entry.wonderCardOffset) + TicketResource::WONDERCARD_SIZE <= m_size &&
+                         static_cast<qint64>(entry.scriptOffset) + TicketResource::SCRIPT_SIZE <= m_size;
+        bool gameOk = entry.gameType <= static_cast<uint32_t>(GameType::Emerald);
+        if (!stringsOk || !payloadOk || !gameOk || entry.idLength == 0) {
+            errorMessage = QString("Ticket pack entry %1 is corrupt").arg(i);
+            close();
+            return false;
+        }
+    }
+
+    m_count = static_cast<int>(header.ticketCount);
+    qCDebug(lcTickets) << "TicketPack: opened" << path << "with" << m_count << "tickets";
+    return true;
+}
+
+void TicketPack::close()
+{
+    if (m_mapped) {
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_size = 0;
+    m_count = 0;
+    m_records = nullptr;
+    m_strings = nullptr;
+    m_stringsSize = 0;
+}
+
+const TicketPack::EntryRecord *TicketPack::record(int index) const
+{
+    return (index >= 0 && index < m_count) ? &m_records[index] : nullptr;
+}
+
+QString TicketPack::readString(uint32_t offset, uint32_t length) const
+{
+    return QString::fromUtf8(m_strings + offset, static_cast<int>(length));
+}
+
+TicketPack::Entry TicketPack::entry(int index) const
+{
+    Entry result;
+    const EntryRecord *entry = record(index);
+    if (!entry) {
+        return result;
+    }
+
+    result.id = readString(entry->idOffset, entry->idLength);
+    result.name = readString(entry->nameOffset, entry->nameLength);
+    result.description = readString(entry->descriptionOffset, entry->descriptionLength);
+    result.gameType = static_cast<GameType>(static_cast<uint32_t>(entry->gameType));
+    return result;
+}
+
+ByteView TicketPack::wonderCard(int index) const
+{
+    const EntryRecord *entry = record(index);
+    return entry ? ByteView(m_mapped + entry->wonderCardOffset, TicketResource::WONDERCARD_SIZE)
+                 : ByteView();
+}
+
+ByteView TicketPack::script(int index) const
+{
+    const EntryRecord *entry = record(index);
+    return entry ? ByteView(m_mapped + entry->scriptOffset, TicketResource::SCRIPT_SIZE)
+                 : ByteView();
+}
+
+// =============================================================================
+// WRITING
+// =============================================================================
+
+bool TicketPack::Builder::addTicket(const QString &id, const QString &name, const QString &description,
+                                    GameType gameType, const QByteArray &wonderCardData,
+                                    const QByteArray &scriptData, QString &errorMessage)
+{
+    if (id.isEmpty()) {
+        errorMessage = "Ticket ID must not be empty";
+        return false;
+    }
+
+    if (wonderCardData.size() != TicketResource::WONDERCARD_SIZE ||
+        scriptData.size() != TicketResource::SCRIPT_SIZE) {
+        errorMessage = QString("Invalid data sizes for %1: Wonder Card %2 bytes, script %3 bytes")
+                          .arg(id).arg(wonderCardData.size()).arg(scriptData.size());
+        return false;
+    }
+
+    Item item;
+    item.entry.id = id;
+    item.entry.name = name;
+    item.entry.description = description;
+    item.entry.gameType = gameType;
+    item.wonderCardData = wonderCardData;
+    item.scriptData = scriptData;
+    m_tickets.append(item);
+    return true;
+}
+
+bool TicketPack::Builder::write(const QString &path, QString &errorMessage) const
+{
+    // String table
+    QByteArray strings;
+    QVector<EntryRecord> records(m_tickets.size());
+    auto appendString = [&strings](const QString &value, quint32_le &offset, quint32_le &length) {
+        QByteArray utf8 = value.toUtf8();
+        offset = static_cast<uint32_t>(strings.size());
+        length = static_cast<uint32_t>(utf8.size());
+        strings.append(utf8);
+    };
+
+    for (int i = 0; i < m_tickets.size(); ++i) {
+        const Entry &entry = m_tickets.at(i).entry;
+        EntryRecord &record = records[i];
+        std::memset(&record, 0, sizeof(record));
+        record.gameType = static_cast<uint32_t>(entry.gameType);
+        appendString(entry.id, record.idOffset, record.idLength);
+        appendString(entry.name, record.nameOffset, record.nameLength);
+        appendString(entry.description, record.descriptionOffset, record.descriptionLength);
+    }
+
+    // Lay out header + entry table, strings, then 4-byte aligned payloads
+    uint32_t stringsOffset = sizeof(FileHeader) + m_tickets.size() * sizeof(EntryRecord);
+    uint32_t offset = (stringsOffset + strings.size() + 3) & ~3u;
+    for (EntryRecord &record : records) {
+        record.wonderCardOffset = offset;
+        offset += TicketResource::WONDERCARD_SIZE;
+        record.scriptOffset = offset;
+        offset += TicketResource::SCRIPT_SIZE;
+    }
+
+    QByteArray buffer(static_cast<int>(offset), '\0');
+    char *out = buffer.data();
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.ticketCount = static_cast<uint32_t>(records.size());
+    header.stringsOffset = stringsOffset;
+    header.stringsSize = static_cast<uint32_t>(strings.size());
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), records.constData(), records.size() * sizeof(EntryRecord));
+    std::memcpy(out + stringsOffset, strings.constData(), strings.size());
+
+    for (int i = 0; i < m_tickets.size(); ++i) {
+        const Item &item = m_tickets.at(i);
+        std::memcpy(out + records[i].wonderCardOffset, item.wonderCardData.constData(), item.wonderCardData.size());
+        std::memcpy(out + records[i].scriptOffset, item.scriptData.constData(), item.scriptData.size());
+    }
+
+    // QSaveFile writes a temp file, syncs it and renames it over the target
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        errorMessage = "Failed to create ticket pack: " + file.errorString();
+        return false;
+    }
+
+    if (file.write(buffer) != buffer.size() || !file.commit()) {
+        errorMessage = "Failed to write ticket pack: " + file.errorString();
+        return false;
+    }
+
+    qCDebug(lcTickets) << "TicketPack: wrote" << path << "(" << m_tickets.size() << "tickets," << buffer.size() << "bytes)";
+    return true;
+}
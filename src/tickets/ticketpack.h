@@ -0,0 +1,166 @@
+/**
+ * @file ticketpack.h
+ * @brief Single-file binary archive of Mystery Gift tickets.
+ *
+ * A loose Tickets/ folder costs two file opens per ticket (plus a directory
+ * listing and size checks), which dominates startup for large libraries and
+ * is especially slow on Windows with on-access AV scanning. A ticket pack
+ * stores the same data in one file that is memory-mapped once; Wonder Card
+ * and script payloads are handed out as views over the mapping and are only
+ * copied when a ticket's data is actually loaded.
+ *
+ * ## File Layout (little-endian 32-bit fields on every host, no padding)
+ * - Header: magic "MGTP", format version, ticket count, string table
+ *   offset/size
+ * - Entry table: one fixed-size record per ticket (game type, id/name/
+ *   description string ranges, Wonder Card and script offsets)
+ * - String table: UTF-8 ticket IDs, display names and descriptions
+ * - Payload: 336-byte Wonder Cards and 1004-byte scripts, with CRC headers,
+ *   exactly as stored in the loose .bin files
+ *
+ * Display names and descriptions from tickets.json are folded into the
+ * string table when the pack is built, so loading a pack needs no manifest.
+ *
+ * @see TicketManager for pack discovery (Tickets/tickets.mgtp)
+ * @see mgi_pack (main_pack.cpp) for building a pack from a Tickets/ folder
+ *
+ * @author ComradeSean
+ * @version 1.0
+ */
+
+#ifndef TICKETPACK_H
+#define TICKETPACK_H
+
+// =============================================================================
+// Qt Framework Includes
+// =============================================================================
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QVector>
+#include <QtEndian>
+#include <cstddef>
+#include <cstdint>
+
+// =============================================================================
+// Project Includes
+// =============================================================================
+#include "savefile.h"
+
+/**
+ * @class TicketPack
+ * @brief Memory-mapped reader and writer for ticket pack files.
+ *
+ * USAGE (read):
+ *   TicketPack pack;
+ *   if (pack.open(path, error)) {
+ *       TicketPack::Entry entry = pack.entry(0);
+ *       ByteView wonderCard = pack.wonderCard(0);
+ *   }
+ *
+ * USAGE (write):
+ *   TicketPack::Builder builder;
+ *   builder.addTicket(id, name, description, gameType, wonderCardData, scriptData);
+ *   builder.write(path, error);
+ *
+ * Views returned by wonderCard() / script() reference the mapping and stay
+ * valid only while the pack is open.
+ */
+class TicketPack
+{
+public:
+    /// Ticket metadata decoded from the entry table and string table.
+    struct Entry {
+        QString id;
+        QString name;
+        QString description;
+        GameType gameType = GameType::Unknown;
+    };
+
+    TicketPack();
+    ~TicketPack();
+
+    TicketPack(const TicketPack&) = delete;
+    TicketPack& operator=(const TicketPack&) = delete;
+
+    // Open and validate a pack file
+    bool open(const QString &path, QString &errorMessage);
+    void close();
+    bool isOpen() const { return m_mapped != nullptr; }
+    QString path() const { return m_file.fileName(); }
+
+    // Ticket access
+    int count() const { return m_count; }
+    Entry entry(int index) const;
+    ByteView wonderCard(int index) const;   // Full 336-byte file image (zero-copy)
+    ByteView script(int index) const;       // Full 1004-byte file image (zero-copy)
+
+    /**
+     * @class Builder
+     * @brief Collects tickets in memory and writes a pack file atomically.
+     */
+    class Builder
+    {
+    public:
+        bool addTicket(const QString &id, const QString &name, const QString &description,
+                       GameType gameType, const QByteArray &wonderCardData,
+                       const QByteArray &scriptData, QString &errorMessage);
+        int count() const { return m_tickets.size(); }
+
+        bool write(const QString &path, QString &errorMessage) const;
+
+    private:
+        struct Item {
+            Entry entry;
+            QByteArray wonderCardData;
+            QByteArray scriptData;
+        };
+        QVector<Item> m_tickets;
+    };
+
+    // Constants
+    static const uint32_t FORMAT_VERSION = 1;
+    static const QString DEFAULT_FILENAME;   // "tickets.mgtp" inside the Tickets folder
+
+private:
+    // On-disk records
+    struct FileHeader {
+        char magic[4];              // "MGTP"
+        quint32_le version;         // FORMAT_VERSION
+        quint32_le ticketCount;
+        quint32_le stringsOffset;   // From start of file
+        quint32_le stringsSize;
+        quint32_le reserved;
+    };
+
+    struct EntryRecord {
+        quint32_le gameType;        // GameType
+        quint32_le idOffset;        // Offsets relative to the string table
+        quint32_le idLength;
+        quint32_le nameOffset;
+        quint32_le nameLength;
+        quint32_le descriptionOffset;
+        quint32_le descriptionLength;
+        quint32_le wonderCardOffset; // From start of file
+        quint32_le scriptOffset;    // From start of file
+    };
+
+    // Records are mapped in place, so the layout is pinned here
+    static_assert(sizeof(FileHeader) == 24 && offsetof(FileHeader, stringsSize) == 16,
+                  "TicketPack::FileHeader layout changed");
+    static_assert(sizeof(EntryRecord) == 36 && offsetof(EntryRecord, scriptOffset) == 32,
+                  "TicketPack::EntryRecord layout changed");
+
+    const EntryRecord *record(int index) const;
+    QString readString(uint32_t offset, uint32_t length) const;
+
+    QFile m_file;
+    uchar *m_mapped;
+    qint64 m_size;
+    int m_count;
+    const EntryRecord *m_records;
+    const char *m_strings;
+    uint32_t m_stringsSize;
+};
+
+#endif // TICKETPACK_H
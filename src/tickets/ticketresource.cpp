@@ -1,4 +1,5 @@
 #include "ticketresource.h"
+#include "ticketpack.h"
 #include <QFile>
 #include <QFileInfo>
 #include <QDir>
@@ -6,6 +7,7 @@
 TicketResource::TicketResource()
     : m_gameType(GameType::Unknown)
     , m_dataLoaded(false)
+    , m_packIndex(-1)
 {
 }
 
@@ -19,9 +21,32 @@ TicketResource::TicketResource(const QString &id, const QString &name, GameType
     , m_scriptFile(scriptFile)
     , m_description(description)
     , m_dataLoaded(false)
+    , m_packIndex(-1)
 {
 }
 
+void TicketResource::setPackSource(const QSharedPointer<const TicketPack> &pack, int index)
+{
+    m_pack = pack;
+    m_packIndex = index;
+}
+
+ByteView TicketResource::wonderCardBytes() const
+{
+    if (m_dataLoaded || !m_pack) {
+        return ByteView(m_wonderCardData);
+    }
+    return m_pack->wonderCard(m_packIndex);
+}
+
+ByteView TicketResource::scriptBytes() const
+{
+    if (m_dataLoaded || !m_pack) {
+        return ByteView(m_scriptData);
+    }
+    return m_pack->script(m_packIndex);
+}
+
 QString TicketResource::gameTypeString() const
 {
     switch (m_gameType) {
@@ -40,6 +65,20 @@ bool TicketResource::loadData(const QString &ticketsFolder, QString &errorMessag
     m_scriptData.clear();
     m_dataLoaded = false;
 
+    // Pack-backed: sizes were validated when the pack was opened
+    if (m_pack) {
+        ByteView wonderCard = m_pack->wonderCard(m_packIndex);
+        ByteView script = m_pack->script(m_packIndex);
+        if (wonderCard.isEmpty() || script.isEmpty()) {
+            errorMessage = QString("Ticket %1 not found in pack %2").arg(m_id, m_pack->path());
+            return false;
+        }
+        m_wonderCardData = wonderCard.toByteArray();
+        m_scriptData = script.toByteArray();
+        m_dataLoaded = true;
+        return true;
+    }
+
     // Load Wonder Card file
     QString wonderCardPath = QDir(ticketsFolder).filePath(m_wonderCardFile);
     QFile wonderCardFile(wonderCardPath);
@@ -3,11 +3,17 @@
 
 #include <QString>
 #include <QByteArray>
+#include <QSharedPointer>
 #include "savefile.h"
 
+class TicketPack;
+
 /// <summary>
 /// Represents a single Mystery Gift ticket with its associated data files.
 /// Each ticket contains Wonder Card data, GMScript dialog data, and metadata.
+/// Data comes either from a pair of loose .bin files or from a shared,
+/// memory-mapped TicketPack entry; pack-backed tickets expose their bytes as
+/// views into the pack until loadData() materializes a private copy.
 /// </summary>
 class TicketResource
 {
@@ -26,12 +32,22 @@ public:
     QString scriptFile() const { return m_scriptFile; }
     QString description() const { return m_description; }
 
+    // Manifest overrides
+    void setName(const QString &name) { m_name = name; }
+    void setDescription(const QString &description) { m_description = description; }
+
+    // Pack-backed source (keeps the pack mapped while any copy of this ticket lives)
+    void setPackSource(const QSharedPointer<const TicketPack> &pack, int index);
+    bool isPacked() const { return !m_pack.isNull(); }
+
     // Data accessors (loaded on demand)
     const QByteArray& wonderCardData() const { return m_wonderCardData; }
     const QByteArray& scriptData() const { return m_scriptData; }
+    ByteView wonderCardBytes() const;   // Loaded data, or the pack entry if not loaded yet
+    ByteView scriptBytes() const;
     bool isDataLoaded() const { return m_dataLoaded; }
 
-    // Load binary data from files
+    // Load binary data from files (or copy it out of the pack; ticketsFolder is then unused)
     bool loadData(const QString &ticketsFolder, QString &errorMessage);
 
     // Constants - Wonder Card format (336 bytes total = 0x150)
@@ -56,6 +72,10 @@ private:
     QByteArray m_wonderCardData;
     QByteArray m_scriptData;
     bool m_dataLoaded;
+
+    // Pack source (null for loose files)
+    QSharedPointer<const TicketPack> m_pack;
+    int m_packIndex;
 };
 
 #endif // TICKETRESOURCE_H
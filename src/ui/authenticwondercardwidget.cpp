@@ -1,16 +1,27 @@
 #include "authenticwondercardwidget.h"
+#include "logcategories.h"
+#include "tracing.h"
 #include "fallbackgraphics.h"
+#include "spritecache.h"
+#include "cardrasterizer.h"
 #include <QPainter>
 #include <QMouseEvent>
 #include <QKeyEvent>
+#include <QPaintEvent>
 #include <QDebug>
 
 AuthenticWonderCardWidget::AuthenticWonderCardWidget(QWidget *parent)
     : QWidget(parent)
     , m_romReader(nullptr)
     , m_fontRenderer(nullptr)
+    , m_assetCache(nullptr)
     , m_romLoaded(false)
     , m_fallbackMode(false)
+    , m_romFonts(false)
+    , m_cancelLoad(0)
+    , m_loadGeneration(0)
+    , m_loadInProgress(false)
+    , m_loadApplied(false)
     , m_bgIndex(0)
     , m_iconSpecies(0)
     , m_hasData(false)
@@ -32,12 +43,18 @@ AuthenticWonderCardWidget::AuthenticWonderCardWidget(QWidget *parent)
     // Create ROM reader and font renderer
     m_romReader = new GBAROReader();
     m_fontRenderer = new Gen3FontRenderer();
+    m_assetCache = new RomAssetCache();
 }
 
 AuthenticWonderCardWidget::~AuthenticWonderCardWidget()
 {
+    // Workers only touch their own AsyncLoad, but must finish before we go away
+    m_cancelLoad.storeRelaxed(1);
+    m_loadPool.waitForDone();
+
     delete m_fontRenderer;
     delete m_romReader;
+    delete m_assetCache;
 }
 
 void AuthenticWonderCardWidget::initTextFields()
@@ -63,11 +80,54 @@ void AuthenticWonderCardWidget::initTextFields()
 
 bool AuthenticWonderCardWidget::loadROM(const QString &romPath, QString &errorMessage)
 {
+    cancelROMLoad();
+
+    // Drop assets that may still point into a previous cache mapping
+    m_romLoaded = false;
+    m_backgrounds.clear();
+    m_fontHeader = QImage();
+    m_fontBody = QImage();
+    m_fontIdHeader = QImage();
+    m_fontIdBody = QImage();
+    m_assetCache->close();
+
     // Load ROM
     if (!m_romReader->loadROM(romPath, errorMessage)) {
         return false;
     }
 
+    // Prefer the persistent asset cache; decode from ROM only on a miss
+    QByteArray fingerprint = RomAssetCache::databaseFingerprint();
+    QString cacheError;
+    if (m_assetCache->open(m_romReader->md5(), fingerprint, cacheError) &&
+        loadAssetsFromCache(cacheError)) {
+        qCDebug(lcUi) << "ROM assets loaded from cache";
+    } else {
+        qCDebug(lcUi) << "Asset cache miss:" << cacheError;
+        m_assetCache->close();
+
+        if (!decodeAssetsFromROM(errorMessage)) {
+            return false;
+        }
+        writeAssetCache(fingerprint);
+    }
+
+    m_romLoaded = true;
+    m_fallbackMode = false;
+    m_romFonts = true;
+    qCDebug(lcUi) << "ROM loaded successfully, fonts and backgrounds ready";
+
+    // Re-render if we have data
+    if (m_hasData) {
+        renderCard();
+        update();
+    }
+
+    return true;
+}
+
+bool AuthenticWonderCardWidget::decodeAssetsFromROM(QString &errorMessage)
+{
     // Load font from ROM
     if (!m_fontRenderer->loadFromROM(m_romReader, errorMessage)) {
         return false;
@@ -86,41 +146,97 @@ bool AuthenticWonderCardWidget::loadROM(const QString &romPath, QString &errorMe
     if (m_fontRenderer->isEmerald()) {
         m_fontIdHeader = m_fontRenderer->createColoredIdFont(Gen3FontRenderer::TitleHeader);
         m_fontIdBody = m_fontRenderer->createColoredIdFont(Gen3FontRenderer::BodyFooter);
-        qDebug() << "Emerald ID fonts created";
+        qCDebug(lcUi) << "Emerald ID fonts created";
     }
 
-    // Pre-load all 8 Wonder Card backgrounds
-    m_backgrounds.clear();
+    // Pre-load all 8 Wonder Card backgrounds (LZ77 decoding runs in parallel)
+    QVector<GBAROReader::WonderCardGraphicsData> graphics = m_romReader->decompressWonderCardGraphics();
     m_backgrounds.resize(8);
     for (int i = 0; i < 8; ++i) {
-        m_backgrounds[i] = m_romReader->extractWonderCardBackground(i);
+        if (i < graphics.size() && graphics[i].error.isEmpty()) {
+            m_backgrounds[i] = m_romReader->renderWonderCard(graphics[i].entry, graphics[i].tileset, graphics[i].tilemap);
+        } else {
+            m_backgrounds[i] = QImage();
+        }
         if (m_backgrounds[i].isNull()) {
-            qWarning() << "Failed to load Wonder Card background" << i;
+            qWarning() << "Failed to load Wonder Card background" << i
+                       << (i < graphics.size() ? graphics[i].error : QString());
         }
     }
 
-    m_romLoaded = true;
-    qDebug() << "ROM loaded successfully, fonts and backgrounds ready";
+    return true;
+}
 
-    // Re-render if we have data
-    if (m_hasData) {
-        renderCard();
-        update();
+bool AuthenticWonderCardWidget::loadAssetsFromCache(QString &errorMessage)
+{
+    if (!m_fontRenderer->loadFromCache(m_romReader, *m_assetCache, errorMessage)) {
+        return false;
+    }
+
+    // Colored fonts and backgrounds are used as-is, straight from the mapping
+    m_fontHeader = m_assetCache->image(RomAssetCache::ColoredFont, RomAssetCache::MainHeader);
+    m_fontBody = m_assetCache->image(RomAssetCache::ColoredFont, RomAssetCache::MainBody);
+    if (m_fontHeader.isNull() || m_fontBody.isNull()) {
+        errorMessage = "Asset cache has no colored fonts";
+        return false;
+    }
+
+    if (m_fontRenderer->isEmerald()) {
+        m_fontIdHeader = m_assetCache->image(RomAssetCache::ColoredFont, RomAssetCache::IdHeader);
+        m_fontIdBody = m_assetCache->image(RomAssetCache::ColoredFont, RomAssetCache::IdBody);
+    }
+
+    m_backgrounds.resize(8);
+    for (int i = 0; i < 8; ++i) {
+        m_backgrounds[i] = m_assetCache->image(RomAssetCache::Background, i);
+        if (m_backgrounds[i].isNull()) {
+            qWarning() << "Asset cache has no Wonder Card background" << i;
+        }
     }
 
     return true;
 }
 
+void AuthenticWonderCardWidget::writeAssetCache(const QByteArray &fingerprint)
+{
+    if (m_romReader->md5().isEmpty() || fingerprint.isEmpty()) {
+        return;
+    }
+
+    RomAssetCache::Builder builder;
+    m_fontRenderer->storeInCache(builder);
+
+    builder.addImage(RomAssetCache::ColoredFont, RomAssetCache::MainHeader, m_fontHeader);
+    builder.addImage(RomAssetCache::ColoredFont, RomAssetCache::MainBody, m_fontBody);
+    builder.addImage(RomAssetCache::ColoredFont, RomAssetCache::IdHeader, m_fontIdHeader);
+    builder.addImage(RomAssetCache::ColoredFont, RomAssetCache::IdBody, m_fontIdBody);
+
+    for (int i = 0; i < m_backgrounds.size(); ++i) {
+        builder.addImage(RomAssetCache::Background, i, m_backgrounds[i]);
+    }
+
+    // Icon set: every species index the card can display
+    for (int species = 0; species <= ICON_SPECIES_LIMIT; ++species) {
+        builder.addImage(RomAssetCache::PokemonIcon, species, SpriteCache::instance().icon(m_romReader, species));
+    }
+
+    QString errorMessage;
+    if (!builder.write(RomAssetCache::cacheFilePath(m_romReader->md5()), m_romReader->md5(),
+                       fingerprint, errorMessage)) {
+        qWarning() << "Failed to write ROM asset cache:" << errorMessage;
+    }
+}
+
 bool AuthenticWonderCardWidget::loadFallbackGraphics(QString &errorMessage)
 {
-    qDebug() << "Loading fallback graphics...";
+    qCDebug(lcUi) << "Loading fallback graphics...";
 
     m_fallbackMode = true;
 
-    // Generate placeholder font
-    QImage placeholderFont = FallbackGraphics::generatePlaceholderFont();
+    // Placeholder font (embedded at build time)
+    QImage placeholderFont = FallbackGraphics::placeholderFont();
     if (placeholderFont.isNull()) {
-        errorMessage = "Failed to generate fallback font";
+        errorMessage = "Failed to load fallback font";
         return false;
     }
 
@@ -128,15 +244,15 @@ bool AuthenticWonderCardWidget::loadFallbackGraphics(QString &errorMessage)
     m_fontHeader = placeholderFont;
     m_fontBody = placeholderFont;
 
-    // Generate placeholder backgrounds for all 8 slots
+    // Placeholder backgrounds for all 8 slots
     m_backgrounds.clear();
     m_backgrounds.resize(8);
     for (int i = 0; i < 8; ++i) {
-        m_backgrounds[i] = FallbackGraphics::generatePlaceholderBackground(i);
+        m_backgrounds[i] = FallbackGraphics::placeholderBackground(i);
     }
 
-    // Generate placeholder icon
-    m_iconImage = FallbackGraphics::generatePlaceholderPokemonIcon();
+    // Placeholder icon
+    m_iconImage = FallbackGraphics::placeholderPokemonIcon();
 
     // Load fallback glyph widths into font renderer if available
     if (m_fontRenderer) {
@@ -145,7 +261,8 @@ bool AuthenticWonderCardWidget::loadFallbackGraphics(QString &errorMessage)
     }
 
     m_romLoaded = false;  // ROM not loaded, but fallback is active
-    qDebug() << "Fallback graphics loaded successfully";
+    m_romFonts = false;
+    qCDebug(lcUi) << "Fallback graphics loaded successfully";
 
     // Re-render if we have data
     if (m_hasData) {
@@ -156,6 +273,286 @@ bool AuthenticWonderCardWidget::loadFallbackGraphics(QString &errorMessage)
     return true;
 }
 
+// =============================================================================
+// ASYNCHRONOUS ROM LOADING
+// =============================================================================
+
+/// State of one asynchronous load. Created on the GUI thread, filled in by
+/// workers (each stage writes only its own members) and handed back to the
+/// GUI thread through queued calls, which take ownership of what they need.
+struct AuthenticWonderCardWidget::AsyncLoad {
+    int generation = 0;
+    QString romPath;
+    RomDatabase *database = nullptr;
+
+    QScopedPointer<GBAROReader> reader;
+    QScopedPointer<Gen3FontRenderer> fontRenderer;
+    QScopedPointer<RomAssetCache> assetCache;
+    QByteArray fingerprint;
+    bool cacheHit = false;
+
+    QImage fontHeader;
+    QImage fontBody;
+    QImage fontIdHeader;
+    QImage fontIdBody;
+    QVector<QImage> backgrounds;
+
+    QString errorMessage;   // Set by the ROM mapping or font stage on failure
+};
+
+void AuthenticWonderCardWidget::loadROMAsync(const QString &romPath, RomDatabase *database)
+{
+    cancelROMLoad();
+
+    // Keep the card usable while the ROM loads
+    if (!m_romLoaded && !m_fallbackMode) {
+        QString error;
+        loadFallbackGraphics(error);
+    }
+
+    QSharedPointer<AsyncLoad> load(new AsyncLoad);
+    load->generation = ++m_loadGeneration;
+    load->romPath = romPath;
+    load->database = database;
+    load->reader.reset(new GBAROReader());
+    load->fontRenderer.reset(new Gen3FontRenderer());
+    load->assetCache.reset(new RomAssetCache());
+
+    m_cancelLoad.storeRelaxed(0);
+    m_loadInProgress = true;
+    m_loadApplied = false;
+    m_loadPool.start([this, load]() { runAsyncLoad(load); });
+}
+
+void AuthenticWonderCardWidget::cancelROMLoad()
+{
+    if (!m_loadInProgress) {
+        return;
+    }
+
+    m_cancelLoad.storeRelaxed(1);
+    m_loadPool.waitForDone();
+    ++m_loadGeneration;   // Drop results that are still queued
+    m_loadInProgress = false;
+
+    // Don't leave half of a first load on screen
+    if (m_loadApplied && !m_romLoaded) {
+        QString error;
+        loadFallbackGraphics(error);
+    }
+    m_loadApplied = false;
+}
+
+bool AuthenticWonderCardWidget::isCurrentLoad(const QSharedPointer<AsyncLoad> &load) const
+{
+    return load->generation == m_loadGeneration && !m_cancelLoad.loadRelaxed();
+}
+
+void AuthenticWonderCardWidget::postLoadStage(QSharedPointer<AsyncLoad> load,
+                                              void (AuthenticWonderCardWidget::*stage)(QSharedPointer<AsyncLoad>))
+{
+    QMetaObject::invokeMethod(this, [this, load, stage]() { (this->*stage)(load); }, Qt::QueuedConnection);
+}
+
+void AuthenticWonderCardWidget::runAsyncLoad(QSharedPointer<AsyncLoad> load)
+{
+    GBAROReader *reader = load->reader.data();
+    auto progress = [this, load](const QString &stage) {
+        QMetaObject::invokeMethod(this, [this, load, stage]() {
+            if (isCurrentLoad(load)) {
+                emit romLoadProgress(stage);
+            }
+        }, Qt::QueuedConnection);
+    };
+
+    // Stage 1: map + identify
+    bool mapped = load->database ? reader->loadROM(load->romPath, load->database, load->errorMessage)
+                                 : reader->loadROM(load->romPath, load->errorMessage);
+    if (!mapped || m_cancelLoad.loadRelaxed()) {
+        postLoadStage(load, &AuthenticWonderCardWidget::finishAsyncLoad);
+        return;
+    }
+    progress(reader->versionName());
+
+    // A valid asset cache replaces the decode stages (it is only a mapping)
+    load->fingerprint = RomAssetCache::databaseFingerprint();
+    QString cacheError;
+    load->cacheHit = load->assetCache->open(reader->md5(), load->fingerprint, cacheError);
+
+    if (!load->cacheHit) {
+        qCDebug(lcUi) << "Asset cache miss:" << cacheError;
+        load->assetCache->close();
+
+        // Stage 2: fonts, backgrounds and icons in parallel (read-only ROM access)
+        QThreadPool stagePool;
+
+        stagePool.start([this, load, reader]() {
+            Gen3FontRenderer *renderer = load->fontRenderer.data();
+            QString error;
+            if (!renderer->loadFromROM(reader, error)) {
+                load->errorMessage = error;
+                return;
+            }
+            load->fontHeader = renderer->createColoredFont(Gen3FontRenderer::TitleHeader);
+            load->fontBody = renderer->createColoredFont(Gen3FontRenderer::BodyFooter);
+            if (load->fontHeader.isNull() || load->fontBody.isNull()) {
+                load->errorMessage = "Failed to create colored fonts";
+                return;
+            }
+            if (renderer->isEmerald()) {
+                load->fontIdHeader = renderer->createColoredIdFont(Gen3FontRenderer::TitleHeader);
+                load->fontIdBody = renderer->createColoredIdFont(Gen3FontRenderer::BodyFooter);
+            }
+            postLoadStage(load, &AuthenticWonderCardWidget::applyLoadedFonts);
+        });
+
+        stagePool.start([this, load, reader]() {
+            QVector<GBAROReader::WonderCardGraphicsData> graphics = reader->decompressWonderCardGraphics();
+            load->backgrounds.resize(8);
+            for (int i = 0; i < 8; ++i) {
+                if (i < graphics.size() && graphics[i].error.isEmpty()) {
+                    load->backgrounds[i] = reader->renderWonderCard(graphics[i].entry, graphics[i].tileset,
+                                                                    graphics[i].tilemap);
+                }
+                if (load->backgrounds[i].isNull()) {
+                    qWarning() << "Failed to load Wonder Card background" << i
+                               << (i < graphics.size() ? graphics[i].error : QString());
+                }
+            }
+            postLoadStage(load, &AuthenticWonderCardWidget::applyLoadedBackgrounds);
+        });
+
+        stagePool.start([this, reader, progress]() {
+            for (int species = 0; species <= ICON_SPECIES_LIMIT; ++species) {
+                if (m_cancelLoad.loadRelaxed()) {
+                    return;
+                }
+                SpriteCache::instance().icon(reader, static_cast<uint16_t>(species));
+            }
+            progress("icons");
+        });
+
+        stagePool.waitForDone();
+    }
+
+    // Name tables were decoded by loadROM() in stage 1
+    postLoadStage(load, &AuthenticWonderCardWidget::finishAsyncLoad);
+}
+
+void AuthenticWonderCardWidget::applyLoadedFonts(QSharedPointer<AsyncLoad> load)
+{
+    // When replacing a loaded ROM, hold everything for the final swap
+    if (!isCurrentLoad(load) || m_romLoaded || !load->fontRenderer) {
+        return;
+    }
+
+    // The renderer is self-contained once loaded (it never reads the ROM again)
+    delete m_fontRenderer;
+    m_fontRenderer = load->fontRenderer.take();
+    m_fontHeader = load->fontHeader;
+    m_fontBody = load->fontBody;
+    m_fontIdHeader = load->fontIdHeader;
+    m_fontIdBody = load->fontIdBody;
+    m_romFonts = true;
+    m_loadApplied = true;
+
+    if (m_hasData) {
+        renderCard();
+        update();
+    }
+    emit romLoadProgress("fonts");
+}
+
+void AuthenticWonderCardWidget::applyLoadedBackgrounds(QSharedPointer<AsyncLoad> load)
+{
+    if (!isCurrentLoad(load) || m_romLoaded) {
+        return;
+    }
+
+    m_backgrounds = load->backgrounds;
+    m_loadApplied = true;
+
+    if (m_hasData) {
+        renderCard();
+        update();
+    }
+    emit romLoadProgress("backgrounds");
+}
+
+void AuthenticWonderCardWidget::finishAsyncLoad(QSharedPointer<AsyncLoad> load)
+{
+    if (!isCurrentLoad(load)) {
+        return;
+    }
+    m_loadInProgress = false;
+
+    if (!load->errorMessage.isEmpty() || !load->reader->isLoaded()) {
+        QString error = load->errorMessage.isEmpty() ? QString("ROM load cancelled") : load->errorMessage;
+        if (m_loadApplied && !m_romLoaded) {
+            QString fallbackError;
+            loadFallbackGraphics(fallbackError);
+        }
+        m_loadApplied = false;
+        emit romLoadFinished(false, error);
+        return;
+    }
+
+    // Swap in the new ROM. Callers that kept the old reader pointer must
+    // query getRomReader() again after romLoadFinished().
+    m_romLoaded = false;
+    delete m_romReader;
+    m_romReader = load->reader.take();
+    delete m_assetCache;
+    m_assetCache = load->assetCache.take();
+
+    QString errorMessage;
+    bool assetsReady = true;
+    if (load->cacheHit) {
+        if (loadAssetsFromCache(errorMessage)) {
+            qCDebug(lcUi) << "ROM assets loaded from cache";
+        } else {
+            // Rare: header matched but contents are unusable; decode here
+            qCDebug(lcUi) << "Asset cache unusable:" << errorMessage;
+            m_assetCache->close();
+            assetsReady = decodeAssetsFromROM(errorMessage);
+            if (assetsReady) {
+                writeAssetCache(load->fingerprint);
+            }
+        }
+    } else {
+        if (load->fontRenderer) {
+            delete m_fontRenderer;
+            m_fontRenderer = load->fontRenderer.take();
+        }
+        m_fontHeader = load->fontHeader;
+        m_fontBody = load->fontBody;
+        m_fontIdHeader = load->fontIdHeader;
+        m_fontIdBody = load->fontIdBody;
+        m_backgrounds = load->backgrounds;
+        writeAssetCache(load->fingerprint);
+    }
+    m_loadApplied = false;
+
+    if (!assetsReady) {
+        QString fallbackError;
+        loadFallbackGraphics(fallbackError);
+        emit romLoadFinished(false, errorMessage);
+        return;
+    }
+
+    m_romLoaded = true;
+    m_fallbackMode = false;
+    m_romFonts = true;
+    qCDebug(lcUi) << "ROM loaded asynchronously:" << m_romReader->versionName();
+
+    loadPokemonIcon(m_iconSpecies);
+    if (m_hasData) {
+        renderCard();
+        update();
+    }
+    emit romLoadFinished(true, QString());
+}
+
 QSize AuthenticWonderCardWidget::sizeHint() const
 {
     return QSize(CARD_WIDTH * DISPLAY_SCALE, CARD_HEIGHT * DISPLAY_SCALE);
@@ -223,6 +620,8 @@ void AuthenticWonderCardWidget::clear()
     }
 
     m_renderedCard = QImage();
+    m_scaledCard = QPixmap();
+    m_cursorRect = QRect();
     update();
 }
 
@@ -235,8 +634,7 @@ void AuthenticWonderCardWidget::setFieldText(const QString &fieldName, const QSt
 {
     if (m_fieldTexts.contains(fieldName)) {
         m_fieldTexts[fieldName] = text;
-        renderCard();
-        update();
+        updateFieldLayer(fieldIndex(fieldName));
         emit wonderCardChanged(buildWonderCardData());
     }
 }
@@ -245,7 +643,13 @@ void AuthenticWonderCardWidget::setBackgroundIndex(int index)
 {
     if (index >= 0 && index < 8) {
         m_bgIndex = index;
-        renderCard();
+        if (m_renderedCard.isNull()) {
+            renderCard();
+        } else {
+            // Text and icon layers are unchanged; only the base is swapped
+            renderBackgroundLayer();
+            compositeRect(m_renderedCard.rect());
+        }
         update();
     }
 }
@@ -254,8 +658,7 @@ void AuthenticWonderCardWidget::setIconSpecies(int species)
 {
     m_iconSpecies = species;
     loadPokemonIcon(species);
-    renderCard();
-    update();
+    updateIconLayer();
 }
 
 void AuthenticWonderCardWidget::loadPokemonIcon(int species)
@@ -264,7 +667,7 @@ void AuthenticWonderCardWidget::loadPokemonIcon(int species)
 
     // In fallback mode, use the placeholder icon with the species index
     if (m_fallbackMode) {
-        m_iconImage = FallbackGraphics::generatePlaceholderPokemonIcon(species);
+        m_iconImage = FallbackGraphics::placeholderPokemonIcon(species);
         return;
     }
 
@@ -272,168 +675,259 @@ void AuthenticWonderCardWidget::loadPokemonIcon(int species)
         return;
     }
 
-    // Only skip icon for raw 0x0000 - NOT for clamped values
-    // The save file may contain 0xFFFF which gets clamped to 0,
-    // but should still display icon index 0 (unlike raw 0x0000)
-    if (species == 0) {
+    // Raw 0x0000 has no icon; invalid species map to the game's fallback icon
+    int displaySpecies = CardRasterizer::iconDisplaySpecies(species, m_fontRenderer->isEmerald());
+    if (displaySpecies < 0) {
         return;
     }
 
-    // Transform invalid species (from decomp)
-    // FRLG: species > 412 → 0 (Bulbasaur icon)
-    // Emerald: species > 412 → 260 (Question Mark icon)
-    const int SPECIES_LIMIT = 412;
-    const int EMERALD_INVALID_ICON = 260;  // SPECIES_OLD_UNOWN_J in Emerald
-    const int FRLG_INVALID_ICON = 0;        // SPECIES_NONE in FRLG
-
-    int displaySpecies;
-    if (species > SPECIES_LIMIT) {
-        displaySpecies = m_fontRenderer->isEmerald() ? EMERALD_INVALID_ICON : FRLG_INVALID_ICON;
-    } else {
-        displaySpecies = species;
-    }
-
     // Load icon from ROM (displaySpecies 0 is valid - it's the "unknown" icon)
-    // Icons are 32x64 (2 frames stacked), we use first frame
-    QImage iconFull = m_romReader->extractPokemonIcon(displaySpecies);
+    QImage iconFull = m_assetCache->contains(RomAssetCache::PokemonIcon, displaySpecies)
+        ? m_assetCache->image(RomAssetCache::PokemonIcon, displaySpecies)
+        : SpriteCache::instance().icon(m_romReader, displaySpecies);
     if (iconFull.isNull()) {
         qWarning() << "Failed to load icon for species" << displaySpecies;
         return;
     }
 
-    // Extract first frame (top 32x32) and convert to ARGB32
-    QImage iconFrame = iconFull.copy(0, 0, 32, 32);
-    m_iconImage = iconFrame.convertToFormat(QImage::Format_ARGB32);
-
-    // Make palette index 0 transparent
-    // Since we're coming from indexed format, we need to check original
-    if (iconFull.format() == QImage::Format_Indexed8) {
-        QVector<QRgb> palette = iconFull.colorTable();
-        for (int y = 0; y < m_iconImage.height(); ++y) {
-            for (int x = 0; x < m_iconImage.width(); ++x) {
-                int idx = iconFrame.pixelIndex(x, y);
-                if (idx == 0) {
-                    m_iconImage.setPixel(x, y, qRgba(0, 0, 0, 0));
-                }
-            }
-        }
-    }
+    m_iconImage = CardRasterizer::iconFrame(iconFull);
 }
 
 void AuthenticWonderCardWidget::renderCard()
 {
+    MGI_TRACE_SCOPE("AuthenticWonderCardWidget::renderCard");
     // Allow rendering in both ROM mode and fallback mode
     if (!m_romLoaded && !m_fallbackMode) {
         m_renderedCard = QImage();
+        m_scaledCard = QPixmap();
+        m_backgroundLayer = QImage();
+        m_fieldLayers.clear();
+        m_iconRect = QRect();
         return;
     }
 
-    // Start with background
+    // Full rebuild: every layer, then one composite of the whole card
+    renderBackgroundLayer();
+
+    m_fieldLayers.resize(m_textFields.size());
+    for (int i = 0; i < m_textFields.size(); ++i) {
+        renderFieldLayer(i);
+    }
+
+    m_renderedCard = QImage(m_backgroundLayer.size(), QImage::Format_ARGB32);
+    compositeRect(m_renderedCard.rect());
+}
+
+void AuthenticWonderCardWidget::renderBackgroundLayer()
+{
     if (m_bgIndex >= 0 && m_bgIndex < m_backgrounds.size() && !m_backgrounds[m_bgIndex].isNull()) {
-        m_renderedCard = m_backgrounds[m_bgIndex].convertToFormat(QImage::Format_ARGB32);
+        m_backgroundLayer = m_backgrounds[m_bgIndex].convertToFormat(QImage::Format_ARGB32);
     } else {
-        m_renderedCard = QImage(CARD_WIDTH, CARD_HEIGHT, QImage::Format_ARGB32);
-        m_renderedCard.fill(Qt::white);
+        m_backgroundLayer = QImage(CARD_WIDTH, CARD_HEIGHT, QImage::Format_ARGB32);
+        m_backgroundLayer.fill(Qt::white);
     }
+}
 
-    QPainter painter(&m_renderedCard);
-    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+void AuthenticWonderCardWidget::renderFieldLayer(int fieldIndex)
+{
+    const TextField &field = m_textFields.at(fieldIndex);
+    FieldLayer &layer = m_fieldLayers[fieldIndex];
+    layer = FieldLayer();
 
-    // Render each text field
-    for (const TextField &field : m_textFields) {
-        QString text = m_fieldTexts.value(field.name);
-        if (text.isEmpty()) {
-            continue;
-        }
+    QString text = m_fieldTexts.value(field.name);
+    if (text.isEmpty()) {
+        return;
+    }
+
+    // Choose font based on field type
+    // For Emerald ID fields: use ID font (FONT_NORMAL)
+    // For everything else: use main font
+    bool useIdFont = field.isIdField && m_fontRenderer->isEmerald() && !m_fontIdHeader.isNull();
 
-        // Choose font based on field type
-        // For Emerald ID fields: use ID font (FONT_NORMAL)
-        // For everything else: use main font
+    // ROM fonts go through the glyph atlas; fallback fonts through the colored sheet
+    if (m_romFonts && m_fontRenderer->hasAtlas()) {
+        layer.image = m_fontRenderer->renderLine(text, field.isHeader ? Gen3FontRenderer::TitleHeader
+                                                                      : Gen3FontRenderer::BodyFooter,
+                                                 0, useIdFont);
+    } else {
         const QImage *fontImg;
-        if (field.isIdField && m_fontRenderer->isEmerald() && !m_fontIdHeader.isNull()) {
+        if (useIdFont) {
             fontImg = field.isHeader ? &m_fontIdHeader : &m_fontIdBody;
         } else {
             fontImg = field.isHeader ? &m_fontHeader : &m_fontBody;
         }
+        layer.image = m_fontRenderer->renderLine(text, *fontImg, 0);
+    }
 
-        // Render text line
-        QImage lineImg = m_fontRenderer->renderLine(text, *fontImg, 0);
-        if (lineImg.width() > 0) {
-            int xPos;
-            if (field.name == "subtitle") {
-                // Subtitle right-aligns to x=160 within header window
-                // x = 160 - string_width; if (x < 0) x = 0;
-                // Then add window offset (8) for screen position
-                int windowX = 160 - lineImg.width();
-                if (windowX < 0)
-                    windowX = 0;
-                xPos = PADDING_LEFT + windowX;
-            } else {
-                // All other fields use standard padding
-                xPos = PADDING_LEFT;
-            }
-            painter.drawImage(xPos, field.yStart, lineImg);
+    if (layer.image.width() <= 0) {
+        layer.image = QImage();
+        return;
+    }
+
+    // Subtitle right-aligns within the header window, everything else is padded
+    int xPos = CardRasterizer::lineX(field.name == "subtitle", layer.image.width());
+    layer.rect = QRect(QPoint(xPos, field.yStart), layer.image.size());
+}
+
+void AuthenticWonderCardWidget::compositeRect(const QRect &cardRect)
+{
+    QRect area = cardRect & m_renderedCard.rect();
+    if (area.isEmpty() || m_backgroundLayer.isNull()) {
+        return;
+    }
+
+    QPainter painter(&m_renderedCard);
+    painter.setClipRect(area);
+
+    // Background replaces, everything else blends on top
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(area.topLeft(), m_backgroundLayer, area);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+    // Text fields
+    for (const FieldLayer &layer : m_fieldLayers) {
+        if (!layer.image.isNull() && layer.rect.intersects(area)) {
+            painter.drawImage(layer.rect.topLeft(), layer.image);
         }
     }
 
     // Draw Pokemon icon
+    m_iconRect = QRect();
     if (!m_iconImage.isNull()) {
         int iconX = ICON_CENTER_X - (ICON_SIZE / 2);
         int iconY = ICON_CENTER_Y - (ICON_SIZE / 2);
-        painter.drawImage(iconX, iconY, m_iconImage);
+        m_iconRect = QRect(QPoint(iconX, iconY), m_iconImage.size());
+        if (m_iconRect.intersects(area)) {
+            painter.drawImage(iconX, iconY, m_iconImage);
+        }
     }
 
     painter.end();
+    updateScaledCard(area);
 }
 
-void AuthenticWonderCardWidget::paintEvent(QPaintEvent *event)
+void AuthenticWonderCardWidget::updateScaledCard(const QRect &cardRect)
 {
-    Q_UNUSED(event);
+    QRect area = cardRect;
+    QSize scaledSize = m_renderedCard.size() * DISPLAY_SCALE;
+    if (m_scaledCard.size() != scaledSize) {
+        m_scaledCard = QPixmap(scaledSize);
+        area = m_renderedCard.rect();
+    }
 
-    QPainter painter(this);
+    // Scale up using nearest-neighbor for crisp pixels, once per change
+    QImage scaled = m_renderedCard.copy(area).scaled(area.size() * DISPLAY_SCALE,
+                                                     Qt::IgnoreAspectRatio,
+                                                     Qt::FastTransformation);
 
-    if (m_renderedCard.isNull()) {
-        // Draw placeholder
-        painter.fillRect(rect(), QColor(200, 200, 200));
-        painter.drawText(rect(), Qt::AlignCenter, "No Wonder Card loaded\nLoad a ROM and Wonder Card to begin");
+    QPainter painter(&m_scaledCard);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(area.topLeft() * DISPLAY_SCALE, scaled);
+}
+
+void AuthenticWonderCardWidget::updateFieldLayer(int fieldIndex)
+{
+    if (fieldIndex < 0 || fieldIndex >= m_textFields.size()) {
         return;
     }
 
-    // Create a copy for cursor drawing (if editing)
-    QImage displayCard = m_renderedCard;
+    // No layers yet (e.g. first render): build everything
+    if (m_renderedCard.isNull() || m_fieldLayers.size() != m_textFields.size()) {
+        renderCard();
+        update();
+        return;
+    }
 
-    // Draw cursor if editing
-    if (!m_activeFieldName.isEmpty() && m_cursorVisible && !m_readOnly) {
-        QPainter cursorPainter(&displayCard);
-        drawCursor(cursorPainter);
-        cursorPainter.end();
+    QRect oldRect = m_fieldLayers.at(fieldIndex).rect;
+    renderFieldLayer(fieldIndex);
+    QRect dirty = oldRect.united(m_fieldLayers.at(fieldIndex).rect);
+
+    compositeRect(dirty);
+    invalidateCardRect(dirty.united(fieldRowRect(fieldIndex)));
+}
+
+void AuthenticWonderCardWidget::updateIconLayer()
+{
+    if (m_renderedCard.isNull()) {
+        renderCard();
+        update();
+        return;
     }
 
-    // Scale up using nearest-neighbor for crisp pixels
-    QImage scaled = displayCard.scaled(
-        CARD_WIDTH * DISPLAY_SCALE,
-        CARD_HEIGHT * DISPLAY_SCALE,
-        Qt::KeepAspectRatio,
-        Qt::FastTransformation  // Nearest neighbor
-    );
+    // Old and new icon may differ in size; cover both
+    QRect oldRect = m_iconRect;
+    QRect newRect;
+    if (!m_iconImage.isNull()) {
+        newRect = QRect(QPoint(ICON_CENTER_X - (ICON_SIZE / 2), ICON_CENTER_Y - (ICON_SIZE / 2)),
+                        m_iconImage.size());
+    }
+    QRect dirty = oldRect.united(newRect);
 
-    painter.drawImage(0, 0, scaled);
+    compositeRect(dirty);
+    invalidateCardRect(dirty);
 }
 
-void AuthenticWonderCardWidget::drawCursor(QPainter &painter)
+void AuthenticWonderCardWidget::invalidateCardRect(const QRect &cardRect)
 {
-    if (m_activeFieldName.isEmpty()) {
+    if (cardRect.isEmpty()) {
         return;
     }
 
-    // Find field info
-    int yStart = 0;
-    for (const TextField &field : m_textFields) {
-        if (field.name == m_activeFieldName) {
-            yStart = field.yStart;
-            break;
+    update(QRect(cardRect.x() * DISPLAY_SCALE, cardRect.y() * DISPLAY_SCALE,
+                 cardRect.width() * DISPLAY_SCALE, cardRect.height() * DISPLAY_SCALE));
+}
+
+QRect AuthenticWonderCardWidget::fieldRowRect(int fieldIndex) const
+{
+    if (fieldIndex < 0 || fieldIndex >= m_textFields.size()) {
+        return QRect();
+    }
+
+    // Full row: covers the line at any alignment plus the cursor
+    return QRect(0, m_textFields.at(fieldIndex).yStart, CARD_WIDTH, CHAR_HEIGHT);
+}
+
+int AuthenticWonderCardWidget::fieldIndex(const QString &fieldName) const
+{
+    for (int i = 0; i < m_textFields.size(); ++i) {
+        if (m_textFields[i].name == fieldName) {
+            return i;
         }
     }
+    return -1;
+}
+
+void AuthenticWonderCardWidget::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+
+    if (m_scaledCard.isNull()) {
+        // Draw placeholder
+        painter.fillRect(rect(), QColor(200, 200, 200));
+        painter.drawText(rect(), Qt::AlignCenter, "No Wonder Card loaded\nLoad a ROM and Wonder Card to begin");
+        return;
+    }
+
+    // The cached card is already at display scale: a straight blit
+    QRect exposed = event->rect();
+    painter.drawPixmap(exposed, m_scaledCard, exposed);
+
+    // Draw cursor overlay if editing
+    m_cursorRect = QRect();
+    if (!m_activeFieldName.isEmpty() && m_cursorVisible && !m_readOnly) {
+        m_cursorRect = cursorRect();
+        painter.fillRect(QRect(m_cursorRect.topLeft() * DISPLAY_SCALE, m_cursorRect.size() * DISPLAY_SCALE),
+                         QColor(0, 0, 0));
+    }
+}
+
+QRect AuthenticWonderCardWidget::cursorRect() const
+{
+    int fieldIdx = fieldIndex(m_activeFieldName);
+    if (fieldIdx < 0) {
+        return QRect();
+    }
+    int yStart = m_textFields.at(fieldIdx).yStart;
 
     QString text = m_fieldTexts.value(m_activeFieldName);
 
@@ -443,37 +937,28 @@ void AuthenticWonderCardWidget::drawCursor(QPainter &painter)
         textWidth += m_fontRenderer->getCharWidth(text[i]);
     }
 
-    // Calculate base X position based on field alignment
-    int baseX;
-    if (m_activeFieldName == "subtitle") {
-        // Subtitle right-aligns to x=160 within header window
-        // x = 160 - string_width; if (x < 0) x = 0;
-        int windowX = 160 - textWidth;
-        if (windowX < 0)
-            windowX = 0;
-        baseX = PADDING_LEFT + windowX;
-    } else {
-        // All other fields use standard padding
-        baseX = PADDING_LEFT;
-    }
-
     // Calculate cursor X position using glyph widths
-    int xPos = baseX;
+    int xPos = CardRasterizer::lineX(m_activeFieldName == "subtitle", textWidth);
     for (int i = 0; i < m_cursorPos && i < text.length(); ++i) {
         xPos += m_fontRenderer->getCharWidth(text[i]);
     }
 
-    // Draw cursor line (2 pixels wide, char height tall)
-    painter.setPen(Qt::NoPen);
-    painter.setBrush(QColor(0, 0, 0));
-    painter.drawRect(xPos, yStart, 2, CHAR_HEIGHT);
+    // Cursor line: 2 pixels wide, char height tall
+    return QRect(xPos, yStart, 2, CHAR_HEIGHT);
+}
+
+void AuthenticWonderCardWidget::refreshCursor()
+{
+    // Erase the cursor where it was last painted, draw it where it is now
+    invalidateCardRect(m_cursorRect);
+    invalidateCardRect(cursorRect());
 }
 
 void AuthenticWonderCardWidget::toggleCursor()
 {
     if (!m_activeFieldName.isEmpty() && !m_readOnly) {
         m_cursorVisible = !m_cursorVisible;
-        update();
+        refreshCursor();
     }
 }
 
@@ -490,13 +975,13 @@ void AuthenticWonderCardWidget::mousePressEvent(QMouseEvent *event)
     // Check which field was clicked
     int fieldIdx = findFieldAtY(y);
     if (fieldIdx >= 0 && fieldIdx < m_textFields.size()) {
+        // Selection only moves the cursor; the card itself is unchanged
         m_activeFieldName = m_textFields[fieldIdx].name;
         QString text = m_fieldTexts.value(m_activeFieldName);
         m_cursorPos = getCursorPosFromX(text, x);
         m_cursorVisible = true;
 
-        renderCard();
-        update();
+        refreshCursor();
         updateStatus();
         emit fieldSelected(m_activeFieldName);
     }
@@ -523,21 +1008,7 @@ int AuthenticWonderCardWidget::getCursorPosFromX(const QString &text, int clickX
         textWidth += m_fontRenderer->getCharWidth(text[i]);
     }
 
-    // Calculate base X position based on field alignment
-    int baseX;
-    if (m_activeFieldName == "subtitle") {
-        // Subtitle right-aligns to x=160 within header window
-        // x = 160 - string_width; if (x < 0) x = 0;
-        int windowX = 160 - textWidth;
-        if (windowX < 0)
-            windowX = 0;
-        baseX = PADDING_LEFT + windowX;
-    } else {
-        // All other fields use standard padding
-        baseX = PADDING_LEFT;
-    }
-
-    int xPos = baseX;
+    int xPos = CardRasterizer::lineX(m_activeFieldName == "subtitle", textWidth);
     for (int i = 0; i < text.length(); ++i) {
         int charWidth = m_fontRenderer->getCharWidth(text[i]);
         if (clickX < xPos + charWidth / 2) {
@@ -557,6 +1028,7 @@ void AuthenticWonderCardWidget::keyPressEvent(QKeyEvent *event)
 
     int key = event->key();
     QString text = m_fieldTexts.value(m_activeFieldName);
+    int previousField = fieldIndex(m_activeFieldName);
 
     bool textChanged = false;
 
@@ -619,11 +1091,12 @@ void AuthenticWonderCardWidget::keyPressEvent(QKeyEvent *event)
     m_cursorVisible = true;
 
     if (textChanged) {
-        renderCard();
+        updateFieldLayer(previousField);
         emit wonderCardChanged(buildWonderCardData());
     }
 
-    update();
+    // Cursor may have moved within or between rows
+    refreshCursor();
     updateStatus();
 }
 
@@ -659,14 +1132,14 @@ void AuthenticWonderCardWidget::focusInEvent(QFocusEvent *event)
 {
     QWidget::focusInEvent(event);
     m_cursorVisible = true;
-    update();
+    refreshCursor();
 }
 
 void AuthenticWonderCardWidget::focusOutEvent(QFocusEvent *event)
 {
     QWidget::focusOutEvent(event);
     // Keep cursor visible when focus is lost so selection is visible
-    update();
+    refreshCursor();
 }
 
 void AuthenticWonderCardWidget::updateStatus()
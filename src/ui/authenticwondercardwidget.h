@@ -7,9 +7,13 @@
 #include <QPixmap>
 #include <QMap>
 #include <QVector>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QSharedPointer>
 #include "mysterygift.h"
 #include "gbaromreader.h"
 #include "gen3fontrenderer.h"
+#include "romassetcache.h"
 
 /**
  * @brief Authentic Wonder Card widget using ROM-extracted graphics and fonts
@@ -28,6 +32,13 @@
  * - Arrow key navigation between fields
  * - Gen3 character encoding validation
  * - Pokemon icon display
+ *
+ * ROM loading can run asynchronously (loadROMAsync): the card shows fallback
+ * graphics immediately while the ROM is mapped and identified on a worker
+ * thread (which also decodes the name tables), then fonts, backgrounds and
+ * icons are decoded in parallel. On a first load each decoded stage is swapped in as
+ * soon as it completes; when replacing an already loaded ROM everything is
+ * swapped at the end so old and new assets never mix.
  */
 class AuthenticWonderCardWidget : public QWidget
 {
@@ -40,6 +51,9 @@ public:
     // ROM loading
     bool loadROM(const QString &romPath, QString &errorMessage);
     bool loadFallbackGraphics(QString &errorMessage);
+    void loadROMAsync(const QString &romPath, RomDatabase *database = nullptr);  // Reports via romLoadFinished()
+    void cancelROMLoad();                                                         // Blocks until workers stop
+    bool isROMLoading() const { return m_loadInProgress; }
     bool isROMLoaded() const { return m_romLoaded; }
     bool isFallbackMode() const { return m_fallbackMode; }
     GBAROReader* getRomReader() { return m_romReader; }
@@ -87,6 +101,10 @@ signals:
     // Emitted with current field info (for status bar)
     void statusUpdate(const QString &fieldName, int byteCount, int maxBytes);
 
+    // Asynchronous ROM loading progress / completion (GUI thread)
+    void romLoadProgress(const QString &stage);
+    void romLoadFinished(bool success, const QString &errorMessage);
+
 protected:
     void paintEvent(QPaintEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
@@ -112,7 +130,28 @@ private:
 
     // Rendering methods
     void renderCard();
-    void drawCursor(QPainter &painter);
+
+    // Cursor is drawn over the widget, never into the card image. Blinks and
+    // moves repaint only the old and new cursor rectangles.
+    QRect cursorRect() const;
+    void refreshCursor();
+
+    // Layered rendering: the background, each text field and the icon are
+    // cached separately. A change re-rasterizes only its own layer, then
+    // recomposites and repaints just the rectangle it covers.
+    struct FieldLayer {
+        QImage image;   // Rendered line (null when the field is empty)
+        QRect rect;     // Card-space area covered by image
+    };
+    void renderBackgroundLayer();
+    void renderFieldLayer(int fieldIndex);
+    void updateFieldLayer(int fieldIndex);
+    void updateIconLayer();
+    void compositeRect(const QRect &cardRect);
+    void updateScaledCard(const QRect &cardRect);
+    void invalidateCardRect(const QRect &cardRect);
+    QRect fieldRowRect(int fieldIndex) const;
+    int fieldIndex(const QString &fieldName) const;
 
     // Field interaction
     int findFieldAtY(int y) const;
@@ -124,11 +163,35 @@ private:
     // Pokemon icon handling
     void loadPokemonIcon(int species);
 
+    // ROM asset decoding / persistent cache
+    bool decodeAssetsFromROM(QString &errorMessage);
+    bool loadAssetsFromCache(QString &errorMessage);
+    void writeAssetCache(const QByteArray &fingerprint);
+
+    // Asynchronous loading pipeline. runAsyncLoad() executes on m_loadPool
+    // and only touches its AsyncLoad; the other methods run on the GUI thread.
+    struct AsyncLoad;
+    void runAsyncLoad(QSharedPointer<AsyncLoad> load);
+    void postLoadStage(QSharedPointer<AsyncLoad> load, void (AuthenticWonderCardWidget::*stage)(QSharedPointer<AsyncLoad>));
+    void applyLoadedFonts(QSharedPointer<AsyncLoad> load);
+    void applyLoadedBackgrounds(QSharedPointer<AsyncLoad> load);
+    void finishAsyncLoad(QSharedPointer<AsyncLoad> load);
+    bool isCurrentLoad(const QSharedPointer<AsyncLoad> &load) const;
+
     // ROM resources
     GBAROReader *m_romReader;
     Gen3FontRenderer *m_fontRenderer;
+    RomAssetCache *m_assetCache;  // Backs cached images; must outlive them
     bool m_romLoaded;
     bool m_fallbackMode;
+    bool m_romFonts;              // Fonts (and glyph atlas) come from a ROM
+
+    // Asynchronous loading state
+    QThreadPool m_loadPool;
+    QAtomicInt m_cancelLoad;
+    int m_loadGeneration;         // Results of older loads are discarded
+    bool m_loadInProgress;
+    bool m_loadApplied;           // A stage of the running load is on screen
 
     // Wonder Card backgrounds (cached)
     QVector<QImage> m_backgrounds;
@@ -161,14 +224,20 @@ private:
     QTimer *m_cursorTimer;
     bool m_cursorVisible;
 
-    // Rendered card cache
+    // Rendered card cache, plus the same card at DISPLAY_SCALE
     QImage m_renderedCard;
+    QPixmap m_scaledCard;
+    QRect m_cursorRect;    // Card-space cursor as last painted (empty if none)
+
+    // Cached layers (m_fieldLayers is parallel to m_textFields)
+    QImage m_backgroundLayer;
+    QVector<FieldLayer> m_fieldLayers;
+    QRect m_iconRect;
 
     // Layout constants (GBA screen: 240x160)
     static const int CARD_WIDTH = 240;
     static const int CARD_HEIGHT = 160;
     static const int DISPLAY_SCALE = 2;
-    static const int PADDING_LEFT = 8;
     static const int PADDING_TOP = 4;
     static const int LINE_SPACING = 2;
     static const int CHAR_HEIGHT = 14;
@@ -177,6 +246,7 @@ private:
     static const int ICON_CENTER_X = 220;
     static const int ICON_CENTER_Y = 20;
     static const int ICON_SIZE = 32;
+    static const int ICON_SPECIES_LIMIT = 412;  // Highest species with its own icon
 };
 
 #endif // AUTHENTICWONDERCARDWIDGET_H
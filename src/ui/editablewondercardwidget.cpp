@@ -1,4 +1,5 @@
 #include "editablewondercardwidget.h"
+#include "spritecache.h"
 #include <QPainter>
 #include <QMouseEvent>
 #include <QKeyEvent>
@@ -7,7 +8,6 @@
 
 // Static member initialization
 GBAROReader *EditableWonderCardWidget::s_romReader = nullptr;
-QMap<uint16_t, QPixmap> EditableWonderCardWidget::s_iconCache;
 
 // Background colors for the 8 Wonder Card types
 const QColor EditableWonderCardWidget::BACKGROUND_COLORS[8] = {
@@ -93,17 +93,8 @@ void EditableWonderCardWidget::setWonderCard(const WonderCardData &wonderCard)
 
     // Load icon if ROM is available
     if (m_hasData && isROMLoaded()) {
-        if (s_iconCache.contains(wonderCard.icon)) {
-            m_cachedIcon = s_iconCache[wonderCard.icon];
-        } else {
-            QImage iconImg = s_romReader->extractPokemonIcon(wonderCard.icon);
-            if (!iconImg.isNull()) {
-                m_cachedIcon = QPixmap::fromImage(iconImg);
-                s_iconCache[wonderCard.icon] = m_cachedIcon;
-            } else {
-                m_cachedIcon = QPixmap();
-            }
-        }
+        QImage iconImg = SpriteCache::instance().icon(s_romReader, wonderCard.icon);
+        m_cachedIcon = iconImg.isNull() ? QPixmap() : QPixmap::fromImage(iconImg);
     } else {
         m_cachedIcon = QPixmap();
     }
@@ -126,7 +117,6 @@ bool EditableWonderCardWidget::loadROM(const QString &romPath, QString &errorMes
     if (s_romReader) {
         delete s_romReader;
         s_romReader = nullptr;
-        s_iconCache.clear();
     }
 
     s_romReader = new GBAROReader();
@@ -136,6 +126,9 @@ bool EditableWonderCardWidget::loadROM(const QString &romPath, QString &errorMes
         return false;
     }
 
+    // Warm the shared icon cache so species changes never decode on the GUI thread
+    SpriteCache::instance().prefetchIcons(s_romReader);
+
     return true;
 }
 
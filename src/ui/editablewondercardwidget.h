@@ -130,7 +130,6 @@ private:
 
     // Static ROM reader
     static GBAROReader *s_romReader;
-    static QMap<uint16_t, QPixmap> s_iconCache;
 
     // Layout constants (GBA screen: 240x160)
     static const int CARD_WIDTH = 240;
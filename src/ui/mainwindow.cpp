@@ -59,6 +59,8 @@
 // Project Includes
 // =============================================================================
 #include "mainwindow.h"
+#include "logcategories.h"
+#include "tracing.h"
 #include "tileviewer.h"
 #include "authenticwondercardwidget.h"
 
@@ -84,6 +86,7 @@
 #include <QTimer>
 #include <QEvent>
 #include <QFileDialog>
+#include <QStandardItemModel>
 #include <QFileInfo>
 #include <QMessageBox>
 #include <QDialog>
@@ -101,11 +104,15 @@
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
-    , m_saveFile(new SaveFile())
+    , m_saveFile(&m_emptySaveFile)
     , m_ticketManager(new TicketManager())
+    , m_documentTabs(nullptr)
+    , m_currentSession(-1)
     , m_romDatabase(new RomDatabase())
     , m_romLoaded(false)
     , m_useFallbackGraphics(false)
+    , m_romDatabaseReady(false)
+    , m_startupCancelled(0)
     , m_editingEnabled(false)
     , m_scriptDisassembler(new ScriptDisassembler())
     , m_dragging(false)
@@ -113,8 +120,7 @@ MainWindow::MainWindow(QWidget *parent)
     , m_menuBar(nullptr)
     , m_toolBar(nullptr)
 {
-    // Load ROM database from YAML
-    loadRomDatabase();
+    // The ROM database is loaded by the startup pipeline (see loadROM())
 
     // Initialize script disassembler
     initScriptDisassembler();
@@ -196,7 +202,11 @@ MainWindow::MainWindow(QWidget *parent)
 
 MainWindow::~MainWindow()
 {
-    delete m_saveFile;
+    // Stop background loading before the objects it uses go away
+    wonderCardVisualDisplay->cancelROMLoad();
+    m_startupCancelled.storeRelaxed(1);
+    m_startupPool.waitForDone();
+
     delete m_ticketManager;
     delete m_romDatabase;
     delete m_scriptDisassembler;
@@ -206,13 +216,9 @@ void MainWindow::initScriptDisassembler()
 {
     QString error;
 
-    // Load command definitions from embedded resource
-    if (!m_scriptDisassembler->loadCommandDefinitions(":/Resources/script_commands.yaml", error)) {
-        qWarning() << "Failed to load script commands:" << error;
-    }
-
-    // Load script data (flags, specials, etc.) from embedded resource
-    if (!m_scriptDisassembler->loadScriptData(":/Resources/script_data.yaml", error)) {
+    // Load command definitions and script data (flags, specials, etc.),
+    // compiled from the YAML resources at build time
+    if (!m_scriptDisassembler->loadDefaultData(error)) {
         qWarning() << "Failed to load script data:" << error;
     }
 }
@@ -372,6 +378,10 @@ QMenuBar* MainWindow::createMenuBar(QWidget *parent)
     validateChecksumsAction->setEnabled(false);  // Disabled until file is loaded
     connect(validateChecksumsAction, &QAction::triggered, this, &MainWindow::onValidateChecksums);
 
+    restoreDeltaAction = toolsMenu->addAction("Restore Delta Backup...");
+    restoreDeltaAction->setEnabled(false);  // Disabled until file is loaded
+    connect(restoreDeltaAction, &QAction::triggered, this, &MainWindow::onRestoreDeltaBackup);
+
     toolsMenu->addSeparator();
 
     QAction *optionsAction = toolsMenu->addAction("Options...");
@@ -463,6 +473,23 @@ void MainWindow::createCentralWidget()
     m_toolBar = createToolBar(centralWidget);
     vbox->addWidget(m_toolBar);
 
+    // One tab per open save (hidden while nothing is open)
+    m_documentTabs = new QTabBar(centralWidget);
+    m_documentTabs->setTabsClosable(true);
+    m_documentTabs->setExpanding(false);
+    m_documentTabs->setDocumentMode(true);
+    m_documentTabs->setDrawBase(false);
+    m_documentTabs->setVisible(false);
+    m_documentTabs->setStyleSheet(
+        "QTabBar { background-color: #e8e8e8; }"
+        "QTabBar::tab { background-color: #d0d0d0; border: 1px solid #a0a0a0; border-bottom: none; "
+        "               padding: 3px 8px; margin-left: 5px; color: #000000; }"
+        "QTabBar::tab:selected { background-color: white; }"
+    );
+    connect(m_documentTabs, &QTabBar::currentChanged, this, &MainWindow::onDocumentTabChanged);
+    connect(m_documentTabs, &QTabBar::tabCloseRequested, this, &MainWindow::onDocumentTabCloseRequested);
+    vbox->addWidget(m_documentTabs);
+
     // Main content area - full width panels
     QVBoxLayout *contentLayout = new QVBoxLayout();
     contentLayout->setSpacing(10);
@@ -556,6 +583,23 @@ void MainWindow::createCentralWidget()
     giftCombo->setEnabled(false);  // Disabled until ROM loaded and edit mode active
     connect(giftCombo, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &MainWindow::onGiftComboChanged);
+
+    // Type to filter: the popup lists prefix, substring, then fuzzy matches
+    giftCombo->setEditable(true);
+    giftCombo->setInsertPolicy(QComboBox::NoInsert);
+    m_giftCompleter = new QCompleter(this);
+    m_giftCompleter->setModel(new QStandardItemModel(m_giftCompleter));
+    m_giftCompleter->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    m_giftCompleter->setMaxVisibleItems(20);
+    giftCombo->lineEdit()->setCompleter(m_giftCompleter);
+    connect(giftCombo->lineEdit(), &QLineEdit::textEdited, this, &MainWindow::onGiftFilterEdited);
+    connect(m_giftCompleter, QOverload<const QModelIndex &>::of(&QCompleter::activated),
+            this, [this](const QModelIndex &index) {
+        int comboIndex = giftCombo->findData(index.data(Qt::UserRole));
+        if (comboIndex >= 0) {
+            giftCombo->setCurrentIndex(comboIndex);
+        }
+    });
     giftRow->addWidget(giftCombo);
 
     metadataLayout->addLayout(giftRow);
@@ -707,6 +751,10 @@ void MainWindow::createCentralWidget()
             this, &MainWindow::onEditableWonderCardChanged);
     connect(wonderCardVisualDisplay, &AuthenticWonderCardWidget::fieldSelected,
             this, &MainWindow::onEditableFieldSelected);
+    connect(wonderCardVisualDisplay, &AuthenticWonderCardWidget::romLoadProgress,
+            this, &MainWindow::onRomLoadProgress);
+    connect(wonderCardVisualDisplay, &AuthenticWonderCardWidget::romLoadFinished,
+            this, &MainWindow::onRomLoadFinished);
     connect(wonderCardVisualDisplay, &AuthenticWonderCardWidget::statusUpdate,
             this, &MainWindow::onEditableStatusUpdate);
 
@@ -1189,9 +1237,9 @@ bool MainWindow::eventFilter(QObject *obj, QEvent *event)
 
 void MainWindow::onOpenClicked()
 {
-    // Open a Pokemon Generation III save file (.sav) and extract any
-    // existing Wonder Card data for display
-    QString filePath = QFileDialog::getOpenFileName(
+    // Open one or more Pokemon Generation III save files (.sav). Each file
+    // becomes a session with its own tab; the last one opened is shown
+    QStringList filePaths = QFileDialog::getOpenFileNames(
         this,
         "Open Pokemon Save File",
         QString(),
@@ -1199,7 +1247,7 @@ void MainWindow::onOpenClicked()
     );
 
     // User cancelled
-    if (filePath.isEmpty()) {
+    if (filePaths.isEmpty()) {
         return;
     }
 
@@ -1215,121 +1263,312 @@ void MainWindow::onOpenClicked()
     // Force UI update
     QApplication::processEvents();
 
-    // Load the file
-    QString errorMessage;
-    bool success = m_saveFile->loadFromFile(filePath, errorMessage);
+    // Load the files
+    QStringList failures;
+    for (const QString &filePath : filePaths) {
+        QString errorMessage;
+        if (!openSaveFile(filePath, errorMessage)) {
+            failures << (filePaths.size() > 1 ? QFileInfo(filePath).fileName() + ": " + errorMessage
+                                              : errorMessage);
+        }
+    }
 
     // Re-enable toolbar buttons
     openAction->setEnabled(true);
 
-    if (success) {
-        // Update file path display (elided left with full path in tooltip)
-        setFilePathDisplay(filePath);
-
-        // Update save type button
-        QString gameTypeStr = m_saveFile->gameTypeToString(m_saveFile->detectedGame());
-        saveTypeButton->setText(gameTypeStr);
-        saveTypeButton->setEnabled(true);
-        saveTypeButton->setStyleSheet(
-            "QPushButton { background-color: transparent; color: #000000; border: none; "
-            "             font-weight: normal; font-style: italic; padding: 5px 10px; }"
-            "QPushButton:enabled { cursor: pointer; }"
-            "QPushButton:enabled:hover { color: #505050; text-decoration: underline; }"
-        );
+    if (!failures.isEmpty()) {
+        // Show error dialog
+        QMessageBox box(QMessageBox::Critical, "", "Failed to load save file:\n\n" + failures.join("\n"), QMessageBox::Ok, this);
+        box.setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
+        box.exec();
+    }
 
-        // Update checksum status
-        if (m_saveFile->checksumValid()) {
-            checksumLabel->setText("Checksum: Valid");
-            checksumLabel->setStyleSheet("font-weight: bold; color: #90EE90; background: transparent;"); // Light green
-        } else {
-            checksumLabel->setText("Checksum: Invalid");
-            checksumLabel->setStyleSheet("font-weight: bold; color: #FFB6C1; background: transparent;"); // Light red
+    if (m_currentSession < 0) {
+        // Reset UI to unloaded state
+        showNoSession();
+    } else {
+        // Restore the current session's toolbar and status state
+        showCurrentSession();
+        if (failures.size() < filePaths.size()) {
+            statusLabel->setText("Status: File loaded successfully");
         }
+    }
+}
 
-        // Update status
-        statusLabel->setText("Status: File loaded successfully");
-
-        // Enable file-dependent actions
-        closeAction->setEnabled(true);
-        saveAction->setEnabled(true);
-        saveAsAction->setEnabled(true);
-        editButton->setEnabled(true);
-        editEnableAction->setEnabled(true);
-        clearWcAction->setEnabled(true);
-        enableMgFlagAction->setEnabled(true);
-        validateChecksumsAction->setEnabled(true);
-
-        // Try to extract Wonder Card data
-        if (m_saveFile->hasWonderCard()) {
-            QString wcError, scriptError, rawError;
-
-            WonderCardData wonderCard = m_saveFile->extractWonderCard(wcError);
-            QByteArray wonderCardRaw = m_saveFile->extractWonderCardRaw(rawError);
-            QByteArray scriptData = m_saveFile->extractScript(scriptError);
-
-            if (wcError.isEmpty() && !wonderCard.isEmpty()) {
-                m_currentWonderCard = wonderCard;
-                m_currentWonderCardRaw = wonderCardRaw;
-                m_currentScriptData = scriptData;
-
-                // Set the gift dropdown to match the item in the script
-                if (!m_currentScriptData.isEmpty()) {
-                    uint16_t itemId = extractItemIdFromScript(m_currentScriptData);
-                    if (itemId != 0xFFFF) {
-                        giftCombo->blockSignals(true);
-                        for (int i = 0; i < giftCombo->count(); ++i) {
-                            if (giftCombo->itemData(i).toInt() == itemId) {
-                                giftCombo->setCurrentIndex(i);
-                                break;
-                            }
-                        }
-                        giftCombo->blockSignals(false);
-                    }
-                }
+// =============================================================================
+// SAVE SESSIONS - One tab per open save, all sharing the loaded ROM assets
+// =============================================================================
 
-                // Try to identify the ticket by comparing with known tickets
-                const TicketResource* matchedTicket = m_ticketManager->findTicketByWonderCard(
-                    wonderCardRaw, m_saveFile->detectedGame());
+int MainWindow::findSession(const QString &filePath) const
+{
+    QString absolutePath = QFileInfo(filePath).absoluteFilePath();
+    for (int i = 0; i < m_sessions.size(); ++i) {
+        if (QFileInfo(m_sessions.at(i).saveFile->filePath()).absoluteFilePath() == absolutePath) {
+            return i;
+        }
+    }
+    return -1;
+}
 
-                displayWonderCard(wonderCard, matchedTicket);
+bool MainWindow::openSaveFile(const QString &filePath, QString &errorMessage)
+{
+    // A file that is already open just gets its tab selected
+    int existing = findSession(filePath);
+    if (existing >= 0) {
+        m_documentTabs->setCurrentIndex(existing);
+        return true;
+    }
 
-                // Enable export action since we have Wonder Card data
-                exportWcAction->setEnabled(true);
-            } else {
-                // Save has no Wonder Card or extraction failed
-                clearWonderCardDisplay();
-                exportWcAction->setEnabled(false);
+    // Files are opened for editing: finish an interrupted patch first
+    if (!SaveFile::recoverJournal(filePath, errorMessage)) {
+        return false;
+    }
+
+    QSharedPointer<SaveFile> saveFile(new SaveFile());
+    if (!saveFile->loadFromFile(filePath, errorMessage)) {
+        return false;
+    }
+
+    SaveSession session;
+    session.saveFile = saveFile;
+
+    // Try to extract Wonder Card data
+    if (saveFile->hasWonderCard()) {
+        QString wcError, scriptError, rawError;
+        WonderCardData wonderCard = saveFile->extractWonderCard(wcError);
+
+        if (wcError.isEmpty() && !wonderCard.isEmpty()) {
+            session.wonderCard = wonderCard;
+            session.wonderCardRaw = saveFile->extractWonderCardRaw(rawError);
+            session.scriptData = saveFile->extractScript(scriptError);
+
+            // Try to identify the ticket by comparing with known tickets
+            const TicketResource* matchedTicket = m_ticketManager->findTicketByWonderCard(
+                saveFile->wonderCardRawView(), saveFile->detectedGame());
+            if (matchedTicket) {
+                session.presetTicketId = matchedTicket->id();
             }
-        } else {
-            // No Wonder Card in save
-            clearWonderCardDisplay();
-            exportWcAction->setEnabled(false);
         }
+    }
+
+    m_sessions.append(session);
+
+    m_documentTabs->blockSignals(true);
+    int tab = m_documentTabs->addTab(QFileInfo(filePath).fileName());
+    m_documentTabs->setTabToolTip(tab, filePath);
+    m_documentTabs->setCurrentIndex(tab);
+    m_documentTabs->blockSignals(false);
+    m_documentTabs->setVisible(true);
+
+    activateSession(tab);
+    showCurrentSession();
+    return true;
+}
+
+void MainWindow::storeCurrentSession()
+{
+    if (m_currentSession < 0) {
+        return;
+    }
+
+    // Keep unsaved edits with the session they belong to
+    SaveSession &session = m_sessions[m_currentSession];
+    session.wonderCard = m_currentWonderCard;
+    session.wonderCardRaw = m_currentWonderCardRaw;
+    session.scriptData = m_currentScriptData;
+
+    // Preset items carry the ticket's Wonder Card file; display names need not be unique
+    session.presetTicketId.clear();
+    QString presetFile = presetCombo->currentData().toString();
+    for (const TicketResource &ticket : m_ticketManager->tickets()) {
+        if (!presetFile.isEmpty() && ticket.wonderCardFile() == presetFile) {
+            session.presetTicketId = ticket.id();
+            break;
+        }
+    }
+}
+
+void MainWindow::activateSession(int index)
+{
+    storeCurrentSession();
+
+    const SaveSession &session = m_sessions.at(index);
+    m_currentSession = index;
+    m_saveFile = session.saveFile.data();
+    m_currentWonderCard = session.wonderCard;
+    m_currentWonderCardRaw = session.wonderCardRaw;
+    m_currentScriptData = session.scriptData;
+}
+
+void MainWindow::showCurrentSession()
+{
+    const SaveSession &session = m_sessions.at(m_currentSession);
 
-        // Reset edit state when loading a new file
-        resetEditState();
+    // Update file path display (elided left with full path in tooltip)
+    setFilePathDisplay(m_saveFile->filePath());
 
+    // Update save type button
+    QString gameTypeStr = m_saveFile->gameTypeToString(m_saveFile->detectedGame());
+    saveTypeButton->setText(gameTypeStr);
+    saveTypeButton->setEnabled(true);
+    saveTypeButton->setStyleSheet(
+        "QPushButton { background-color: transparent; color: #000000; border: none; "
+        "             font-weight: normal; font-style: italic; padding: 5px 10px; }"
+        "QPushButton:enabled { cursor: pointer; }"
+        "QPushButton:enabled:hover { color: #505050; text-decoration: underline; }"
+    );
+
+    // Update checksum status
+    if (m_saveFile->checksumValid()) {
+        checksumLabel->setText("Checksum: Valid");
+        checksumLabel->setStyleSheet("font-weight: bold; color: #90EE90; background: transparent;"); // Light green
     } else {
-        // Show error dialog
-        QMessageBox box(QMessageBox::Critical, "", "Failed to load save file:\n\n" + errorMessage, QMessageBox::Ok, this);
-        box.setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
-        box.exec();
+        checksumLabel->setText("Checksum: Invalid");
+        checksumLabel->setStyleSheet("font-weight: bold; color: #FFB6C1; background: transparent;"); // Light red
+    }
 
-        // Reset UI to unloaded state
-        filePathDisplay->setText("<span style='color: #909090; font-style: italic;'>No file loaded</span>");
-        filePathDisplay->setToolTip("");
-        saveTypeButton->setText("Not detected");
-        saveTypeButton->setEnabled(false);
-        saveTypeButton->setStyleSheet(
-            "QPushButton { background-color: transparent; color: #909090; border: none; "
-            "             font-weight: normal; font-style: italic; padding: 5px 10px; }"
-            "QPushButton:enabled { cursor: pointer; }"
-            "QPushButton:enabled:hover { color: #505050; text-decoration: underline; }"
-        );
-        statusLabel->setText("Status: No file loaded");
-        checksumLabel->setText("Checksum: --");
-        checksumLabel->setStyleSheet("font-weight: bold; color: white; background: transparent;");
+    statusLabel->setText(QString("Status: %1").arg(QFileInfo(m_saveFile->filePath()).fileName()));
+
+    // Enable file-dependent actions
+    closeAction->setEnabled(true);
+    saveAction->setEnabled(true);
+    saveAsAction->setEnabled(true);
+    editButton->setEnabled(true);
+    editEnableAction->setEnabled(true);
+    clearWcAction->setEnabled(true);
+    enableMgFlagAction->setEnabled(true);
+    validateChecksumsAction->setEnabled(true);
+    restoreDeltaAction->setEnabled(true);
+
+    if (!m_currentWonderCard.isEmpty()) {
+        // Set the gift dropdown to match the item in the script
+        if (!m_currentScriptData.isEmpty()) {
+            uint16_t itemId = extractItemIdFromScript(m_currentScriptData);
+            if (itemId != 0xFFFF) {
+                giftCombo->blockSignals(true);
+                for (int i = 0; i < giftCombo->count(); ++i) {
+                    if (giftCombo->itemData(i).toInt() == itemId) {
+                        giftCombo->setCurrentIndex(i);
+                        break;
+                    }
+                }
+                giftCombo->blockSignals(false);
+            }
+        }
+
+        // Preset selected for this session (matched ticket, or chosen by the user)
+        const TicketResource *matchedTicket = session.presetTicketId.isEmpty()
+            ? nullptr : m_ticketManager->findTicketById(session.presetTicketId);
+
+        displayWonderCard(m_currentWonderCard, matchedTicket);
+
+        // Enable export action since we have Wonder Card data
+        exportWcAction->setEnabled(true);
+    } else {
+        // Save has no Wonder Card or extraction failed
+        clearWonderCardDisplay();
+        exportWcAction->setEnabled(false);
+    }
+
+    // Editing is per visit; switching sessions always starts read-only
+    resetEditState();
+}
+
+void MainWindow::showNoSession()
+{
+    // Clear Wonder Card display and data
+    clearWonderCardDisplay();
+
+    // Explicitly clear GREEN MAN / script displays
+    scriptTextDisplay->clear();
+    scriptHexDisplay->clear();
+
+    // Reset file path display
+    filePathDisplay->setText("<span style='color: #909090; font-style: italic;'>No file loaded</span>");
+    filePathDisplay->setToolTip("");
+
+    // Reset save type button
+    saveTypeButton->setText("Not detected");
+    saveTypeButton->setEnabled(false);
+    saveTypeButton->setStyleSheet(
+        "QPushButton { background-color: transparent; color: #909090; border: none; "
+        "             font-weight: normal; font-style: italic; padding: 5px 10px; }"
+        "QPushButton:enabled { cursor: pointer; }"
+        "QPushButton:enabled:hover { color: #505050; text-decoration: underline; }"
+    );
+
+    // Reset status bar
+    statusLabel->setText("Status: No file loaded");
+    checksumLabel->setText("Checksum: --");
+    checksumLabel->setStyleSheet("font-weight: bold; color: white; background: transparent;");
+
+    // Disable file-dependent actions
+    closeAction->setEnabled(false);
+    saveAction->setEnabled(false);
+    saveAsAction->setEnabled(false);
+    editButton->setEnabled(false);
+    editEnableAction->setEnabled(false);
+    exportWcAction->setEnabled(false);
+    clearWcAction->setEnabled(false);
+    enableMgFlagAction->setEnabled(false);
+    validateChecksumsAction->setEnabled(false);
+    restoreDeltaAction->setEnabled(false);
+
+    // Reset edit state
+    resetEditState();
+}
+
+void MainWindow::closeSession(int index)
+{
+    if (index < 0 || index >= m_sessions.size()) {
+        return;
+    }
+
+    bool closingCurrent = (index == m_currentSession);
+    if (closingCurrent) {
+        // Its state goes away with it; nothing to store
+        m_currentSession = -1;
+        m_saveFile = &m_emptySaveFile;
+    } else if (index < m_currentSession) {
+        --m_currentSession;
+    }
+
+    m_sessions.remove(index);
+    m_documentTabs->blockSignals(true);
+    m_documentTabs->removeTab(index);
+    m_documentTabs->blockSignals(false);
+
+    if (!closingCurrent) {
+        return;
+    }
+
+    if (m_sessions.isEmpty()) {
+        m_documentTabs->setVisible(false);
+        showNoSession();
+        return;
     }
+
+    int next = qMin(index, m_sessions.size() - 1);
+    m_documentTabs->blockSignals(true);
+    m_documentTabs->setCurrentIndex(next);
+    m_documentTabs->blockSignals(false);
+    activateSession(next);
+    showCurrentSession();
+}
+
+void MainWindow::onDocumentTabChanged(int index)
+{
+    if (index < 0 || index == m_currentSession) {
+        return;
+    }
+
+    activateSession(index);
+    showCurrentSession();
+}
+
+void MainWindow::onDocumentTabCloseRequested(int index)
+{
+    closeSession(index);
 }
 
 void MainWindow::onEditButtonClicked()
@@ -1699,19 +1938,22 @@ void MainWindow::updateScriptTabs()
         }
 
         if (m_scriptDisassembler->isReady()) {
-            // Pass ROM reader for name resolution if available
-            if (wonderCardVisualDisplay && wonderCardVisualDisplay->isROMLoaded()) {
-                GBAROReader *reader = wonderCardVisualDisplay->getRomReader();
-                m_scriptDisassembler->setRomReader(reader);
-                qDebug() << "updateScriptTabs: ROM loaded, hasNameTables=" << (reader ? reader->hasNameTables() : false);
+            // Pass ROM names for name resolution if available
+            GBAROReader *reader = (wonderCardVisualDisplay && wonderCardVisualDisplay->isROMLoaded())
+                                      ? wonderCardVisualDisplay->getRomReader() : nullptr;
+            if (reader) {
+                m_scriptDisassembler->setRomNames(reader->versionName(), reader->itemNames(),
+                                                  reader->pokemonNames(), reader->moveNames());
+                qCDebug(lcUi) << "updateScriptTabs: ROM loaded, hasNameTables=" << reader->hasNameTables();
             } else {
-                m_scriptDisassembler->setRomReader(nullptr);
-                qDebug() << "updateScriptTabs: No ROM loaded";
+                m_scriptDisassembler->clearRomNames();
+                qCDebug(lcUi) << "updateScriptTabs: No ROM loaded";
             }
 
             // Disassemble as RamScript (includes header parsing)
             QString disassembly = m_scriptDisassembler->disassembleRamScript(
                 scriptPayload,
+                m_decodedScript,
                 true,   // showComments
                 true,   // showBytes
                 true    // showOffsets
@@ -1807,6 +2049,7 @@ void MainWindow::onEditableStatusUpdate(const QString &fieldName, int byteCount,
 
 void MainWindow::performSave(const QString &savePath, bool makeBackup)
 {
+    MGI_TRACE_SCOPE("MainWindow::performSave");
     // Use the currently loaded script data (from preset or save file)
     // m_currentScriptData is populated when:
     // 1. Loading a save file with existing Wonder Card
@@ -1814,6 +2057,17 @@ void MainWindow::performSave(const QString &savePath, bool makeBackup)
 
     QString errorMessage;
 
+    // Two sessions on one file would silently overwrite each other's writes
+    int otherSession = findSession(savePath);
+    if (otherSession >= 0 && otherSession != m_currentSession) {
+        QMessageBox box(QMessageBox::Warning, "",
+            QString("%1 is open in another tab.\n\nClose that tab before saving over it.")
+                .arg(QFileInfo(savePath).fileName()), QMessageBox::Ok, this);
+        box.setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
+        box.exec();
+        return;
+    }
+
     // Check if Mystery Gift flag is enabled
     if (!m_saveFile->isMysteryGiftEnabled()) {
         // Flag is not set - prompt user for action
@@ -1937,10 +2191,11 @@ void MainWindow::performSave(const QString &savePath, bool makeBackup)
         box.setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
         box.exec();
 
-        // Update file path display if saved to new location
-        if (savePath != m_saveFile->filePath()) {
-            setFilePathDisplay(savePath);
-        }
+        // A Save As moves the session to the new file: refresh its tab and the path display
+        m_documentTabs->setTabText(m_currentSession, QFileInfo(savePath).fileName());
+        m_documentTabs->setTabToolTip(m_currentSession, savePath);
+        setFilePathDisplay(savePath);
+        statusLabel->setText(QString("Status: %1").arg(QFileInfo(savePath).fileName()));
     } else {
         QMessageBox box(QMessageBox::Critical, "", "Failed to save file:\n\n" + errorMessage, QMessageBox::Ok, this);
         box.setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
@@ -1954,65 +2209,107 @@ void MainWindow::performSave(const QString &savePath, bool makeBackup)
 
 void MainWindow::loadRomDatabase()
 {
-    // Load ROM identification database from embedded Qt resource.
-    // This YAML file contains MD5 checksums and offset data for supported ROMs.
-    QString yamlPath = ":/Resources/gen3_rom_data.yaml";
-
+    // Load ROM identification database (compiled from gen3_rom_data.yaml at
+    // build time). It contains MD5 checksums and offset data for supported ROMs.
     QString error;
-    if (!m_romDatabase->loadFromYaml(yamlPath, error)) {
+    if (!m_romDatabase->load(error)) {
         qWarning() << "Failed to load ROM database:" << error;
         // Continue without database - will use fallback graphics
     } else {
-        qDebug() << "ROM database loaded successfully from embedded resource";
+        qCDebug(lcUi) << "ROM database loaded successfully from embedded resource";
     }
 }
 
 void MainWindow::loadROM()
 {
-    qDebug() << "MainWindow::loadROM() starting...";
-
-    // Search for ROM starting from working directory (recursively checks subdirectories)
-    QString searchDir = QDir::currentPath();
-    qDebug() << "Searching for ROM in:" << searchDir;
+    qCDebug(lcUi) << "MainWindow::loadROM() starting...";
 
-    // Use RomLoader for automatic ROM discovery (searches recursively)
-    RomLoader loader;
-    RomLoader::RomSearchResult result = loader.findRom(searchDir, m_romDatabase);
+    // The window is usable right away with fallback graphics; ROM assets are
+    // swapped in by the card widget as each loading stage completes
+    QString error;
+    wonderCardVisualDisplay->loadFallbackGraphics(error);
+    statusLabel->setText("Loading ROM...");
+    populateGiftDropdown();  // Fallback item IDs until name tables are ready
+
+    m_startupPool.start([this]() {
+        loadRomDatabase();
+
+        // Search for ROM starting from working directory (recursively checks subdirectories)
+        QString searchDir = QDir::currentPath();
+        qCDebug(lcUi) << "Searching for ROM in:" << searchDir;
+
+        // Use RomLoader for automatic ROM discovery (searches recursively)
+        RomLoader loader;
+        RomLoader::RomSearchResult result = loader.findRom(searchDir, m_romDatabase, &m_startupCancelled);
+
+        // If not found, also try application directory (for deployed builds)
+        if (!result.found && !m_startupCancelled.loadRelaxed()) {
+            QString appDir = QCoreApplication::applicationDirPath();
+            if (appDir != searchDir) {
+                qCDebug(lcUi) << "Also checking application directory:" << appDir;
+                result = loader.findRom(appDir, m_romDatabase, &m_startupCancelled);
+            }
+        }
 
-    // If not found, also try application directory (for deployed builds)
-    if (!result.found) {
-        QString appDir = QCoreApplication::applicationDirPath();
-        if (appDir != searchDir) {
-            qDebug() << "Also checking application directory:" << appDir;
-            result = loader.findRom(appDir, m_romDatabase);
+        if (m_startupCancelled.loadRelaxed()) {
+            return;  // Window is closing
         }
-    }
+
+        QMetaObject::invokeMethod(this, [this, result]() { onRomSearchFinished(result); },
+                                  Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::onRomSearchFinished(const RomLoader::RomSearchResult &result)
+{
+    m_romDatabaseReady = true;
 
     if (result.found) {
         // ROM found and identified
         m_romPath = result.path;
         m_romVersionName = result.versionName;
-
-        QString error;
-        if (wonderCardVisualDisplay->loadROM(m_romPath, error)) {
-            m_romLoaded = true;
-            m_useFallbackGraphics = false;
-            statusLabel->setText(QString("ROM: %1").arg(m_romVersionName));
-            qDebug() << "ROM loaded successfully:" << m_romVersionName;
-            populateGiftDropdown();
-        } else {
-            qWarning() << "Failed to load ROM graphics:" << error;
-            m_useFallbackGraphics = true;
-            statusLabel->setText("ROM found but graphics failed - using fallback");
-            populateGiftDropdown();  // Populate with fallback item IDs
-        }
+        statusLabel->setText(QString("Loading ROM: %1...").arg(m_romVersionName));
+        wonderCardVisualDisplay->loadROMAsync(m_romPath, m_romDatabase);
     } else {
         // No ROM found - offer manual selection or use fallback
-        qDebug() << "No ROM found automatically:" << result.errorMessage;
+        qCDebug(lcUi) << "No ROM found automatically:" << result.errorMessage;
         promptForROM();
     }
 
-    qDebug() << "MainWindow::loadROM() completed";
+    qCDebug(lcUi) << "MainWindow::loadROM() completed";
+}
+
+void MainWindow::onRomLoadProgress(const QString &stage)
+{
+    statusLabel->setText(QString("Loading ROM: %1 (%2)").arg(m_romVersionName, stage));
+}
+
+void MainWindow::onRomLoadFinished(bool success, const QString &errorMessage)
+{
+    // The widget replaced its reader; updateScriptTabs() re-fetches its names
+    m_scriptDisassembler->clearRomNames();
+
+    if (success) {
+        m_romLoaded = true;
+        m_useFallbackGraphics = false;
+        statusLabel->setText(QString("ROM: %1").arg(m_romVersionName));
+        qCDebug(lcUi) << "ROM loaded successfully:" << m_romVersionName;
+        populateGiftDropdown();
+
+        // Enable preset/gift combos if editing
+        if (m_editingEnabled) {
+            presetCombo->setEnabled(true);
+            giftCombo->setEnabled(true);
+        }
+
+        // Resolve names in an already displayed script
+        updateScriptTabs();
+    } else {
+        qWarning() << "Failed to load ROM graphics:" << errorMessage;
+        m_useFallbackGraphics = true;
+        statusLabel->setText("ROM found but graphics failed - using fallback");
+        populateGiftDropdown();  // Populate with fallback item IDs
+    }
 }
 
 void MainWindow::promptForROM()
@@ -2057,17 +2354,9 @@ void MainWindow::promptForROM()
                 m_romPath = romPath;
                 m_romVersionName = version->name;
 
-                QString error;
-                if (wonderCardVisualDisplay->loadROM(m_romPath, error)) {
-                    m_romLoaded = true;
-                    m_useFallbackGraphics = false;
-                    statusLabel->setText(QString("ROM: %1").arg(m_romVersionName));
-                    populateGiftDropdown();
-                } else {
-                    m_useFallbackGraphics = true;
-                    statusLabel->setText("ROM load failed - using fallback graphics");
-                    populateGiftDropdown();  // Populate with fallback item IDs
-                }
+                // Completion is handled by onRomLoadFinished()
+                statusLabel->setText(QString("Loading ROM: %1...").arg(m_romVersionName));
+                wonderCardVisualDisplay->loadROMAsync(m_romPath, m_romDatabase);
             } else {
                 QMessageBox::warning(this, "Unknown ROM",
                     QString("The selected ROM is not recognized.\n\n"
@@ -2092,7 +2381,7 @@ void MainWindow::promptForROM()
         m_useFallbackGraphics = true;
         m_romLoaded = false;
         statusLabel->setText("Fallback mode - no ROM loaded");
-        qDebug() << "User chose fallback graphics";
+        qCDebug(lcUi) << "User chose fallback graphics";
 
         // Load fallback graphics into the widget
         QString error;
@@ -2197,31 +2486,57 @@ void MainWindow::populateGiftDropdown()
 
     GBAROReader *reader = wonderCardVisualDisplay->getRomReader();
     if (reader && reader->hasNameTables()) {
-        // ROM loaded - use actual item names
-        int itemCount = reader->getItemCount();
-        qDebug() << "Populating gift dropdown with" << itemCount << "items from ROM";
-
-        for (int i = 0; i < itemCount; ++i) {
-            QString name = reader->getItemName(static_cast<uint16_t>(i));
+        // ROM loaded - use actual item names (decoded once at ROM load)
+        const NameTable &items = reader->itemNames();
+        qCDebug(lcUi) << "Populating gift dropdown with" << items.count() << "items from ROM";
+
+        NameTable::Builder names;
+        names.reserve(items.count());
+        for (int i = 0; i < items.count(); ++i) {
+            QString name = items.name(i);
             if (name.isEmpty()) {
                 name = QString("ITEM_0x%1").arg(i, 4, 16, QChar('0')).toUpper();
             }
-            // Store item ID as user data
-            giftCombo->addItem(name, QVariant(i));
+            names.append(name);
         }
+        m_giftNames = names.build();
     } else {
         // Fallback mode - populate with generic item IDs
         const int FALLBACK_ITEM_COUNT = 377;  // Max items in Gen3 (Emerald)
-        qDebug() << "Populating gift dropdown with" << FALLBACK_ITEM_COUNT << "fallback items";
+        qCDebug(lcUi) << "Populating gift dropdown with" << FALLBACK_ITEM_COUNT << "fallback items";
 
+        NameTable::Builder names;
+        names.reserve(FALLBACK_ITEM_COUNT);
         for (int i = 0; i < FALLBACK_ITEM_COUNT; ++i) {
-            QString name = QString("ITEM_0x%1").arg(i, 4, 16, QChar('0')).toUpper();
-            giftCombo->addItem(name, QVariant(i));
+            names.append(QString("ITEM_0x%1").arg(i, 4, 16, QChar('0')).toUpper());
         }
+        m_giftNames = names.build();
+    }
+
+    // Store item ID as user data
+    for (int i = 0; i < m_giftNames.count(); ++i) {
+        giftCombo->addItem(m_giftNames.name(i), QVariant(i));
     }
 
     giftCombo->blockSignals(false);
-    qDebug() << "Gift dropdown populated with" << giftCombo->count() << "items";
+    qCDebug(lcUi) << "Gift dropdown populated with" << giftCombo->count() << "items";
+}
+
+void MainWindow::onGiftFilterEdited(const QString &text)
+{
+    QStandardItemModel *model = static_cast<QStandardItemModel*>(m_giftCompleter->model());
+    model->clear();
+
+    const QVector<int> ids = m_giftNames.search(text, GIFT_FILTER_LIMIT);
+    for (int id : ids) {
+        QStandardItem *item = new QStandardItem(m_giftNames.name(id));
+        item->setData(id, Qt::UserRole);
+        model->appendRow(item);
+    }
+
+    if (!text.isEmpty()) {
+        m_giftCompleter->complete();
+    }
 }
 
 uint16_t MainWindow::extractItemIdFromScript(const QByteArray &scriptData)
@@ -2247,7 +2562,7 @@ uint16_t MainWindow::extractItemIdFromScript(const QByteArray &scriptData)
         if ((opcode == 0x47 || opcode == 0x46) && i + 4 < scriptData.size()) {
             uint16_t itemId = static_cast<uint8_t>(scriptData[i + 1]) |
                              (static_cast<uint8_t>(scriptData[i + 2]) << 8);
-            qDebug() << "Found item ID" << itemId << "at offset" << i << "via opcode" << Qt::hex << opcode;
+            qCDebug(lcUi) << "Found item ID" << itemId << "at offset" << i << "via opcode" << Qt::hex << opcode;
             return itemId;
         }
 
@@ -2260,7 +2575,7 @@ uint16_t MainWindow::extractItemIdFromScript(const QByteArray &scriptData)
                                 (static_cast<uint8_t>(scriptData[i + 4]) << 8);
                 // Check if value looks like an item ID (not a variable reference)
                 if (value < 0x4000) {
-                    qDebug() << "Found item ID" << value << "via setorcopyvar to VAR_0x8000";
+                    qCDebug(lcUi) << "Found item ID" << value << "via setorcopyvar to VAR_0x8000";
                     return value;
                 }
             }
@@ -2293,7 +2608,7 @@ void MainWindow::updateScriptItemId(uint16_t newItemId)
             m_currentScriptData[i + 1] = static_cast<char>(newItemId & 0xFF);
             m_currentScriptData[i + 2] = static_cast<char>((newItemId >> 8) & 0xFF);
             modified = true;
-            qDebug() << "Updated item ID at offset" << i << "to" << newItemId;
+            qCDebug(lcUi) << "Updated item ID at offset" << i << "to" << newItemId;
         }
 
         // setorcopyvar/copyvarifnotzero (0x1A) - update if setting VAR_0x8000 (item ID)
@@ -2308,7 +2623,7 @@ void MainWindow::updateScriptItemId(uint16_t newItemId)
                     m_currentScriptData[i + 3] = static_cast<char>(newItemId & 0xFF);
                     m_currentScriptData[i + 4] = static_cast<char>((newItemId >> 8) & 0xFF);
                     modified = true;
-                    qDebug() << "Updated setorcopyvar VAR_0x8000 to" << newItemId;
+                    qCDebug(lcUi) << "Updated setorcopyvar VAR_0x8000 to" << newItemId;
                 }
             }
         }
@@ -2333,7 +2648,7 @@ void MainWindow::onGiftComboChanged(int index)
     }
 
     uint16_t newItemId = static_cast<uint16_t>(data.toInt());
-    qDebug() << "Gift combo changed to index" << index << "item ID" << newItemId;
+    qCDebug(lcUi) << "Gift combo changed to index" << index << "item ID" << newItemId;
 
     // Update the script with the new item ID
     updateScriptItemId(newItemId);
@@ -2394,49 +2709,8 @@ void MainWindow::setFilePathDisplay(const QString &fullPath)
 
 void MainWindow::onCloseFile()
 {
-    // Reset save file
-    delete m_saveFile;
-    m_saveFile = new SaveFile();
-
-    // Clear Wonder Card display and data
-    clearWonderCardDisplay();
-
-    // Explicitly clear GREEN MAN / script displays
-    scriptTextDisplay->clear();
-    scriptHexDisplay->clear();
-
-    // Reset file path display
-    filePathDisplay->setText("<span style='color: #909090; font-style: italic;'>No file loaded</span>");
-    filePathDisplay->setToolTip("");
-
-    // Reset save type button
-    saveTypeButton->setText("Not detected");
-    saveTypeButton->setEnabled(false);
-    saveTypeButton->setStyleSheet(
-        "QPushButton { background-color: transparent; color: #909090; border: none; "
-        "             font-weight: normal; font-style: italic; padding: 5px 10px; }"
-        "QPushButton:enabled { cursor: pointer; }"
-        "QPushButton:enabled:hover { color: #505050; text-decoration: underline; }"
-    );
-
-    // Reset status bar
-    statusLabel->setText("Status: No file loaded");
-    checksumLabel->setText("Checksum: --");
-    checksumLabel->setStyleSheet("font-weight: bold; color: white; background: transparent;");
-
-    // Disable file-dependent actions
-    closeAction->setEnabled(false);
-    saveAction->setEnabled(false);
-    saveAsAction->setEnabled(false);
-    editButton->setEnabled(false);
-    editEnableAction->setEnabled(false);
-    exportWcAction->setEnabled(false);
-    clearWcAction->setEnabled(false);
-    enableMgFlagAction->setEnabled(false);
-    validateChecksumsAction->setEnabled(false);
-
-    // Reset edit state
-    resetEditState();
+    // Close the current session; the next one (if any) is shown
+    closeSession(m_currentSession);
 }
 
 // ===== EDIT MENU ACTIONS =====
@@ -2594,6 +2868,11 @@ void MainWindow::onLoadRomManual()
         return;
     }
 
+    if (!m_romDatabaseReady) {
+        statusLabel->setText("ROM database is still loading - try again shortly");
+        return;
+    }
+
     // Validate the selected ROM
     QString md5 = RomLoader::computeMD5(romPath);
     const RomDatabase::RomVersion *version = m_romDatabase->identifyRom(md5);
@@ -2690,6 +2969,54 @@ void MainWindow::onValidateChecksums()
     }
 }
 
+void MainWindow::onRestoreDeltaBackup()
+{
+    if (!m_saveFile->isLoaded()) {
+        QMessageBox box(QMessageBox::Warning, "", "Please load a save file first.", QMessageBox::Ok, this);
+        box.setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
+        box.exec();
+        return;
+    }
+
+    QString savePath = m_saveFile->filePath();
+    QString deltaPath = SaveFile::deltaBackupPath(savePath);
+    if (!QFile::exists(deltaPath)) {
+        QMessageBox box(QMessageBox::Information, "",
+            "This save file has no delta backup.\n\nDelta backups are written by patched saves with backups enabled.",
+            QMessageBox::Ok, this);
+        box.setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
+        box.exec();
+        return;
+    }
+
+    QMessageBox confirm(QMessageBox::Question, "",
+        QString("Restore %1 from %2?\n\nThe file is reloaded afterwards; unsaved changes are lost.")
+            .arg(QFileInfo(savePath).fileName(), QFileInfo(deltaPath).fileName()),
+        QMessageBox::Yes | QMessageBox::No, this);
+    confirm.setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
+    if (confirm.exec() != QMessageBox::Yes) {
+        return;
+    }
+
+    QString errorMessage;
+    if (!SaveFile::restoreFromDeltaBackup(savePath, deltaPath, errorMessage)) {
+        QMessageBox box(QMessageBox::Warning, "", "Failed to restore delta backup:\n\n" + errorMessage, QMessageBox::Ok, this);
+        box.setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
+        box.exec();
+        return;
+    }
+
+    // Reload: the session still holds the pre-restore contents
+    closeSession(m_currentSession);
+    if (!openSaveFile(savePath, errorMessage)) {
+        QMessageBox box(QMessageBox::Warning, "", "Backup restored, but reloading failed:\n\n" + errorMessage, QMessageBox::Ok, this);
+        box.setWindowFlags(Qt::FramelessWindowHint | Qt::Dialog);
+        box.exec();
+        return;
+    }
+    statusLabel->setText("Restored from delta backup");
+}
+
 void MainWindow::onOpenOptions()
 {
     // TODO: Implement options dialog
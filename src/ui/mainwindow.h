@@ -42,6 +42,10 @@
 #include <QStackedWidget>
 #include <QSpinBox>
 #include <QActionGroup>
+#include <QThreadPool>
+#include <QCompleter>
+#include <QTabBar>
+#include <QSharedPointer>
 
 // =============================================================================
 // Project Includes
@@ -51,6 +55,7 @@
 #include "authenticwondercardwidget.h"   // Visual Wonder Card renderer/editor widget
 #include "romdatabase.h"                 // ROM version identification database
 #include "romloader.h"                   // ROM file discovery and loading
+#include "nametable.h"                   // Searchable item names for the gift filter
 #include "scriptdisassembler.h"          // GBA script bytecode disassembler
 
 /**
@@ -106,12 +111,18 @@ private slots:
     // File Menu Slots
     // =========================================================================
 
-    /** @brief Opens a Pokemon save file (.sav) via file dialog. */
+    /** @brief Opens one or more Pokemon save files (.sav), one tab each. */
     void onOpenClicked();
 
-    /** @brief Closes the current save file and resets UI to initial state. */
+    /** @brief Closes the current save file and shows the next open one (or resets the UI). */
     void onCloseFile();
 
+    /** @brief Switches to the save session of the selected document tab. */
+    void onDocumentTabChanged(int index);
+
+    /** @brief Closes the save session of a document tab. */
+    void onDocumentTabCloseRequested(int index);
+
     /** @brief Saves Wonder Card injection to the current file path. */
     void onSaveClicked();
 
@@ -157,12 +168,21 @@ private slots:
     /** @brief Manually load a ROM file via file dialog. */
     void onLoadRomManual();
 
+    /** @brief Reports a completed stage of the asynchronous ROM load. */
+    void onRomLoadProgress(const QString &stage);
+
+    /** @brief Applies the result of the asynchronous ROM load. */
+    void onRomLoadFinished(bool success, const QString &errorMessage);
+
     /** @brief Enables the Mystery Gift flag in the save file. */
     void onEnableMysteryGiftFlag();
 
     /** @brief Validates all checksums in the save file. */
     void onValidateChecksums();
 
+    /** @brief Undoes patched saves of the current file from its .bakd delta backup. */
+    void onRestoreDeltaBackup();
+
     /** @brief Opens the options dialog (not yet implemented). */
     void onOpenOptions();
 
@@ -305,6 +325,7 @@ private:
     QAction *loadRomAction;             ///< Manually load ROM
     QAction *enableMgFlagAction;        ///< Enable Mystery Gift flag in save
     QAction *validateChecksumsAction;   ///< Validate save file checksums
+    QAction *restoreDeltaAction;        ///< Restore save from its delta backup
 
     // =========================================================================
     // View Mode Widgets
@@ -341,6 +362,9 @@ private:
     QGroupBox *textDataGroup;   ///< Main container for Wonder Card display area
     QComboBox *presetCombo;     ///< Preset ticket selection dropdown
     QComboBox *giftCombo;       ///< Gift item selection dropdown (populated from ROM)
+    QCompleter *m_giftCompleter;   ///< Filter popup over m_giftNames
+    NameTable m_giftNames;         ///< Names in giftCombo order (index = item ID)
+    static const int GIFT_FILTER_LIMIT = 50;   ///< Maximum entries in the filter popup
 
     // =========================================================================
     // Wonder Card Visual Control Widgets
@@ -365,9 +389,52 @@ private:
     // =========================================================================
     // Core Data Objects
     // =========================================================================
-    SaveFile *m_saveFile;               ///< Current loaded Pokemon save file
+    SaveFile *m_saveFile;               ///< Current session's save file (or m_emptySaveFile); not owned
     TicketManager *m_ticketManager;     ///< Manages ticket preset resources
 
+    // =========================================================================
+    // Open Documents
+    // =========================================================================
+
+    /// <summary>
+    /// One open save file and its unsaved Wonder Card state. Sessions only own
+    /// their 128 KB save; ROM, fonts and backgrounds are loaded once into
+    /// wonderCardVisualDisplay and shared by every session.
+    /// </summary>
+    struct SaveSession {
+        QSharedPointer<SaveFile> saveFile;
+        WonderCardData wonderCard;
+        QByteArray wonderCardRaw;
+        QByteArray scriptData;
+        QString presetTicketId;         ///< Ticket of the preset shown (matched or chosen), empty if none
+    };
+
+    QTabBar *m_documentTabs;            ///< One tab per session (hidden when none are open)
+    QVector<SaveSession> m_sessions;    ///< Parallel to m_documentTabs
+    int m_currentSession;               ///< Index into m_sessions, -1 when nothing is open
+    SaveFile m_emptySaveFile;           ///< Stand-in for m_saveFile when nothing is open
+
+    /** @brief Returns the session index for a save path, or -1 if it is not open. */
+    int findSession(const QString &filePath) const;
+
+    /** @brief Loads a save into a new session and shows it (or selects it if already open). */
+    bool openSaveFile(const QString &filePath, QString &errorMessage);
+
+    /** @brief Copies the current Wonder Card state back into the current session. */
+    void storeCurrentSession();
+
+    /** @brief Makes a session current (m_saveFile and Wonder Card state), without touching the UI. */
+    void activateSession(int index);
+
+    /** @brief Refreshes toolbar, status bar and Wonder Card display from the current session. */
+    void showCurrentSession();
+
+    /** @brief Resets the UI to the "no file loaded" state. */
+    void showNoSession();
+
+    /** @brief Closes a session and shows a neighbouring one if it was current. */
+    void closeSession(int index);
+
     /** @brief Loads ticket presets from Tickets/ folder. */
     void loadTickets();
 
@@ -426,13 +493,19 @@ private:
     QString m_romVersionName;      ///< Human-readable ROM version name
     bool m_romLoaded;              ///< True if ROM graphics are loaded
     bool m_useFallbackGraphics;    ///< True to use built-in fallback graphics
+    bool m_romDatabaseReady;       ///< False while the startup worker owns m_romDatabase
+    QThreadPool m_startupPool;     ///< Runs database loading and ROM discovery
+    QAtomicInt m_startupCancelled; ///< Set on close to stop the ROM search early
 
-    /** @brief Loads ROM database from embedded YAML resource. */
+    /** @brief Loads ROM database from embedded YAML resource (startup worker thread). */
     void loadRomDatabase();
 
-    /** @brief Auto-discovers and loads GBA ROM from application directory. */
+    /** @brief Shows fallback graphics, then loads the database and discovers the ROM in the background. */
     void loadROM();
 
+    /** @brief Starts loading the discovered ROM, or prompts when none was found. */
+    void onRomSearchFinished(const RomLoader::RomSearchResult &result);
+
     /** @brief Prompts user to select ROM or use fallback graphics. */
     void promptForROM();
 
@@ -440,8 +513,9 @@ private:
     // Script Disassembly
     // =========================================================================
     ScriptDisassembler *m_scriptDisassembler;   ///< GBA script bytecode disassembler
+    DecodedScript m_decodedScript;              ///< Decode buffer reused on every script edit
 
-    /** @brief Loads script command definitions from embedded YAML resources. */
+    /** @brief Loads script command definitions compiled from the YAML resources. */
     void initScriptDisassembler();
 
     // =========================================================================
@@ -467,6 +541,9 @@ private:
     /** @brief Handles gift dropdown selection change. */
     void onGiftComboChanged(int index);
 
+    /** @brief Refreshes the gift filter popup with items matching the typed text. */
+    void onGiftFilterEdited(const QString &text);
+
     // =========================================================================
     // Utility Methods
     // =========================================================================